@@ -0,0 +1,86 @@
+//
+// Copyright 2013 Yangbin Lin and Bili Chen. All Rights Reserved.
+//
+// Author: yblin.xmu@qq.com (Yangbin Lin)
+//
+// To use this code, please cite the follow paper:
+//
+// Chen B, Zeng W, Lin Y, et al. A New Local Search-Based Multiobjective
+// Optimization Algorithm[J]. IEEE Transactions on Evolutionary Computation,
+// 2014, 19(1):1-1.
+//
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "bench/bench.h"
+#include "codelibrary/util/common/arg_sort.h"
+#include "codelibrary/util/common/sequence.h"
+
+namespace {
+
+/**
+ * Print the nanoseconds per element of Sequence and ArgSort on n random
+ * values of type T.
+ */
+template <typename T>
+void Compare(const char* type, int n, int n_threads) {
+    std::mt19937 random(1);
+    std::uniform_real_distribution<double> uniform(-1e6, 1e6);
+    std::vector<T> values(n);
+    for (T& value : values) {
+        value = static_cast<T>(uniform(random));
+    }
+
+    double t_sequence = bench::Time([&]() {
+        cl::Sequence<T> sequence(values);
+        bench::Consume(sequence[0]);
+    });
+
+    std::vector<int> orders;
+    cl::ArgSort arg_sort;
+    double t_sort = bench::Time([&]() {
+        arg_sort.Sort(values, &orders);
+        bench::Consume(orders[0]);
+    });
+
+    cl::ArgSort parallel_sort(n_threads);
+    double t_parallel = bench::Time([&]() {
+        parallel_sort.Sort(values, &orders);
+        bench::Consume(orders[0]);
+    });
+
+    double t_partial = bench::Time([&]() {
+        arg_sort.PartialSort(values, n / 10, &orders);
+        bench::Consume(orders[0]);
+    });
+
+    std::printf("%-6s %8d %10.2f %10.2f %10.2f %10.2f\n", type, n,
+                1e9 * t_sequence / n, 1e9 * t_sort / n,
+                1e9 * t_parallel / n, 1e9 * t_partial / n);
+}
+
+} // namespace
+
+// The nanoseconds per element of cl::Sequence and cl::ArgSort: Sort() with one
+// thread and with all hardware threads, and PartialSort() of the 10%
+// smallest values.
+BENCHMARK(ArgSort_VersusSequence) {
+    int n_threads = std::max(1u, std::thread::hardware_concurrency());
+    std::printf("%-6s %8s %10s %10s %10s %10s   (ns per element)\n", "type",
+                "n", "Sequence", "ArgSort", "threads", "partial");
+    const int sizes[] = { 100, 1000, 10000, 100000, 1000000 };
+    for (int n : sizes) {
+        Compare<double>("double", n, n_threads);
+    }
+    for (int n : sizes) {
+        Compare<float>("float", n, n_threads);
+    }
+    for (int n : sizes) {
+        Compare<int>("int", n, n_threads);
+    }
+    std::printf("threads = %d\n", n_threads);
+}
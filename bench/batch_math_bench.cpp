@@ -0,0 +1,87 @@
+//
+// Copyright 2013 Yangbin Lin and Bili Chen. All Rights Reserved.
+//
+// Author: yblin.xmu@qq.com (Yangbin Lin)
+//
+// To use this code, please cite the follow paper:
+//
+// Chen B, Zeng W, Lin Y, et al. A New Local Search-Based Multiobjective
+// Optimization Algorithm[J]. IEEE Transactions on Evolutionary Computation,
+// 2014, 19(1):1-1.
+//
+
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "bench/bench.h"
+#include "codelibrary/math/batch_math_array.h"
+
+#if CL_BATCH_MATH
+
+using namespace cl::batch_math;
+
+namespace {
+
+// The number of values per call, which fit in the L1 cache.
+const int N_VALUES = 1024;
+
+typedef void (*ArrayFunction)(const double*, int, double*, Accuracy);
+typedef double (*LibmFunction)(double);
+
+/**
+ * Print the nanoseconds per value of libm and of batch_math at each accuracy.
+ */
+void Compare(const char* name, LibmFunction libm, ArrayFunction batch,
+             double low, double high) {
+    std::mt19937 random(1);
+    std::uniform_real_distribution<double> uniform(low, high);
+    std::vector<double> x(N_VALUES), y(N_VALUES);
+    for (double& v : x) {
+        v = uniform(random);
+    }
+
+    double t_libm = bench::Time([&]() {
+        for (int i = 0; i < N_VALUES; ++i) {
+            y[i] = libm(x[i]);
+        }
+        bench::Consume(y[N_VALUES - 1]);
+    });
+    std::printf("%-6s %8.2f", name, 1e9 * t_libm / N_VALUES);
+
+    const Accuracy accuracies[] = {
+        FULL_ACCURACY, HIGH_ACCURACY, LOW_ACCURACY
+    };
+    for (Accuracy accuracy : accuracies) {
+        double t = bench::Time([&]() {
+            batch(x.data(), N_VALUES, y.data(), accuracy);
+            bench::Consume(y[N_VALUES - 1]);
+        });
+        std::printf(" %8.2f", 1e9 * t / N_VALUES);
+    }
+    std::printf("\n");
+}
+
+double PowOfTwoThirds(double x) { return std::pow(x, 2.0 / 3.0); }
+
+void PowOfTwoThirds(const double* x, int n, double* y, Accuracy accuracy) {
+    static const std::vector<double> exponents(N_VALUES, 2.0 / 3.0);
+    Pow(x, exponents.data(), n, y, accuracy);
+}
+
+} // namespace
+
+// The nanoseconds per value of the elementary functions, by libm and by the
+// array functions of batch_math (dispatched to the best instruction set).
+BENCHMARK(BatchMath_VersusLibm) {
+    std::printf("%-6s %8s %8s %8s %8s   (ns per value)\n", "", "libm",
+                "full", "high", "low");
+    Compare("sin", std::sin, Sin, -100.0, 100.0);
+    Compare("cos", std::cos, Cos, -100.0, 100.0);
+    Compare("exp", std::exp, Exp, -700.0, 700.0);
+    Compare("log", std::log, Log, 1e-300, 1e300);
+    Compare("pow", PowOfTwoThirds, PowOfTwoThirds, 0.0, 10.0);
+}
+
+#endif // CL_BATCH_MATH
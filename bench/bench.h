@@ -0,0 +1,108 @@
+//
+// Copyright 2013 Yangbin Lin and Bili Chen. All Rights Reserved.
+//
+// Author: yblin.xmu@qq.com (Yangbin Lin)
+//
+// To use this code, please cite the follow paper:
+//
+// Chen B, Zeng W, Lin Y, et al. A New Local Search-Based Multiobjective
+// Optimization Algorithm[J]. IEEE Transactions on Evolutionary Computation,
+// 2014, 19(1):1-1.
+//
+
+#ifndef BENCH_BENCH_H_
+#define BENCH_BENCH_H_
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+/// A benchmark registered by BENCHMARK().
+struct Benchmark {
+    const char* name;
+    void (*function)();
+};
+
+/**
+ * All registered benchmarks.
+ */
+inline std::vector<Benchmark>* Registry() {
+    static std::vector<Benchmark> registry;
+    return &registry;
+}
+
+/// Register a benchmark at the static initialization.
+struct Registrar {
+    Registrar(const char* name, void (*function)()) {
+        Benchmark benchmark = { name, function };
+        Registry()->push_back(benchmark);
+    }
+};
+
+/**
+ * Run the benchmarks whose names contain 'filter'. Each benchmark prints its
+ * own table.
+ *
+ * @return the number of benchmarks run.
+ */
+inline int RunAll(const std::string& filter) {
+    int n = 0;
+    for (const Benchmark& benchmark : *Registry()) {
+        if (std::string(benchmark.name).find(filter) == std::string::npos) {
+            continue;
+        }
+        std::printf("== %s\n", benchmark.name);
+        benchmark.function();
+        std::printf("\n");
+        std::fflush(stdout);
+        ++n;
+    }
+    return n;
+}
+
+/**
+ * Keep a result alive, so that the measured computation is not optimized out.
+ */
+inline void Consume(double value) {
+    volatile double sink = value;
+    (void)sink;
+}
+
+/**
+ * The seconds per call of function, called repeatedly for at least
+ * 'min_seconds' after one warm-up call.
+ */
+template <class Function>
+double Time(const Function& function, double min_seconds = 0.2) {
+    typedef std::chrono::steady_clock Clock;
+
+    function();
+    for (long long n = 1; ; n *= 2) {
+        Clock::time_point start = Clock::now();
+        for (long long i = 0; i < n; ++i) {
+            function();
+        }
+        double seconds = std::chrono::duration<double>(Clock::now() -
+                                                       start).count();
+        if (seconds >= min_seconds) return seconds / n;
+    }
+}
+
+} // namespace bench
+
+/**
+ * Define a benchmark, e.g.,
+ *
+ *    BENCHMARK(BatchMath_Throughput) {
+ *        std::printf("%.2f ns\n", 1e9 * bench::Time(...));
+ *    }
+ */
+#define BENCHMARK(name)                                              \
+    static void name();                                              \
+    static bench::Registrar name##_registrar(#name, name);           \
+    static void name()
+
+#endif // BENCH_BENCH_H_
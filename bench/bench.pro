@@ -0,0 +1,27 @@
+TEMPLATE = app
+CONFIG += console
+CONFIG -= app_bundle
+CONFIG -= qt
+CONFIG += c++11
+CONFIG += release
+
+TARGET = bench
+INCLUDEPATH += ..
+
+SOURCES += \
+    main.cpp \
+    arg_sort_bench.cpp \
+    batch_math_bench.cpp \
+    float_storage_bench.cpp \
+    process_pool_bench.cpp \
+    solver_nsls_bench.cpp
+
+HEADERS += \
+    bench.h
+
+unix:QMAKE_CXXFLAGS += -pthread
+unix:LIBS += -pthread -ldl
+
+# The wide vectors of cl::batch_math are passed by value only to the inlined
+# functions, so the ABI warnings of GCC do not apply.
+*-g++*:QMAKE_CXXFLAGS += -Wno-psabi
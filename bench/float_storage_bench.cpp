@@ -0,0 +1,183 @@
+//
+// Copyright 2013 Yangbin Lin and Bili Chen. All Rights Reserved.
+//
+// Author: yblin.xmu@qq.com (Yangbin Lin)
+//
+// To use this code, please cite the follow paper:
+//
+// Chen B, Zeng W, Lin Y, et al. A New Local Search-Based Multiobjective
+// Optimization Algorithm[J]. IEEE Transactions on Evolutionary Computation,
+// 2014, 19(1):1-1.
+//
+
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+#include "bench/bench.h"
+#include "codelibrary/util/array/array_2d.h"
+#include "solver/util/bitset_non_dominated_sort.h"
+#include "solver/util/non_dominated_archive.h"
+#include "test/metrics.h"
+
+namespace {
+
+/**
+ * The bytes of heap in use, 0 if unknown.
+ */
+double HeapBytes() {
+#if defined(__GLIBC__) && \
+    (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    struct mallinfo2 info = mallinfo2();
+    return static_cast<double>(info.uordblks + info.hblkhd);
+#else
+    return 0.0;
+#endif
+}
+
+/**
+ * n individuals with m objectives on the positive unit sphere, which are
+ * non-dominated to each other, and d random variables.
+ */
+moo::Population SpherePoints(int n, int m, int d) {
+    std::mt19937 random(1);
+    std::normal_distribution<double> normal(0.0, 1.0);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    moo::Population population(n);
+    for (moo::Individual& individual : population) {
+        individual.objectives.resize(m);
+        double norm = 0.0;
+        for (double& f : individual.objectives) {
+            f = std::fabs(normal(random));
+            norm += f * f;
+        }
+        for (double& f : individual.objectives) {
+            f /= std::sqrt(norm);
+        }
+        individual.variables.resize(d);
+        for (double& x : individual.variables) {
+            x = uniform(random);
+        }
+    }
+    return population;
+}
+
+/**
+ * n individuals with m uniform random objectives.
+ */
+moo::Population RandomPoints(int n, int m) {
+    std::mt19937 random(2);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    moo::Population population(n);
+    for (moo::Individual& individual : population) {
+        individual.objectives.resize(m);
+        for (double& f : individual.objectives) {
+            f = uniform(random);
+        }
+    }
+    return population;
+}
+
+/**
+ * Print the heap, the insertion and the export of an archive of type A.
+ */
+template <class A>
+void Archive(const char* type, const moo::Population& points) {
+    double heap = HeapBytes();
+    A* archive = new A();
+    double t_insert = bench::Time([&]() {
+        archive->clear();
+        archive->Insert(points);
+    }, 0.0);
+    double bytes = HeapBytes() - heap;
+
+    moo::Population exported;
+    double t_export = bench::Time([&]() {
+        archive->Export(100, &exported);
+        bench::Consume(exported[0].objectives[0]);
+    }, 0.0);
+    std::printf("archive  %-6s %10.1f %10.3f %10.3f %8d\n", type,
+                bytes / (1 << 20), t_insert, t_export, archive->size());
+    delete archive;
+}
+
+/**
+ * Print the time of sorting by a bitset sort of type S.
+ */
+template <class S>
+void Sort(const char* type, const moo::Population& population,
+          std::vector<int>* ranks) {
+    S sort(1);
+    double t = bench::Time([&]() {
+        sort.Ranks(population, -1, ranks);
+        bench::Consume((*ranks)[0]);
+    });
+    std::printf("sort     %-6s %10s %10.3f %10s %8d  M = %d\n", type, "-",
+                t, "-", static_cast<int>(population.size()),
+                static_cast<int>(population[0].objectives.size()));
+}
+
+/**
+ * Print the memory and the time of IGD against a front of type T.
+ */
+template <typename T>
+void IGD(const char* type, const moo::Population& population,
+         const moo::Population& points, double* igd) {
+    int m = static_cast<int>(points[0].objectives.size());
+    cl::Array2D<T> front(static_cast<int>(points.size()), m);
+    for (int i = 0; i < front.rows(); ++i) {
+        for (int k = 0; k < m; ++k) {
+            front(i, k) = static_cast<T>(points[i].objectives[k]);
+        }
+    }
+    double t = bench::Time([&]() {
+        *igd = moo::Metrics::IGD(population, front);
+    }, 0.0);
+    std::printf("igd      %-6s %10.1f %10.3f %10s %8d\n", type,
+                front.data().size() * sizeof(T) / double(1 << 20), t, "-",
+                front.rows());
+}
+
+} // namespace
+
+// The memory (MB of heap) and the seconds of the structures that may store
+// their values in float, against double:
+//  - archive: insert 300000 non-dominated points (M = 3, 10 variables), and
+//    Export(100);
+//  - sort: the ranks of 4000 and 20000 random points by the bitset sort;
+//  - igd: IGD of 100 points against a front of 10^6 points (M = 3).
+BENCHMARK(FloatStorage_MemoryAndThroughput) {
+    std::printf("%-8s %-6s %10s %10s %10s %8s\n", "", "type", "MB",
+                "seconds", "export", "size");
+
+    moo::Population points = SpherePoints(300000, 3, 10);
+    Archive<moo::NonDominatedArchive>("double", points);
+    Archive<moo::FloatNonDominatedArchive>("float", points);
+
+    const int sizes[] = { 4000, 20000 };
+    const int objectives[] = { 2, 3, 5 };
+    for (int n : sizes) {
+        for (int m : objectives) {
+            moo::Population population = RandomPoints(n, m);
+            std::vector<int> ranks, float_ranks;
+            Sort<moo::BitsetNonDominatedSort>("double", population, &ranks);
+            Sort<moo::FloatBitsetNonDominatedSort>("float", population,
+                                                   &float_ranks);
+            if (ranks != float_ranks) {
+                std::printf("         the ranks of float differ\n");
+            }
+        }
+    }
+
+    moo::Population front = SpherePoints(1000000, 3, 0);
+    moo::Population population = SpherePoints(100, 3, 0);
+    double igd = 0.0, float_igd = 0.0;
+    IGD<double>("double", population, front, &igd);
+    IGD<float>("float", population, front, &float_igd);
+    std::printf("         IGD %.9g (double), %.9g (float)\n", igd, float_igd);
+}
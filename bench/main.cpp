@@ -0,0 +1,26 @@
+//
+// Copyright 2013 Yangbin Lin and Bili Chen. All Rights Reserved.
+//
+// Author: yblin.xmu@qq.com (Yangbin Lin)
+//
+// To use this code, please cite the follow paper:
+//
+// Chen B, Zeng W, Lin Y, et al. A New Local Search-Based Multiobjective
+// Optimization Algorithm[J]. IEEE Transactions on Evolutionary Computation,
+// 2014, 19(1):1-1.
+//
+
+#include <cstdio>
+#include <string>
+
+#include "bench/bench.h"
+
+// Usage: bench [filter], runs the benchmarks whose names contain filter.
+int main(int argc, char* argv[]) {
+    std::string filter = argc > 1 ? argv[1] : "";
+    if (bench::RunAll(filter) == 0) {
+        std::printf("No benchmark matches '%s'.\n", filter.c_str());
+        return 1;
+    }
+    return 0;
+}
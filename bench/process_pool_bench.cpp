@@ -0,0 +1,99 @@
+//
+// Copyright 2013 Yangbin Lin and Bili Chen. All Rights Reserved.
+//
+// Author: yblin.xmu@qq.com (Yangbin Lin)
+//
+// To use this code, please cite the follow paper:
+//
+// Chen B, Zeng W, Lin Y, et al. A New Local Search-Based Multiobjective
+// Optimization Algorithm[J]. IEEE Transactions on Evolutionary Computation,
+// 2014, 19(1):1-1.
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "bench/bench.h"
+#include "solver/util/process_pool_evaluator.h"
+
+#ifndef _WIN32
+
+namespace {
+
+// The size of the evaluated batches, i.e., of a population.
+const int N_CANDIDATES = 256;
+
+// The dimensions of the stand-in problem.
+const int N_VARIABLES = 30;
+const int N_OBJECTIVES = 2;
+
+/**
+ * A stand-in for an external objective: it spins for 'microseconds', then
+ * returns two cheap objectives.
+ */
+moo::ProcessPoolEvaluator::Function StandIn(int microseconds) {
+    return [microseconds](const std::vector<double>& x,
+                          std::vector<double>* f) {
+        typedef std::chrono::steady_clock Clock;
+        Clock::time_point end = Clock::now() +
+                                std::chrono::microseconds(microseconds);
+        while (Clock::now() < end) {}
+
+        double sum = 0.0;
+        for (double v : x) {
+            sum += v;
+        }
+        (*f)[0] = x[0];
+        (*f)[1] = sum;
+    };
+}
+
+} // namespace
+
+// The microseconds per evaluation of a batch of 256 candidates by the stand-in
+// objective that spins for 0, 10 and 100 microseconds, in process and by the
+// pool of 1, 2 and 4 workers. With 0 microseconds, the pool time is the
+// overhead of the shared slots and the semaphores per evaluation.
+BENCHMARK(ProcessPool_EvaluationOverhead) {
+    std::mt19937 random(1);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    cl::Array2D<double> variables(N_CANDIDATES, N_VARIABLES);
+    for (double& v : variables.data()) {
+        v = uniform(random);
+    }
+    cl::Array2D<double> objectives;
+
+    std::printf("%6s %10s %10s %10s %10s   (us per evaluation)\n", "work",
+                "in-process", "1 worker", "2 workers", "4 workers");
+    const int works[] = { 0, 10, 100 };
+    for (int work : works) {
+        moo::ProcessPoolEvaluator::Function function = StandIn(work);
+        std::vector<double> x(N_VARIABLES), f(N_OBJECTIVES);
+        double t_direct = bench::Time([&]() {
+            for (int i = 0; i < N_CANDIDATES; ++i) {
+                std::copy_n(variables.data().begin() + i * N_VARIABLES,
+                            N_VARIABLES, x.begin());
+                function(x, &f);
+            }
+            bench::Consume(f[1]);
+        });
+        std::printf("%6d %10.2f", work, 1e6 * t_direct / N_CANDIDATES);
+
+        const int n_workers[] = { 1, 2, 4 };
+        for (int n : n_workers) {
+            moo::ProcessPoolEvaluator evaluator(N_VARIABLES, N_OBJECTIVES,
+                                                function, n);
+            double t = bench::Time([&]() {
+                evaluator.Evaluate(variables, &objectives);
+                bench::Consume(objectives(N_CANDIDATES - 1, 1));
+            });
+            std::printf(" %10.2f", 1e6 * t / N_CANDIDATES);
+        }
+        std::printf("\n");
+    }
+}
+
+#endif // _WIN32
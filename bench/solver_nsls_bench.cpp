@@ -0,0 +1,102 @@
+//
+// Copyright 2013 Yangbin Lin and Bili Chen. All Rights Reserved.
+//
+// Author: yblin.xmu@qq.com (Yangbin Lin)
+//
+// To use this code, please cite the follow paper:
+//
+// Chen B, Zeng W, Lin Y, et al. A New Local Search-Based Multiobjective
+// Optimization Algorithm[J]. IEEE Transactions on Evolutionary Computation,
+// 2014, 19(1):1-1.
+//
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <string>
+
+#include "bench/bench.h"
+#include "solver/solver_nsls.h"
+#include "test/test_factory.h"
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+// The seconds spent in the phases of the timed solver.
+double update_seconds = 0.0;
+double truncation_seconds = 0.0;
+
+double Seconds(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+/// NSLSUpdater that adds its time to update_seconds.
+class TimedUpdater : public moo::NSLSUpdater {
+public:
+    int operator() (const moo::BasicTest& test, std::mt19937* random,
+                    moo::Population* population,
+                    moo::Surrogate* surrogate = NULL,
+                    const std::vector<int>* variables = NULL) {
+        Clock::time_point start = Clock::now();
+        int n = NSLSUpdater::operator()(test, random, population, surrogate,
+                                        variables);
+        update_seconds += Seconds(start);
+        return n;
+    }
+};
+
+/// FarthestCandidate that adds its time to truncation_seconds.
+class TimedSelector : public moo::FarthestCandidate {
+public:
+    void operator () (const moo::BasicTest& test,
+                      const moo::Population& population, int n,
+                      moo::Population* selected_population) const {
+        Clock::time_point start = Clock::now();
+        FarthestCandidate::operator()(test, population, n,
+                                      selected_population);
+        truncation_seconds += Seconds(start);
+    }
+};
+
+} // namespace
+
+// The milliseconds per generation of SolverNSLS (N = 100) on DTLZ2 with M
+// objectives and M + 9 variables, split into the phases: the local search
+// with the evaluations, the truncation of the last front by the farthest
+// candidates, and the rest, i.e., the non-dominated sort and the copies.
+BENCHMARK(SolverNSLS_Phases) {
+    const int N_GENERATIONS = 100;
+
+    std::printf("%3s %10s %10s %10s %10s %12s   (ms per generation)\n", "M",
+                "total", "update", "truncation", "sort+rest", "evaluations");
+    const int objectives[] = { 2, 3, 5, 8, 10, 15 };
+    for (int m : objectives) {
+        std::string name = "DTLZ2_M" + std::to_string(m) + "_D" +
+                           std::to_string(m + 9);
+        std::unique_ptr<moo::BasicTest> test(
+                moo::TestFactory::CreateTest(name));
+
+        moo::SolverNSLS<TimedSelector, TimedUpdater> solver;
+        solver.set_seed(1);
+        moo::Population population;
+        solver.Initialize(*test, 100, &population);
+        int64_t n_evaluations = solver.n_evaluations();
+
+        update_seconds = 0.0;
+        truncation_seconds = 0.0;
+        Clock::time_point start = Clock::now();
+        for (int i = 0; i < N_GENERATIONS; ++i) {
+            solver.SingleStep(&population);
+        }
+        double total = Seconds(start);
+
+        double scale = 1e3 / N_GENERATIONS;
+        std::printf("%3d %10.3f %10.3f %10.3f %10.3f %12lld\n", m,
+                    scale * total, scale * update_seconds,
+                    scale * truncation_seconds,
+                    scale * (total - update_seconds - truncation_seconds),
+                    static_cast<long long>((solver.n_evaluations() -
+                                            n_evaluations) / N_GENERATIONS));
+    }
+}
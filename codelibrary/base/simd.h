@@ -0,0 +1,84 @@
+//
+// Copyright 2015 Yangbin Lin. All Rights Reserved.
+//
+// Author: yblin.xmu@qq.com (Yangbin Lin)
+//
+// This file is part of the Code Library.
+//
+
+#ifndef BASE_SIMD_H_
+#define BASE_SIMD_H_
+
+/**
+ * Runtime dispatch of the vectorized loops.
+ *
+ * The loops are written as plain loops over arrays, and the compiler
+ * vectorizes them for the instruction set of the function they are inlined
+ * into. A dispatched function is compiled once per instruction set by the
+ * target attributes, and the best one supported by the processor is chosen at
+ * run time:
+ *
+ *    template <typename T>
+ *    CL_SIMD_INLINE void Loop(...) { ... }
+ *
+ *    CL_TARGET_AVX512 void LoopAVX512(...) { Loop(...); }
+ *    CL_TARGET_AVX2   void LoopAVX2(...)   { Loop(...); }
+ *    void LoopGeneric(...)                 { Loop(...); }
+ *
+ *    switch (cl::simd::SupportedLevel()) { ... }
+ *
+ * The functions called in the loops must be CL_SIMD_INLINE, otherwise they are
+ * compiled for the generic instruction set.
+ *
+ * On the compilers or processors without the target attributes, only the
+ * generic functions are used.
+ */
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define CL_SIMD_DISPATCH 1
+#define CL_SIMD_INLINE inline __attribute__((always_inline))
+#define CL_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#define CL_TARGET_AVX512 __attribute__((target("avx512f,avx512dq,avx2,fma")))
+#else
+#define CL_SIMD_DISPATCH 0
+#if defined(_MSC_VER)
+#define CL_SIMD_INLINE __forceinline
+#else
+#define CL_SIMD_INLINE inline
+#endif
+#define CL_TARGET_AVX2
+#define CL_TARGET_AVX512
+#endif
+
+namespace cl {
+namespace simd {
+
+/**
+ * The instruction sets of the dispatched functions.
+ */
+enum SimdLevel {
+    GENERIC = 0,
+    AVX2    = 1,
+    AVX512  = 2
+};
+
+/**
+ * The best instruction set supported by the processor.
+ */
+inline SimdLevel SupportedLevel() {
+#if CL_SIMD_DISPATCH
+    static const SimdLevel level =
+        __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq")
+            ? AVX512
+            : (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")
+                   ? AVX2 : GENERIC);
+    return level;
+#else
+    return GENERIC;
+#endif
+}
+
+} // namespace simd
+} // namespace cl
+
+#endif // BASE_SIMD_H_
@@ -0,0 +1,593 @@
+//
+// Copyright 2015 Yangbin Lin. All Rights Reserved.
+//
+// Author: yblin.xmu@qq.com (Yangbin Lin)
+//
+// This file is part of the Code Library.
+//
+
+#ifndef MATH_BATCH_MATH_H_
+#define MATH_BATCH_MATH_H_
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+#include "codelibrary/base/simd.h"
+
+#if CL_SIMD_DISPATCH
+#include <immintrin.h>
+#endif
+
+// The vector extensions of GCC and Clang.
+#if defined(__GNUC__)
+#define CL_BATCH_MATH 1
+#else
+#define CL_BATCH_MATH 0
+#endif
+
+#if CL_BATCH_MATH
+
+namespace cl {
+
+/**
+ * Elementary functions over the lanes of a SIMD vector.
+ *
+ * The functions of libm can not be vectorized, since they are calls with
+ * branches. The functions here compute all lanes at once by the vector
+ * extensions of GCC and Clang: the range reduction and the scaling by powers
+ * of two are done by arithmetic on the bits, and the special cases by
+ * selections, so there is no branch.
+ *
+ * The vector type should be the one of the target, i.e., Lanes2 for SSE2,
+ * Lanes4 for AVX2 and Lanes8 for AVX-512, since the wider vectors are
+ * emulated lane by lane. The functions should be inlined into the functions
+ * compiled for each target (see codelibrary/base/simd.h):
+ *
+ *    template <typename V>
+ *    CL_SIMD_INLINE void Loop(const double* x, int n, double* y) {
+ *        const int N_LANES = batch_math::LaneTraits<V>::N_LANES;
+ *        for (int i = 0; i + N_LANES <= n; i += N_LANES) {
+ *            V v = batch_math::Load<V>(x + i);
+ *            batch_math::Store(batch_math::Cos(4.0 * PI * v), y + i);
+ *        }
+ *        ...
+ *    }
+ *
+ *    CL_TARGET_AVX512 void LoopAVX512(...) { Loop<batch_math::Lanes8>(...); }
+ *
+ * The accuracy of Sin(), Cos(), SinCos(), Exp(), Log() and Pow() is chosen by
+ * the template argument, FULL_ACCURACY by default:
+ *
+ *    V y = batch_math::Exp<batch_math::LOW_ACCURACY>(x);
+ *
+ * With FULL_ACCURACY, the polynomials are the ones of fdlibm, the errors are
+ * within 2 ulps of the correct results. The others use the minimax
+ * polynomials of lower degrees, see Accuracy. In any case:
+ *  - Sin(), Cos() and SinCos() are accurate for |x| < 1e6, the error grows
+ *    with |x| beyond.
+ *  - Pow(x, y) requires x >= 0.
+ */
+namespace batch_math {
+
+/**
+ * The accuracy of the elementary functions, as the bound of the relative
+ * errors:
+ *  - FULL_ACCURACY, 2 ulps, i.e., about 4e-16.
+ *  - HIGH_ACCURACY, 1e-12.
+ *  - LOW_ACCURACY, 1e-7, i.e., the accuracy of the floats.
+ *
+ * The lower the accuracy, the cheaper the polynomials. The bounds of Pow() are
+ * the ones of Exp() and Log() times (1 + |y * log(x)|) except FULL_ACCURACY.
+ */
+enum Accuracy {
+    FULL_ACCURACY = 0,
+    HIGH_ACCURACY = 1,
+    LOW_ACCURACY  = 2
+};
+
+/// The vectors of doubles of SSE2, AVX2 and AVX-512.
+typedef double Lanes2 __attribute__((vector_size(16)));
+typedef double Lanes4 __attribute__((vector_size(32)));
+typedef double Lanes8 __attribute__((vector_size(64)));
+
+/**
+ * The types that go with a vector of doubles:
+ *  - Bits, the bits of the lanes, and the results of the comparisons (0 or
+ *    all ones).
+ *  - UnsignedBits, shifted right without the sign extension.
+ *  - Unaligned, the lanes at any address of doubles.
+ */
+template <typename V>
+struct LaneTraits;
+
+template <>
+struct LaneTraits<Lanes2> {
+    static const int N_LANES = 2;
+    typedef int64_t Bits __attribute__((vector_size(16)));
+    typedef uint64_t UnsignedBits __attribute__((vector_size(16)));
+    typedef double Unaligned
+            __attribute__((vector_size(16), aligned(8), may_alias));
+};
+
+template <>
+struct LaneTraits<Lanes4> {
+    static const int N_LANES = 4;
+    typedef int64_t Bits __attribute__((vector_size(32)));
+    typedef uint64_t UnsignedBits __attribute__((vector_size(32)));
+    typedef double Unaligned
+            __attribute__((vector_size(32), aligned(8), may_alias));
+};
+
+template <>
+struct LaneTraits<Lanes8> {
+    static const int N_LANES = 8;
+    typedef int64_t Bits __attribute__((vector_size(64)));
+    typedef uint64_t UnsignedBits __attribute__((vector_size(64)));
+    typedef double Unaligned
+            __attribute__((vector_size(64), aligned(8), may_alias));
+};
+
+template <typename V>
+CL_SIMD_INLINE V Broadcast(double value) {
+    V zero = {};
+    return zero + value;
+}
+
+/**
+ * Load the lanes from p, which needs not be aligned.
+ */
+template <typename V>
+CL_SIMD_INLINE V Load(const double* p) {
+    typedef typename LaneTraits<V>::Unaligned Unaligned;
+    return *reinterpret_cast<const Unaligned*>(p);
+}
+
+/**
+ * Store the lanes to p, which needs not be aligned.
+ */
+template <typename V>
+CL_SIMD_INLINE void Store(const V& v, double* p) {
+    typedef typename LaneTraits<V>::Unaligned Unaligned;
+    *reinterpret_cast<Unaligned*>(p) = v;
+}
+
+/**
+ * mask ? a : b for each lane, where mask is 0 or all ones, e.g., the result
+ * of a comparison.
+ */
+template <typename V>
+CL_SIMD_INLINE V Select(const typename LaneTraits<V>::Bits& mask, const V& a,
+                        const V& b) {
+    typedef typename LaneTraits<V>::Bits Bits;
+    return (V)((Bits)b ^ (((Bits)a ^ (Bits)b) & mask));
+}
+
+template <typename V>
+CL_SIMD_INLINE V Abs(const V& x) {
+    typedef typename LaneTraits<V>::Bits Bits;
+    return (V)((Bits)x & INT64_C(0x7fffffffffffffff));
+}
+
+template <typename V>
+CL_SIMD_INLINE V Min(const V& a, const V& b) {
+    return Select(a < b, a, b);
+}
+
+template <typename V>
+CL_SIMD_INLINE V Max(const V& a, const V& b) {
+    return Select(a > b, a, b);
+}
+
+/**
+ * The square root of each lane.
+ *
+ * The vectors of the targets use the instructions, which are not always
+ * inlined since they have the target attributes, but are inlined by the
+ * optimizer into the functions of the same target.
+ */
+template <typename V>
+CL_SIMD_INLINE V Sqrt(const V& x) {
+    V y;
+    for (int l = 0; l < LaneTraits<V>::N_LANES; ++l) {
+        y[l] = std::sqrt(x[l]);
+    }
+    return y;
+}
+
+#if CL_SIMD_DISPATCH
+#if defined(__SSE2__)
+CL_SIMD_INLINE Lanes2 Sqrt(const Lanes2& x) {
+    return (Lanes2)_mm_sqrt_pd((__m128d)x);
+}
+#endif
+
+CL_TARGET_AVX2 inline Lanes4 Sqrt(const Lanes4& x) {
+    return (Lanes4)_mm256_sqrt_pd((__m256d)x);
+}
+
+CL_TARGET_AVX512 inline Lanes8 Sqrt(const Lanes8& x) {
+    // Not _mm512_sqrt_pd(), which warns of its undefined source in GCC.
+    return (Lanes8)_mm512_maskz_sqrt_pd(0xff, (__m512d)x);
+}
+#endif // CL_SIMD_DISPATCH
+
+namespace internal {
+
+/**
+ * Round to the nearest integer, for |x| < 2^51.
+ */
+template <typename V>
+CL_SIMD_INLINE V RoundToInt(const V& x) {
+    const double magic = 6755399441055744.0; // 1.5 * 2^52.
+    return (x + magic) - magic;
+}
+
+/**
+ * 2^k for an integral k in [-1022, 1023].
+ */
+template <typename V>
+CL_SIMD_INLINE V Exp2Int(const V& k) {
+    typedef typename LaneTraits<V>::Bits Bits;
+
+    // The low bits of the sum hold k + 1023.
+    const double magic = 6755399441055744.0 + 1023.0;
+    return (V)((Bits)(k + magic) << 52);
+}
+
+/**
+ * a * b = product + error, where the error is exact but the product of the
+ * low halves, i.e., with 2^-106 relative error.
+ *
+ * The operands are split into the high 26 bits and the rest by masking, not
+ * by the multiplication of Dekker, so the result is the same if the compiler
+ * fuses the multiplications and additions on the targets with FMA.
+ */
+template <typename V>
+CL_SIMD_INLINE void TwoProduct(const V& a, const V& b, V* product,
+                               V* error) {
+    typedef typename LaneTraits<V>::Bits Bits;
+
+    const int64_t mask = ~INT64_C(0x7ffffff);
+    V a_hi = (V)((Bits)a & mask);
+    V a_lo = a - a_hi;
+    V b_hi = (V)((Bits)b & mask);
+    V b_lo = b - b_hi;
+    *product = a * b;
+    *error = ((a_hi * b_hi - *product) + a_hi * b_lo + a_lo * b_hi) +
+             a_lo * b_lo;
+}
+
+/**
+ * x = m * 2^e, m in [sqrt(2) / 2, sqrt(2)), for the finite positive x.
+ */
+template <typename V>
+CL_SIMD_INLINE void Decompose(const V& x, V* m, V* e) {
+    typedef typename LaneTraits<V>::Bits Bits;
+    typedef typename LaneTraits<V>::UnsignedBits UnsignedBits;
+
+    const double SQRT2 = 1.41421356237309504880e+00;
+
+    // Scale the subnormal numbers up by 2^54.
+    Bits subnormal = x < std::numeric_limits<double>::min();
+    Bits u = (Bits)Select(subnormal, x * 18014398509481984.0, x);
+
+    UnsignedBits exponent = (UnsignedBits)u >> 52 & 0x7ff;
+    *e = (V)(exponent | UINT64_C(0x4330000000000000)) -
+         (4503599627370496.0 + 1023.0);
+    *e = Select(subnormal, *e - 54.0, *e);
+    *m = (V)((u & INT64_C(0x000fffffffffffff)) |
+             INT64_C(0x3ff0000000000000));
+    Bits large = *m > SQRT2;
+    *m = Select(large, 0.5 * *m, *m);
+    *e = Select(large, *e + 1.0, *e);
+}
+
+/**
+ * e^(x + lo) for a small lo. Beyond [-746, 710], lo is ignored, since the
+ * result is 0 or infinity anyway.
+ */
+template <Accuracy A, typename V>
+CL_SIMD_INLINE V Exp(const V& x, const V& lo) {
+    const double LOG2_E = 1.44269504088896338700e+00;
+    const double LN2_HI = 6.93147180369123816490e-01;
+    const double LN2_LO = 1.90821492927058770002e-10;
+
+    V t = Select(x < -746.0, Broadcast<V>(-746.0), x);
+    t = Select(t > 710.0, Broadcast<V>(710.0), t);
+
+    // x = r + k * ln2, r in [-ln2 / 2, ln2 / 2].
+    V k = RoundToInt(t * LOG2_E);
+    V r = ((t - k * LN2_HI) - k * LN2_LO) +
+          Select(t == x, lo, Broadcast<V>(0.0));
+
+    V y;
+    V z = r * r;
+    if (A == FULL_ACCURACY) {
+        const double P1 =  1.66666666666666019037e-01;
+        const double P2 = -2.77777777770155933842e-03;
+        const double P3 =  6.61375632143793436117e-05;
+        const double P4 = -1.65339022054652515390e-06;
+        const double P5 =  4.13813679705723846039e-08;
+        V c = r - z * (P1 + z * (P2 + z * (P3 + z * (P4 + z * P5))));
+        y = 1.0 - ((r * c) / (c - 2.0) - r);
+    } else if (A == HIGH_ACCURACY) {
+        // The minimax polynomial of (e^r - 1 - r) / r^2, error 6e-14.
+        const double E0 = 4.99999999999575173160e-01;
+        const double E1 = 1.66666666669437579795e-01;
+        const double E2 = 4.16666667826323944279e-02;
+        const double E3 = 8.33333315565020632532e-03;
+        const double E4 = 1.38888399192471298504e-03;
+        const double E5 = 1.98415398433411768915e-04;
+        const double E6 = 2.48674206632026672604e-05;
+        const double E7 = 2.74671818952278800989e-06;
+        V z2 = z * z;
+        V p = (E0 + r * E1) + z * (E2 + r * E3) +
+              z2 * ((E4 + r * E5) + z * (E6 + r * E7));
+        y = 1.0 + (r + z * p);
+    } else {
+        // The minimax polynomial of (e^r - 1 - r) / r^2, error 8e-9.
+        const double E0 = 4.99999981560989570362e-01;
+        const double E1 = 1.66665798130561676471e-01;
+        const double E2 = 4.16678001018436494629e-02;
+        const double E3 = 8.36286274785631722484e-03;
+        const double E4 = 1.38220030347010526019e-03;
+        V p = (E0 + r * E1) + z * ((E2 + r * E3) + z * E4);
+        y = 1.0 + (r + z * p);
+    }
+
+    // Scale by 2^k in two steps, so that the subnormal results and the
+    // overflows are right.
+    V k1 = RoundToInt(k * 0.5 - 0.25);
+    return y * Exp2Int(k1) * Exp2Int(k - k1);
+}
+
+/**
+ * log(x) = hi + lo for the finite positive x, with about 2^-65 relative
+ * error, i.e., 12 more bits than Log().
+ */
+template <typename V>
+CL_SIMD_INLINE void LogExtended(const V& x, V* hi, V* lo) {
+    const double LN2_HI = 6.93147180369123816490e-01; // 32 bits.
+    const double LN2_LO = 1.90821492927058770002e-10;
+    const double LG1 = 6.666666666666735130e-01;
+    const double LG2 = 3.999999999940941908e-01;
+    const double LG3 = 2.857142874366239149e-01;
+    const double LG4 = 2.222219843214978396e-01;
+    const double LG5 = 1.818357216161805012e-01;
+    const double LG6 = 1.531383769920937332e-01;
+    const double LG7 = 1.479819860511658591e-01;
+
+    V m, e;
+    Decompose(x, &m, &e);
+
+    // log(m) = 2atanh(s) = 2s + s * R(s^2), s = f / (2 + f), where
+    // s = s_hi + s_lo in double-double.
+    V f = m - 1.0;
+    V d = 2.0 + f;
+    V d_lo = (2.0 - d) + f;
+    V s = f / d;
+    V p, p_lo;
+    TwoProduct(s, d, &p, &p_lo);
+    V s_lo = (((f - p) - p_lo) - s * d_lo) / d;
+
+    V z = s * s;
+    V r = s * z * (LG1 + z * (LG2 + z * (LG3 + z * (LG4 + z * (LG5 +
+                                         z * (LG6 + z * LG7))))));
+
+    // e * LN2_HI is exact, so is 2s.
+    V a = e * LN2_HI;
+    V b = 2.0 * s;
+    V sum = a + b;
+    V b_virtual = sum - a;
+    V error = (a - (sum - b_virtual)) + (b - b_virtual);
+    V tail = error + ((r + 2.0 * s_lo) + e * LN2_LO);
+    *hi = sum + tail;
+    *lo = tail - (*hi - sum);
+}
+
+} // namespace internal
+
+/**
+ * The largest integer not greater than x, for |x| < 2^51.
+ */
+template <typename V>
+CL_SIMD_INLINE V Floor(const V& x) {
+    V r = internal::RoundToInt(x);
+    return r - Select(r > x, Broadcast<V>(1.0), Broadcast<V>(0.0));
+}
+
+/**
+ * sin(x) and cos(x).
+ */
+template <Accuracy A = FULL_ACCURACY, typename V>
+CL_SIMD_INLINE void SinCos(const V& x, V* sin_x, V* cos_x) {
+    typedef typename LaneTraits<V>::Bits Bits;
+
+    const double TWO_OVER_PI = 6.36619772367581382433e-01;
+    // PI / 2 = PIO2_1 + PIO2_2 + PIO2_3, the first two have 33 bits.
+    const double PIO2_1 = 1.57079632673412561417e+00;
+    const double PIO2_2 = 6.07710050630396597660e-11;
+    const double PIO2_3 = 2.02226624871116645580e-21;
+
+    // x = r + q * PI / 2, r in [-PI / 4, PI / 4].
+    const double magic = 6755399441055744.0;
+    V shifted = x * TWO_OVER_PI + magic;
+    V q = shifted - magic;
+    V r = ((x - q * PIO2_1) - q * PIO2_2) - q * PIO2_3;
+    Bits quadrant = (Bits)shifted & 3;
+
+    V s, c;
+    V z = r * r;
+    V hz = 0.5 * z;
+    if (A == FULL_ACCURACY) {
+        const double S1 = -1.66666666666666324348e-01;
+        const double S2 =  8.33333333332248946124e-03;
+        const double S3 = -1.98412698298579493134e-04;
+        const double S4 =  2.75573137070700676789e-06;
+        const double S5 = -2.50507602534068634195e-08;
+        const double S6 =  1.58969099521155010221e-10;
+        const double C1 =  4.16666666666666019037e-02;
+        const double C2 = -1.38888888888741095749e-03;
+        const double C3 =  2.48015872894767294178e-05;
+        const double C4 = -2.75573143513906633035e-07;
+        const double C5 =  2.08757232129817482790e-09;
+        const double C6 = -1.13596475577881948265e-11;
+        s = r + r * z * (S1 + z * (S2 + z * (S3 + z * (S4 + z * (S5 +
+                                                             z * S6)))));
+        V w = 1.0 - hz;
+        V p = z * (C1 + z * (C2 + z * (C3 + z * (C4 + z * (C5 + z * C6)))));
+        c = w + (((1.0 - w) - hz) + z * p);
+    } else if (A == HIGH_ACCURACY) {
+        // The minimax polynomials, errors 5e-15 and 1.2e-13.
+        const double S1 = -1.66666666666303503463e-01;
+        const double S2 =  8.33333332507777378717e-03;
+        const double S3 = -1.98412637286345084568e-04;
+        const double S4 =  2.75553396565075888483e-06;
+        const double S5 = -2.47604545686499745797e-08;
+        const double C1 =  4.16666666194921431199e-02;
+        const double C2 = -1.38888835001403795032e-03;
+        const double C3 =  2.47994601708353740090e-05;
+        const double C4 = -2.72057555025686737758e-07;
+        s = r + r * z * (S1 + z * (S2 + z * (S3 + z * (S4 + z * S5))));
+        c = 1.0 - (hz - z * z * (C1 + z * (C2 + z * (C3 + z * C4))));
+    } else {
+        // The minimax polynomials, errors 4e-9 and 8e-8.
+        const double S1 = -1.66666546095496553859e-01;
+        const double S2 =  8.33216076188127152680e-03;
+        const double S3 = -1.95152831921812665826e-04;
+        const double C1 =  4.16610713080322533908e-02;
+        const double C2 = -1.36487143840760116048e-03;
+        s = r + r * z * (S1 + z * (S2 + z * S3));
+        c = 1.0 - (hz - z * z * (C1 + z * C2));
+    }
+
+    // quadrant:  0   1   2   3
+    // sin:       s   c  -s  -c
+    // cos:       c  -s  -c   s
+    Bits odd = -(quadrant & 1);
+    V a = Select(odd, c, s);
+    V b = Select(odd, s, c);
+    Bits sin_sign = (quadrant & 2) << 62;
+    Bits cos_sign = ((quadrant + 1) & 2) << 62;
+    *sin_x = (V)((Bits)a ^ sin_sign);
+    *cos_x = (V)((Bits)b ^ cos_sign);
+}
+
+template <Accuracy A = FULL_ACCURACY, typename V>
+CL_SIMD_INLINE V Sin(const V& x) {
+    V s, c;
+    SinCos<A>(x, &s, &c);
+    return s;
+}
+
+template <Accuracy A = FULL_ACCURACY, typename V>
+CL_SIMD_INLINE V Cos(const V& x) {
+    V s, c;
+    SinCos<A>(x, &s, &c);
+    return c;
+}
+
+/**
+ * e^x.
+ */
+template <Accuracy A = FULL_ACCURACY, typename V>
+CL_SIMD_INLINE V Exp(const V& x) {
+    return internal::Exp<A>(x, Broadcast<V>(0.0));
+}
+
+/**
+ * The natural logarithm of x.
+ */
+template <Accuracy A = FULL_ACCURACY, typename V>
+CL_SIMD_INLINE V Log(const V& x) {
+    const double LN2_HI = 6.93147180369123816490e-01;
+    const double LN2_LO = 1.90821492927058770002e-10;
+    const double inf = std::numeric_limits<double>::infinity();
+
+    V m, e;
+    internal::Decompose(x, &m, &e);
+
+    V f = m - 1.0;
+    V s = f / (2.0 + f);
+    V z = s * s;
+    V y;
+    if (A == FULL_ACCURACY) {
+        const double LG1 = 6.666666666666735130e-01;
+        const double LG2 = 3.999999999940941908e-01;
+        const double LG3 = 2.857142874366239149e-01;
+        const double LG4 = 2.222219843214978396e-01;
+        const double LG5 = 1.818357216161805012e-01;
+        const double LG6 = 1.531383769920937332e-01;
+        const double LG7 = 1.479819860511658591e-01;
+        V w = z * z;
+        V t1 = w * (LG2 + w * (LG4 + w * LG6));
+        V t2 = z * (LG1 + w * (LG3 + w * (LG5 + w * LG7)));
+        V h = 0.5 * f * f;
+        y = e * LN2_HI - ((h - (s * (h + t1 + t2) + e * LN2_LO)) - f);
+    } else {
+        // log(m) = 2s + s * s^2 * L(s^2), the minimax polynomials of L have
+        // the errors 3e-14 and 8e-10.
+        V p;
+        if (A == HIGH_ACCURACY) {
+            const double L0 = 6.66666666757999126780e-01;
+            const double L1 = 3.99999956225378039409e-01;
+            const double L2 = 2.85721090522230269926e-01;
+            const double L3 = 2.21761942967868774801e-01;
+            const double L4 = 1.95840558769766553970e-01;
+            p = L0 + z * (L1 + z * (L2 + z * (L3 + z * L4)));
+        } else {
+            const double L0 = 6.66667763816073954963e-01;
+            const double L1 = 3.99775415756621066432e-01;
+            const double L2 = 2.98717277731131547469e-01;
+            p = L0 + z * (L1 + z * L2);
+        }
+        y = e * LN2_HI + (2.0 * s + (s * z * p + e * LN2_LO));
+    }
+
+    // The infinities and NaNs are kept, except -infinity, which is negative.
+    y = Select(Abs(x) < inf, y, x);
+    y = Select(x == 0.0, Broadcast<V>(-inf), y);
+    return Select(x < 0.0,
+                  Broadcast<V>(std::numeric_limits<double>::quiet_NaN()), y);
+}
+
+/**
+ * x^y for x >= 0.
+ *
+ * With FULL_ACCURACY, log(x) is computed with 12 more bits, so the error is
+ * within 2 ulps. Otherwise, it is Exp(y * Log(x)), whose relative error grows
+ * with |y * log(x)|.
+ */
+template <Accuracy A = FULL_ACCURACY, typename V>
+CL_SIMD_INLINE V Pow(const V& x, const V& y) {
+    const double inf = std::numeric_limits<double>::infinity();
+
+    V p;
+    if (A == FULL_ACCURACY) {
+        V hi, lo, product, error;
+        internal::LogExtended(x, &hi, &lo);
+        internal::TwoProduct(y, hi, &product, &error);
+        p = internal::Exp<A>(product, error + y * lo);
+        p = Select(x == inf, Select(y > 0.0, x, Broadcast<V>(0.0)), p);
+        p = Select(x == x, p, x);
+    } else {
+        p = Exp<A>(y * Log<A>(x));
+    }
+
+    // The special cases of std::pow().
+    V p0 = Select(y > 0.0, Broadcast<V>(0.0), Broadcast<V>(inf));
+    p = Select(x == 0.0, p0, p);
+    p = Select(x < 0.0,
+               Broadcast<V>(std::numeric_limits<double>::quiet_NaN()), p);
+    p = Select(y == y, p, y);
+    p = Select(x == 1.0, Broadcast<V>(1.0), p);
+    return Select(y == 0.0, Broadcast<V>(1.0), p);
+}
+
+} // namespace batch_math
+} // namespace cl
+
+#endif // CL_BATCH_MATH
+
+#endif // MATH_BATCH_MATH_H_
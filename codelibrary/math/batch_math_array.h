@@ -0,0 +1,214 @@
+//
+// Copyright 2015 Yangbin Lin. All Rights Reserved.
+//
+// Author: yblin.xmu@qq.com (Yangbin Lin)
+//
+// This file is part of the Code Library.
+//
+
+#ifndef MATH_BATCH_MATH_ARRAY_H_
+#define MATH_BATCH_MATH_ARRAY_H_
+
+#include <algorithm>
+#include <cassert>
+
+#include "codelibrary/base/simd.h"
+#include "codelibrary/math/batch_math.h"
+
+#if CL_BATCH_MATH
+
+namespace cl {
+
+/**
+ * The elementary functions of batch_math over arrays of doubles.
+ *
+ * Each function is compiled for AVX-512, AVX2 and the generic instruction
+ * set, and the best one supported by the processor is chosen at run time, so
+ * the callers need not know the vectors nor the targets, e.g., the problem
+ * plugins built without -march:
+ *
+ *    batch_math::Cos(x, n, y, batch_math::HIGH_ACCURACY); // y[i] = cos(x[i])
+ *
+ * The input and the output may be the same array.
+ */
+namespace batch_math {
+namespace internal {
+
+template <Accuracy A>
+struct SinFunction {
+    template <typename V>
+    CL_SIMD_INLINE V operator()(const V& x, const V&) const {
+        return batch_math::Sin<A>(x);
+    }
+};
+
+template <Accuracy A>
+struct CosFunction {
+    template <typename V>
+    CL_SIMD_INLINE V operator()(const V& x, const V&) const {
+        return batch_math::Cos<A>(x);
+    }
+};
+
+template <Accuracy A>
+struct ExpFunction {
+    template <typename V>
+    CL_SIMD_INLINE V operator()(const V& x, const V&) const {
+        return batch_math::Exp<A>(x);
+    }
+};
+
+template <Accuracy A>
+struct LogFunction {
+    template <typename V>
+    CL_SIMD_INLINE V operator()(const V& x, const V&) const {
+        return batch_math::Log<A>(x);
+    }
+};
+
+struct SqrtFunction {
+    template <typename V>
+    CL_SIMD_INLINE V operator()(const V& x, const V&) const {
+        return batch_math::Sqrt(x);
+    }
+};
+
+template <Accuracy A>
+struct PowFunction {
+    template <typename V>
+    CL_SIMD_INLINE V operator()(const V& x, const V& y) const {
+        return batch_math::Pow<A>(x, y);
+    }
+};
+
+/**
+ * z[i] = function(x[i], y[i]), where the unary functions ignore y[i].
+ */
+template <typename V, class Function>
+CL_SIMD_INLINE void Map(const Function& function, const double* x,
+                        const double* y, int n, double* z) {
+    const int N_LANES = LaneTraits<V>::N_LANES;
+
+    int i = 0;
+    for (; i + N_LANES <= n; i += N_LANES) {
+        Store(function(Load<V>(x + i), Load<V>(y + i)), z + i);
+    }
+    if (i == n) return;
+
+    // The rest is computed in zero padded lanes.
+    double a[N_LANES] = {}, b[N_LANES] = {};
+    std::copy(x + i, x + n, a);
+    std::copy(y + i, y + n, b);
+    Store(function(Load<V>(a), Load<V>(b)), a);
+    std::copy(a, a + (n - i), z + i);
+}
+
+template <class Function>
+CL_TARGET_AVX512 void MapAVX512(const Function& function, const double* x,
+                                const double* y, int n, double* z) {
+    Map<Lanes8>(function, x, y, n, z);
+}
+
+template <class Function>
+CL_TARGET_AVX2 void MapAVX2(const Function& function, const double* x,
+                            const double* y, int n, double* z) {
+    Map<Lanes4>(function, x, y, n, z);
+}
+
+template <class Function>
+void MapGeneric(const Function& function, const double* x, const double* y,
+                int n, double* z) {
+    Map<Lanes2>(function, x, y, n, z);
+}
+
+template <class Function>
+void Dispatch(const Function& function, const double* x, const double* y,
+              int n, double* z) {
+    assert(n >= 0);
+    assert(n == 0 || (x && y && z));
+
+    switch (simd::SupportedLevel()) {
+    case simd::AVX512:
+        MapAVX512(function, x, y, n, z);
+        break;
+    case simd::AVX2:
+        MapAVX2(function, x, y, n, z);
+        break;
+    default:
+        MapGeneric(function, x, y, n, z);
+    }
+}
+
+/**
+ * Dispatch the Function of the accuracy.
+ */
+template <template <Accuracy> class Function>
+void Dispatch(Accuracy accuracy, const double* x, const double* y, int n,
+              double* z) {
+    switch (accuracy) {
+    case HIGH_ACCURACY:
+        Dispatch(Function<HIGH_ACCURACY>(), x, y, n, z);
+        break;
+    case LOW_ACCURACY:
+        Dispatch(Function<LOW_ACCURACY>(), x, y, n, z);
+        break;
+    default:
+        Dispatch(Function<FULL_ACCURACY>(), x, y, n, z);
+    }
+}
+
+} // namespace internal
+
+/**
+ * y[i] = sin(x[i]) for i = [0, n).
+ */
+inline void Sin(const double* x, int n, double* y,
+                Accuracy accuracy = FULL_ACCURACY) {
+    internal::Dispatch<internal::SinFunction>(accuracy, x, x, n, y);
+}
+
+/**
+ * y[i] = cos(x[i]) for i = [0, n).
+ */
+inline void Cos(const double* x, int n, double* y,
+                Accuracy accuracy = FULL_ACCURACY) {
+    internal::Dispatch<internal::CosFunction>(accuracy, x, x, n, y);
+}
+
+/**
+ * y[i] = e^x[i] for i = [0, n).
+ */
+inline void Exp(const double* x, int n, double* y,
+                Accuracy accuracy = FULL_ACCURACY) {
+    internal::Dispatch<internal::ExpFunction>(accuracy, x, x, n, y);
+}
+
+/**
+ * y[i] = log(x[i]) for i = [0, n).
+ */
+inline void Log(const double* x, int n, double* y,
+                Accuracy accuracy = FULL_ACCURACY) {
+    internal::Dispatch<internal::LogFunction>(accuracy, x, x, n, y);
+}
+
+/**
+ * y[i] = sqrt(x[i]) for i = [0, n), which is always correctly rounded.
+ */
+inline void Sqrt(const double* x, int n, double* y) {
+    internal::Dispatch(internal::SqrtFunction(), x, x, n, y);
+}
+
+/**
+ * z[i] = x[i]^y[i] for i = [0, n), where x[i] >= 0.
+ */
+inline void Pow(const double* x, const double* y, int n, double* z,
+                Accuracy accuracy = FULL_ACCURACY) {
+    internal::Dispatch<internal::PowFunction>(accuracy, x, y, n, z);
+}
+
+} // namespace batch_math
+} // namespace cl
+
+#endif // CL_BATCH_MATH
+
+#endif // MATH_BATCH_MATH_ARRAY_H_
@@ -0,0 +1,164 @@
+//
+// Copyright 2015 Yangbin Lin. All Rights Reserved.
+//
+// Author: yblin.xmu@qq.com (Yangbin Lin)
+//
+// This file is part of the Code Library.
+//
+
+#ifndef MATH_BATCH_RANDOM_H_
+#define MATH_BATCH_RANDOM_H_
+
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace cl {
+
+/// Random Number Generator for Blocks of Numbers.
+/**
+ * BatchRandom runs N_LANES independent xoshiro256+ generators side by side.
+ * The state of each word is stored as an array over the lanes, so that the
+ * compiler can vectorize one step of all lanes, and the numbers are always
+ * generated in blocks:
+ *
+ *    BatchRandom random(seed);
+ *    random.Uniform(n, values);          // n doubles in [0, 1).
+ *    random.Normal(n, 0.5, 0.1, values); // n normal doubles.
+ *    random.Integers(n, bound, indices); // n integers in [0, bound).
+ *
+ * The sequence only depends on the seed and the sizes of the requests. The
+ * lower bits of xoshiro256+ are weak, only the upper bits are used.
+ */
+class BatchRandom {
+public:
+    static const int N_LANES = 4;
+
+    explicit BatchRandom(uint64_t seed = 0) {
+        Seed(seed);
+    }
+
+    /**
+     * Reset the generator. The lanes are initialized by SplitMix64.
+     */
+    void Seed(uint64_t seed) {
+        for (int i = 0; i < 4; ++i) {
+            for (int l = 0; l < N_LANES; ++l) {
+                seed += UINT64_C(0x9E3779B97F4A7C15);
+                uint64_t z = seed;
+                z = (z ^ (z >> 30)) * UINT64_C(0xBF58476D1CE4E5B9);
+                z = (z ^ (z >> 27)) * UINT64_C(0x94D049BB133111EB);
+                state_[i][l] = z ^ (z >> 31);
+            }
+        }
+    }
+
+    /**
+     * Generate n uniform doubles in [0, 1).
+     */
+    void Uniform(int n, double* values) {
+        assert(n >= 0);
+        assert(values || n == 0);
+
+        uint64_t block[N_LANES];
+        int i = 0;
+        for (; i + N_LANES <= n; i += N_LANES) {
+            Next(block);
+            for (int l = 0; l < N_LANES; ++l) {
+                values[i + l] = ToDouble(block[l]);
+            }
+        }
+        if (i < n) {
+            Next(block);
+            for (int l = 0; i < n; ++i, ++l) {
+                values[i] = ToDouble(block[l]);
+            }
+        }
+    }
+
+    /**
+     * Generate n uniform doubles in [low, high).
+     */
+    void Uniform(int n, double low, double high, double* values) {
+        Uniform(n, values);
+        double range = high - low;
+        for (int i = 0; i < n; ++i) {
+            values[i] = low + range * values[i];
+        }
+    }
+
+    /**
+     * Generate n normal doubles by the Box-Muller transform.
+     */
+    void Normal(int n, double mean, double sigma, double* values) {
+        assert(n >= 0);
+        assert(values || n == 0);
+
+        int m = (n + 1) / 2;
+        buffer_.resize(2 * m);
+        Uniform(2 * m, buffer_.data());
+
+        const double two_pi = 6.283185307179586476925286766559;
+        const double* u = buffer_.data();
+        for (int i = 0; i < m; ++i) {
+            // 1 - u is in (0, 1], so the log is finite.
+            double r = sigma * std::sqrt(-2.0 * std::log(1.0 - u[2 * i]));
+            double theta = two_pi * u[2 * i + 1];
+            values[i] = mean + r * std::cos(theta);
+            if (m + i < n) values[m + i] = mean + r * std::sin(theta);
+        }
+    }
+
+    /**
+     * Generate n integers in [0, bound) by the multiply-shift method. The bias
+     * is at most bound / 2^32, which is negligible for the sizes of
+     * populations.
+     */
+    void Integers(int n, uint32_t bound, int* values) {
+        assert(n >= 0);
+        assert(values || n == 0);
+        assert(bound > 0);
+
+        uint64_t block[N_LANES];
+        for (int i = 0; i < n; i += N_LANES) {
+            Next(block);
+            for (int l = 0; l < N_LANES && i + l < n; ++l) {
+                values[i + l] = static_cast<int>(((block[l] >> 32) * bound) >>
+                                                 32);
+            }
+        }
+    }
+
+private:
+    /**
+     * One step of all lanes.
+     */
+    void Next(uint64_t* block) {
+        uint64_t* s0 = state_[0];
+        uint64_t* s1 = state_[1];
+        uint64_t* s2 = state_[2];
+        uint64_t* s3 = state_[3];
+        for (int l = 0; l < N_LANES; ++l) {
+            block[l] = s0[l] + s3[l];
+            uint64_t t = s1[l] << 17;
+            s2[l] ^= s0[l];
+            s3[l] ^= s1[l];
+            s1[l] ^= s2[l];
+            s0[l] ^= s3[l];
+            s2[l] ^= t;
+            s3[l] = (s3[l] << 45) | (s3[l] >> 19);
+        }
+    }
+
+    static double ToDouble(uint64_t x) {
+        return static_cast<double>(x >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+    uint64_t state_[4][N_LANES]; // The states of lanes, word by word.
+    std::vector<double> buffer_; // The uniform numbers for Normal().
+};
+
+} // namespace cl
+
+#endif // MATH_BATCH_RANDOM_H_
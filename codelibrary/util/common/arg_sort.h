@@ -0,0 +1,377 @@
+//
+// Copyright 2015 Yangbin Lin. All Rights Reserved.
+//
+// Author: yblin.xmu@qq.com (Yangbin Lin)
+//
+// This file is part of the Code Library.
+//
+
+#ifndef UTIL_COMMON_ARG_SORT_H_
+#define UTIL_COMMON_ARG_SORT_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace cl {
+
+/// Radix Key.
+/**
+ * RadixKey<T>::Get() maps a value to an unsigned integer with the same order,
+ * so that the values can be sorted by their bits. It is defined for 32-bit and
+ * 64-bit integers, float and double.
+ *
+ * For floating-point values, the sign bit of positive values is flipped and all
+ * bits of negative values are flipped. -0.0 is ordered before +0.0, and NaNs
+ * are ordered by their bits (i.e., after +inf or before -inf).
+ */
+template <typename T, bool = std::is_floating_point<T>::value,
+          size_t = sizeof(T)>
+struct RadixKey;
+
+template <typename T>
+struct RadixKey<T, false, 4> {
+    typedef uint32_t Type;
+
+    static Type Get(T value) {
+        return static_cast<Type>(value) ^
+               (std::is_signed<T>::value ? UINT32_C(0x80000000) : 0);
+    }
+};
+
+template <typename T>
+struct RadixKey<T, false, 8> {
+    typedef uint64_t Type;
+
+    static Type Get(T value) {
+        return static_cast<Type>(value) ^
+               (std::is_signed<T>::value ? UINT64_C(0x8000000000000000) : 0);
+    }
+};
+
+template <typename T>
+struct RadixKey<T, true, 4> {
+    typedef uint32_t Type;
+
+    static Type Get(T value) {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits ^ ((0 - (bits >> 31)) | UINT32_C(0x80000000));
+    }
+};
+
+template <typename T>
+struct RadixKey<T, true, 8> {
+    typedef uint64_t Type;
+
+    static Type Get(T value) {
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits ^ ((0 - (bits >> 63)) | UINT64_C(0x8000000000000000));
+    }
+};
+
+/// Reusable Argsort.
+/**
+ * ArgSort gives the positions in a list at which each successive element of the
+ * sorted list appears, like Sequence, but it is designed for the hot paths:
+ *
+ * 1. The values are converted to RadixKeys and packed with their indices:
+ *    32-bit keys and indices share one uint64_t, 64-bit keys are paired with
+ *    the indices. The items are sorted directly, instead of through pointers.
+ * 2. The items are sorted by an LSD radix sort with 11-bit digits. The
+ *    histograms of all digits are counted in one pass, and the passes whose
+ *    digit is the same for all keys are skipped. Small inputs are sorted by
+ *    std::sort on the items.
+ * 3. Large inputs are split into chunks sorted by different threads, then the
+ *    chunks are merged in parallel.
+ * 4. PartialSort() only sorts the k smallest (or largest) elements.
+ * 5. All buffers are kept by the object, so that after the first call on the
+ *    largest input no memory is allocated. The object can be copied, e.g., to
+ *    keep one per thread.
+ *
+ * Since the index is a part of each item, the sort is stable: the equal
+ * values are ordered by their indices, also in the descending order.
+ *
+ * Example:
+ *    double a[] = {2.0, 3.0, 1.0};
+ *    ArgSort arg_sort;
+ *    std::vector<int> orders;
+ *    arg_sort.Sort(a, 3, &orders); // orders = (2, 0, 1).
+ *    arg_sort.PartialSort(a, 3, 1, &orders, true); // orders = (1).
+ */
+class ArgSort {
+    // The 64-bit key with its index.
+    struct Item {
+        bool operator < (const Item& item) const {
+            return key < item.key || (key == item.key && index < item.index);
+        }
+
+        uint64_t key;
+        uint32_t index;
+    };
+
+    // The radix sort uses 11-bit digits.
+    static const int RADIX_BITS = 11;
+    static const int RADIX_SIZE = 1 << RADIX_BITS;
+    static const int MAX_PASSES = (64 + RADIX_BITS - 1) / RADIX_BITS;
+
+    // The inputs smaller than RADIX_THRESHOLD per key bit are sorted by
+    // std::sort, i.e., 1024 items for 32-bit keys and 2048 for 64-bit keys.
+    static const int RADIX_THRESHOLD = 32;
+
+    // The minimum number of elements for each thread.
+    static const int PARALLEL_THRESHOLD = 1 << 16;
+
+public:
+    explicit ArgSort(int n_threads = 1)
+        : n_threads_(n_threads) {
+        assert(n_threads_ > 0);
+    }
+
+    /**
+     * Sort the indices of values[0, n) by the values.
+     */
+    template <typename T>
+    void Sort(const T* values, int n, std::vector<int>* orders,
+              bool descending = false) {
+        assert(values || n == 0);
+        assert(n >= 0);
+        assert(orders);
+
+        Sort(values, n, n, descending,
+             std::integral_constant<bool,
+                     sizeof(typename RadixKey<T>::Type) == 4>(), orders);
+    }
+
+    template <typename T>
+    void Sort(const std::vector<T>& values, std::vector<int>* orders,
+              bool descending = false) {
+        Sort(values.data(), static_cast<int>(values.size()), orders,
+             descending);
+    }
+
+    /**
+     * Get the indices of the k smallest (or largest if 'descending') values in
+     * order.
+     */
+    template <typename T>
+    void PartialSort(const T* values, int n, int k, std::vector<int>* orders,
+                     bool descending = false) {
+        assert(values || n == 0);
+        assert(0 <= k && k <= n);
+        assert(orders);
+
+        Sort(values, n, k, descending,
+             std::integral_constant<bool,
+                     sizeof(typename RadixKey<T>::Type) == 4>(), orders);
+    }
+
+    template <typename T>
+    void PartialSort(const std::vector<T>& values, int k,
+                     std::vector<int>* orders, bool descending = false) {
+        PartialSort(values.data(), static_cast<int>(values.size()), k, orders,
+                    descending);
+    }
+
+    /**
+     * Set the maximum number of threads, the threads are only used for the
+     * inputs larger than PARALLEL_THRESHOLD per thread.
+     */
+    void set_n_threads(int n_threads) {
+        assert(n_threads > 0);
+
+        n_threads_ = n_threads;
+    }
+
+    int n_threads() const { return n_threads_; }
+
+private:
+    /**
+     * Sort the 32-bit keys, packed with the indices as key << 32 | index.
+     */
+    template <typename T>
+    void Sort(const T* values, int n, int k, bool descending,
+              std::true_type, std::vector<int>* orders) {
+        uint32_t flip = descending ? ~UINT32_C(0) : 0;
+        packed_.resize(n);
+        for (int i = 0; i < n; ++i) {
+            uint64_t key = RadixKey<T>::Get(values[i]) ^ flip;
+            packed_[i] = (key << 32) | static_cast<uint32_t>(i);
+        }
+
+        SortItems(&packed_, &packed_tmp_, k, 32);
+
+        orders->resize(k);
+        for (int i = 0; i < k; ++i) {
+            (*orders)[i] = static_cast<int>(packed_[i] & UINT32_C(0xFFFFFFFF));
+        }
+    }
+
+    /**
+     * Sort the 64-bit keys, paired with the indices.
+     */
+    template <typename T>
+    void Sort(const T* values, int n, int k, bool descending,
+              std::false_type, std::vector<int>* orders) {
+        uint64_t flip = descending ? ~UINT64_C(0) : 0;
+        items_.resize(n);
+        for (int i = 0; i < n; ++i) {
+            items_[i].key = RadixKey<T>::Get(values[i]) ^ flip;
+            items_[i].index = static_cast<uint32_t>(i);
+        }
+
+        SortItems(&items_, &items_tmp_, k, 64);
+
+        orders->resize(k);
+        for (int i = 0; i < k; ++i) {
+            (*orders)[i] = static_cast<int>(items_[i].index);
+        }
+    }
+
+    /**
+     * Sort the first k items of *items into order. The key occupies the
+     * highest 'key_bits' bits of RadixDigits().
+     */
+    template <typename T>
+    void SortItems(std::vector<T>* items, std::vector<T>* tmp, int k,
+                   int key_bits) {
+        int n = static_cast<int>(items->size());
+        if (k < n) {
+            // Select the k-th item as the pivot, then keep the k smaller items
+            // in their original order, so that the radix sort is still stable.
+            tmp->assign(items->begin(), items->end());
+            std::nth_element(tmp->begin(), tmp->begin() + k, tmp->end());
+            T pivot = (*tmp)[k];
+            int j = 0;
+            for (int i = 0; i < n; ++i) {
+                if ((*items)[i] < pivot) (*items)[j++] = (*items)[i];
+            }
+            assert(j == k);
+            n = k;
+        }
+        if (n < RADIX_THRESHOLD * key_bits) {
+            std::sort(items->begin(), items->begin() + n);
+            return;
+        }
+
+        tmp->resize(items->size());
+        int n_threads = std::min(n_threads_, n / PARALLEL_THRESHOLD);
+        if (n_threads <= 1) {
+            histograms_.resize(MAX_PASSES * RADIX_SIZE);
+            if (RadixSort(items->data(), tmp->data(), n, key_bits,
+                          histograms_.data()) != items->data()) {
+                std::copy(tmp->begin(), tmp->begin() + n, items->begin());
+            }
+            return;
+        }
+
+        // Sort the chunks in parallel.
+        histograms_.resize(n_threads * MAX_PASSES * RADIX_SIZE);
+        std::vector<int> bounds(n_threads + 1);
+        for (int t = 0; t <= n_threads; ++t) {
+            bounds[t] = static_cast<int>(int64_t(n) * t / n_threads);
+        }
+        std::vector<std::thread> threads;
+        for (int t = 0; t < n_threads; ++t) {
+            threads.emplace_back([=]() {
+                T* first = items->data() + bounds[t];
+                T* tmp_first = tmp->data() + bounds[t];
+                int size = bounds[t + 1] - bounds[t];
+                if (RadixSort(first, tmp_first, size, key_bits,
+                              histograms_.data() +
+                              t * MAX_PASSES * RADIX_SIZE) != first) {
+                    std::copy(tmp_first, tmp_first + size, first);
+                }
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+
+        // Merge the sorted chunks in pairs until one is left.
+        T* source = items->data();
+        T* target = tmp->data();
+        for (int width = 1; width < n_threads; width *= 2) {
+            threads.clear();
+            for (int t = 0; t < n_threads; t += 2 * width) {
+                int first = bounds[t];
+                int middle = bounds[std::min(t + width, n_threads)];
+                int last = bounds[std::min(t + 2 * width, n_threads)];
+                threads.emplace_back([=]() {
+                    std::merge(source + first, source + middle,
+                               source + middle, source + last,
+                               target + first);
+                });
+            }
+            for (std::thread& thread : threads) {
+                thread.join();
+            }
+            std::swap(source, target);
+        }
+        if (source != items->data()) {
+            std::copy(source, source + n, items->data());
+        }
+    }
+
+    /**
+     * LSD radix sort of items[0, n) by the key bits.
+     *
+     * @return the array that holds the result, either 'items' or 'tmp'.
+     */
+    template <typename T>
+    static T* RadixSort(T* items, T* tmp, int n, int key_bits,
+                        uint32_t* histograms) {
+        int low_bit = 64 - key_bits;
+        int n_passes = (key_bits + RADIX_BITS - 1) / RADIX_BITS;
+        std::fill(histograms, histograms + n_passes * RADIX_SIZE, 0);
+
+        for (int i = 0; i < n; ++i) {
+            uint64_t key = RadixDigits(items[i]) >> low_bit;
+            for (int pass = 0; pass < n_passes; ++pass) {
+                ++histograms[pass * RADIX_SIZE +
+                             ((key >> (pass * RADIX_BITS)) & (RADIX_SIZE - 1))];
+            }
+        }
+
+        for (int pass = 0; pass < n_passes; ++pass) {
+            uint32_t* count = histograms + pass * RADIX_SIZE;
+            int shift = low_bit + pass * RADIX_BITS;
+            if (count[(RadixDigits(items[0]) >> shift) & (RADIX_SIZE - 1)] ==
+                uint32_t(n)) {
+                continue;
+            }
+
+            uint32_t sum = 0;
+            for (int i = 0; i < RADIX_SIZE; ++i) {
+                uint32_t c = count[i];
+                count[i] = sum;
+                sum += c;
+            }
+            for (int i = 0; i < n; ++i) {
+                tmp[count[(RadixDigits(items[i]) >> shift) &
+                          (RADIX_SIZE - 1)]++] = items[i];
+            }
+            std::swap(items, tmp);
+        }
+        return items;
+    }
+
+    static uint64_t RadixDigits(uint64_t item) { return item;     }
+    static uint64_t RadixDigits(const Item& item) { return item.key; }
+
+    int n_threads_;                     // The maximum number of threads.
+    std::vector<uint64_t> packed_;      // The packed 32-bit keys.
+    std::vector<uint64_t> packed_tmp_;  // The buffer for packed keys.
+    std::vector<Item> items_;           // The 64-bit keys.
+    std::vector<Item> items_tmp_;       // The buffer for 64-bit keys.
+    std::vector<uint32_t> histograms_;  // The histograms of each thread.
+};
+
+} // namespace cl
+
+#endif // UTIL_COMMON_ARG_SORT_H_
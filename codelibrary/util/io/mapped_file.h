@@ -0,0 +1,128 @@
+//
+// Copyright 2015 Yangbin Lin. All Rights Reserved.
+//
+// Author: yblin.xmu@qq.com (Yangbin Lin)
+//
+// This file is part of the Code Library.
+//
+
+#ifndef UTIL_IO_MAPPED_FILE_H_
+#define UTIL_IO_MAPPED_FILE_H_
+
+#include <cstddef>
+#include <string>
+
+#ifdef _WIN32
+#include <fstream>
+#include <vector>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "codelibrary/base/macros.h"
+
+namespace cl {
+
+/// Read-only Memory Mapped File.
+/**
+ * MappedFile maps the whole file into memory, so that the large binary files
+ * can be read without copying them through a stream buffer.
+ *
+ * On the platforms without mmap, the file is read into a buffer instead.
+ *
+ * Usage:
+ *    MappedFile file;
+ *    if (file.Open("front.bin")) {
+ *        const char* p = file.data();
+ *        ...
+ *    }
+ */
+class MappedFile {
+public:
+    MappedFile()
+        : data_(NULL), size_(0) {}
+
+    ~MappedFile() {
+        Close();
+    }
+
+    /**
+     * Map the given file. Return false if the file can not be mapped or it is
+     * empty.
+     */
+    bool Open(const std::string& file) {
+        Close();
+
+#ifdef _WIN32
+        std::ifstream fin(file.c_str(), std::ios::binary | std::ios::ate);
+        if (!fin) return false;
+
+        std::streamoff size = fin.tellg();
+        if (size <= 0) return false;
+
+        buffer_.resize(static_cast<size_t>(size));
+        fin.seekg(0);
+        if (!fin.read(&buffer_[0], size)) {
+            buffer_.clear();
+            return false;
+        }
+
+        data_ = &buffer_[0];
+        size_ = buffer_.size();
+#else
+        int fd = open(file.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+            close(fd);
+            return false;
+        }
+
+        void* p = mmap(NULL, static_cast<size_t>(st.st_size), PROT_READ,
+                       MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (p == MAP_FAILED) return false;
+
+        data_ = static_cast<const char*>(p);
+        size_ = static_cast<size_t>(st.st_size);
+#endif
+        return true;
+    }
+
+    /**
+     * Unmap the file.
+     */
+    void Close() {
+#ifdef _WIN32
+        buffer_.clear();
+#else
+        if (data_) {
+            munmap(const_cast<char*>(data_), size_);
+        }
+#endif
+        data_ = NULL;
+        size_ = 0;
+    }
+
+    bool is_open()      const { return data_ != NULL; }
+    const char* data()  const { return data_;         }
+    size_t size()       const { return size_;         }
+
+private:
+    const char* data_; // The mapped data.
+    size_t size_;      // The size of mapped data in bytes.
+
+#ifdef _WIN32
+    std::vector<char> buffer_; // The buffer used instead of mmap.
+#endif
+
+    DISALLOW_COPY_AND_ASSIGN(MappedFile);
+};
+
+} // namespace cl
+
+#endif // UTIL_IO_MAPPED_FILE_H_
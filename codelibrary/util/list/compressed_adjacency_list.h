@@ -0,0 +1,324 @@
+//
+// Copyright 2015 Yangbin Lin. All Rights Reserved.
+//
+// Author: yblin.xmu@qq.com (Yangbin Lin)
+//
+// This file is part of the Code Library.
+//
+
+#ifndef UTIL_LIST_COMPRESSED_ADJACENCY_LIST_H_
+#define UTIL_LIST_COMPRESSED_ADJACENCY_LIST_H_
+
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "codelibrary/util/list/adjacency_list.h"
+
+namespace cl {
+
+/// Compressed Adjacency List (compressed sparse row graph).
+/**
+ * A static graph that stores the targets of all edges in one array, grouped
+ * by the source vertices, and the offset of each group:
+ *
+ *   offsets: 0 2 3 4
+ *   targets: 1 2 | 0 | 0
+ *
+ * is the graph (0, 1), (0, 2), (1, 0), (2, 0). Each edge costs 4 bytes,
+ * instead of a node with three pointers in AdjacencyList, and the copy is a
+ * plain copy of two arrays. The id of an edge is its index in targets, so the
+ * edge properties are vectors indexed by Edge::id().
+ *
+ * The graph is built in two passes, since the number of edges of each source
+ * must be known before the edges are stored:
+ *
+ *    CompressedAdjacencyList list(n);
+ *    for each edge (s, t): list.CountEdge(s);
+ *    list.Allocate();
+ *    for each edge (s, t): list.InsertOneWayEdge(s, t);
+ *
+ * or at once from the edge buffers of several threads by Build(). The edges of
+ * a source keep the order of insertion.
+ *
+ * The edge lists can be iterated like the ones of AdjacencyList:
+ *
+ *    for (const CompressedAdjacencyList::Edge& e : list.edge_list(v)) {
+ *        ... e.source(), e.target() ...
+ *    }
+ */
+class CompressedAdjacencyList {
+public:
+    /// Edge for CompressedAdjacencyList, created on the fly by the iterators.
+    class Edge {
+    public:
+        Edge(int id, int source, int target)
+            : id_(id), source_(source), target_(target) {}
+
+        int id()     const { return id_;     }
+        int source() const { return source_; }
+        int target() const { return target_; }
+
+    private:
+        int id_;     // The index of this edge in the targets.
+        int source_; // The source vertex of edge.
+        int target_; // The target vertex of edge.
+    };
+
+    /// Iterator over the edges of a source vertex.
+    class EdgeIterator : public std::iterator<std::forward_iterator_tag,
+                                              Edge, std::ptrdiff_t,
+                                              const Edge*, Edge> {
+    public:
+        EdgeIterator()
+            : targets_(NULL), id_(0), source_(0) {}
+
+        EdgeIterator(const int* targets, int id, int source)
+            : targets_(targets), id_(id), source_(source) {}
+
+        bool operator == (const EdgeIterator& rhs) const {
+            return id_ == rhs.id_;
+        }
+
+        bool operator != (const EdgeIterator& rhs) const {
+            return id_ != rhs.id_;
+        }
+
+        Edge operator*() const { return Edge(id_, source_, targets_[id_]); }
+
+        EdgeIterator& operator++() {
+            ++id_;
+            return *this;
+        }
+
+        EdgeIterator operator++(int /*n*/) {
+            EdgeIterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+    private:
+        const int* targets_; // The targets of graph.
+        int id_;             // The id of the current edge.
+        int source_;         // The source vertex.
+    };
+
+    /// The edges of a source vertex.
+    class EdgeList {
+    public:
+        EdgeList(const int* targets, int first, int last, int source)
+            : targets_(targets), first_(first), last_(last), source_(source) {}
+
+        EdgeIterator begin() const {
+            return EdgeIterator(targets_, first_, source_);
+        }
+
+        EdgeIterator end() const {
+            return EdgeIterator(targets_, last_, source_);
+        }
+
+        bool empty() const { return first_ == last_; }
+        int size()   const { return last_ - first_; }
+
+        /**
+         * The targets of the edges, in [targets(), targets() + size()).
+         */
+        const int* targets() const { return targets_ + first_; }
+
+    private:
+        const int* targets_; // The targets of graph.
+        int first_;          // The id of the first edge.
+        int last_;           // The id after the last edge.
+        int source_;         // The source vertex.
+    };
+
+    /// The edges (source, target) collected by one thread for Build().
+    typedef std::vector<std::pair<int, int> > EdgeBuffer;
+
+    explicit CompressedAdjacencyList(int size_vertices = 0) {
+        Resize(size_vertices);
+    }
+
+    /**
+     * Convert the adjacency list, the edges of each source keep their order.
+     */
+    explicit CompressedAdjacencyList(const AdjacencyList& adjacency_list) {
+        Resize(adjacency_list.size_vertices());
+        for (int i = 0; i < size_vertices_; ++i) {
+            CountEdge(i, adjacency_list.edge_list(i).size());
+        }
+        Allocate();
+        for (int i = 0; i < size_vertices_; ++i) {
+            for (const AdjacencyList::Edge& e : adjacency_list.edge_list(i)) {
+                InsertOneWayEdge(e.source(), e.target());
+            }
+        }
+    }
+
+    /**
+     * Clear the data and resize the list, then the edges can be counted.
+     */
+    void Resize(int size_vertices) {
+        assert(size_vertices >= 0);
+
+        size_vertices_ = size_vertices;
+        offsets_.assign(size_vertices_ + 1, 0);
+        targets_.clear();
+        cursors_.clear();
+    }
+
+    /**
+     * The first pass: count 'count' edges from the source.
+     */
+    void CountEdge(int source, int count = 1) {
+        assert(0 <= source && source < size_vertices_);
+        assert(cursors_.empty() && "CountEdge() after Allocate()");
+
+        offsets_[source + 1] += count;
+    }
+
+    /**
+     * Allocate the counted edges, then they can be inserted.
+     */
+    void Allocate() {
+        for (int i = 0; i < size_vertices_; ++i) {
+            offsets_[i + 1] += offsets_[i];
+        }
+        targets_.resize(offsets_[size_vertices_]);
+        cursors_.assign(offsets_.begin(), offsets_.end() - 1);
+    }
+
+    /**
+     * The second pass: insert a counted edge.
+     *
+     * @return the new edge.
+     */
+    Edge InsertOneWayEdge(int source, int target) {
+        assert(0 <= source && source < size_vertices_);
+        assert(0 <= target && target < size_vertices_);
+        assert(!cursors_.empty() && "InsertOneWayEdge() before Allocate()");
+        assert(cursors_[source] < offsets_[source + 1] && "Uncounted edge");
+
+        int id = cursors_[source]++;
+        targets_[id] = target;
+        return Edge(id, source, target);
+    }
+
+    /**
+     * Build the graph from the edges collected by several threads. The edges
+     * of a source are ordered by the buffers, and then by the order in each
+     * buffer, so the graph does not depend on the number of threads.
+     *
+     * Each thread counts the sources of its buffers, then the prefix sums give
+     * each buffer its own slots for each source, and the threads fill the
+     * slots without locks.
+     *
+     * If 'n_threads' is 0, the number of hardware threads is used.
+     */
+    void Build(int size_vertices, const std::vector<EdgeBuffer>& buffers,
+               int n_threads = 0) {
+        Resize(size_vertices);
+
+        int n_buffers = static_cast<int>(buffers.size());
+        if (n_threads == 0) {
+            n_threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        n_threads = std::max(1, std::min(n_threads, n_buffers));
+
+        // counts[b * n + s] is the number of edges from s in the b-th buffer,
+        // then it becomes the first slot of them.
+        int n = size_vertices_;
+        std::vector<int> counts(static_cast<size_t>(n_buffers) * n, 0);
+        RunThreads(n_threads, [&](int t) {
+            for (int b = t; b < n_buffers; b += n_threads) {
+                int* count = &counts[static_cast<size_t>(b) * n];
+                for (const std::pair<int, int>& e : buffers[b]) {
+                    assert(0 <= e.first && e.first < n);
+                    ++count[e.first];
+                }
+            }
+        });
+
+        for (int s = 0; s < n; ++s) {
+            int offset = offsets_[s];
+            for (int b = 0; b < n_buffers; ++b) {
+                int& count = counts[static_cast<size_t>(b) * n + s];
+                int first = offset;
+                offset += count;
+                count = first;
+            }
+            offsets_[s + 1] = offset;
+        }
+        targets_.resize(offsets_[n]);
+
+        RunThreads(n_threads, [&](int t) {
+            for (int b = t; b < n_buffers; b += n_threads) {
+                int* cursor = &counts[static_cast<size_t>(b) * n];
+                for (const std::pair<int, int>& e : buffers[b]) {
+                    assert(0 <= e.second && e.second < n);
+                    targets_[cursor[e.first]++] = e.second;
+                }
+            }
+        });
+    }
+
+    /**
+     * Clear all edges.
+     */
+    void clear() {
+        Resize(0);
+    }
+
+    bool empty()        const { return size_vertices_ == 0; }
+    int size_vertices() const { return size_vertices_; }
+    int size_edges()    const { return offsets_[size_vertices_]; }
+
+    /**
+     * The number of edges from the vertex i.
+     */
+    int degree(int i) const {
+        assert(0 <= i && i < size_vertices_);
+
+        return offsets_[i + 1] - offsets_[i];
+    }
+
+    /**
+     * The edges from the vertex i.
+     */
+    EdgeList edge_list(int i) const {
+        assert(0 <= i && i < size_vertices_);
+
+        return EdgeList(targets_.data(), offsets_[i], offsets_[i + 1], i);
+    }
+
+    const std::vector<int>& offsets() const { return offsets_; }
+    const std::vector<int>& targets() const { return targets_; }
+
+private:
+    /**
+     * Call f(t) for t in [0, n_threads), each one by a thread.
+     */
+    template <typename Function>
+    static void RunThreads(int n_threads, const Function& f) {
+        std::vector<std::thread> threads;
+        for (int t = 1; t < n_threads; ++t) {
+            threads.emplace_back(f, t);
+        }
+        f(0);
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+    }
+
+    int size_vertices_;        // The number of vertices.
+    std::vector<int> offsets_; // The first edge of each vertex, and the end.
+    std::vector<int> targets_; // The targets of edges, grouped by sources.
+    std::vector<int> cursors_; // The next slot of each source when filling.
+};
+
+} // namespace cl
+
+#endif // UTIL_LIST_COMPRESSED_ADJACENCY_LIST_H_
@@ -0,0 +1,99 @@
+//
+// Copyright 2015 Yangbin Lin. All Rights Reserved.
+//
+// Author: yblin.xmu@qq.com (Yangbin Lin)
+//
+// This file is part of the Code Library.
+//
+
+#ifndef UTIL_QUEUE_SPSC_QUEUE_H_
+#define UTIL_QUEUE_SPSC_QUEUE_H_
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "codelibrary/base/macros.h"
+
+namespace cl {
+
+/// Bounded Single-Producer Single-Consumer Lock-free Queue.
+/**
+ * SPSCQueue is a ring buffer shared by exactly one producer thread and one
+ * consumer thread. Neither TryPush nor TryPop ever blocks: they return false if
+ * the queue is full or empty.
+ *
+ * The elements are swapped in and out of the queue, so that the buffers owned
+ * by the elements (e.g., std::vector) can be reused without copying.
+ */
+template <typename T>
+class SPSCQueue {
+public:
+    /**
+     * Create a queue that can hold 'capacity' elements.
+     */
+    explicit SPSCQueue(int capacity)
+        : size_(capacity + 1), buffer_(capacity + 1), head_(0), tail_(0) {
+        assert(capacity > 0);
+    }
+
+    /**
+     * Swap *value into the queue. Only called by the producer.
+     *
+     * @return false if the queue is full.
+     */
+    bool TryPush(T* value) {
+        assert(value);
+
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        size_t next = tail + 1 == size_ ? 0 : tail + 1;
+        if (next == head_.load(std::memory_order_acquire)) return false;
+
+        std::swap(buffer_[tail], *value);
+        tail_.store(next, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Swap the front element out of the queue. Only called by the consumer.
+     *
+     * @return false if the queue is empty.
+     */
+    bool TryPop(T* value) {
+        assert(value);
+
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire)) return false;
+
+        std::swap(*value, buffer_[head]);
+        head_.store(head + 1 == size_ ? 0 : head + 1,
+                    std::memory_order_release);
+        return true;
+    }
+
+    bool empty() const {
+        return head_.load(std::memory_order_acquire) ==
+               tail_.load(std::memory_order_acquire);
+    }
+
+    int capacity() const { return static_cast<int>(size_) - 1; }
+
+private:
+    size_t size_;           // The size of ring buffer.
+    std::vector<T> buffer_; // The ring buffer, one slot is always empty.
+
+    // The head and tail are kept in different cache lines to avoid false
+    // sharing between the producer and the consumer.
+    char padding1_[64];
+    std::atomic<size_t> head_; // The next position to pop.
+    char padding2_[64];
+    std::atomic<size_t> tail_; // The next position to push.
+
+    DISALLOW_COPY_AND_ASSIGN(SPSCQueue);
+};
+
+} // namespace cl
+
+#endif // UTIL_QUEUE_SPSC_QUEUE_H_
@@ -0,0 +1,34 @@
+//
+// Copyright 2013 Yangbin Lin. All Rights Reserved.
+//
+// Author: yblin.xmu@qq.com (Yangbin Lin)
+//
+// This file is part of the Multi-objective Optimization.
+//
+
+#ifndef CORE_BATCH_EVALUATOR_H_
+#define CORE_BATCH_EVALUATOR_H_
+
+#include "codelibrary/util/array/array_2d.h"
+
+namespace moo {
+
+/**
+ * The interface of the evaluators that compute the objectives of many
+ * individuals at once, e.g., in parallel or out of process.
+ */
+class BatchEvaluator {
+public:
+    virtual ~BatchEvaluator() {}
+
+    /**
+     * Evaluate the individuals, one per row of 'variables'. The objectives are
+     * stored in the same rows of 'objectives'.
+     */
+    virtual void Evaluate(const cl::Array2D<double>& variables,
+                          cl::Array2D<double>* objectives) = 0;
+};
+
+} // namespace moo
+
+#endif // CORE_BATCH_EVALUATOR_H_
@@ -9,6 +9,7 @@
 #ifndef CORE_OBJECTIVES_H_
 #define CORE_OBJECTIVES_H_
 
+#include <functional>
 #include <vector>
 
 namespace moo {
@@ -20,6 +21,26 @@ typedef double (*Objective)(const std::vector<double>& variables);
 
 typedef double (*Constraint)(const std::vector<double>& variables);
 
+/**
+ * Compute the cached partial state of the given variables, e.g., the partial
+ * sums shared by the objectives.
+ *
+ * It is a function object, so the tests whose sizes are chosen at run time
+ * can bind it to their parameters.
+ */
+typedef std::function<void(const std::vector<double>& variables,
+                           std::vector<double>* state)> PartialState;
+
+/**
+ * Update all objectives after the index-th variable is changed from old_value
+ * to variables[index]. The partial state is updated in place, so that it can be
+ * used for the next change.
+ */
+typedef std::function<void(const std::vector<double>& variables, int index,
+                           double old_value, std::vector<double>* state,
+                           std::vector<double>* objectives)>
+        IncrementalObjectives;
+
 } // namespace moo
 
 #endif // CORE_OBJECTIVES_H_
@@ -16,9 +16,11 @@ int main() {
     moo::Population population;
     moo::SolverNSLS<> solver;
     solver.Initialize(*(test.get()), 100, &population);
-    for (int i = 0; i < 100; ++i) {
-        solver.SingleStep(&population);
-    }
+
+    moo::Termination termination;
+    termination.set_max_generations(100);
+    termination.set_stagnation(20, 1e-3);
+    solver.Run(&termination, &population);
 
     // Draw results.
     std::vector<cl::RPoint2D> points;
@@ -34,4 +34,49 @@ HEADERS += \
     test/test_kur.h \
     test/test_lz.h \
     test/test_sch.h \
-    test/test_uf.h
+    test/test_uf.h \
+    test/sum_of_terms.h \
+    solver/util/checkpoint.h \
+    codelibrary/util/io/mapped_file.h \
+    codelibrary/util/queue/spsc_queue.h \
+    solver/util/trajectory_logger.h \
+    test/pareto_front.h \
+    test/pareto_front_io.h \
+    solver/util/external_archive.h \
+    solver/util/non_dominated_archive.h \
+    solver/util/termination.h \
+    solver/util/crowding_distance.h \
+    solver/util/selector/crowding_distance_selector.h \
+    codelibrary/util/common/arg_sort.h \
+    codelibrary/math/batch_random.h \
+    solver/util/batch_variation.h \
+    solver/util/surrogate.h \
+    solver/util/reference_directions.h \
+    solver/util/selector/reference_point_selector.h \
+    solver/util/incremental_non_dominated_sort.h \
+    solver/util/bitset_non_dominated_sort.h \
+    codelibrary/util/list/compressed_adjacency_list.h \
+    core/batch_evaluator.h \
+    solver/util/process_pool_evaluator.h \
+    test/plugin/problem_plugin.h \
+    test/plugin/plugin_test.h \
+    test/test_registry.h \
+    codelibrary/base/simd.h \
+    codelibrary/math/batch_math.h \
+    codelibrary/math/batch_math_array.h \
+    test/batch/kernel_evaluator.h \
+    test/batch/test_kernels.h \
+    test/scalable_test.h \
+    test/test_scalable_dtlz.h \
+    test/test_wfg.h \
+    test/test_lsmop.h \
+    solver/util/state_util.h \
+    solver/util/variable_scheduler.h \
+    solver/util/evaluation_store.h
+
+unix:QMAKE_CXXFLAGS += -pthread
+unix:LIBS += -pthread -ldl
+
+# The wide vectors of cl::batch_math are passed by value only to the inlined
+# functions, so the ABI warnings of GCC do not apply.
+*-g++*:QMAKE_CXXFLAGS += -Wno-psabi
@@ -13,7 +13,20 @@
 #ifndef SOLVER_BASIC_SOLVER_H_
 #define SOLVER_BASIC_SOLVER_H_
 
+#include <cstdint>
+#include <ctime>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
 #include "core/population.h"
+#include "solver/util/checkpoint.h"
+#include "solver/util/external_archive.h"
+#include "solver/util/surrogate.h"
+#include "solver/util/termination.h"
+#include "solver/util/trajectory_logger.h"
+#include "solver/util/variable_scheduler.h"
 #include "test/basic_test.h"
 
 namespace moo {
@@ -21,7 +34,19 @@ namespace moo {
 /// Basic MOO Solver.
 class BasicSolver {
 public:
-    BasicSolver() {}
+    BasicSolver()
+        : size_population_(0),
+          n_generation_(0),
+          n_evaluations_(0),
+          random_engine_(static_cast<unsigned int>(time(NULL))),
+          checkpoint_interval_(0),
+          n_failed_checkpoints_(0),
+          last_failed_checkpoint_(-1),
+          trajectory_logger_(NULL),
+          archive_(NULL),
+          surrogate_(NULL),
+          variable_scheduler_(NULL),
+          initial_population_(NULL) {}
 
     virtual ~BasicSolver() {}
 
@@ -36,13 +61,232 @@ public:
      */
     virtual void SingleStep(Population* population) = 0;
 
-    int size_population() const { return size_population_; }
-    int n_generation()    const { return n_generation_;    }
+    /**
+     * Run the solver from the current population until the termination is
+     * met, and return the reason. The population must be initialized (or
+     * restarted) before.
+     */
+    Termination::Reason Run(Termination* termination, Population* population) {
+        assert(termination);
+        assert(population);
+
+        termination->Start(max_generation_cost());
+        while (!termination->Check(n_generation_, n_evaluations_,
+                                   *population)) {
+            SingleStep(population);
+        }
+        return termination->reason();
+    }
+
+    /**
+     * Save the state of solver and the given population into a checkpoint. The
+     * archive, if any, is saved as the second population.
+     */
+    bool SaveCheckpoint(const std::string& file,
+                        const Population& population) const {
+        std::vector<const Population*> populations(1, &population);
+        Population archive;
+        if (archive_) {
+            archive_->Export(&archive);
+            populations.push_back(&archive);
+        }
+        return Checkpoint::Save(file, GetState(), populations);
+    }
+
+    /**
+     * Restart the solver from a checkpoint saved by SaveCheckpoint. The test
+     * must be the same as the one used to create the checkpoint, and the
+     * surrogate and the variable scheduler must be set as they were (their
+     * states are restored from the checkpoint), then the run continues
+     * exactly as if it was never stopped.
+     */
+    bool Restart(const BasicTest& test, const std::string& file,
+                 Population* population) {
+        assert(population);
+
+        SolverState state;
+        std::vector<Population> populations;
+        if (!Checkpoint::Load(file, &state, &populations)) return false;
+
+        if (state.test_name != test.name ||
+            state.n_variables != test.parameter.n_variables ||
+            state.n_objectives != test.parameter.n_objectives ||
+            state.n_constraints != test.parameter.n_constraints ||
+            populations.empty()) {
+            return false;
+        }
+
+        std::istringstream in(state.random_engine);
+        std::mt19937 random_engine;
+        in >> random_engine;
+        if (in.fail()) return false;
+
+        if (!surrogate_) {
+            if (!state.surrogate.empty()) return false;
+        } else if (!surrogate_->LoadState(test, state.surrogate)) {
+            return false;
+        }
+        if (!variable_scheduler_) {
+            if (!state.scheduler.empty()) return false;
+        } else if (!variable_scheduler_->LoadState(test, state.scheduler)) {
+            return false;
+        }
+
+        test_ = test;
+        size_population_ = state.size_population;
+        n_generation_ = state.n_generation;
+        n_evaluations_ = state.n_evaluations;
+        random_engine_ = random_engine;
+        population->swap(populations[0]);
+        if (archive_ && populations.size() > 1) {
+            archive_->clear();
+            archive_->Insert(populations[1]);
+        }
+        return true;
+    }
+
+    /**
+     * Save a checkpoint into the file every 'interval' generations. Set
+     * interval to 0 to disable it. A failed save does not stop the run, it is
+     * counted by n_failed_checkpoints().
+     */
+    void set_checkpoint(const std::string& file, int interval) {
+        assert(interval >= 0);
+
+        checkpoint_file_ = file;
+        checkpoint_interval_ = interval;
+        n_failed_checkpoints_ = 0;
+        last_failed_checkpoint_ = -1;
+    }
+
+    /**
+     * Log the population of each generation by the given logger, NULL to
+     * disable it. The logger is not owned by solver.
+     */
+    void set_trajectory_logger(TrajectoryLogger* trajectory_logger) {
+        trajectory_logger_ = trajectory_logger;
+    }
+
+    /**
+     * Keep all non-dominated individuals found during the run in the given
+     * archive, NULL to disable it, e.g., a FloatNonDominatedArchive to keep
+     * millions of them in float. The archive is not owned by solver.
+     */
+    void set_archive(ExternalArchive* archive) {
+        archive_ = archive;
+    }
+
+    /**
+     * Pre-screen the trials by the given surrogate, NULL to disable it. The
+     * surrogate is not owned by solver, and it is reset by Initialize() and
+     * restored by Restart().
+     */
+    void set_surrogate(Surrogate* surrogate) {
+        surrogate_ = surrogate;
+    }
+
+    /**
+     * Try only the variables chosen by the given scheduler in each generation,
+     * NULL to try all variables. The scheduler is not owned by solver, and it
+     * is initialized by Initialize() and restored by Restart().
+     */
+    void set_variable_scheduler(VariableScheduler* variable_scheduler) {
+        variable_scheduler_ = variable_scheduler;
+    }
+
+    /**
+     * Start from the given evaluated individuals, e.g., the best points of an
+     * EvaluationStore, NULL to start from random ones. Initialize() takes at
+     * most the size of population from them, and fills the rest randomly. The
+     * population is not owned by solver.
+     */
+    void set_initial_population(const Population* initial_population) {
+        initial_population_ = initial_population;
+    }
+
+    /**
+     * Set the seed of random engine.
+     */
+    void set_seed(unsigned int seed) {
+        random_engine_.seed(seed);
+    }
+
+    /**
+     * The maximum number of evaluations of a generation, so that Run() stops
+     * before the first generation exceeds the budget. 0 if unknown.
+     */
+    virtual int64_t max_generation_cost() const { return 0; }
+
+    int size_population()   const { return size_population_; }
+    int n_generation()      const { return n_generation_;    }
+    int64_t n_evaluations() const { return n_evaluations_;   }
+
+    /**
+     * The number of periodic checkpoints that failed to be saved, and the
+     * generation of the last one (-1 if none).
+     */
+    int n_failed_checkpoints()   const { return n_failed_checkpoints_;   }
+    int last_failed_checkpoint() const { return last_failed_checkpoint_; }
 
 protected:
-    int size_population_; // The size of population.
-    BasicTest test_;      // The test.
-    int n_generation_;    // The number of generation.
+    /**
+     * Get the state of solver.
+     */
+    SolverState GetState() const {
+        SolverState state;
+        state.test_name = test_.name;
+        state.n_variables = test_.parameter.n_variables;
+        state.n_objectives = test_.parameter.n_objectives;
+        state.n_constraints = test_.parameter.n_constraints;
+        state.size_population = size_population_;
+        state.n_generation = n_generation_;
+        state.n_evaluations = n_evaluations_;
+
+        std::ostringstream out;
+        out << random_engine_;
+        state.random_engine = out.str();
+        if (surrogate_) {
+            state.surrogate = surrogate_->SaveState();
+        }
+        if (variable_scheduler_) {
+            state.scheduler = variable_scheduler_->SaveState();
+        }
+        return state;
+    }
+
+    /**
+     * Save the checkpoint and log the population if it is the time. It should
+     * be called at the end of each generation.
+     */
+    void FinishGeneration(const Population& population) {
+        if (checkpoint_interval_ > 0 &&
+            n_generation_ % checkpoint_interval_ == 0 &&
+            !SaveCheckpoint(checkpoint_file_, population)) {
+            ++n_failed_checkpoints_;
+            last_failed_checkpoint_ = n_generation_;
+        }
+        if (trajectory_logger_) {
+            trajectory_logger_->Log(n_generation_, population);
+        }
+    }
+
+    int size_population_;        // The size of population.
+    BasicTest test_;             // The test.
+    int n_generation_;           // The number of generation.
+    int64_t n_evaluations_;      // The number of evaluations.
+    std::mt19937 random_engine_; // The random engine used by solver.
+
+    std::string checkpoint_file_; // The file of checkpoint.
+    int checkpoint_interval_;     // The interval of generations to save the
+                                  // checkpoint, 0 if disabled.
+    int n_failed_checkpoints_;    // The number of failed checkpoints.
+    int last_failed_checkpoint_;  // The generation of the last failed one.
+
+    TrajectoryLogger* trajectory_logger_;   // The logger of populations.
+    ExternalArchive* archive_;              // The external archive.
+    Surrogate* surrogate_;                  // The surrogate of trials.
+    VariableScheduler* variable_scheduler_; // The scheduler of variables.
+    const Population* initial_population_;  // The warm-start individuals.
 };
 
 } // namespace moo
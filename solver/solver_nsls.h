@@ -13,10 +13,14 @@
 #ifndef SOLVER_SOLVER_NSLS_H_
 #define SOLVER_SOLVER_NSLS_H_
 
+#include <algorithm>
 #include <random>
+#include <vector>
 
 #include "solver/basic_solver.h"
+#include "solver/util/incremental_non_dominated_sort.h"
 #include "solver/util/initializer.h"
+#include "solver/util/non_dominated_sort.h"
 #include "solver/util/selector.h"
 #include "solver/util/updater.h"
 
@@ -31,7 +35,8 @@ namespace moo {
 template <class Selector = FarthestCandidate, class Updater = NSLSUpdater>
 class SolverNSLS : public BasicSolver {
 public:
-    SolverNSLS() : BasicSolver() {}
+    SolverNSLS()
+        : BasicSolver(), incremental_sort_(true) {}
 
     virtual ~SolverNSLS() {}
 
@@ -47,11 +52,39 @@ public:
         size_population_ = (size_population / 4 +
                            (size_population % 4 != 0)) * 4;
 
-        Initializer::Random(test_, size_population_, population);
+        if (initial_population_) {
+            n_evaluations_ = Initializer::Seeded(test_, *initial_population_,
+                                                 size_population_,
+                                                 &random_engine_, population);
+        } else {
+            Initializer::Random(test_, size_population_, &random_engine_,
+                                population);
+            n_evaluations_ = size_population_;
+        }
+        if (archive_) {
+            archive_->Insert(*population);
+        }
+        if (surrogate_) {
+            surrogate_->Initialize(test_);
+        }
+        if (variable_scheduler_) {
+            n_evaluations_ += variable_scheduler_->Initialize(test_);
+        }
 
         n_generation_ = 0;
     }
 
+    /**
+     * Two trials for each variable of each individual, only the variables
+     * selected by the scheduler if any.
+     */
+    int64_t max_generation_cost() const {
+        int n_variables = variable_scheduler_ ?
+                variable_scheduler_->max_variables_per_generation() :
+                test_.parameter.n_variables;
+        return 2 * static_cast<int64_t>(size_population_) * n_variables;
+    }
+
     /**
      * Single step running the solver.
      */
@@ -60,18 +93,124 @@ public:
             return;
         }
 
+        const std::vector<int>* variables = NULL;
+        if (variable_scheduler_) {
+            variable_scheduler_->Select(n_generation_, &random_engine_,
+                                        &variables_);
+            variables = &variables_;
+        }
+
         Population new_population = *population;
-        Updater()(test_, &new_population);
+        n_evaluations_ += updater_(test_, &random_engine_, &new_population,
+                                   surrogate_, variables);
+        if (variable_scheduler_) {
+            variable_scheduler_->Update(variables_, *population,
+                                        new_population);
+        }
+        if (archive_) {
+            archive_->Insert(new_population);
+        }
 
         Population union_population = *population;
         union_population.insert(union_population.end(), new_population.begin(),
                                 new_population.end());
 
-        NonDominatedSortingSelector<Selector>::
-                Select(test_, union_population, size_population_, population);
+        if (incremental_sort_) {
+            std::vector<Population> fronts;
+            SortIncrementally(union_population, population->size(), &fronts);
+            NonDominatedSortingSelector<Selector>::
+                    SelectFronts(test_, fronts, size_population_, population);
+            LoadSort(*population);
+        } else {
+            NonDominatedSortingSelector<Selector>::
+                    Select(test_, union_population, size_population_,
+                           population);
+        }
 
         ++n_generation_;
+
+        FinishGeneration(*population);
+    }
+
+    /**
+     * Keep the fronts of population between generations and only insert the
+     * offspring into them, instead of sorting the union of parents and
+     * offspring from scratch. The selected population is the same. It is
+     * enabled by default.
+     */
+    void set_incremental_sort(bool incremental_sort) {
+        incremental_sort_ = incremental_sort;
     }
+
+    /**
+     * The updater, e.g., to get the number of objective calls saved by the
+     * lazy evaluation.
+     */
+    const Updater& updater() const {
+        return updater_;
+    }
+
+    /**
+     * The incremental sort, e.g., to get the number of dominance comparisons.
+     */
+    const IncrementalNonDominatedSort& incremental_sort() const {
+        return sort_;
+    }
+
+private:
+    /**
+     * Sort the union of the parents (the first n_parents individuals) and the
+     * offspring into the fronts that cover the population, by inserting the
+     * offspring into the fronts of parents. The fronts of parents are sorted
+     * again if the population was changed since the last generation.
+     */
+    void SortIncrementally(const Population& union_population, int n_parents,
+                           std::vector<Population>* fronts) {
+        bool sorted = sort_.size() == n_parents &&
+                      static_cast<int>(ids_.size()) == n_parents;
+        for (int i = 0; sorted && i < n_parents; ++i) {
+            const std::vector<double>& objectives =
+                    union_population[i].objectives;
+            sorted = std::equal(objectives.begin(), objectives.end(),
+                                sort_.objectives(ids_[i]));
+        }
+        if (!sorted) {
+            sort_.clear();
+            ids_.resize(n_parents);
+            for (int i = 0; i < n_parents; ++i) {
+                ids_[i] = sort_.Insert(union_population[i].objectives);
+            }
+        }
+
+        int n = static_cast<int>(union_population.size());
+        for (int i = n_parents; i < n; ++i) {
+            ids_.push_back(sort_.Insert(union_population[i].objectives));
+        }
+        std::vector<int> ranks(n);
+        for (int i = 0; i < n; ++i) {
+            ranks[i] = sort_.rank(ids_[i]);
+        }
+        SplitFronts(union_population, ranks, size_population_, fronts);
+    }
+
+    /**
+     * Load the fronts of the selected population, whose ranks are set by the
+     * selector.
+     */
+    void LoadSort(const Population& population) {
+        sort_.clear();
+        ids_.resize(population.size());
+        for (size_t i = 0; i < population.size(); ++i) {
+            ids_[i] = sort_.Insert(population[i].objectives,
+                                   population[i].rank);
+        }
+    }
+
+    Updater updater_;                   // The updater of population.
+    bool incremental_sort_;             // Use the incremental sort or not.
+    IncrementalNonDominatedSort sort_;  // The fronts of the population.
+    std::vector<int> ids_;              // The ids of individuals in sort_.
+    std::vector<int> variables_;        // The variables of the generation.
 };
 
 } // namespace moo
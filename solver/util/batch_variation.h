@@ -0,0 +1,288 @@
+//
+// Copyright 2013 Yangbin Lin and Bili Chen. All Rights Reserved.
+//
+// Author: yblin.xmu@qq.com (Yangbin Lin)
+//
+// To use this code, please cite the follow paper:
+//
+// Chen B, Zeng W, Lin Y, et al. A New Local Search-Based Multiobjective
+// Optimization Algorithm[J]. IEEE Transactions on Evolutionary Computation,
+// 2014, 19(1):1-1.
+//
+
+#ifndef SOLVER_UTIL_BATCH_VARIATION_H_
+#define SOLVER_UTIL_BATCH_VARIATION_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "codelibrary/math/batch_random.h"
+#include "codelibrary/util/array/array_2d.h"
+
+#include "test/basic_test.h"
+
+namespace moo {
+
+/// Batched Variation Operators.
+/**
+ * The operators work on variable matrices, one individual per row, and create
+ * a whole block of offspring at once. The random numbers of a block are drawn
+ * in advance by cl::BatchRandom, so the inner loops only contain arithmetic
+ * and selects, and all offspring are clamped into the bounds of test at the
+ * end. The offspring can be passed directly to
+ * PopulationUtil::SetObjectiveValues() for the variable matrices.
+ *
+ * The buffers are kept by the object and reused by the next call.
+ *
+ * Usage:
+ *    BatchVariation variation(seed);
+ *    variation.SBX(test, parents, &offspring);
+ *    variation.Polynomial(test, offspring, &offspring);
+ *    PopulationUtil::SetObjectiveValues(test, offspring, &objectives);
+ */
+class BatchVariation {
+public:
+    explicit BatchVariation(uint64_t seed = 0)
+        : random_(seed) {}
+
+    /**
+     * The NSLS move of the index-th variable. For each parent x, two offspring
+     * are created by changing the index-th variable to
+     *
+     *   x + r * (y - z)  (the i-th row)  and  x - r * (y - z)  (the n + i-th),
+     *
+     * where y and z are two random parents and r ~ N(mu, sigma). Since the
+     * offspring only differ from their parents in one variable, the NSLS local
+     * search can sweep the variables and select among 2n offspring per step.
+     */
+    void NSLSMove(const BasicTest& test, const cl::Array2D<double>& parents,
+                  int index, cl::Array2D<double>* offspring,
+                  double mu = 0.5, double sigma = 0.1) {
+        assert(offspring && offspring != &parents);
+        assert(0 <= index && index < parents.columns());
+
+        int n = parents.rows();
+        int d = parents.columns();
+        offspring->Resize(2 * n, d);
+        if (n == 0) return;
+
+        normals_.resize(n);
+        indices_.resize(2 * n);
+        random_.Normal(n, mu, sigma, normals_.data());
+        random_.Integers(2 * n, n, indices_.data());
+
+        const double* x = parents.data().data();
+        double* y = offspring->data().data();
+        std::copy(x, x + n * d, y);
+        std::copy(x, x + n * d, y + n * d);
+
+        double low = test.parameter.min_variables[index];
+        double high = test.parameter.max_variables[index];
+        for (int i = 0; i < n; ++i) {
+            double v = x[i * d + index];
+            double step = normals_[i] * (x[indices_[2 * i] * d + index] -
+                                         x[indices_[2 * i + 1] * d + index]);
+            y[i * d + index] = std::min(std::max(v + step, low), high);
+            y[(n + i) * d + index] = std::min(std::max(v - step, low), high);
+        }
+    }
+
+    /**
+     * Polynomial mutation. Each variable is mutated with the given probability,
+     * the mutated positions are found by geometric skips, so only the mutated
+     * variables consume random numbers and powers. 'parents' and 'offspring'
+     * can be the same matrix.
+     */
+    void Polynomial(const BasicTest& test, const cl::Array2D<double>& parents,
+                    cl::Array2D<double>* offspring, double probability = 0.05,
+                    double distribution_index = 20.0) {
+        assert(offspring);
+        assert(0.0 <= probability && probability <= 1.0);
+
+        if (offspring != &parents) *offspring = parents;
+
+        int d = parents.columns();
+        int size = parents.size();
+        if (size == 0 || probability <= 0.0) return;
+
+        // Collect the positions of mutated variables.
+        positions_.clear();
+        if (probability >= 1.0) {
+            for (int i = 0; i < size; ++i) {
+                positions_.push_back(i);
+            }
+        } else {
+            // The skips are drawn in blocks of the expected number of them.
+            double log_q = std::log1p(-probability);
+            int block = static_cast<int>(probability * size) + 8;
+            int64_t position = -1;
+            while (position < size) {
+                uniforms_.resize(block);
+                random_.Uniform(block, uniforms_.data());
+                for (int k = 0; k < block; ++k) {
+                    position += 1 + static_cast<int64_t>(
+                            std::log1p(-uniforms_[k]) / log_q);
+                    if (position >= size) break;
+                    positions_.push_back(static_cast<int>(position));
+                }
+            }
+        }
+
+        int m = static_cast<int>(positions_.size());
+        uniforms_.resize(m);
+        random_.Uniform(m, uniforms_.data());
+
+        const double* low = test.parameter.min_variables.data();
+        const double* high = test.parameter.max_variables.data();
+        double* y = offspring->data().data();
+        double eta = distribution_index + 1.0;
+        double inv_eta = 1.0 / eta;
+        for (int k = 0; k < m; ++k) {
+            int p = positions_[k];
+            int j = p % d;
+            double v = y[p];
+            double range = high[j] - low[j];
+            double u = uniforms_[k];
+
+            bool left = u <= 0.5;
+            double delta = left ? (v - low[j]) / range : (high[j] - v) / range;
+            double a = left ? 2.0 * u : 2.0 * (1.0 - u);
+            double b = left ? 1.0 - 2.0 * u : 2.0 * (u - 0.5);
+            double value = a + b * std::pow(1.0 - delta, eta);
+            double deltaq = std::pow(value, inv_eta) - 1.0;
+            v += (left ? deltaq : -deltaq) * range;
+            y[p] = std::min(std::max(v, low[j]), high[j]);
+        }
+    }
+
+    /**
+     * Simulated binary crossover. The rows (0, 1), (2, 3), ... are crossed
+     * with the given probability, and each variable of a crossed pair is
+     * exchanged with probability 0.5. The last row is copied if the number of
+     * rows is odd.
+     */
+    void SBX(const BasicTest& test, const cl::Array2D<double>& parents,
+             cl::Array2D<double>* offspring, double probability = 0.9,
+             double distribution_index = 20.0) {
+        assert(offspring && offspring != &parents);
+
+        int n = parents.rows();
+        int d = parents.columns();
+        *offspring = parents;
+        int n_pairs = n / 2;
+        if (n_pairs == 0) return;
+
+        uniforms_.resize(n_pairs * (2 * d + 1));
+        random_.Uniform(static_cast<int>(uniforms_.size()), uniforms_.data());
+        const double* pair_u = uniforms_.data();
+        const double* swap_u = pair_u + n_pairs;
+        const double* beta_u = swap_u + n_pairs * d;
+
+        const double* x = parents.data().data();
+        double* y = offspring->data().data();
+        double inv_eta = 1.0 / (distribution_index + 1.0);
+        for (int k = 0; k < n_pairs; ++k) {
+            if (pair_u[k] >= probability) continue;
+
+            const double* x1 = x + 2 * k * d;
+            const double* x2 = x1 + d;
+            double* y1 = y + 2 * k * d;
+            double* y2 = y1 + d;
+            const double* s = swap_u + k * d;
+            const double* u = beta_u + k * d;
+            for (int j = 0; j < d; ++j) {
+                double base = u[j] <= 0.5 ? 2.0 * u[j]
+                                          : 0.5 / (1.0 - u[j]);
+                double beta = std::pow(base, inv_eta);
+                double mean = 0.5 * (x1[j] + x2[j]);
+                double half = 0.5 * beta * (x2[j] - x1[j]);
+                bool cross = s[j] < 0.5;
+                y1[j] = cross ? mean - half : x1[j];
+                y2[j] = cross ? mean + half : x2[j];
+            }
+        }
+        Clamp(test, offspring);
+    }
+
+    /**
+     * DE/rand/1/bin. For each parent x, the mutant y + F * (z - w) is built
+     * from three other distinct random parents, then each variable is taken
+     * from the mutant with probability CR (and at least one variable is).
+     */
+    void DifferentialEvolution(const BasicTest& test,
+                               const cl::Array2D<double>& parents,
+                               cl::Array2D<double>* offspring,
+                               double f = 0.5, double cr = 1.0) {
+        assert(offspring && offspring != &parents);
+        assert(parents.rows() >= 4);
+
+        int n = parents.rows();
+        int d = parents.columns();
+        offspring->Resize(n, d);
+
+        indices_.resize(4 * n);
+        random_.Integers(4 * n, n, indices_.data());
+        uniforms_.resize(n * d);
+        random_.Uniform(n * d, uniforms_.data());
+
+        const double* x = parents.data().data();
+        double* y = offspring->data().data();
+        for (int i = 0; i < n; ++i) {
+            int* r = &indices_[4 * i];
+            // Redraw the duplicates, which is rare for large populations.
+            while (r[0] == i) random_.Integers(1, n, &r[0]);
+            while (r[1] == i || r[1] == r[0]) random_.Integers(1, n, &r[1]);
+            while (r[2] == i || r[2] == r[0] || r[2] == r[1]) {
+                random_.Integers(1, n, &r[2]);
+            }
+            int j_rand = r[3] % d;
+
+            const double* a = x + r[0] * d;
+            const double* b = x + r[1] * d;
+            const double* c = x + r[2] * d;
+            const double* p = x + i * d;
+            const double* u = &uniforms_[i * d];
+            double* q = y + i * d;
+            for (int j = 0; j < d; ++j) {
+                double mutant = a[j] + f * (b[j] - c[j]);
+                q[j] = (u[j] < cr || j == j_rand) ? mutant : p[j];
+            }
+        }
+        Clamp(test, offspring);
+    }
+
+    /**
+     * Clamp each row of variables into the bounds of test.
+     */
+    static void Clamp(const BasicTest& test, cl::Array2D<double>* variables) {
+        assert(variables);
+        assert(variables->columns() == test.parameter.n_variables ||
+               variables->empty());
+
+        const double* low = test.parameter.min_variables.data();
+        const double* high = test.parameter.max_variables.data();
+        int d = variables->columns();
+        double* y = variables->data().data();
+        for (int i = 0; i < variables->rows(); ++i, y += d) {
+            for (int j = 0; j < d; ++j) {
+                y[j] = std::min(std::max(y[j], low[j]), high[j]);
+            }
+        }
+    }
+
+    cl::BatchRandom* random() { return &random_; }
+
+private:
+    cl::BatchRandom random_;       // The random number generator.
+    std::vector<double> uniforms_; // The uniform numbers of a block.
+    std::vector<double> normals_;  // The normal numbers of a block.
+    std::vector<int> indices_;     // The random indices of a block.
+    std::vector<int> positions_;   // The mutated positions.
+};
+
+} // namespace moo
+
+#endif // SOLVER_UTIL_BATCH_VARIATION_H_
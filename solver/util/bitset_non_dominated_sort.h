@@ -0,0 +1,413 @@
+//
+// Copyright 2013 Yangbin Lin and Bili Chen. All Rights Reserved.
+//
+// Author: yblin.xmu@qq.com (Yangbin Lin)
+//
+// To use this code, please cite the follow paper:
+//
+// Chen B, Zeng W, Lin Y, et al. A New Local Search-Based Multiobjective
+// Optimization Algorithm[J]. IEEE Transactions on Evolutionary Computation,
+// 2014, 19(1):1-1.
+//
+
+#ifndef SOLVER_UTIL_BITSET_NON_DOMINATED_SORT_H_
+#define SOLVER_UTIL_BITSET_NON_DOMINATED_SORT_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "core/population.h"
+#include "solver/util/non_dominated_sort.h"
+
+namespace moo {
+
+/// Multi-threaded Non-dominated Sort on Bitset Dominance Matrix.
+/**
+ * When most pairs must be compared anyway (many objectives, or a population
+ * with few fronts), the sort is bounded by the N^2 / 2 comparisons. This
+ * sorter splits them into 64 x 64 tiles, which are computed by all threads:
+ *
+ * - The objectives are transposed (one array per objective), so each row of a
+ *   tile compares one individual with 64 contiguous values per objective.
+ * - The relation is stored as a packed bit matrix (N^2 / 8 bytes), where the
+ *   j-th bit of the i-th row is set if i dominates j. A tile fills one word of
+ *   each of its 64 rows, and the transposed word (j dominates i) of the
+ *   mirrored tile by a 64 x 64 bit transpose, so each pair is compared once.
+ * - The indegree of each individual is counted during the tiles.
+ *
+ * Then the fronts are peeled: the members of a front decrease the indegrees of
+ * the set bits in their rows, and the individuals whose indegrees become zero
+ * form the next front. The columns are split among threads, so each thread
+ * only scans its words of the rows and owns the indegrees of its columns.
+ *
+ * The result is the same as NonDominatedRanks(), so SplitFronts() builds the
+ * fronts. The matrix and buffers are kept by the object for the next call.
+ *
+ * T is the type of the stored objectives. With float, the objectives are
+ * rounded to the nearest float when they are copied, which halves the memory
+ * traffic of the tiles and doubles the values per vector. Since the rounding
+ * is monotonic, a relation is never reversed, but the differences below the
+ * float resolution are lost: two individuals whose objectives round to the
+ * same values are ties (neither dominates the other), and a dominance decided
+ * by such differences alone may appear or vanish. The ranks are then the
+ * exact ranks of the rounded objectives.
+ *
+ * Usage:
+ *    BitsetNonDominatedSort sort;
+ *    std::vector<Population> fronts;
+ *    int n_whole = sort.Sort(population, n, &fronts);
+ */
+template <typename T = double>
+class BasicBitsetNonDominatedSort {
+    // The minimum size of population to sort in parallel.
+    static const int PARALLEL_THRESHOLD = 1024;
+
+    // The size of tile (bits per word).
+    static const int TILE = 64;
+
+    /// Block the threads until all of them arrive.
+    class Barrier {
+    public:
+        explicit Barrier(int n_threads)
+            : n_threads_(n_threads), count_(0), generation_(0) {}
+
+        void Wait() {
+            std::unique_lock<std::mutex> lock(mutex_);
+            int generation = generation_;
+            if (++count_ == n_threads_) {
+                count_ = 0;
+                ++generation_;
+                condition_.notify_all();
+            } else {
+                condition_.wait(lock, [&] {
+                    return generation != generation_;
+                });
+            }
+        }
+
+    private:
+        std::mutex mutex_;
+        std::condition_variable condition_;
+        int n_threads_;
+        int count_;
+        int generation_;
+    };
+
+public:
+    /**
+     * If 'n_threads' is 0, the number of hardware threads is used.
+     */
+    explicit BasicBitsetNonDominatedSort(int n_threads = 0)
+        : n_threads_(n_threads), size_(0), n_objectives_(0), n_blocks_(0),
+          next_tile_(0), n_limit_(-1), n_ranked_(0), rank_(0), done_(false),
+          ranks_(nullptr), barrier_(nullptr) {
+        assert(n_threads_ >= 0);
+
+        if (n_threads_ == 0) {
+            n_threads_ = std::max(1u, std::thread::hardware_concurrency());
+        }
+    }
+
+    /**
+     * Compute the ranks of individuals. If n >= 0, the peeling stops at the
+     * first fronts that cover n individuals, and the others get rank -1.
+     */
+    void Ranks(const Population& population, int n, std::vector<int>* ranks) {
+        assert(ranks);
+
+        size_ = static_cast<int>(population.size());
+        ranks->assign(size_, -1);
+        if (size_ == 0 || n == 0) return;
+
+        int m = static_cast<int>(population[0].objectives.size());
+        n_blocks_ = (size_ + TILE - 1) / TILE;
+        int n_columns = n_blocks_ * TILE;
+
+        // The padded values are NaN, which neither dominate nor are dominated.
+        objectives_.assign(static_cast<size_t>(m) * n_columns,
+                           std::numeric_limits<T>::quiet_NaN());
+        for (int i = 0; i < size_; ++i) {
+            assert(static_cast<int>(population[i].objectives.size()) == m);
+            for (int k = 0; k < m; ++k) {
+                objectives_[k * n_columns + i] =
+                        static_cast<T>(population[i].objectives[k]);
+            }
+        }
+        n_objectives_ = m;
+
+        int n_threads = size_ < PARALLEL_THRESHOLD ? 1 :
+                        std::min(n_threads_, n_blocks_);
+        matrix_.resize(static_cast<size_t>(n_columns) * n_blocks_);
+        counts_.resize(static_cast<size_t>(n_threads) * n_columns);
+        indegrees_.resize(n_columns);
+        nexts_.resize(n_threads);
+        for (std::vector<int>& next : nexts_) {
+            next.clear();
+        }
+        front_.clear();
+
+        next_tile_ = 0;
+        n_limit_ = n;
+        n_ranked_ = 0;
+        rank_ = 0;
+        done_ = false;
+        ranks_ = ranks->data();
+
+        Barrier barrier(n_threads);
+        barrier_ = &barrier;
+        std::vector<std::thread> threads;
+        for (int t = 1; t < n_threads; ++t) {
+            threads.emplace_back(&BasicBitsetNonDominatedSort::Run, this, t,
+                                 n_threads);
+        }
+        Run(0, n_threads);
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+        barrier_ = nullptr;
+        ranks_ = nullptr;
+    }
+
+    /**
+     * Sort population into fronts, see NonDominatedSort(population, n, fronts).
+     * If n < 0, all individuals are sorted.
+     *
+     * @return the number of fronts taken whole.
+     */
+    int Sort(const Population& population, int n,
+             std::vector<Population>* fronts) {
+        assert(fronts);
+
+        Ranks(population, n, &ranks_buffer_);
+        return SplitFronts(population, ranks_buffer_, n, fronts);
+    }
+
+    /**
+     * The bytes of the dominance matrix of the last sort.
+     */
+    size_t matrix_bytes() const {
+        return static_cast<size_t>(n_blocks_) * TILE * n_blocks_ *
+               sizeof(uint64_t);
+    }
+
+private:
+    /**
+     * The work of the t-th thread.
+     */
+    void Run(int t, int n_threads) {
+        int n_columns = n_blocks_ * TILE;
+        int* counts = &counts_[static_cast<size_t>(t) * n_columns];
+        std::fill(counts, counts + n_columns, 0);
+
+        // The tiles (I, J), I <= J, are taken in row order, so consecutive
+        // tiles of a thread share the individuals of block I.
+        int n_tiles = n_blocks_ * (n_blocks_ + 1) / 2;
+        int block = 0, first = 0; // The row of tiles and its first index.
+        for (int tile = next_tile_++; tile < n_tiles; tile = next_tile_++) {
+            while (tile >= first + n_blocks_ - block) {
+                first += n_blocks_ - block;
+                ++block;
+            }
+            ComputeTile(block, block + tile - first, counts);
+        }
+        barrier_->Wait();
+
+        // Each thread owns a range of words, i.e., of columns.
+        int word_begin = n_blocks_ * t / n_threads;
+        int word_end = n_blocks_ * (t + 1) / n_threads;
+        int begin = word_begin * TILE;
+        int end = std::min(word_end * TILE, size_);
+        std::vector<int>& next = nexts_[t];
+        for (int j = begin; j < end; ++j) {
+            int indegree = 0;
+            for (int s = 0; s < n_threads; ++s) {
+                indegree += counts_[static_cast<size_t>(s) * n_columns + j];
+            }
+            indegrees_[j] = indegree;
+            if (indegree == 0) next.push_back(j);
+        }
+        barrier_->Wait();
+
+        for (;;) {
+            if (t == 0) NextFront();
+            barrier_->Wait();
+            if (done_) break;
+
+            for (int i : front_) {
+                const uint64_t* row = &matrix_[static_cast<size_t>(i) *
+                                               n_blocks_];
+                for (int w = word_begin; w < word_end; ++w) {
+                    for (uint64_t bits = row[w]; bits != 0;
+                         bits &= bits - 1) {
+                        int j = w * TILE + LowestBit(bits);
+                        if (--indegrees_[j] == 0) next.push_back(j);
+                    }
+                }
+            }
+            barrier_->Wait();
+        }
+    }
+
+    /**
+     * Gather the next front from the threads, and assign its rank.
+     */
+    void NextFront() {
+        front_.clear();
+        for (std::vector<int>& next : nexts_) {
+            front_.insert(front_.end(), next.begin(), next.end());
+            next.clear();
+        }
+        if (front_.empty()) {
+            done_ = true;
+            return;
+        }
+
+        for (int i : front_) {
+            ranks_[i] = rank_;
+        }
+        ++rank_;
+        n_ranked_ += static_cast<int>(front_.size());
+
+        // The last front is not peeled, it only assigns the ranks.
+        if (n_ranked_ == size_ || (n_limit_ >= 0 && n_ranked_ >= n_limit_)) {
+            front_.clear();
+            done_ = true;
+        }
+    }
+
+    /**
+     * Compare the individuals of block I (rows) and block J (columns).
+     */
+    void ComputeTile(int block_i, int block_j, int* counts) {
+        int n_columns = n_blocks_ * TILE;
+        int m = n_objectives_;
+        const T* objectives = objectives_.data();
+        uint64_t* matrix = matrix_.data();
+        bool diagonal = block_i == block_j;
+
+        uint64_t dominate[TILE];   // The bits of j dominated by i.
+        uint64_t dominated[TILE];  // The bits of j dominating i.
+        for (int r = 0; r < TILE; ++r) {
+            int i = block_i * TILE + r;
+
+            // The flags are bytes set by selects, so the loop is vectorized.
+            uint8_t better[TILE] = { 0 }, worse[TILE] = { 0 };
+            for (int k = 0; k < m; ++k) {
+                T x = objectives[k * n_columns + i];
+                const T* y = objectives + k * n_columns + block_j * TILE;
+                for (int c = 0; c < TILE; ++c) {
+                    better[c] = x < y[c] ? 1 : better[c];
+                    worse[c] = x > y[c] ? 1 : worse[c];
+                }
+            }
+
+            dominate[r] = 0;
+            dominated[r] = 0;
+            for (int c = 0; c < TILE; c += 8) {
+                uint64_t b, w;
+                std::memcpy(&b, better + c, 8);
+                std::memcpy(&w, worse + c, 8);
+                dominate[r] |= PackBytes(b & ~w) << c;
+                dominated[r] |= PackBytes(w & ~b) << c;
+            }
+            matrix[static_cast<size_t>(i) * n_blocks_ + block_j] = dominate[r];
+            if (!diagonal) counts[i] += PopCount(dominated[r]);
+        }
+
+        // The column c of dominate has the bits of i that dominate j.
+        Transpose(dominate);
+        for (int c = 0; c < TILE; ++c) {
+            counts[block_j * TILE + c] += PopCount(dominate[c]);
+        }
+        if (diagonal) return;
+
+        // The mirrored tile: the row j has the bits of i dominated by j.
+        Transpose(dominated);
+        for (int c = 0; c < TILE; ++c) {
+            int j = block_j * TILE + c;
+            matrix[static_cast<size_t>(j) * n_blocks_ + block_i] =
+                    dominated[c];
+        }
+    }
+
+    /**
+     * Pack 8 bytes (each 0 or 1, the first one in the lowest byte) into 8
+     * bits. The multiplier moves the c-th byte to the bit 56 + c without
+     * carries.
+     */
+    static uint64_t PackBytes(uint64_t bytes) {
+        return (bytes * 0x0102040810204080ULL) >> 56;
+    }
+
+    /**
+     * Transpose a 64 x 64 bit matrix: the j-th bit of a[i] is swapped with
+     * the i-th bit of a[j] (Hacker's Delight, 7-3).
+     */
+    static void Transpose(uint64_t a[64]) {
+        uint64_t mask = 0x00000000FFFFFFFFULL;
+        for (int j = 32; j != 0; j >>= 1, mask ^= mask << j) {
+            for (int k = 0; k < 64; k = ((k | j) + 1) & ~j) {
+                uint64_t t = ((a[k] >> j) ^ a[k | j]) & mask;
+                a[k] ^= t << j;
+                a[k | j] ^= t;
+            }
+        }
+    }
+
+    static int PopCount(uint64_t x) {
+#if defined(__GNUC__)
+        return __builtin_popcountll(x);
+#else
+        x = x - ((x >> 1) & 0x5555555555555555ULL);
+        x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+        x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+        return static_cast<int>((x * 0x0101010101010101ULL) >> 56);
+#endif
+    }
+
+    /**
+     * The index of the lowest set bit, x must not be 0.
+     */
+    static int LowestBit(uint64_t x) {
+#if defined(__GNUC__)
+        return __builtin_ctzll(x);
+#else
+        return PopCount((x & (0 - x)) - 1);
+#endif
+    }
+
+    int n_threads_;                      // The maximum number of threads.
+    int size_;                           // The size of population.
+    int n_objectives_;                   // The number of objectives.
+    int n_blocks_;                       // The number of 64-blocks (words).
+    std::vector<T> objectives_;          // The objectives, one per array.
+    std::vector<uint64_t> matrix_;       // Row i: the bits of j i dominates.
+    std::vector<int> counts_;            // The indegrees of each thread.
+    std::vector<int> indegrees_;         // The remaining indegrees.
+    std::atomic<int> next_tile_;         // The next tile to compute.
+
+    std::vector<int> front_;             // The front being peeled.
+    std::vector<std::vector<int> > nexts_; // The next front of each thread.
+    int n_limit_;                        // Stop when n_limit_ are ranked.
+    int n_ranked_;                       // The number of ranked individuals.
+    int rank_;                           // The rank of the next front.
+    bool done_;                          // True if the peeling is finished.
+    int* ranks_;                         // The output ranks.
+    Barrier* barrier_;                   // The barrier of the threads.
+    std::vector<int> ranks_buffer_;      // The buffer for Sort().
+};
+
+typedef BasicBitsetNonDominatedSort<double> BitsetNonDominatedSort;
+typedef BasicBitsetNonDominatedSort<float> FloatBitsetNonDominatedSort;
+
+} // namespace moo
+
+#endif // SOLVER_UTIL_BITSET_NON_DOMINATED_SORT_H_
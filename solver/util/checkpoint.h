@@ -0,0 +1,407 @@
+//
+// Copyright 2013 Yangbin Lin and Bili Chen. All Rights Reserved.
+//
+// Author: yblin.xmu@qq.com (Yangbin Lin)
+//
+// To use this code, please cite the follow paper:
+//
+// Chen B, Zeng W, Lin Y, et al. A New Local Search-Based Multiobjective
+// Optimization Algorithm[J]. IEEE Transactions on Evolutionary Computation,
+// 2014, 19(1):1-1.
+//
+
+#ifndef SOLVER_UTIL_CHECKPOINT_H_
+#define SOLVER_UTIL_CHECKPOINT_H_
+
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "codelibrary/util/io/mapped_file.h"
+#include "core/population.h"
+
+namespace moo {
+
+/// The state of solver stored in the checkpoint, except the populations.
+struct SolverState {
+    std::string test_name;     // The name of test.
+    int n_variables;           // The number of variables.
+    int n_objectives;          // The number of objectives.
+    int n_constraints;         // The number of constraints.
+    int size_population;       // The size of population.
+    int n_generation;          // The number of generation.
+    int64_t n_evaluations;     // The number of evaluations.
+    std::string random_engine; // The serialized state of random engine.
+    std::string scheduler;     // The state of variable scheduler, if any.
+    std::string surrogate;     // The state of surrogate, if any.
+};
+
+/// Binary Checkpoint for Solvers.
+/**
+ * A checkpoint is a versioned binary snapshot of the solver state and a list of
+ * populations (e.g., the current population and the archive). The layout is:
+ *
+ *   Header | magic, version, dimensions, generation, checksum, evaluations,
+ *          | lengths of the states
+ *   Name   | the test name, padded to 8 bytes
+ *   Random | the state of random engine, padded to 8 bytes
+ *   States | the states of variable scheduler and surrogate, empty if not
+ *          | used, each padded to 8 bytes
+ *   Blocks | for each population: size, then the row-major variables,
+ *          | objectives, constraints and distances, then the ranks and lives,
+ *          | padded to 8 bytes
+ *
+ * All values are stored in the native byte order. The checksum covers
+ * everything after the header.
+ *
+ * The checkpoint is written into a temporary file and then renamed, so that a
+ * crash during saving never destroys the previous checkpoint. It is loaded
+ * through a memory mapped file.
+ */
+class Checkpoint {
+    // The header of checkpoint file.
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t n_blocks;
+        int32_t n_variables;
+        int32_t n_objectives;
+        int32_t n_constraints;
+        int32_t size_population;
+        int64_t n_generation;
+        uint32_t name_length;
+        uint32_t random_length;
+        uint64_t checksum;
+        int64_t n_evaluations;
+        uint32_t scheduler_length;
+        uint32_t surrogate_length;
+    };
+
+    /// Streaming FNV-1a style checksum over 8-byte words.
+    class Checksum {
+    public:
+        Checksum()
+            : hash_(14695981039346656037ULL), word_(0), n_bytes_(0) {}
+
+        void Update(const void* data, size_t size) {
+            const unsigned char* p = static_cast<const unsigned char*>(data);
+            while (size > 0 && n_bytes_ != 0) {
+                Push(*p++);
+                --size;
+            }
+            for (; size >= 8; size -= 8, p += 8) {
+                uint64_t word;
+                std::memcpy(&word, p, 8);
+                Mix(word);
+            }
+            for (; size > 0; --size) {
+                Push(*p++);
+            }
+        }
+
+        uint64_t hash() const {
+            return n_bytes_ == 0 ? hash_ : (hash_ ^ word_) * 1099511628211ULL;
+        }
+
+    private:
+        void Push(unsigned char c) {
+            word_ |= static_cast<uint64_t>(c) << (8 * n_bytes_);
+            if (++n_bytes_ == 8) {
+                Mix(word_);
+                word_ = 0;
+                n_bytes_ = 0;
+            }
+        }
+
+        void Mix(uint64_t word) {
+            hash_ = (hash_ ^ word) * 1099511628211ULL;
+        }
+
+        uint64_t hash_; // The current hash value.
+        uint64_t word_; // The pending bytes.
+        int n_bytes_;   // The number of pending bytes.
+    };
+
+    /// Binary writer that keeps the checksum of written data.
+    class Writer {
+    public:
+        explicit Writer(FILE* file)
+            : file_(file), size_(0), ok_(true) {}
+
+        void Write(const void* data, size_t size) {
+            if (size == 0) return;
+            ok_ = ok_ && std::fwrite(data, 1, size, file_) == size;
+            checksum_.Update(data, size);
+            size_ += size;
+        }
+
+        /**
+         * Write zeros until the size is a multiple of 8.
+         */
+        void Pad() {
+            static const char zeros[8] = { 0 };
+            Write(zeros, (8 - size_ % 8) % 8);
+        }
+
+        bool ok()               const { return ok_;              }
+        uint64_t checksum()     const { return checksum_.hash(); }
+
+    private:
+        FILE* file_;        // The output file.
+        size_t size_;       // The number of written bytes.
+        bool ok_;           // False if any writing failed.
+        Checksum checksum_; // The checksum of written data.
+    };
+
+public:
+    // The current version of checkpoint format.
+    static const uint32_t VERSION = 2;
+
+    /**
+     * Save the state and the populations into the given file.
+     */
+    static bool Save(const std::string& file, const SolverState& state,
+                     const std::vector<const Population*>& populations) {
+        std::string tmp_file = file + ".tmp";
+        FILE* f = std::fopen(tmp_file.c_str(), "wb");
+        if (!f) return false;
+
+        Header header;
+        std::memset(&header, 0, sizeof(header));
+        std::memcpy(header.magic, "NSLSCKPT", 8);
+        header.version         = VERSION;
+        header.n_blocks        = static_cast<uint32_t>(populations.size());
+        header.n_variables     = state.n_variables;
+        header.n_objectives    = state.n_objectives;
+        header.n_constraints   = state.n_constraints;
+        header.size_population = state.size_population;
+        header.n_generation    = state.n_generation;
+        header.n_evaluations   = state.n_evaluations;
+        header.name_length     = static_cast<uint32_t>(state.test_name.size());
+        header.random_length   =
+                static_cast<uint32_t>(state.random_engine.size());
+        header.scheduler_length =
+                static_cast<uint32_t>(state.scheduler.size());
+        header.surrogate_length =
+                static_cast<uint32_t>(state.surrogate.size());
+
+        // The header is rewritten after the checksum is known.
+        bool ok = std::fwrite(&header, sizeof(header), 1, f) == 1;
+
+        Writer writer(f);
+        writer.Write(state.test_name.data(), state.test_name.size());
+        writer.Pad();
+        writer.Write(state.random_engine.data(), state.random_engine.size());
+        writer.Pad();
+        writer.Write(state.scheduler.data(), state.scheduler.size());
+        writer.Pad();
+        writer.Write(state.surrogate.data(), state.surrogate.size());
+        writer.Pad();
+        for (size_t k = 0; k < populations.size(); ++k) {
+            WriteBlock(state, *populations[k], &writer);
+        }
+
+        header.checksum = writer.checksum();
+        ok = ok && writer.ok() && std::fseek(f, 0, SEEK_SET) == 0 &&
+             std::fwrite(&header, sizeof(header), 1, f) == 1 &&
+             std::fflush(f) == 0;
+#ifdef _WIN32
+        ok = ok && _commit(_fileno(f)) == 0;
+#else
+        ok = ok && fsync(fileno(f)) == 0;
+#endif
+        ok = std::fclose(f) == 0 && ok;
+
+        if (!ok) {
+            std::remove(tmp_file.c_str());
+            return false;
+        }
+
+#ifdef _WIN32
+        // Windows can not rename onto an existing file.
+        std::remove(file.c_str());
+#endif
+        return std::rename(tmp_file.c_str(), file.c_str()) == 0;
+    }
+
+    /**
+     * Load the state and the populations from the given file.
+     */
+    static bool Load(const std::string& file, SolverState* state,
+                     std::vector<Population>* populations) {
+        assert(state);
+        assert(populations);
+
+        cl::MappedFile mapped_file;
+        if (!mapped_file.Open(file)) return false;
+
+        const char* data = mapped_file.data();
+        size_t size = mapped_file.size();
+
+        Header header;
+        if (size < sizeof(header)) return false;
+        std::memcpy(&header, data, sizeof(header));
+        if (std::memcmp(header.magic, "NSLSCKPT", 8) != 0 ||
+            header.version != VERSION ||
+            header.n_variables < 0 || header.n_objectives < 0 ||
+            header.n_constraints < 0) {
+            return false;
+        }
+
+        Checksum checksum;
+        checksum.Update(data + sizeof(header), size - sizeof(header));
+        if (checksum.hash() != header.checksum) return false;
+
+        size_t offset = sizeof(header);
+        if (!ReadString(data, size, header.name_length, &offset,
+                        &state->test_name) ||
+            !ReadString(data, size, header.random_length, &offset,
+                        &state->random_engine) ||
+            !ReadString(data, size, header.scheduler_length, &offset,
+                        &state->scheduler) ||
+            !ReadString(data, size, header.surrogate_length, &offset,
+                        &state->surrogate)) {
+            return false;
+        }
+        state->n_variables     = header.n_variables;
+        state->n_objectives    = header.n_objectives;
+        state->n_constraints   = header.n_constraints;
+        state->size_population = header.size_population;
+        state->n_generation    = static_cast<int>(header.n_generation);
+        state->n_evaluations   = header.n_evaluations;
+
+        populations->resize(header.n_blocks);
+        for (uint32_t k = 0; k < header.n_blocks; ++k) {
+            if (!ReadBlock(data, size, *state, &offset, &(*populations)[k])) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+private:
+    /**
+     * Write a population as a block.
+     */
+    static void WriteBlock(const SolverState& state,
+                           const Population& population, Writer* writer) {
+        int64_t n = static_cast<int64_t>(population.size());
+        writer->Write(&n, sizeof(n));
+
+        for (const Individual& ind : population) {
+            assert(ind.variables.size() == size_t(state.n_variables));
+            writer->Write(ind.variables.data(),
+                          ind.variables.size() * sizeof(double));
+        }
+        for (const Individual& ind : population) {
+            assert(ind.objectives.size() == size_t(state.n_objectives));
+            writer->Write(ind.objectives.data(),
+                          ind.objectives.size() * sizeof(double));
+        }
+        for (const Individual& ind : population) {
+            assert(ind.constraints.size() == size_t(state.n_constraints));
+            writer->Write(ind.constraints.data(),
+                          ind.constraints.size() * sizeof(double));
+        }
+        for (const Individual& ind : population) {
+            writer->Write(&ind.distance, sizeof(double));
+        }
+        for (const Individual& ind : population) {
+            int32_t rank = ind.rank;
+            writer->Write(&rank, sizeof(rank));
+        }
+        for (const Individual& ind : population) {
+            int32_t life = ind.life;
+            writer->Write(&life, sizeof(life));
+        }
+        writer->Pad();
+    }
+
+    /**
+     * Read a block into population.
+     */
+    static bool ReadBlock(const char* data, size_t size,
+                          const SolverState& state, size_t* offset,
+                          Population* population) {
+        int64_t n = 0;
+        if (*offset + sizeof(n) > size) return false;
+        std::memcpy(&n, data + *offset, sizeof(n));
+        *offset += sizeof(n);
+
+        size_t row = sizeof(double) * (state.n_variables + state.n_objectives +
+                                       state.n_constraints + 1) +
+                     2 * sizeof(int32_t);
+        if (n < 0 || static_cast<uint64_t>(n) > (size - *offset) / row) {
+            return false;
+        }
+
+        const char* p = data + *offset;
+        population->resize(static_cast<size_t>(n));
+        for (Individual& ind : *population) {
+            ReadArray(state.n_variables, &p, &ind.variables);
+        }
+        for (Individual& ind : *population) {
+            ReadArray(state.n_objectives, &p, &ind.objectives);
+        }
+        for (Individual& ind : *population) {
+            ReadArray(state.n_constraints, &p, &ind.constraints);
+        }
+        for (Individual& ind : *population) {
+            std::memcpy(&ind.distance, p, sizeof(double));
+            p += sizeof(double);
+        }
+        for (Individual& ind : *population) {
+            int32_t rank;
+            std::memcpy(&rank, p, sizeof(rank));
+            ind.rank = rank;
+            p += sizeof(rank);
+        }
+        for (Individual& ind : *population) {
+            int32_t life;
+            std::memcpy(&life, p, sizeof(life));
+            ind.life = life;
+            p += sizeof(life);
+        }
+
+        *offset = p - data;
+        *offset += (8 - *offset % 8) % 8;
+        return *offset <= size;
+    }
+
+    /**
+     * Read n doubles from p into values.
+     */
+    static void ReadArray(int n, const char** p, std::vector<double>* values) {
+        values->resize(n);
+        if (n > 0) {
+            std::memcpy(values->data(), *p, n * sizeof(double));
+        }
+        *p += n * sizeof(double);
+    }
+
+    /**
+     * Read a padded string of the given length.
+     */
+    static bool ReadString(const char* data, size_t size, uint32_t length,
+                           size_t* offset, std::string* s) {
+        if (length > size - *offset) return false;
+        s->assign(data + *offset, length);
+        *offset += length;
+        *offset += (8 - *offset % 8) % 8;
+        return *offset <= size;
+    }
+};
+
+} // namespace moo
+
+#endif // SOLVER_UTIL_CHECKPOINT_H_
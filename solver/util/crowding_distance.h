@@ -0,0 +1,174 @@
+//
+// Copyright 2013 Yangbin Lin and Bili Chen. All Rights Reserved.
+//
+// Author: yblin.xmu@qq.com (Yangbin Lin)
+//
+// To use this code, please cite the follow paper:
+//
+// Chen B, Zeng W, Lin Y, et al. A New Local Search-Based Multiobjective
+// Optimization Algorithm[J]. IEEE Transactions on Evolutionary Computation,
+// 2014, 19(1):1-1.
+//
+
+#ifndef SOLVER_UTIL_CROWDING_DISTANCE_H_
+#define SOLVER_UTIL_CROWDING_DISTANCE_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+#include "codelibrary/util/common/arg_sort.h"
+
+#include "core/population.h"
+
+namespace moo {
+
+/// Crowding Distance of NSGA-II.
+/**
+ * The crowding distance of an individual is the sum over all objectives of the
+ * normalized distance between its two neighbors along the objective. The
+ * individuals with the minimum or the maximum value of any objective get
+ * INFINITY.
+ *
+ * For each objective, the individuals are ordered by cl::ArgSort, which is
+ * stable, so the result is deterministic even with ties. All buffers are kept
+ * by the object and reused by the next call, so after the first call on the
+ * largest population no memory is allocated. The objectives are processed in
+ * parallel if the population is large enough to pay for the threads.
+ *
+ * Usage:
+ *    CrowdingDistance crowding_distance;
+ *    std::vector<double> distance;
+ *    crowding_distance.Compute(population, &distance);
+ */
+class CrowdingDistance {
+    // The minimum size of population to compute the objectives in parallel.
+    static const int PARALLEL_THRESHOLD = 4096;
+
+    /// The buffers for one objective.
+    struct Buffer {
+        cl::ArgSort arg_sort;
+        std::vector<double> values;
+        std::vector<int> orders;
+        std::vector<double> distance;
+    };
+
+public:
+    /**
+     * If 'n_threads' is 0, the number of hardware threads is used.
+     */
+    explicit CrowdingDistance(int n_threads = 0)
+        : n_threads_(n_threads) {
+        assert(n_threads_ >= 0);
+
+        if (n_threads_ == 0) {
+            n_threads_ = std::max(1u, std::thread::hardware_concurrency());
+        }
+    }
+
+    /**
+     * Compute the crowding distance of each individual in population.
+     */
+    void Compute(const Population& population, std::vector<double>* distance) {
+        assert(distance);
+
+        int n = static_cast<int>(population.size());
+        distance->assign(n, 0.0);
+        if (n == 0) return;
+
+        int n_objectives = static_cast<int>(population[0].objectives.size());
+        if (buffers_.size() < size_t(n_objectives)) {
+            buffers_.resize(n_objectives);
+        }
+
+        int n_threads = n < PARALLEL_THRESHOLD ? 1 :
+                        std::min(n_threads_, n_objectives);
+        if (n_threads <= 1) {
+            for (int m = 0; m < n_objectives; ++m) {
+                ComputeObjective(population, m, &buffers_[m]);
+            }
+        } else {
+            std::vector<std::thread> threads;
+            for (int t = 1; t < n_threads; ++t) {
+                threads.emplace_back(&CrowdingDistance::ComputeObjectives,
+                                     this, std::cref(population), t,
+                                     n_threads);
+            }
+            ComputeObjectives(population, 0, n_threads);
+            for (std::thread& thread : threads) {
+                thread.join();
+            }
+        }
+
+        for (int m = 0; m < n_objectives; ++m) {
+            const double* d = buffers_[m].distance.data();
+            for (int i = 0; i < n; ++i) {
+                (*distance)[i] += d[i];
+            }
+        }
+    }
+
+    /**
+     * Set the crowding distance to each individual in population.
+     */
+    void operator() (Population* population) {
+        assert(population);
+
+        Compute(*population, &distance_);
+        for (size_t i = 0; i < population->size(); ++i) {
+            (*population)[i].distance = distance_[i];
+        }
+    }
+
+private:
+    /**
+     * Compute the objectives {first, first + step, ...}.
+     */
+    void ComputeObjectives(const Population& population, int first,
+                           int step) {
+        int n_objectives = static_cast<int>(population[0].objectives.size());
+        for (int m = first; m < n_objectives; m += step) {
+            ComputeObjective(population, m, &buffers_[m]);
+        }
+    }
+
+    /**
+     * Compute the contribution of the m-th objective into buffer->distance.
+     */
+    static void ComputeObjective(const Population& population, int m,
+                                 Buffer* buffer) {
+        int n = static_cast<int>(population.size());
+        buffer->values.resize(n);
+        for (int i = 0; i < n; ++i) {
+            buffer->values[i] = population[i].objectives[m];
+        }
+        buffer->arg_sort.Sort(buffer->values, &buffer->orders);
+
+        const int* orders = buffer->orders.data();
+        buffer->distance.assign(n, 0.0);
+        double* distance = buffer->distance.data();
+        distance[orders[0]] = INFINITY;
+        distance[orders[n - 1]] = INFINITY;
+
+        const double* values = buffer->values.data();
+        double min = values[orders[0]];
+        double max = values[orders[n - 1]];
+        if (n <= 2 || !(max > min)) return;
+
+        double scale = 1.0 / (max - min);
+        for (int i = 1; i < n - 1; ++i) {
+            distance[orders[i]] = scale * (values[orders[i + 1]] -
+                                           values[orders[i - 1]]);
+        }
+    }
+
+    int n_threads_;                   // The maximum number of threads.
+    std::vector<Buffer> buffers_;     // The buffers of each objective.
+    std::vector<double> distance_;    // The buffer for operator().
+};
+
+} // namespace moo
+
+#endif // SOLVER_UTIL_CROWDING_DISTANCE_H_
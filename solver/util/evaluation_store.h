@@ -0,0 +1,668 @@
+//
+// Copyright 2013 Yangbin Lin and Bili Chen. All Rights Reserved.
+//
+// Author: yblin.xmu@qq.com (Yangbin Lin)
+//
+// To use this code, please cite the follow paper:
+//
+// Chen B, Zeng W, Lin Y, et al. A New Local Search-Based Multiobjective
+// Optimization Algorithm[J]. IEEE Transactions on Evolutionary Computation,
+// 2014, 19(1):1-1.
+//
+
+#ifndef SOLVER_UTIL_EVALUATION_STORE_H_
+#define SOLVER_UTIL_EVALUATION_STORE_H_
+
+#ifndef _WIN32
+
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "codelibrary/base/macros.h"
+#include "codelibrary/util/array/array_2d.h"
+#include "codelibrary/util/io/mapped_file.h"
+#include "core/batch_evaluator.h"
+#include "core/population.h"
+#include "solver/util/population_util.h"
+#include "solver/util/selector/farthest_candidate.h"
+#include "solver/util/selector/non_dominated_sorting_selector.h"
+#include "test/basic_test.h"
+
+namespace moo {
+
+/// Persistent Evaluation Store.
+/**
+ * EvaluationStore keeps the objectives of every evaluated candidate in a file,
+ * so that the runs of the same problem (e.g., with different seeds or
+ * settings) share their evaluations instead of starting from zero.
+ *
+ * The file is an append-only log: a header ("NSLSEVDB", version, resolution)
+ * and a list of records
+ *
+ *   problem (uint64), n_variables, n_objectives (uint32 * 2),
+ *   checksum (uint64), variables, objectives (double * (n + m)).
+ *
+ * where problem is the hash of the problem's name, e.g., the test name. The
+ * records are read through a memory mapped file, and a hash index from the
+ * problem and the quantised variables (round(x / resolution), or the bits of x
+ * if the resolution is 0) to the records is kept in memory. The index is built
+ * when the store is opened and extended by Refresh() when the file grows.
+ *
+ * The new records are buffered and appended in batches by Flush(), which is
+ * called when 'batch_size' records are pending and by the destructor. The
+ * processes that share the file are serialized by flock(): Refresh() holds a
+ * shared lock, Flush() an exclusive one. The records are not synced to disk,
+ * a record torn by a crash fails its checksum and is cut off by the next
+ * Flush().
+ *
+ * Usage:
+ *    EvaluationStore store;
+ *    if (store.Open("evaluations.db")) {
+ *        StoredEvaluator evaluator(test, &store);
+ *        test.batch_evaluator = &evaluator;
+ *        ...
+ *    }
+ */
+class EvaluationStore {
+    // The header of store file.
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t reserved;
+        double resolution;
+    };
+
+    // The header of a record, followed by the variables and the objectives.
+    struct RecordHeader {
+        uint64_t problem;
+        uint32_t n_variables;
+        uint32_t n_objectives;
+        uint64_t checksum;
+    };
+
+    // A record that is not appended yet.
+    struct PendingRecord {
+        uint64_t problem;
+        std::vector<double> variables;
+        std::vector<double> objectives;
+    };
+
+    // The hash index from the keys to the records.
+    typedef std::unordered_multimap<uint64_t, int64_t> Index;
+
+public:
+    // The current version of store format.
+    static const uint32_t VERSION = 1;
+
+    EvaluationStore()
+        : fd_(-1),
+          resolution_(0.0),
+          batch_size_(256),
+          indexed_size_(0) {}
+
+    ~EvaluationStore() {
+        Close();
+    }
+
+    /**
+     * Open the store file, create it if it does not exist. The variables are
+     * quantised to the multiples of 'resolution' to find the records, 0 to
+     * compare the exact values.
+     *
+     * Return false if the file can not be opened, or it is not a store, or it
+     * was created with another resolution.
+     */
+    bool Open(const std::string& file, double resolution = 0.0) {
+        assert(resolution >= 0.0);
+
+        Close();
+
+        fd_ = open(file.c_str(), O_RDWR | O_CREAT, 0644);
+        if (fd_ < 0) return false;
+
+        file_ = file;
+        resolution_ = resolution;
+
+        bool ok = flock(fd_, LOCK_EX) == 0 && InitializeHeader();
+        if (ok) Scan();
+        flock(fd_, LOCK_UN);
+        if (!ok) {
+            close(fd_);
+            fd_ = -1;
+            file_.clear();
+        }
+        return ok;
+    }
+
+    /**
+     * Append the pending records and close the file.
+     */
+    void Close() {
+        if (fd_ < 0) return;
+
+        Flush();
+        mapped_file_.Close();
+        close(fd_);
+        fd_ = -1;
+        file_.clear();
+        index_.clear();
+        records_.clear();
+        pending_.clear();
+        pending_index_.clear();
+        indexed_size_ = 0;
+    }
+
+    /**
+     * Index the records appended by the other processes since the last call.
+     */
+    void Refresh() {
+        assert(is_open());
+
+        flock(fd_, LOCK_SH);
+        Scan();
+        flock(fd_, LOCK_UN);
+    }
+
+    /**
+     * Find the objectives of the given variables of problem.
+     *
+     * @return false if they are not stored.
+     */
+    bool Find(const std::string& problem, const std::vector<double>& variables,
+              std::vector<double>* objectives) const {
+        assert(objectives);
+
+        return Find(Hash(problem), variables.data(),
+                    static_cast<int>(variables.size()), objectives);
+    }
+
+    /**
+     * Store the objectives of the given variables of problem. They are
+     * appended when the batch is full, or by Flush().
+     */
+    void Insert(const std::string& problem,
+                const std::vector<double>& variables,
+                const std::vector<double>& objectives) {
+        Insert(Hash(problem), variables.data(),
+               static_cast<int>(variables.size()), objectives.data(),
+               static_cast<int>(objectives.size()));
+    }
+
+    /**
+     * Append the pending records to the file.
+     */
+    bool Flush() {
+        if (fd_ < 0 || pending_.empty()) return true;
+
+        if (flock(fd_, LOCK_EX) != 0) return false;
+
+        // Under the exclusive lock, anything after the last valid record is
+        // the tail of a crashed writer.
+        Scan();
+        struct stat st;
+        bool ok = fstat(fd_, &st) == 0;
+        if (ok && static_cast<uint64_t>(st.st_size) > indexed_size_) {
+            ok = ftruncate(fd_, static_cast<off_t>(indexed_size_)) == 0;
+        }
+
+        std::vector<char> buffer;
+        for (const PendingRecord& record : pending_) {
+            AppendRecord(record, &buffer);
+        }
+        ok = ok && WriteAll(buffer.data(), buffer.size(), indexed_size_);
+
+        if (ok) {
+            pending_.clear();
+            pending_index_.clear();
+            Scan();
+        }
+        flock(fd_, LOCK_UN);
+        return ok;
+    }
+
+    /**
+     * Get all stored individuals of the given problem, with the given numbers
+     * of variables and objectives.
+     */
+    void Load(const std::string& problem, int n_variables, int n_objectives,
+              Population* population) const {
+        assert(population);
+
+        uint64_t id = Hash(problem);
+        population->clear();
+        for (int64_t k = 0; k < static_cast<int64_t>(records_.size()); ++k) {
+            const RecordHeader* header = GetRecord(k);
+            if (header->problem != id ||
+                header->n_variables != uint32_t(n_variables) ||
+                header->n_objectives != uint32_t(n_objectives)) {
+                continue;
+            }
+            const double* x = Values(header);
+            AddIndividual(x, n_variables, x + n_variables, n_objectives,
+                          population);
+        }
+        for (const PendingRecord& record : pending_) {
+            if (record.problem != id ||
+                record.variables.size() != size_t(n_variables) ||
+                record.objectives.size() != size_t(n_objectives)) {
+                continue;
+            }
+            AddIndividual(record.variables.data(), n_variables,
+                          record.objectives.data(), n_objectives, population);
+        }
+    }
+
+    /**
+     * Get the best n stored individuals of the test, i.e., the first fronts
+     * and the farthest candidates of the last one, to warm-start a solver. It
+     * gets all of them if there are no more than n.
+     */
+    void GetBest(const BasicTest& test, int n, Population* population) const {
+        assert(n >= 0);
+        assert(population);
+
+        Population stored;
+        Load(test.name, test.parameter.n_variables,
+             test.parameter.n_objectives, &stored);
+        if (stored.size() <= static_cast<size_t>(n)) {
+            population->swap(stored);
+            return;
+        }
+        NonDominatedSortingSelector<FarthestCandidate>::
+                Select(test, stored, n, population);
+    }
+
+    /**
+     * Append the records when the given number of them are pending.
+     */
+    void set_batch_size(int batch_size) {
+        assert(batch_size > 0);
+
+        batch_size_ = batch_size;
+    }
+
+    bool is_open()              const { return fd_ >= 0;           }
+    double resolution()         const { return resolution_;        }
+    int batch_size()            const { return batch_size_;        }
+    size_t size()               const { return records_.size();    }
+    size_t n_pending()          const { return pending_.size();    }
+
+private:
+    friend class StoredEvaluator;
+
+    /**
+     * Write the header into an empty file, or check the header of the file.
+     */
+    bool InitializeHeader() {
+        struct stat st;
+        if (fstat(fd_, &st) != 0) return false;
+
+        Header header;
+        std::memset(&header, 0, sizeof(header));
+        if (st.st_size == 0) {
+            std::memcpy(header.magic, "NSLSEVDB", 8);
+            header.version = VERSION;
+            header.resolution = resolution_;
+            return WriteAll(&header, sizeof(header), 0);
+        }
+
+        return st.st_size >= static_cast<off_t>(sizeof(header)) &&
+               pread(fd_, &header, sizeof(header), 0) ==
+               static_cast<ssize_t>(sizeof(header)) &&
+               std::memcmp(header.magic, "NSLSEVDB", 8) == 0 &&
+               header.version == VERSION &&
+               header.resolution == resolution_;
+    }
+
+    /**
+     * Map the file again if it has grown, and index its new valid records.
+     * The caller holds the lock.
+     */
+    void Scan() {
+        struct stat st;
+        if (fstat(fd_, &st) != 0) return;
+
+        if (indexed_size_ == 0) indexed_size_ = sizeof(Header);
+        if (static_cast<size_t>(st.st_size) == mapped_file_.size()) return;
+        if (!mapped_file_.Open(file_)) return;
+
+        const char* data = mapped_file_.data();
+        uint64_t size = mapped_file_.size();
+        while (indexed_size_ + sizeof(RecordHeader) <= size) {
+            RecordHeader header;
+            std::memcpy(&header, data + indexed_size_, sizeof(header));
+            uint64_t n_values = uint64_t(header.n_variables) +
+                                header.n_objectives;
+            if (n_values > (size - indexed_size_ - sizeof(header)) /
+                           sizeof(double)) {
+                break;
+            }
+            const char* values = data + indexed_size_ + sizeof(header);
+            if (Checksum(header, values) != header.checksum) break;
+
+            int64_t k = static_cast<int64_t>(records_.size());
+            records_.push_back(indexed_size_);
+            index_.insert(Index::value_type(
+                    Key(header.problem,
+                        reinterpret_cast<const double*>(values),
+                        header.n_variables), k));
+            indexed_size_ += sizeof(header) + n_values * sizeof(double);
+        }
+    }
+
+    /**
+     * Find the objectives of the n variables x of problem.
+     */
+    bool Find(uint64_t problem, const double* x, int n,
+              std::vector<double>* objectives) const {
+        uint64_t key = Key(problem, x, n);
+
+        auto range = index_.equal_range(key);
+        for (auto i = range.first; i != range.second; ++i) {
+            const RecordHeader* header = GetRecord(i->second);
+            if (header->problem != problem ||
+                header->n_variables != uint32_t(n)) {
+                continue;
+            }
+            const double* values = Values(header);
+            if (!IsSame(values, x, n)) continue;
+
+            objectives->assign(values + n,
+                               values + n + header->n_objectives);
+            return true;
+        }
+
+        range = pending_index_.equal_range(key);
+        for (auto i = range.first; i != range.second; ++i) {
+            const PendingRecord& record = pending_[i->second];
+            if (record.problem != problem ||
+                record.variables.size() != size_t(n) ||
+                !IsSame(record.variables.data(), x, n)) {
+                continue;
+            }
+            *objectives = record.objectives;
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * Store the m objectives f of the n variables x of problem.
+     */
+    void Insert(uint64_t problem, const double* x, int n, const double* f,
+                int m) {
+        assert(is_open());
+        assert(n >= 0 && m >= 0);
+
+        pending_.resize(pending_.size() + 1);
+        PendingRecord& record = pending_.back();
+        record.problem = problem;
+        record.variables.assign(x, x + n);
+        record.objectives.assign(f, f + m);
+        pending_index_.insert(Index::value_type(Key(problem, x, n),
+                                                pending_.size() - 1));
+
+        if (static_cast<int>(pending_.size()) >= batch_size_) {
+            Flush();
+        }
+    }
+
+    /**
+     * Serialize the record into the end of buffer.
+     */
+    static void AppendRecord(const PendingRecord& record,
+                             std::vector<char>* buffer) {
+        std::vector<double> values(record.variables);
+        values.insert(values.end(), record.objectives.begin(),
+                      record.objectives.end());
+
+        RecordHeader header;
+        header.problem = record.problem;
+        header.n_variables = static_cast<uint32_t>(record.variables.size());
+        header.n_objectives = static_cast<uint32_t>(record.objectives.size());
+        header.checksum = Checksum(header,
+                                   reinterpret_cast<const char*>(
+                                       values.data()));
+
+        const char* p = reinterpret_cast<const char*>(&header);
+        buffer->insert(buffer->end(), p, p + sizeof(header));
+        p = reinterpret_cast<const char*>(values.data());
+        buffer->insert(buffer->end(), p, p + values.size() * sizeof(double));
+    }
+
+    /**
+     * Write the data at the given offset of file.
+     */
+    bool WriteAll(const void* data, size_t size, uint64_t offset) {
+        const char* p = static_cast<const char*>(data);
+        while (size > 0) {
+            ssize_t n = pwrite(fd_, p, size, static_cast<off_t>(offset));
+            if (n <= 0) return false;
+            p += n;
+            size -= n;
+            offset += n;
+        }
+        return true;
+    }
+
+    /**
+     * The header of the k-th mapped record.
+     */
+    const RecordHeader* GetRecord(int64_t k) const {
+        return reinterpret_cast<const RecordHeader*>(mapped_file_.data() +
+                                                     records_[k]);
+    }
+
+    /**
+     * The variables and the objectives of a mapped record. The records are
+     * 8-byte aligned, since the header and the values are.
+     */
+    static const double* Values(const RecordHeader* header) {
+        return reinterpret_cast<const double*>(header + 1);
+    }
+
+    /**
+     * Append an individual of the given values to population.
+     */
+    static void AddIndividual(const double* x, int n, const double* f, int m,
+                              Population* population) {
+        population->resize(population->size() + 1);
+        Individual& ind = population->back();
+        ind.variables.assign(x, x + n);
+        ind.objectives.assign(f, f + m);
+        ind.rank = 0;
+        ind.distance = 0.0;
+        ind.life = 0;
+    }
+
+    /**
+     * Return true if the quantised values of a and b are the same.
+     */
+    bool IsSame(const double* a, const double* b, int n) const {
+        for (int i = 0; i < n; ++i) {
+            if (Quantise(a[i]) != Quantise(b[i])) return false;
+        }
+        return true;
+    }
+
+    /**
+     * The cell of x in the grid of resolution, or the bits of x.
+     */
+    uint64_t Quantise(double x) const {
+        if (resolution_ > 0.0) {
+            return static_cast<uint64_t>(std::llround(x / resolution_));
+        }
+        if (x == 0.0) x = 0.0; // -0.0 is the same as 0.0.
+        uint64_t bits;
+        std::memcpy(&bits, &x, sizeof(bits));
+        return bits;
+    }
+
+    /**
+     * The key of the quantised variables of problem in the index.
+     */
+    uint64_t Key(uint64_t problem, const double* x, int n) const {
+        uint64_t hash = Mix(14695981039346656037ULL, problem);
+        for (int i = 0; i < n; ++i) {
+            hash = Mix(hash, Quantise(x[i]));
+        }
+        return hash;
+    }
+
+    /**
+     * The checksum of a record.
+     */
+    static uint64_t Checksum(const RecordHeader& header, const char* values) {
+        uint64_t hash = Mix(14695981039346656037ULL, header.problem);
+        hash = Mix(hash, (uint64_t(header.n_variables) << 32) |
+                         header.n_objectives);
+        int n = header.n_variables + header.n_objectives;
+        for (int i = 0; i < n; ++i) {
+            uint64_t word;
+            std::memcpy(&word, values + i * sizeof(double), sizeof(word));
+            hash = Mix(hash, word);
+        }
+        return hash;
+    }
+
+    /**
+     * The FNV-1a hash of the name of problem.
+     */
+    static uint64_t Hash(const std::string& problem) {
+        uint64_t hash = 14695981039346656037ULL;
+        for (char c : problem) {
+            hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ULL;
+        }
+        return hash;
+    }
+
+    /**
+     * Mix a word into the hash, FNV-1a style on 8-byte words.
+     */
+    static uint64_t Mix(uint64_t hash, uint64_t word) {
+        return (hash ^ word) * 1099511628211ULL;
+    }
+
+    int fd_;                            // The store file, -1 if closed.
+    std::string file_;                  // The name of store file.
+    double resolution_;                 // The grid to quantise the variables.
+    int batch_size_;                    // The number of buffered records.
+    cl::MappedFile mapped_file_;        // The mapped file.
+    uint64_t indexed_size_;             // The size of indexed valid records.
+    std::vector<uint64_t> records_;     // The offsets of mapped records.
+    Index index_;                       // The index of mapped records.
+    std::vector<PendingRecord> pending_; // The records to be appended.
+    Index pending_index_;               // The index of pending records.
+
+    DISALLOW_COPY_AND_ASSIGN(EvaluationStore);
+};
+
+/// Stored Evaluator.
+/**
+ * It looks up the candidates in an EvaluationStore, and evaluates only the
+ * missing ones by the test, i.e., by its batch evaluator or its objective
+ * functions. The new results are written back into the store.
+ *
+ * The solver may evaluate the trials without the batch evaluator, e.g.,
+ * incrementally or lazily, so clear those hooks of the test to make every
+ * evaluation go through the store.
+ *
+ * Usage:
+ *    StoredEvaluator evaluator(test, &store);
+ *    test.batch_evaluator = &evaluator;
+ */
+class StoredEvaluator : public BatchEvaluator {
+public:
+    /**
+     * The test is copied before it is redirected to this evaluator.
+     */
+    StoredEvaluator(const BasicTest& test, EvaluationStore* store)
+        : test_(test),
+          problem_(EvaluationStore::Hash(test.name)),
+          store_(store),
+          n_hits_(0),
+          n_misses_(0) {
+        assert(store_ && store_->is_open());
+    }
+
+    /**
+     * Evaluate the individuals, one per row of 'variables'.
+     */
+    virtual void Evaluate(const cl::Array2D<double>& variables,
+                          cl::Array2D<double>* objectives) {
+        assert(objectives);
+
+        int n = variables.rows();
+        int d = test_.parameter.n_variables;
+        int m = test_.parameter.n_objectives;
+        assert(variables.columns() == d || n == 0);
+
+        objectives->Resize(n, m);
+        if (n == 0) return;
+
+        store_->Refresh();
+
+        std::vector<int> misses;
+        std::vector<double> f;
+        for (int i = 0; i < n; ++i) {
+            const double* x = variables.data().data() + i * d;
+            if (store_->Find(problem_, x, d, &f) &&
+                f.size() == static_cast<size_t>(m)) {
+                std::copy(f.begin(), f.end(),
+                          objectives->data().begin() + i * m);
+            } else {
+                misses.push_back(i);
+            }
+        }
+        n_hits_ += n - static_cast<int64_t>(misses.size());
+        n_misses_ += misses.size();
+        if (misses.empty()) return;
+
+        cl::Array2D<double> x(static_cast<int>(misses.size()), d), y;
+        for (size_t k = 0; k < misses.size(); ++k) {
+            std::copy_n(variables.data().begin() + misses[k] * d, d,
+                        x.data().begin() + k * d);
+        }
+        PopulationUtil::SetObjectiveValues(test_, x, &y);
+        for (size_t k = 0; k < misses.size(); ++k) {
+            const double* row = y.data().data() + k * m;
+            std::copy_n(row, m, objectives->data().begin() + misses[k] * m);
+            store_->Insert(problem_, x.data().data() + k * d, d, row, m);
+        }
+    }
+
+    /**
+     * The number of candidates found in the store.
+     */
+    int64_t n_hits() const { return n_hits_; }
+
+    /**
+     * The number of candidates evaluated by the test.
+     */
+    int64_t n_misses() const { return n_misses_; }
+
+private:
+    BasicTest test_;         // The test to evaluate the missing candidates.
+    uint64_t problem_;       // The hash of the test name.
+    EvaluationStore* store_; // The store, not owned.
+    int64_t n_hits_;         // The number of found candidates.
+    int64_t n_misses_;       // The number of evaluated candidates.
+
+    DISALLOW_COPY_AND_ASSIGN(StoredEvaluator);
+};
+
+} // namespace moo
+
+#endif // _WIN32
+
+#endif // SOLVER_UTIL_EVALUATION_STORE_H_
@@ -0,0 +1,49 @@
+//
+// Copyright 2013 Yangbin Lin and Bili Chen. All Rights Reserved.
+//
+// Author: yblin.xmu@qq.com (Yangbin Lin)
+//
+// To use this code, please cite the follow paper:
+//
+// Chen B, Zeng W, Lin Y, et al. A New Local Search-Based Multiobjective
+// Optimization Algorithm[J]. IEEE Transactions on Evolutionary Computation,
+// 2014, 19(1):1-1.
+//
+
+#ifndef SOLVER_UTIL_EXTERNAL_ARCHIVE_H_
+#define SOLVER_UTIL_EXTERNAL_ARCHIVE_H_
+
+#include "core/population.h"
+
+namespace moo {
+
+/**
+ * The interface of the external archives kept by the solver during a run,
+ * e.g., NonDominatedArchive and FloatNonDominatedArchive. It is called once
+ * per generation, so the virtual calls cost nothing against the insertions.
+ */
+class ExternalArchive {
+public:
+    virtual ~ExternalArchive() {}
+
+    /**
+     * Insert a population, e.g., a whole generation.
+     *
+     * @return the number of inserted individuals.
+     */
+    virtual int Insert(const Population& population) = 0;
+
+    /**
+     * Export all individuals in the archive, as they are stored.
+     */
+    virtual void Export(Population* population) const = 0;
+
+    /**
+     * Remove all individuals.
+     */
+    virtual void clear() = 0;
+};
+
+} // namespace moo
+
+#endif // SOLVER_UTIL_EXTERNAL_ARCHIVE_H_
@@ -0,0 +1,376 @@
+//
+// Copyright 2013 Yangbin Lin and Bili Chen. All Rights Reserved.
+//
+// Author: yblin.xmu@qq.com (Yangbin Lin)
+//
+// To use this code, please cite the follow paper:
+//
+// Chen B, Zeng W, Lin Y, et al. A New Local Search-Based Multiobjective
+// Optimization Algorithm[J]. IEEE Transactions on Evolutionary Computation,
+// 2014, 19(1):1-1.
+//
+
+#ifndef SOLVER_UTIL_INCREMENTAL_NON_DOMINATED_SORT_H_
+#define SOLVER_UTIL_INCREMENTAL_NON_DOMINATED_SORT_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+#include "core/population.h"
+
+namespace moo {
+
+/// Incremental Non-dominated Sort.
+/**
+ * It keeps the non-dominated fronts of a set of individuals, and updates them
+ * when an individual is inserted or removed, instead of sorting the whole set
+ * again (like the efficient non-domination level update of Li et al.):
+ *
+ * - Insert: the rank of x is the first front that has no member dominating x.
+ *   Since a front dominates x only if all the fronts before it do, the front
+ *   is found by a binary search over the fronts. Then the members of the front
+ *   dominated by x move to the next front, and the members there dominated by
+ *   the moved ones move again, and so on.
+ * - Remove: the members of the next front dominated by x move up if no member
+ *   of x's front dominates them, and so on.
+ *
+ * An insertion or a removal changes each rank by at most one, so only the
+ * moved individuals need to be compared with the next front.
+ *
+ * Each front is kept in the lexicographic order of objectives. Since a
+ * dominates b only if a is before b in this order, the dominators of x in a
+ * front are before the position of x, and the dominated ones are after it. For
+ * two objectives, the second objective is decreasing along a front, so the
+ * only possible dominator is the one right before x, and the dominated members
+ * are a run right after x.
+ *
+ * Each individual is identified by the id returned by Insert(). Only the
+ * objectives are stored.
+ *
+ * Usage:
+ *    IncrementalNonDominatedSort sort;
+ *    int id = sort.Insert(individual.objectives);
+ *    int rank = sort.rank(id);
+ *    sort.Remove(id);
+ */
+class IncrementalNonDominatedSort {
+public:
+    IncrementalNonDominatedSort()
+        : n_objectives_(0), size_(0), n_fronts_(0), n_comparisons_(0) {}
+
+    /**
+     * Remove all individuals. The ids are reused from 0.
+     */
+    void clear() {
+        objectives_.clear();
+        ranks_.clear();
+        free_ids_.clear();
+        for (std::vector<int>& front : fronts_) {
+            front.clear();
+        }
+        n_fronts_ = 0;
+        n_objectives_ = 0;
+        size_ = 0;
+    }
+
+    /**
+     * Insert an individual with the given objectives.
+     *
+     * @return the id of the individual.
+     */
+    int Insert(const std::vector<double>& objectives) {
+        int id = NewId(objectives);
+
+        // Binary search of the first front that does not dominate x.
+        int low = 0, high = n_fronts_;
+        while (low < high) {
+            int mid = (low + high) / 2;
+            if (HasDominator(fronts_[mid], id)) {
+                low = mid + 1;
+            } else {
+                high = mid;
+            }
+        }
+
+        int rank = low;
+        std::vector<int>& dominated = dominated_;
+        dominated.clear();
+        if (rank < n_fronts_) {
+            GetDominated(fronts_[rank], id, &dominated);
+        }
+        AddToFront(id, rank);
+
+        // Push the dominated members down, front by front.
+        for (int k = rank + 1; !dominated.empty(); ++k) {
+            for (int i : dominated) {
+                RemoveFromFront(i);
+            }
+            moved_.clear();
+            if (k < n_fronts_) {
+                for (int i : dominated) {
+                    GetDominated(fronts_[k], i, &moved_);
+                }
+                Unique(&moved_);
+            }
+            for (int i : dominated) {
+                AddToFront(i, k);
+            }
+            dominated.swap(moved_);
+        }
+        return id;
+    }
+
+    /**
+     * Insert an individual whose rank is known, e.g., the individuals
+     * selected from a sorted population. No comparison is made, the caller
+     * must ensure that the rank is right.
+     */
+    int Insert(const std::vector<double>& objectives, int rank) {
+        assert(rank >= 0);
+
+        int id = NewId(objectives);
+        AddToFront(id, rank);
+        return id;
+    }
+
+    /**
+     * Remove the individual with the given id.
+     */
+    void Remove(int id) {
+        assert(Contains(id));
+
+        int rank = ranks_[id];
+        RemoveFromFront(id);
+
+        // Pull the members of the next fronts up, front by front.
+        std::vector<int>& removed = dominated_;
+        removed.assign(1, id);
+        for (int k = rank + 1; k < n_fronts_ && !removed.empty(); ++k) {
+            moved_.clear();
+            for (int i : removed) {
+                GetDominated(fronts_[k], i, &moved_);
+            }
+            Unique(&moved_);
+
+            removed.clear();
+            for (int i : moved_) {
+                if (!HasDominator(fronts_[k - 1], i)) removed.push_back(i);
+            }
+            for (int i : removed) {
+                RemoveFromFront(i);
+                AddToFront(i, k - 1);
+            }
+        }
+
+        ranks_[id] = -1;
+        free_ids_.push_back(id);
+        --size_;
+    }
+
+    /**
+     * Return true if the id is an individual in the set.
+     */
+    bool Contains(int id) const {
+        return id >= 0 && id < static_cast<int>(ranks_.size()) &&
+               ranks_[id] >= 0;
+    }
+
+    /**
+     * The rank (front) of the individual with the given id.
+     */
+    int rank(int id) const {
+        assert(Contains(id));
+
+        return ranks_[id];
+    }
+
+    /**
+     * The objectives of the individual with the given id.
+     */
+    const double* objectives(int id) const {
+        assert(Contains(id));
+
+        return Objectives(id);
+    }
+
+    /**
+     * The ids in the k-th front, in the lexicographic order of objectives.
+     */
+    const std::vector<int>& front(int k) const {
+        assert(0 <= k && k < n_fronts_);
+
+        return fronts_[k];
+    }
+
+    int n_fronts() const { return n_fronts_; }
+    int size()     const { return size_;     }
+
+    /**
+     * The number of dominance comparisons made so far.
+     */
+    int64_t n_comparisons() const { return n_comparisons_; }
+
+private:
+    /**
+     * Store the objectives under a free id.
+     */
+    int NewId(const std::vector<double>& objectives) {
+        int m = static_cast<int>(objectives.size());
+        if (size_ == 0 && m != n_objectives_) {
+            clear();
+            n_objectives_ = m;
+        }
+        assert(m == n_objectives_);
+
+        int id;
+        if (free_ids_.empty()) {
+            id = static_cast<int>(ranks_.size());
+            ranks_.push_back(-1);
+            objectives_.resize(objectives_.size() + n_objectives_);
+        } else {
+            id = free_ids_.back();
+            free_ids_.pop_back();
+        }
+        std::copy(objectives.begin(), objectives.end(),
+                  objectives_.begin() + id * n_objectives_);
+        ++size_;
+        return id;
+    }
+
+    const double* Objectives(int id) const {
+        return &objectives_[id * n_objectives_];
+    }
+
+    /**
+     * The lexicographic order of objectives, the ties are broken by the ids.
+     */
+    bool Less(int a, int b) const {
+        const double* x = Objectives(a);
+        const double* y = Objectives(b);
+        for (int k = 0; k < n_objectives_; ++k) {
+            if (x[k] < y[k]) return true;
+            if (x[k] > y[k]) return false;
+        }
+        return a < b;
+    }
+
+    /**
+     * The position of id in the front.
+     */
+    int Position(const std::vector<int>& front, int id) const {
+        return static_cast<int>(
+                std::lower_bound(front.begin(), front.end(), id,
+                                 [this](int a, int b) {
+                                     return Less(a, b);
+                                 }) - front.begin());
+    }
+
+    void AddToFront(int id, int rank) {
+        if (rank >= static_cast<int>(fronts_.size())) {
+            fronts_.resize(rank + 1);
+        }
+        n_fronts_ = std::max(n_fronts_, rank + 1);
+
+        std::vector<int>& front = fronts_[rank];
+        front.insert(front.begin() + Position(front, id), id);
+        ranks_[id] = rank;
+    }
+
+    void RemoveFromFront(int id) {
+        std::vector<int>& front = fronts_[ranks_[id]];
+        int position = Position(front, id);
+        assert(position < static_cast<int>(front.size()) &&
+               front[position] == id);
+        front.erase(front.begin() + position);
+
+        while (n_fronts_ > 0 && fronts_[n_fronts_ - 1].empty()) {
+            --n_fronts_;
+        }
+    }
+
+    /**
+     * Return true if a member of front dominates the individual id.
+     */
+    bool HasDominator(const std::vector<int>& front, int id) {
+        const double* x = Objectives(id);
+        int position = Position(front, id);
+        if (n_objectives_ == 2) {
+            return position > 0 &&
+                   Dominance(Objectives(front[position - 1]), x) == 1;
+        }
+        for (int j = position - 1; j >= 0; --j) {
+            if (Dominance(Objectives(front[j]), x) == 1) return true;
+        }
+        return false;
+    }
+
+    /**
+     * Append the members of front dominated by the individual id.
+     */
+    void GetDominated(const std::vector<int>& front, int id,
+                      std::vector<int>* dominated) {
+        const double* x = Objectives(id);
+        int size = static_cast<int>(front.size());
+        int j = Position(front, id);
+        if (n_objectives_ == 2) {
+            // Skip the members equal to x, then take the run.
+            while (j < size && std::equal(x, x + 2, Objectives(front[j]))) {
+                ++j;
+            }
+            for (; j < size; ++j) {
+                if (Dominance(x, Objectives(front[j])) != 1) break;
+                dominated->push_back(front[j]);
+            }
+            return;
+        }
+        for (; j < size; ++j) {
+            if (Dominance(x, Objectives(front[j])) == 1) {
+                dominated->push_back(front[j]);
+            }
+        }
+    }
+
+    /**
+     * Remove the duplicated ids.
+     */
+    static void Unique(std::vector<int>* ids) {
+        std::sort(ids->begin(), ids->end());
+        ids->erase(std::unique(ids->begin(), ids->end()), ids->end());
+    }
+
+    /**
+     * The same as IndividualUtil::Dominance() for the stored objectives.
+     */
+    int Dominance(const double* a, const double* b) {
+        ++n_comparisons_;
+
+        bool better = false, worse = false;
+        for (int k = 0; k < n_objectives_; ++k) {
+            if (a[k] < b[k]) {
+                better = true;
+            } else if (a[k] > b[k]) {
+                worse = true;
+            }
+        }
+        if (better == worse) return 0;
+        return better ? 1 : -1;
+    }
+
+    int n_objectives_;                      // The number of objectives.
+    int size_;                              // The number of individuals.
+    std::vector<double> objectives_;        // The objectives of each id.
+    std::vector<int> ranks_;                // The rank of each id, or -1.
+    std::vector<int> free_ids_;             // The removed ids.
+    std::vector<std::vector<int> > fronts_; // The sorted ids of each front.
+    int n_fronts_;                          // The number of fronts.
+
+    std::vector<int> dominated_;            // The members to move.
+    std::vector<int> moved_;                // The members to move next.
+    int64_t n_comparisons_;                 // The dominance comparisons.
+};
+
+} // namespace moo
+
+#endif // SOLVER_UTIL_INCREMENTAL_NON_DOMINATED_SORT_H_
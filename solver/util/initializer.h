@@ -13,6 +13,7 @@
 #ifndef SOLVER_UTIL_INITIALIZER_H_
 #define SOLVER_UTIL_INITIALIZER_H_
 
+#include <algorithm>
 #include <ctime>
 #include <random>
 
@@ -36,6 +37,17 @@ public:
 
         srand(seed);
         std::mt19937 mt_random(seed);
+        Random(test, size_population, &mt_random, population);
+    }
+
+    /**
+     * Random initialize the population by the given random engine.
+     */
+    static void Random(const BasicTest& test, int size_population,
+                       std::mt19937* random, Population* population) {
+        assert(random);
+        assert(population);
+
         std::uniform_real_distribution<double> distribution(0, 1);
 
         population->resize(size_population);
@@ -47,7 +59,7 @@ public:
 
             (*population)[i].variables.resize(test.parameter.n_variables);
             for (int j = 0; j < test.parameter.n_variables; ++j) {
-                double t = distribution(mt_random);
+                double t = distribution(*random);
                 (*population)[i].variables[j] =
                         t * (test.parameter.max_variables[j] -
                              test.parameter.min_variables[j]) +
@@ -59,6 +71,39 @@ public:
         }
         PopulationUtil::SetObjectiveValues(test, population);
     }
+
+    /**
+     * Initialize the population by the first individuals of 'initial', which
+     * are already evaluated, and random ones for the rest.
+     *
+     * @return the number of evaluated random individuals.
+     */
+    static int Seeded(const BasicTest& test, const Population& initial,
+                      int size_population, std::mt19937* random,
+                      Population* population) {
+        assert(random);
+        assert(population);
+
+        int n = std::min(size_population, static_cast<int>(initial.size()));
+        population->clear();
+        if (n < size_population) {
+            Random(test, size_population - n, random, population);
+        }
+        population->insert(population->begin(), initial.begin(),
+                           initial.begin() + n);
+        for (int i = 0; i < n; ++i) {
+            assert((*population)[i].variables.size() ==
+                   size_t(test.parameter.n_variables));
+            assert((*population)[i].objectives.size() ==
+                   size_t(test.parameter.n_objectives));
+
+            (*population)[i].distance = 0.0;
+            (*population)[i].rank = 0;
+            (*population)[i].life = 0;
+            (*population)[i].constraints.resize(test.parameter.n_constraints);
+        }
+        return size_population - n;
+    }
 };
 
 } // namespace moo
@@ -0,0 +1,613 @@
+//
+// Copyright 2013 Yangbin Lin and Bili Chen. All Rights Reserved.
+//
+// Author: yblin.xmu@qq.com (Yangbin Lin)
+//
+// To use this code, please cite the follow paper:
+//
+// Chen B, Zeng W, Lin Y, et al. A New Local Search-Based Multiobjective
+// Optimization Algorithm[J]. IEEE Transactions on Evolutionary Computation,
+// 2014, 19(1):1-1.
+//
+
+#ifndef SOLVER_UTIL_NON_DOMINATED_ARCHIVE_H_
+#define SOLVER_UTIL_NON_DOMINATED_ARCHIVE_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <numeric>
+#include <vector>
+
+#include "codelibrary/base/macros.h"
+#include "codelibrary/util/common/arg_sort.h"
+#include "core/population.h"
+#include "solver/util/external_archive.h"
+
+namespace moo {
+
+/// Unbounded External Non-dominated Archive.
+/**
+ * NonDominatedArchive keeps every non-dominated individual inserted into it.
+ * An inserted individual is rejected if it is weakly dominated by the archive,
+ * otherwise it is added and all individuals dominated by it are removed.
+ *
+ * The archive is organized as an ND-tree. Each node keeps the bounds (the
+ * ideal and nadir points) of its subtree, so that most of the subtrees are
+ * accepted or rejected as a whole:
+ *   1. if the nadir point of a node weakly dominates y, y is rejected;
+ *   2. if y weakly dominates the ideal point, the whole node is removed;
+ *   3. if y is not comparable with the bounds, the node is skipped.
+ * The bounds are not shrunk after removals, they remain valid but looser.
+ *
+ * The individuals are stored in flat arrays of T, so the archive of millions
+ * of individuals may be kept in float to halve its memory and the traffic of
+ * the updates. An inserted individual is rounded to T first, and all
+ * comparisons and distances are computed in double on the rounded values, so
+ * the archive is always consistent with what it stores. The individuals whose
+ * objectives round to the same values are ties: the later one is weakly
+ * dominated and rejected. Export() returns the rounded values.
+ *
+ * Both precisions are ExternalArchive, so either may be kept by the solver.
+ *
+ * Reference:
+ *   Jaszkiewicz A, Lust T. ND-Tree-based update: a fast algorithm for the
+ *   dynamic non-dominance problem. IEEE Transactions on Evolutionary
+ *   Computation, 2018, 22(5): 778-791.
+ */
+template <typename T = double>
+class BasicNonDominatedArchive : public ExternalArchive {
+    // The node of ND-tree.
+    struct Node {
+        std::vector<T> ideal;      // The lower bounds of objectives.
+        std::vector<T> nadir;      // The upper bounds of objectives.
+        std::vector<int> children; // The children, empty for leaves.
+        std::vector<int> points;   // The slots of points in a leaf.
+        bool is_leaf;              // True if it is a leaf.
+    };
+
+public:
+    /**
+     * Create an empty archive. A leaf is split when it has more than
+     * 'max_leaf_size' points, into 'n_children' children (0 means the number
+     * of objectives plus 1).
+     */
+    explicit BasicNonDominatedArchive(int max_leaf_size = 20,
+                                      int n_children = 0)
+        : max_leaf_size_(max_leaf_size),
+          n_children_(n_children),
+          n_objectives_(0),
+          n_variables_(0),
+          n_constraints_(0),
+          size_(0),
+          root_(-1) {
+        assert(max_leaf_size_ > 1);
+        assert(n_children_ == 0 || n_children_ > 1);
+    }
+
+    /**
+     * Insert an individual into the archive.
+     *
+     * @return true if the individual is not weakly dominated by the archive,
+     *         and it is inserted.
+     */
+    bool Insert(const Individual& individual) {
+        if (n_objectives_ == 0) {
+            n_objectives_ = static_cast<int>(individual.objectives.size());
+            assert(n_objectives_ > 0);
+            if (n_children_ == 0) n_children_ = n_objectives_ + 1;
+            n_variables_ = static_cast<int>(individual.variables.size());
+            n_constraints_ = static_cast<int>(individual.constraints.size());
+        }
+        assert(individual.objectives.size() == size_t(n_objectives_));
+        assert(individual.variables.size() == size_t(n_variables_));
+        assert(individual.constraints.size() == size_t(n_constraints_));
+
+        point_.assign(individual.objectives.begin(),
+                      individual.objectives.end());
+        const T* y = point_.data();
+        if (root_ == -1) {
+            root_ = NewNode(y, true);
+        } else if (!Update(root_, y)) {
+            return false;
+        }
+
+        if (IsEmpty(root_)) {
+            // All points have been removed.
+            FreeNode(root_);
+            root_ = NewNode(y, true);
+        }
+
+        int slot = NewSlot(individual);
+        InsertPoint(root_, slot);
+        ++size_;
+        return true;
+    }
+
+    /**
+     * Insert a population, e.g., a whole generation.
+     *
+     * The individuals are inserted in increasing order of the sum of
+     * objectives. Since a dominating individual always has a smaller sum, no
+     * individual of the population is inserted and then removed by another.
+     *
+     * @return the number of inserted individuals.
+     */
+    virtual int Insert(const Population& population) {
+        std::vector<double> sums(population.size());
+        for (size_t i = 0; i < population.size(); ++i) {
+            sums[i] = std::accumulate(population[i].objectives.begin(),
+                                      population[i].objectives.end(), 0.0);
+        }
+        std::vector<int> order;
+        cl::ArgSort().Sort(sums, &order);
+
+        int n = 0;
+        for (int i : order) {
+            n += Insert(population[i]);
+        }
+        return n;
+    }
+
+    /**
+     * Check if the given objectives are weakly dominated by the archive.
+     */
+    bool IsDominated(const std::vector<double>& objectives) const {
+        assert(objectives.size() == size_t(n_objectives_) || size_ == 0);
+
+        if (size_ == 0) return false;
+        std::vector<T> y(objectives.begin(), objectives.end());
+        return IsDominated(root_, y.data());
+    }
+
+    /**
+     * Export all individuals in the archive.
+     */
+    virtual void Export(Population* population) const {
+        assert(population);
+
+        population->clear();
+        population->reserve(size_);
+        for (size_t i = 0; i < used_.size(); ++i) {
+            if (!used_[i]) continue;
+            population->resize(population->size() + 1);
+            GetIndividual(static_cast<int>(i), &population->back());
+        }
+    }
+
+    /**
+     * Export at most n individuals spread over the archive. Like
+     * FarthestCandidate, the extreme individuals of each objective are
+     * selected first, then the one farthest from the selected ones, until n
+     * individuals are selected.
+     */
+    void Export(int n, Population* population) const {
+        assert(population);
+        assert(n >= 0);
+
+        if (n >= size_) {
+            Export(population);
+            return;
+        }
+
+        std::vector<int> slots;
+        slots.reserve(size_);
+        for (size_t i = 0; i < used_.size(); ++i) {
+            if (used_[i]) slots.push_back(static_cast<int>(i));
+        }
+
+        std::vector<int> selected;
+        std::vector<double> distances(slots.size(), INFINITY);
+        std::vector<bool> flag(slots.size(), false);
+        for (int m = 0; m < n_objectives_ && int(selected.size()) < n; ++m) {
+            int min_index = 0, max_index = 0;
+            for (size_t i = 1; i < slots.size(); ++i) {
+                if (Objective(slots[i], m) < Objective(slots[min_index], m)) {
+                    min_index = static_cast<int>(i);
+                }
+                if (Objective(slots[i], m) > Objective(slots[max_index], m)) {
+                    max_index = static_cast<int>(i);
+                }
+            }
+            if (!flag[min_index] && int(selected.size()) < n) {
+                Select(slots, min_index, &flag, &selected, &distances);
+            }
+            if (!flag[max_index] && int(selected.size()) < n) {
+                Select(slots, max_index, &flag, &selected, &distances);
+            }
+        }
+
+        while (int(selected.size()) < n) {
+            int best = -1;
+            for (size_t i = 0; i < slots.size(); ++i) {
+                if (!flag[i] && (best == -1 || distances[i] > distances[best])) {
+                    best = static_cast<int>(i);
+                }
+            }
+            assert(best != -1);
+
+            Select(slots, best, &flag, &selected, &distances);
+        }
+
+        population->resize(n);
+        for (int i = 0; i < n; ++i) {
+            GetIndividual(slots[selected[i]], &(*population)[i]);
+        }
+    }
+
+    /**
+     * Remove all individuals.
+     */
+    virtual void clear() {
+        nodes_.clear();
+        free_nodes_.clear();
+        objectives_.clear();
+        variables_.clear();
+        constraints_.clear();
+        ranks_.clear();
+        distances_.clear();
+        lives_.clear();
+        used_.clear();
+        free_slots_.clear();
+        size_ = 0;
+        root_ = -1;
+    }
+
+    bool empty()                      const { return size_ == 0; }
+    int size()                        const { return size_;      }
+
+private:
+    /**
+     * Remove the points in node dominated by y.
+     *
+     * @return false if y is weakly dominated by a point in node.
+     */
+    bool Update(int node, const T* y) {
+        Node& n = nodes_[node];
+        if (WeaklyDominates(n.nadir.data(), y)) return false;
+
+        if (WeaklyDominates(y, n.ideal.data())) {
+            // The whole subtree is dominated by y.
+            RemoveSubtree(node);
+            return true;
+        }
+
+        if (!WeaklyDominates(y, n.nadir.data()) &&
+            !WeaklyDominates(n.ideal.data(), y)) {
+            return true;
+        }
+
+        if (n.is_leaf) {
+            std::vector<int>& points = nodes_[node].points;
+            for (size_t i = 0; i < points.size();) {
+                const T* p = &objectives_[points[i] * n_objectives_];
+                if (WeaklyDominates(p, y)) return false;
+
+                if (WeaklyDominates(y, p)) {
+                    FreeSlot(points[i]);
+                    points[i] = points.back();
+                    points.pop_back();
+                } else {
+                    ++i;
+                }
+            }
+        } else {
+            for (size_t i = 0; i < nodes_[node].children.size();) {
+                int child = nodes_[node].children[i];
+                if (!Update(child, y)) return false;
+
+                std::vector<int>& children = nodes_[node].children;
+                if (IsEmpty(child)) {
+                    FreeNode(child);
+                    children[i] = children.back();
+                    children.pop_back();
+                } else {
+                    ++i;
+                }
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Check if y is weakly dominated by a point in node.
+     */
+    bool IsDominated(int node, const T* y) const {
+        const Node& n = nodes_[node];
+        if (WeaklyDominates(n.nadir.data(), y)) return true;
+        if (!WeaklyDominates(n.ideal.data(), y)) return false;
+
+        if (n.is_leaf) {
+            for (int slot : n.points) {
+                if (WeaklyDominates(&objectives_[slot * n_objectives_], y)) {
+                    return true;
+                }
+            }
+        } else {
+            for (int child : n.children) {
+                if (IsDominated(child, y)) return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Insert the point in slot into the subtree of node.
+     */
+    void InsertPoint(int node, int slot) {
+        const T* y = &objectives_[slot * n_objectives_];
+        while (true) {
+            UpdateBounds(node, y);
+            if (nodes_[node].is_leaf) break;
+
+            // Go to the child whose center is the closest to y.
+            int best = -1;
+            double min_distance = INFINITY;
+            for (int child : nodes_[node].children) {
+                double d = CenterDistance(child, y);
+                if (d < min_distance) {
+                    min_distance = d;
+                    best = child;
+                }
+            }
+            node = best;
+        }
+
+        nodes_[node].points.push_back(slot);
+        if (static_cast<int>(nodes_[node].points.size()) > max_leaf_size_) {
+            Split(node);
+        }
+    }
+
+    /**
+     * Split a leaf into n_children_ children. The first child starts from the
+     * point with the highest average distance to the other points, and each
+     * following child from the point with the highest average distance to the
+     * starting points of the existing children. The remaining points are then
+     * added to the closest children.
+     */
+    void Split(int node) {
+        std::vector<int> points;
+        points.swap(nodes_[node].points);
+        int n = static_cast<int>(points.size());
+
+        std::vector<double> sum(n, 0.0);
+        for (int i = 0; i < n; ++i) {
+            for (int j = i + 1; j < n; ++j) {
+                double d = PointDistance(points[i], points[j]);
+                sum[i] += d;
+                sum[j] += d;
+            }
+        }
+
+        int n_children = std::min(n_children_, n);
+        std::vector<bool> used(n, false);
+        std::vector<int> children;
+        int seed = static_cast<int>(std::max_element(sum.begin(), sum.end()) -
+                                    sum.begin());
+        std::fill(sum.begin(), sum.end(), 0.0);
+        while (true) {
+            used[seed] = true;
+            children.push_back(NewNode(&objectives_[points[seed] *
+                                                    n_objectives_], true));
+            nodes_[children.back()].points.push_back(points[seed]);
+            if (static_cast<int>(children.size()) == n_children) break;
+
+            // The average distance to the seeds.
+            seed = -1;
+            for (int i = 0; i < n; ++i) {
+                if (used[i]) continue;
+                sum[i] += PointDistance(points[i],
+                                        nodes_[children.back()].points[0]);
+                if (seed == -1 || sum[i] > sum[seed]) seed = i;
+            }
+        }
+
+        for (int i = 0; i < n; ++i) {
+            if (used[i]) continue;
+
+            const T* y = &objectives_[points[i] * n_objectives_];
+            int best = children[0];
+            double min_distance = INFINITY;
+            for (int child : children) {
+                double d = CenterDistance(child, y);
+                if (d < min_distance) {
+                    min_distance = d;
+                    best = child;
+                }
+            }
+            UpdateBounds(best, y);
+            nodes_[best].points.push_back(points[i]);
+        }
+
+        nodes_[node].is_leaf = false;
+        nodes_[node].children = children;
+    }
+
+    /**
+     * Remove all points and nodes in the subtree of node, except the node
+     * itself, which becomes an empty leaf.
+     */
+    void RemoveSubtree(int node) {
+        std::vector<int> children;
+        children.swap(nodes_[node].children);
+        for (int child : children) {
+            RemoveSubtree(child);
+            FreeNode(child);
+        }
+        for (int slot : nodes_[node].points) {
+            FreeSlot(slot);
+        }
+        nodes_[node].points.clear();
+        nodes_[node].is_leaf = true;
+    }
+
+    bool IsEmpty(int node) const {
+        return nodes_[node].is_leaf ? nodes_[node].points.empty()
+                                    : nodes_[node].children.empty();
+    }
+
+    void UpdateBounds(int node, const T* y) {
+        Node& n = nodes_[node];
+        for (int i = 0; i < n_objectives_; ++i) {
+            n.ideal[i] = std::min(n.ideal[i], y[i]);
+            n.nadir[i] = std::max(n.nadir[i], y[i]);
+        }
+    }
+
+    /**
+     * The squared distance from y to the center of node's bounds.
+     */
+    double CenterDistance(int node, const T* y) const {
+        const Node& n = nodes_[node];
+        double d = 0.0;
+        for (int i = 0; i < n_objectives_; ++i) {
+            double t = 0.5 * (double(n.ideal[i]) + n.nadir[i]) - y[i];
+            d += t * t;
+        }
+        return d;
+    }
+
+    double PointDistance(int slot1, int slot2) const {
+        const T* a = &objectives_[slot1 * n_objectives_];
+        const T* b = &objectives_[slot2 * n_objectives_];
+        double d = 0.0;
+        for (int i = 0; i < n_objectives_; ++i) {
+            double t = double(a[i]) - b[i];
+            d += t * t;
+        }
+        return std::sqrt(d);
+    }
+
+    double Objective(int slot, int m) const {
+        return objectives_[slot * n_objectives_ + m];
+    }
+
+    /**
+     * Select slots[index] for Export and update the distances.
+     */
+    void Select(const std::vector<int>& slots, int index,
+                std::vector<bool>* flag, std::vector<int>* selected,
+                std::vector<double>* distances) const {
+        (*flag)[index] = true;
+        selected->push_back(index);
+        for (size_t i = 0; i < slots.size(); ++i) {
+            if ((*flag)[i]) continue;
+            (*distances)[i] = std::min((*distances)[i],
+                                       PointDistance(slots[i], slots[index]));
+        }
+    }
+
+    /**
+     * Return true if a is less than or equal to b in all objectives.
+     */
+    bool WeaklyDominates(const T* a, const T* b) const {
+        for (int i = 0; i < n_objectives_; ++i) {
+            if (a[i] > b[i]) return false;
+        }
+        return true;
+    }
+
+    int NewNode(const T* y, bool is_leaf) {
+        int node;
+        if (free_nodes_.empty()) {
+            node = static_cast<int>(nodes_.size());
+            nodes_.push_back(Node());
+        } else {
+            node = free_nodes_.back();
+            free_nodes_.pop_back();
+        }
+
+        Node& n = nodes_[node];
+        n.ideal.assign(y, y + n_objectives_);
+        n.nadir.assign(y, y + n_objectives_);
+        n.children.clear();
+        n.points.clear();
+        n.is_leaf = is_leaf;
+        return node;
+    }
+
+    void FreeNode(int node) {
+        free_nodes_.push_back(node);
+    }
+
+    int NewSlot(const Individual& individual) {
+        int slot;
+        if (free_slots_.empty()) {
+            slot = static_cast<int>(used_.size());
+            objectives_.resize(objectives_.size() + n_objectives_);
+            variables_.resize(variables_.size() + n_variables_);
+            constraints_.resize(constraints_.size() + n_constraints_);
+            ranks_.push_back(0);
+            distances_.push_back(0.0);
+            lives_.push_back(0);
+            used_.push_back(true);
+        } else {
+            slot = free_slots_.back();
+            free_slots_.pop_back();
+            used_[slot] = true;
+        }
+        std::copy(point_.begin(), point_.end(),
+                  objectives_.begin() + slot * n_objectives_);
+        std::copy(individual.variables.begin(), individual.variables.end(),
+                  variables_.begin() + slot * n_variables_);
+        std::copy(individual.constraints.begin(),
+                  individual.constraints.end(),
+                  constraints_.begin() + slot * n_constraints_);
+        ranks_[slot] = individual.rank;
+        distances_[slot] = individual.distance;
+        lives_[slot] = individual.life;
+        return slot;
+    }
+
+    /**
+     * Get the individual in slot, widened to double.
+     */
+    void GetIndividual(int slot, Individual* individual) const {
+        const T* y = &objectives_[slot * n_objectives_];
+        const T* x = &variables_[slot * n_variables_];
+        const T* c = &constraints_[slot * n_constraints_];
+        individual->objectives.assign(y, y + n_objectives_);
+        individual->variables.assign(x, x + n_variables_);
+        individual->constraints.assign(c, c + n_constraints_);
+        individual->rank = ranks_[slot];
+        individual->distance = distances_[slot];
+        individual->life = lives_[slot];
+    }
+
+    void FreeSlot(int slot) {
+        used_[slot] = false;
+        free_slots_.push_back(slot);
+        --size_;
+    }
+
+    int max_leaf_size_; // The maximum number of points in a leaf.
+    int n_children_;    // The number of children of an internal node.
+    int n_objectives_;  // The number of objectives, 0 if unknown.
+    int n_variables_;   // The number of variables.
+    int n_constraints_; // The number of constraints.
+    int size_;          // The number of individuals in the archive.
+
+    std::vector<Node> nodes_;      // The nodes of ND-tree.
+    std::vector<int> free_nodes_;  // The unused nodes.
+    int root_;                     // The root of ND-tree, -1 if no node.
+
+    std::vector<T> objectives_;      // The objectives by slots.
+    std::vector<T> variables_;       // The variables by slots.
+    std::vector<T> constraints_;     // The constraints by slots.
+    std::vector<int> ranks_;         // The ranks by slots.
+    std::vector<double> distances_;  // The distances by slots.
+    std::vector<int> lives_;         // The lives by slots.
+    std::vector<bool> used_;         // True if the slot is used.
+    std::vector<int> free_slots_;    // The unused slots.
+    std::vector<T> point_;           // The rounded objectives being inserted.
+
+    DISALLOW_COPY_AND_ASSIGN(BasicNonDominatedArchive);
+};
+
+typedef BasicNonDominatedArchive<double> NonDominatedArchive;
+typedef BasicNonDominatedArchive<float> FloatNonDominatedArchive;
+
+} // namespace moo
+
+#endif // SOLVER_UTIL_NON_DOMINATED_ARCHIVE_H_
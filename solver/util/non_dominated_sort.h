@@ -9,9 +9,14 @@
 #ifndef SOLVER_UTIL_NON_DOMINATED_SORT_H_
 #define SOLVER_UTIL_NON_DOMINATED_SORT_H_
 
+#include <algorithm>
+#include <cassert>
+#include <climits>
+#include <cstdint>
 #include <queue>
+#include <vector>
 
-#include "codelibrary/util/list/adjacency_list.h"
+#include "codelibrary/util/list/compressed_adjacency_list.h"
 
 #include "core/population.h"
 #include "solver/util/individual_util.h"
@@ -21,28 +26,46 @@ namespace moo {
 /**
  * Perfrom non-dominated sort for given population.
  */
-static void NonDominatedSort(const Population& population,
+inline void NonDominatedSort(const Population& population,
                              std::vector<Population>* fronts) {
-    // The indegrees of every individuals in the adjacency list.
-    std::vector<int> indegrees(population.size(), 0);
+    int n = static_cast<int>(population.size());
 
-    cl::AdjacencyList list(population.size());
+    // The indegrees of every individuals in the adjacency list.
+    std::vector<int> indegrees(n, 0);
 
-    for (size_t i = 0; i < population.size(); ++i) {
-        for (size_t j = i + 1; j < population.size(); ++j) {
-            if (i == j) continue;
+    // The dominance of each pair (i, j), i < j, is kept in a byte, so the
+    // edges are counted in the first pass and stored in the second one without
+    // comparing the individuals again.
+    std::vector<int8_t> dominances(static_cast<size_t>(n) * (n - 1) / 2 + 1);
+    cl::CompressedAdjacencyList list(n);
+    size_t pair = 0;
+    for (int i = 0; i < n; ++i) {
+        for (int j = i + 1; j < n; ++j, ++pair) {
             int dominance = IndividualUtil::Dominance(population[i],
                                                       population[j]);
+            dominances[pair] = static_cast<int8_t>(dominance);
             if (dominance == 1) {
-                list.InsertOneWayEdge(i, j);
+                list.CountEdge(i);
                 ++indegrees[j];
             } else if (dominance == -1) {
-                list.InsertOneWayEdge(j, i);
+                list.CountEdge(j);
                 ++indegrees[i];
             }
         }
     }
 
+    list.Allocate();
+    pair = 0;
+    for (int i = 0; i < n; ++i) {
+        for (int j = i + 1; j < n; ++j, ++pair) {
+            if (dominances[pair] == 1) {
+                list.InsertOneWayEdge(i, j);
+            } else if (dominances[pair] == -1) {
+                list.InsertOneWayEdge(j, i);
+            }
+        }
+    }
+
     // Topological sorting to get every non-dominated fronts.
     std::vector<int> rank(population.size(), 0); // The rank of individuals.
 
@@ -57,7 +80,8 @@ static void NonDominatedSort(const Population& population,
         int node = queue.front();
         queue.pop();
 
-        for (const cl::AdjacencyList::Edge& e : list.edge_list(node)) {
+        for (const cl::CompressedAdjacencyList::Edge& e :
+                 list.edge_list(node)) {
             --indegrees[e.target()];
             if (indegrees[e.target()] == 0) {
                 queue.push(e.target());
@@ -77,6 +101,182 @@ static void NonDominatedSort(const Population& population,
     }
 }
 
+/**
+ * Build the fronts from the ranks of individuals, the individuals with
+ * negative ranks (not ranked) are ignored. If n >= 0, only the first fronts
+ * that cover n individuals are built.
+ *
+ * It works for the ranks of any sorting engine, the individuals in each front
+ * keep the order of population.
+ *
+ * @return the number of fronts taken whole, i.e., it is fronts->size() - 1 if
+ *         the last front must be split to select exactly n individuals.
+ */
+inline int SplitFronts(const Population& population,
+                       const std::vector<int>& ranks, int n,
+                       std::vector<Population>* fronts) {
+    assert(fronts);
+    assert(ranks.size() == population.size());
+
+    int n_fronts = 0;
+    for (size_t i = 0; i < ranks.size(); ++i) {
+        n_fronts = std::max(n_fronts, ranks[i] + 1);
+    }
+    std::vector<int> sizes(n_fronts, 0);
+    for (size_t i = 0; i < ranks.size(); ++i) {
+        if (ranks[i] >= 0) ++sizes[ranks[i]];
+    }
+
+    // Cut the fronts after the one that covers n individuals.
+    int n_whole = n_fronts;
+    if (n == 0) {
+        n_fronts = n_whole = 0;
+    } else if (n > 0) {
+        int count = 0;
+        for (int k = 0; k < n_fronts; ++k) {
+            count += sizes[k];
+            if (count >= n) {
+                n_fronts = k + 1;
+                n_whole = count == n ? n_fronts : k;
+                break;
+            }
+        }
+    }
+
+    fronts->resize(n_fronts);
+    for (int k = 0; k < n_fronts; ++k) {
+        (*fronts)[k].clear();
+        (*fronts)[k].reserve(sizes[k]);
+    }
+    for (size_t i = 0; i < population.size(); ++i) {
+        if (ranks[i] >= 0 && ranks[i] < n_fronts) {
+            (*fronts)[ranks[i]].push_back(population[i]);
+        }
+    }
+    return n_whole;
+}
+
+/**
+ * Compute the ranks of individuals by the efficient non-dominated sort with
+ * sequential search (ENS-SS).
+ *
+ * The individuals are visited in lexicographic order of objectives, so an
+ * individual can only be dominated by the ones visited before it, and its rank
+ * is the first front that has no member dominating it. The rank is final when
+ * it is assigned.
+ *
+ * If n >= 0, the sort stops peeling at the first fronts that cover n
+ * individuals: a later individual is only compared with these fronts, and it
+ * gets rank -1 if all of them dominate it, since its rank must be larger.
+ */
+inline void NonDominatedRanks(const Population& population, int n,
+                              std::vector<int>* ranks) {
+    assert(ranks);
+
+    int size = static_cast<int>(population.size());
+    ranks->assign(size, -1);
+    if (size == 0 || n == 0) return;
+
+    int m = static_cast<int>(population[0].objectives.size());
+    std::vector<const double*> objectives(size);
+    for (int i = 0; i < size; ++i) {
+        assert(static_cast<int>(population[i].objectives.size()) == m);
+        objectives[i] = population[i].objectives.data();
+    }
+
+    // Ties are broken by the index, so the order is deterministic.
+    std::vector<int> orders(size);
+    for (int i = 0; i < size; ++i) {
+        orders[i] = i;
+    }
+    std::sort(orders.begin(), orders.end(), [&](int a, int b) {
+        const double* x = objectives[a];
+        const double* y = objectives[b];
+        for (int k = 0; k < m; ++k) {
+            if (x[k] < y[k]) return true;
+            if (x[k] > y[k]) return false;
+        }
+        return a < b;
+    });
+
+    std::vector<std::vector<int> > fronts;
+    std::vector<int> sizes; // The prefix sums of the sizes of fronts.
+    int n_limit = INT_MAX;  // The number of fronts that cover n.
+    for (int i : orders) {
+        const double* x = objectives[i];
+        int n_fronts = std::min(static_cast<int>(fronts.size()), n_limit);
+
+        int rank = 0;
+        for (; rank < n_fronts; ++rank) {
+            // The members are checked from the last one, which is the most
+            // similar to x.
+            const std::vector<int>& front = fronts[rank];
+            bool dominated = false;
+            for (int j = static_cast<int>(front.size()) - 1; j >= 0; --j) {
+                // y precedes x, so y dominates x if y <= x and y != x.
+                const double* y = objectives[front[j]];
+                bool less_equal = true, less = false;
+                for (int k = 0; k < m; ++k) {
+                    if (y[k] > x[k]) {
+                        less_equal = false;
+                        break;
+                    }
+                    if (y[k] < x[k]) less = true;
+                }
+                if (less_equal && less) {
+                    dominated = true;
+                    break;
+                }
+            }
+            if (!dominated) break;
+        }
+        if (rank == n_limit) continue;
+
+        if (rank == static_cast<int>(fronts.size())) {
+            fronts.push_back(std::vector<int>());
+            sizes.push_back(rank == 0 ? 0 : sizes.back());
+        }
+        fronts[rank].push_back(i);
+        (*ranks)[i] = rank;
+
+        if (n >= 0) {
+            // Only the prefix sums from the rank are changed.
+            int n_sizes = static_cast<int>(sizes.size());
+            for (int k = rank; k < n_sizes; ++k) {
+                ++sizes[k];
+            }
+            for (int k = rank; k < std::min(n_limit, n_sizes); ++k) {
+                if (sizes[k] >= n) {
+                    n_limit = k + 1;
+                    break;
+                }
+            }
+        }
+    }
+
+    // The ranks after the limit may be assigned before the limit decreased.
+    for (int i = 0; i < size; ++i) {
+        if ((*ranks)[i] >= n_limit) (*ranks)[i] = -1;
+    }
+}
+
+/**
+ * Partial non-dominated sort: peel the fronts only until they cover n
+ * individuals, and skip the dominated remainder.
+ *
+ * @return the number of fronts taken whole; if it is less than
+ *         fronts->size(), the last front must be split.
+ */
+inline int NonDominatedSort(const Population& population, int n,
+                            std::vector<Population>* fronts) {
+    assert(fronts);
+    assert(n >= 0);
+
+    std::vector<int> ranks;
+    NonDominatedRanks(population, n, &ranks);
+    return SplitFronts(population, ranks, n, fronts);
+}
+
 } // namespace moo
 
 #endif // SOLVER_UTIL_NON_DOMINATED_SORTING_H_
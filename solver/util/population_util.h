@@ -13,11 +13,13 @@
 #ifndef SOLVER_UTIL_POPULATION_UTIL_H_
 #define SOLVER_UTIL_POPULATION_UTIL_H_
 
-#include <cfloat>
+#include <algorithm>
+#include <vector>
 
-#include "codelibrary/util/common/sequence.h"
+#include "codelibrary/util/array/array_2d.h"
 
 #include "test/basic_test.h"
+#include "solver/util/crowding_distance.h"
 #include "solver/util/individual_util.h"
 #include "core/population.h"
 
@@ -27,17 +29,77 @@ namespace moo {
 class PopulationUtil {
 public:
     /**
-     * Set the objectives' values for population.
+     * Set the objectives' values for population. The population is evaluated
+     * as one batch if the test has a batch evaluator.
      */
     static void SetObjectiveValues(const BasicTest& test,
                                    Population* population) {
         assert(population);
 
+        if (test.has_batch_evaluator()) {
+            cl::Array2D<double> variables, objectives;
+            GetVariables(*population, &variables);
+            test.batch_evaluator->Evaluate(variables, &objectives);
+            int m = objectives.columns();
+            for (size_t i = 0; i < population->size(); ++i) {
+                const double* row = objectives.data().data() + i * m;
+                (*population)[i].objectives.assign(row, row + m);
+            }
+            return;
+        }
+
         for (size_t i = 0; i < population->size(); ++i) {
             IndividualUtil::SetObjectives(test.objectives, &(*population)[i]);
         }
     }
 
+    /**
+     * Evaluate a batch of individuals, one per row of 'variables'. The
+     * objectives are stored in the same rows of 'objectives'.
+     */
+    static void SetObjectiveValues(const BasicTest& test,
+                                   const cl::Array2D<double>& variables,
+                                   cl::Array2D<double>* objectives) {
+        assert(objectives);
+        assert(variables.columns() == test.parameter.n_variables ||
+               variables.empty());
+
+        if (test.has_batch_evaluator()) {
+            test.batch_evaluator->Evaluate(variables, objectives);
+            return;
+        }
+
+        int n = variables.rows();
+        int d = variables.columns();
+        int m = test.parameter.n_objectives;
+        objectives->Resize(n, m);
+
+        std::vector<double> x(d);
+        for (int i = 0; i < n; ++i) {
+            std::copy_n(variables.data().begin() + i * d, d, x.begin());
+            for (int j = 0; j < m; ++j) {
+                (*objectives)(i, j) = (test.objectives[j])(x);
+            }
+        }
+    }
+
+    /**
+     * Get the variables of population, one individual per row.
+     */
+    static void GetVariables(const Population& population,
+                             cl::Array2D<double>* variables) {
+        assert(variables);
+
+        int n = static_cast<int>(population.size());
+        int d = n == 0 ? 0 : static_cast<int>(population[0].variables.size());
+        variables->Resize(n, d);
+        for (int i = 0; i < n; ++i) {
+            std::copy(population[i].variables.begin(),
+                      population[i].variables.end(),
+                      variables->data().begin() + i * d);
+        }
+    }
+
     /**
      * Set the constraints' values for population.
      */
@@ -71,43 +133,18 @@ public:
     }
 
     /**
-     * Set the crowding distance for each individual in population.
+     * Set the crowding distance for each individual in population. Both the
+     * minimum and the maximum individuals of each objective get INFINITY, see
+     * CrowdingDistance.
      */
     static void SetCrowdingDistance(const BasicTest& test,
                                     Population* population) {
-        for (size_t i = 0; i < population->size(); ++i) {
-            (*population)[i].distance = 0.0;
-        }
-
-        if (population->size() > 2) {
-            for (int m = 0; m < test.parameter.n_objectives; ++m) {
-                // Sorting population by m-th objective value.
-                std::vector<double> objectives(population->size());
-                for (size_t i = 0; i < population->size(); ++i) {
-                    objectives[i] = (*population)[i].objectives[m];
-                }
-
-                cl::Sequence<double> seq(objectives);
-
-                for (size_t i = 1; i < population->size() - 1; ++i) {
-                    double delt = objectives[seq[i + 1]] -
-                                  objectives[seq[i - 1]];
-                    (*population)[seq[i]].distance += delt;
-                }
-            }
-        }
+        assert(population);
+        assert(population->empty() || (*population)[0].objectives.size() ==
+               size_t(test.parameter.n_objectives));
 
-        // Set the distance of boundary individualto INFINITY.
-        for (int m = 0; m < test.parameter.n_objectives; ++m) {
-            int min_index = 0;
-            for (size_t i = 1; i < population->size(); ++i) {
-                if ((*population)[i].objectives[m] <
-                    (*population)[min_index].objectives[m]) {
-                    min_index = i;
-                }
-            }
-            (*population)[min_index].distance = INFINITY;
-        }
+        static thread_local CrowdingDistance crowding_distance;
+        crowding_distance(population);
     }
 };
 
@@ -0,0 +1,570 @@
+//
+// Copyright 2013 Yangbin Lin and Bili Chen. All Rights Reserved.
+//
+// Author: yblin.xmu@qq.com (Yangbin Lin)
+//
+// To use this code, please cite the follow paper:
+//
+// Chen B, Zeng W, Lin Y, et al. A New Local Search-Based Multiobjective
+// Optimization Algorithm[J]. IEEE Transactions on Evolutionary Computation,
+// 2014, 19(1):1-1.
+//
+
+#ifndef SOLVER_UTIL_PROCESS_POOL_EVALUATOR_H_
+#define SOLVER_UTIL_PROCESS_POOL_EVALUATOR_H_
+
+#ifndef _WIN32
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <ctime>
+#include <functional>
+#include <new>
+#include <vector>
+
+#include <semaphore.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/prctl.h>
+#endif
+
+#include "codelibrary/base/macros.h"
+#include "codelibrary/util/array/array_2d.h"
+#include "core/batch_evaluator.h"
+#include "test/basic_test.h"
+
+namespace moo {
+
+/// Process Pool Evaluator.
+/**
+ * It evaluates the objectives in N local worker processes, for the objectives
+ * that can not run in process, e.g., the wrappers of external simulators that
+ * crash or leak memory.
+ *
+ * The candidates and the results are exchanged through a ring of slots in an
+ * anonymous shared mapping: the parent writes the variables of a candidate
+ * into a free slot and marks it ready, a worker claims the slot by a
+ * compare-and-swap, evaluates it and writes the objectives into the same slot.
+ * Two process-shared semaphores count the ready and the done slots, so no
+ * data goes through pipes and nothing is serialized.
+ *
+ * Since a slot is claimed by the state that holds the worker's index, the
+ * parent knows which candidates a dead worker had. When the parent waits too
+ * long for a result, or every 'capacity' results, it reaps the dead workers,
+ * puts their candidates back, and forks new workers. A candidate that kills
+ * the workers 'max_attempts' times gets the objectives HUGE_VAL, so it is
+ * dominated by any evaluated individual. Optionally, a worker is recycled
+ * after a number of evaluations (to bound the leaks), and killed if an
+ * evaluation exceeds a timeout.
+ *
+ * The workers are forked from the parent, so the function and its data are
+ * inherited without serialization. Like any fork, it should not be done while
+ * other threads of the parent hold locks (e.g., in malloc), so create the pool
+ * before starting other threads. If the processes can not be created, the
+ * candidates are evaluated in process. So are they if all workers died and can
+ * not be forked again (e.g., the limit of processes is reached), and they are
+ * counted by n_failures().
+ *
+ * Usage:
+ *    ProcessPoolEvaluator evaluator(test, 8);
+ *    test.batch_evaluator = &evaluator;
+ *    ... PopulationUtil::SetObjectiveValues(test, population) ...
+ */
+class ProcessPoolEvaluator : public BatchEvaluator {
+    // The states of a slot, a claimed slot has the state CLAIMED + worker.
+    static const int FREE    = 0;
+    static const int READY   = 1;
+    static const int DONE    = 2;
+    static const int CLAIMED = 3;
+
+    // The time (in milliseconds) to wait for a result before checking the
+    // workers.
+    static const int WAIT_MILLISECONDS = 10;
+
+    // The consecutive failed forks before the ready candidates are evaluated
+    // in process, when no worker is alive.
+    static const int MAX_FAILED_STARTS = 100;
+
+    /// The header of the shared memory.
+    struct Header {
+        sem_t ready; // The number of ready slots (may be more).
+        sem_t done;  // The number of done slots (may be more).
+        std::atomic<int> max_evaluations; // Recycle the workers, 0 for never.
+    };
+
+    /// The header of a slot, followed by the variables and the objectives.
+    struct Slot {
+        std::atomic<int> state;
+        std::atomic<int64_t> start; // The claimed time, 0 if not started.
+        int row;                    // The row in the batch (parent only).
+        int attempts;               // The failed attempts (parent only).
+    };
+
+public:
+    /**
+     * The objective function run by the workers.
+     */
+    typedef std::function<void(const std::vector<double>& variables,
+                               std::vector<double>* objectives)> Function;
+
+    /**
+     * Evaluate the objectives of test by 'n_workers' processes, 0 for the
+     * number of processors. 'capacity' is the number of slots, 0 for twice the
+     * number of workers.
+     */
+    explicit ProcessPoolEvaluator(const BasicTest& test, int n_workers = 0,
+                                  int capacity = 0) {
+        assert(test.objectives.size() ==
+               static_cast<size_t>(test.parameter.n_objectives) &&
+               "The test has no objective functions, e.g., a PluginTest");
+
+        std::vector<Objective> objectives = test.objectives;
+        Function function = [objectives](const std::vector<double>& x,
+                                         std::vector<double>* f) {
+            for (size_t j = 0; j < objectives.size(); ++j) {
+                (*f)[j] = (objectives[j])(x);
+            }
+        };
+        Initialize(test.parameter.n_variables, test.parameter.n_objectives,
+                   function, n_workers, capacity);
+    }
+
+    ProcessPoolEvaluator(int n_variables, int n_objectives,
+                         const Function& function, int n_workers = 0,
+                         int capacity = 0) {
+        Initialize(n_variables, n_objectives, function, n_workers, capacity);
+    }
+
+    virtual ~ProcessPoolEvaluator() {
+        Shutdown();
+    }
+
+    /**
+     * Evaluate the individuals, one per row of 'variables'.
+     */
+    virtual void Evaluate(const cl::Array2D<double>& variables,
+                          cl::Array2D<double>* objectives) {
+        assert(objectives);
+        assert(variables.columns() == n_variables_ || variables.empty());
+
+        int n = variables.rows();
+        objectives->Resize(n, n_objectives_);
+        if (n == 0) return;
+
+        if (!memory_) {
+            EvaluateInProcess(variables, objectives);
+            return;
+        }
+
+        int next = 0, n_done = 0, n_unchecked = 0;
+        for (int s = 0; s < capacity_ && next < n; ++s) {
+            Submit(s, next++, variables);
+        }
+        while (n_done < n) {
+            bool woken = WaitDone();
+            for (int s = 0; s < capacity_; ++s) {
+                Slot* slot = GetSlot(s);
+                if (slot->state.load(std::memory_order_acquire) != DONE) {
+                    continue;
+                }
+                const double* f = SlotObjectives(s);
+                std::copy(f, f + n_objectives_,
+                          objectives->data().begin() +
+                          slot->row * n_objectives_);
+                slot->state.store(FREE, std::memory_order_relaxed);
+                ++n_done;
+                ++n_unchecked;
+                if (next < n) Submit(s, next++, variables);
+            }
+            if (!woken || n_unchecked >= capacity_) {
+                CheckWorkers();
+                n_unchecked = 0;
+            }
+        }
+        n_evaluations_ += n;
+    }
+
+    /**
+     * The number of attempts of a candidate before it is given up.
+     */
+    void set_max_attempts(int max_attempts) {
+        assert(max_attempts > 0);
+
+        max_attempts_ = max_attempts;
+    }
+
+    /**
+     * Restart each worker after the given number of evaluations, 0 for never.
+     */
+    void set_max_evaluations_per_worker(int n) {
+        assert(n >= 0);
+
+        if (memory_) header()->max_evaluations.store(n);
+    }
+
+    /**
+     * Kill the worker if an evaluation takes longer than the given seconds, 0
+     * for no limit. The candidate counts as a failed attempt.
+     */
+    void set_timeout(double seconds) {
+        assert(seconds >= 0.0);
+
+        timeout_ = static_cast<int64_t>(seconds * 1e9);
+    }
+
+    int n_workers()       const { return static_cast<int>(pids_.size()); }
+    int capacity()        const { return capacity_;      }
+    int64_t n_evaluations() const { return n_evaluations_; }
+    int n_restarts()      const { return n_restarts_;    }
+
+    /**
+     * The number of candidates not evaluated by a worker, i.e., given up after
+     * 'max_attempts', or evaluated in process since no worker could be forked.
+     */
+    int n_failures()      const { return n_failures_;    }
+
+private:
+    void Initialize(int n_variables, int n_objectives,
+                    const Function& function, int n_workers, int capacity) {
+        assert(n_variables > 0);
+        assert(n_objectives > 0);
+        assert(n_workers >= 0);
+        assert(capacity >= 0);
+
+        n_variables_ = n_variables;
+        n_objectives_ = n_objectives;
+        function_ = function;
+        if (n_workers == 0) {
+            n_workers = std::max(1, static_cast<int>(
+                                 sysconf(_SC_NPROCESSORS_ONLN)));
+        }
+        capacity_ = capacity == 0 ? 2 * n_workers : capacity;
+        max_attempts_ = 3;
+        timeout_ = 0;
+        n_evaluations_ = 0;
+        n_restarts_ = 0;
+        n_failures_ = 0;
+        n_failed_starts_ = 0;
+
+        // Each slot starts at a cache line, so the workers do not share one.
+        size_t values = sizeof(double) * (n_variables_ + n_objectives_);
+        slot_size_ = RoundUp(RoundUp(sizeof(Slot), sizeof(double)) + values);
+        size_t header_size = RoundUp(sizeof(Header));
+        memory_size_ = header_size + slot_size_ * capacity_;
+        void* memory = mmap(NULL, memory_size_, PROT_READ | PROT_WRITE,
+                            MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+        if (memory == MAP_FAILED) {
+            memory_ = NULL;
+            return;
+        }
+        memory_ = static_cast<char*>(memory);
+        slots_ = memory_ + header_size;
+
+        Header* h = new (memory_) Header;
+        h->max_evaluations.store(0);
+        if (sem_init(&h->ready, 1, 0) != 0 || sem_init(&h->done, 1, 0) != 0) {
+            munmap(memory_, memory_size_);
+            memory_ = NULL;
+            return;
+        }
+        for (int s = 0; s < capacity_; ++s) {
+            Slot* slot = new (slots_ + slot_size_ * s) Slot;
+            slot->state.store(FREE);
+            slot->start.store(0);
+            assert(slot->state.is_lock_free() && slot->start.is_lock_free());
+        }
+
+        parent_ = getpid();
+        pids_.assign(n_workers, 0);
+        for (int w = 0; w < n_workers; ++w) {
+            if (!StartWorker(w)) {
+                // Fall back to the evaluation in process.
+                Shutdown();
+                return;
+            }
+        }
+    }
+
+    /**
+     * Kill the workers and release the shared memory.
+     */
+    void Shutdown() {
+        for (pid_t pid : pids_) {
+            if (pid <= 0) continue;
+            kill(pid, SIGKILL);
+            waitpid(pid, NULL, 0);
+        }
+        pids_.clear();
+        if (memory_) {
+            sem_destroy(&header()->ready);
+            sem_destroy(&header()->done);
+            munmap(memory_, memory_size_);
+            memory_ = NULL;
+        }
+    }
+
+    /**
+     * Fork the w-th worker.
+     */
+    bool StartWorker(int w) {
+        pid_t pid = fork();
+        if (pid == 0) {
+            // The worker must never return into the code of the parent.
+            try {
+                RunWorker(w);
+            } catch (...) {
+                _exit(1);
+            }
+            _exit(0);
+        }
+        pids_[w] = pid;
+        n_failed_starts_ = pid > 0 ? 0 : n_failed_starts_ + 1;
+        return pid > 0;
+    }
+
+    /**
+     * The loop of the w-th worker process.
+     */
+    void RunWorker(int w) {
+#ifdef __linux__
+        // Exit with the parent.
+        prctl(PR_SET_PDEATHSIG, SIGKILL);
+        if (getppid() != parent_) _exit(0);
+#endif
+        std::vector<double> x(n_variables_), f(n_objectives_);
+        for (int count = 0; ; ) {
+            if (sem_wait(&header()->ready) != 0) {
+                if (errno == EINTR) continue;
+                _exit(1);
+            }
+
+            // A wake-up without a ready slot is harmless.
+            int s = Claim(w);
+            if (s < 0) continue;
+
+            Slot* slot = GetSlot(s);
+            slot->start.store(Now(), std::memory_order_relaxed);
+            const double* v = SlotVariables(s);
+            std::copy(v, v + n_variables_, x.begin());
+            function_(x, &f);
+            assert(static_cast<int>(f.size()) == n_objectives_);
+            std::copy(f.begin(), f.end(), SlotObjectives(s));
+            slot->state.store(DONE, std::memory_order_release);
+            sem_post(&header()->done);
+
+            int max_evaluations = header()->max_evaluations.load();
+            if (max_evaluations > 0 && ++count >= max_evaluations) {
+                _exit(0);
+            }
+        }
+    }
+
+    /**
+     * Claim a ready slot for the w-th worker, or return -1.
+     */
+    int Claim(int w) {
+        for (int k = 0; k < capacity_; ++k) {
+            int s = (w + k) % capacity_;
+            int expected = READY;
+            if (GetSlot(s)->state.compare_exchange_strong(
+                    expected, CLAIMED + w, std::memory_order_acquire)) {
+                return s;
+            }
+        }
+        return -1;
+    }
+
+    /**
+     * Put the row of variables into the slot s.
+     */
+    void Submit(int s, int row, const cl::Array2D<double>& variables) {
+        Slot* slot = GetSlot(s);
+        const double* v = variables.data().data() + row * n_variables_;
+        std::copy(v, v + n_variables_, SlotVariables(s));
+        slot->row = row;
+        slot->attempts = 0;
+        Ready(s);
+    }
+
+    void Ready(int s) {
+        Slot* slot = GetSlot(s);
+        slot->start.store(0, std::memory_order_relaxed);
+        slot->state.store(READY, std::memory_order_release);
+        sem_post(&header()->ready);
+    }
+
+    /**
+     * Wait for a done slot. Return false on timeout.
+     */
+    bool WaitDone() {
+        timespec deadline;
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        deadline.tv_nsec += WAIT_MILLISECONDS * 1000000L;
+        if (deadline.tv_nsec >= 1000000000L) {
+            deadline.tv_nsec -= 1000000000L;
+            ++deadline.tv_sec;
+        }
+        while (sem_timedwait(&header()->done, &deadline) != 0) {
+            if (errno != EINTR) return false;
+        }
+        return true;
+    }
+
+    /**
+     * Kill the workers that exceed the timeout, then restart the dead workers
+     * and put their candidates back.
+     */
+    void CheckWorkers() {
+        int n_workers = static_cast<int>(pids_.size());
+        if (timeout_ > 0) {
+            int64_t now = Now();
+            for (int s = 0; s < capacity_; ++s) {
+                Slot* slot = GetSlot(s);
+                int state = slot->state.load(std::memory_order_acquire);
+                int64_t start = slot->start.load(std::memory_order_relaxed);
+                if (state >= CLAIMED && start > 0 && now - start > timeout_ &&
+                    pids_[state - CLAIMED] > 0) {
+                    kill(pids_[state - CLAIMED], SIGKILL);
+                }
+            }
+        }
+
+        for (int w = 0; w < n_workers; ++w) {
+            if (pids_[w] > 0 && waitpid(pids_[w], NULL, WNOHANG) == 0) {
+                continue;
+            }
+
+            bool claimed = false;
+            for (int s = 0; s < capacity_; ++s) {
+                Slot* slot = GetSlot(s);
+                if (slot->state.load(std::memory_order_acquire) !=
+                    CLAIMED + w) {
+                    continue;
+                }
+                claimed = true;
+                if (++slot->attempts < max_attempts_) {
+                    Ready(s);
+                } else {
+                    std::fill_n(SlotObjectives(s), n_objectives_, HUGE_VAL);
+                    slot->state.store(DONE, std::memory_order_release);
+                    sem_post(&header()->done);
+                    ++n_failures_;
+                }
+            }
+            // The worker may die after it took a ready count, so give it back.
+            if (!claimed && pids_[w] > 0) sem_post(&header()->ready);
+
+            StartWorker(w);
+            ++n_restarts_;
+        }
+
+        // Nothing would ever claim the ready slots.
+        if (n_failed_starts_ >= MAX_FAILED_STARTS &&
+            std::count_if(pids_.begin(), pids_.end(),
+                          [](pid_t pid) { return pid > 0; }) == 0) {
+            EvaluateReadySlots();
+        }
+    }
+
+    /**
+     * Evaluate the ready slots in this process.
+     */
+    void EvaluateReadySlots() {
+        std::vector<double> x(n_variables_), f(n_objectives_);
+        for (int s = 0; s < capacity_; ++s) {
+            Slot* slot = GetSlot(s);
+            if (slot->state.load(std::memory_order_acquire) != READY) {
+                continue;
+            }
+            const double* v = SlotVariables(s);
+            std::copy(v, v + n_variables_, x.begin());
+            function_(x, &f);
+            std::copy(f.begin(), f.end(), SlotObjectives(s));
+            slot->state.store(DONE, std::memory_order_release);
+            sem_post(&header()->done);
+            ++n_failures_;
+        }
+    }
+
+    /**
+     * Evaluate the rows in this process.
+     */
+    void EvaluateInProcess(const cl::Array2D<double>& variables,
+                           cl::Array2D<double>* objectives) {
+        int n = variables.rows();
+        std::vector<double> x(n_variables_), f(n_objectives_);
+        for (int i = 0; i < n; ++i) {
+            const double* v = variables.data().data() + i * n_variables_;
+            std::copy(v, v + n_variables_, x.begin());
+            function_(x, &f);
+            std::copy(f.begin(), f.end(),
+                      objectives->data().begin() + i * n_objectives_);
+        }
+        n_evaluations_ += n;
+    }
+
+    Header* header() const {
+        return reinterpret_cast<Header*>(memory_);
+    }
+
+    Slot* GetSlot(int s) const {
+        return reinterpret_cast<Slot*>(slots_ + slot_size_ * s);
+    }
+
+    double* SlotVariables(int s) const {
+        return reinterpret_cast<double*>(
+                slots_ + slot_size_ * s +
+                RoundUp(sizeof(Slot), sizeof(double)));
+    }
+
+    double* SlotObjectives(int s) const {
+        return SlotVariables(s) + n_variables_;
+    }
+
+    static size_t RoundUp(size_t size, size_t alignment = 64) {
+        return (size + alignment - 1) / alignment * alignment;
+    }
+
+    /**
+     * The monotonic time in nanoseconds, shared by the processes.
+     */
+    static int64_t Now() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    int n_variables_;                 // The number of variables.
+    int n_objectives_;                // The number of objectives.
+    Function function_;               // The function run by the workers.
+    int capacity_;                    // The number of slots.
+    int max_attempts_;                // The attempts of a candidate.
+    int64_t timeout_;                 // The timeout in ns, 0 for none.
+
+    char* memory_;                    // The shared memory, NULL if failed.
+    size_t memory_size_;              // The size of shared memory.
+    char* slots_;                     // The first slot.
+    size_t slot_size_;                // The bytes of a slot.
+    pid_t parent_;                    // The parent process.
+    std::vector<pid_t> pids_;         // The worker processes.
+
+    int64_t n_evaluations_;           // The number of evaluations.
+    int n_restarts_;                  // The number of restarted workers.
+    int n_failures_;                  // The candidates not run by workers.
+    int n_failed_starts_;             // The consecutive failed forks.
+
+    DISALLOW_COPY_AND_ASSIGN(ProcessPoolEvaluator);
+};
+
+} // namespace moo
+
+#endif // _WIN32
+
+#endif // SOLVER_UTIL_PROCESS_POOL_EVALUATOR_H_
@@ -0,0 +1,145 @@
+//
+// Copyright 2013 Yangbin Lin and Bili Chen. All Rights Reserved.
+//
+// Author: yblin.xmu@qq.com (Yangbin Lin)
+//
+// To use this code, please cite the follow paper:
+//
+// Chen B, Zeng W, Lin Y, et al. A New Local Search-Based Multiobjective
+// Optimization Algorithm[J]. IEEE Transactions on Evolutionary Computation,
+// 2014, 19(1):1-1.
+//
+
+#ifndef SOLVER_UTIL_REFERENCE_DIRECTIONS_H_
+#define SOLVER_UTIL_REFERENCE_DIRECTIONS_H_
+
+#include <cassert>
+#include <climits>
+#include <vector>
+
+#include "codelibrary/util/array/array_2d.h"
+
+namespace moo {
+
+/// Reference Directions on the Unit Simplex.
+/**
+ * The Das and Dennis's systematic approach places the points
+ *
+ *   (c_1 / H, c_2 / H, ..., c_M / H),  c_1 + ... + c_M = H, c_i >= 0,
+ *
+ * on the unit simplex, where H is the number of divisions, which gives
+ * C(H + M - 1, M - 1) points. For many objectives a single layer either has
+ * too many points or (H < M) only points on the boundary, so Generate() uses
+ * two layers like NSGA-III: a boundary layer and an inner layer shrunk by half
+ * toward the center of the simplex.
+ *
+ * The directions are stored one per row.
+ */
+class ReferenceDirections {
+public:
+    /**
+     * The number of Das-Dennis points, or INT_MAX if it is too large.
+     */
+    static int Count(int n_objectives, int n_divisions) {
+        assert(n_objectives > 0);
+        assert(n_divisions >= 0);
+
+        // C(H + M - 1, M - 1), each partial product is a binomial coefficient.
+        long long count = 1;
+        for (int i = 1; i < n_objectives; ++i) {
+            count = count * (n_divisions + i) / i;
+            if (count > INT_MAX) return INT_MAX;
+        }
+        return static_cast<int>(count);
+    }
+
+    /**
+     * Append the Das-Dennis points with the given divisions to directions. The
+     * points are shrunk toward the center of simplex by 'scale' (1 for the
+     * boundary layer).
+     *
+     * The compositions of H are enumerated by the NEXCOM algorithm of
+     * Nijenhuis and Wilf, each one in amortized O(1) without recursion.
+     */
+    static void DasDennis(int n_objectives, int n_divisions,
+                          cl::Array2D<double>* directions,
+                          double scale = 1.0) {
+        assert(directions);
+        assert(directions->empty() || directions->columns() == n_objectives);
+        assert(n_divisions > 0);
+        assert(0.0 < scale && scale <= 1.0);
+
+        int count = Count(n_objectives, n_divisions);
+        assert(count < INT_MAX);
+
+        int first = directions->empty() ? 0 : directions->rows();
+        directions->Resize(first + count, n_objectives);
+
+        int m = n_objectives;
+        double step = scale / n_divisions;
+        double center = (1.0 - scale) / m;
+        std::vector<int> r(m, 0);
+        r[0] = n_divisions;
+        int t = n_divisions, h = 0;
+        for (int k = first; ; ++k) {
+            double* p = directions->data().data() + k * m;
+            for (int i = 0; i < m; ++i) {
+                p[i] = center + step * r[i];
+            }
+            if (r[m - 1] == n_divisions) break;
+
+            if (t > 1) h = 0;
+            ++h;
+            t = r[h - 1];
+            r[h - 1] = 0;
+            r[0] = t - 1;
+            ++r[h];
+        }
+    }
+
+    /**
+     * Generate at most n_directions (and at least M) reference directions. The
+     * single layer with the largest H is used if H >= M, otherwise the two
+     * layers (H1 >= H2) with the most points.
+     */
+    static void Generate(int n_objectives, int n_directions,
+                         cl::Array2D<double>* directions) {
+        assert(directions);
+        assert(n_objectives > 0);
+
+        directions->Resize(0, n_objectives);
+        if (n_objectives == 1) {
+            DasDennis(1, 1, directions);
+            return;
+        }
+
+        int h = 1;
+        while (Count(n_objectives, h + 1) <= n_directions) ++h;
+        if (h >= n_objectives) {
+            DasDennis(n_objectives, h, directions);
+            return;
+        }
+
+        int best_h1 = h, best_h2 = 0, best = Count(n_objectives, h);
+        for (int h1 = 1; h1 <= h; ++h1) {
+            int c1 = Count(n_objectives, h1);
+            for (int h2 = 1; h2 <= h1; ++h2) {
+                int c2 = Count(n_objectives, h2);
+                if (c1 + c2 > n_directions) break;
+                if (c1 + c2 > best) {
+                    best = c1 + c2;
+                    best_h1 = h1;
+                    best_h2 = h2;
+                }
+            }
+        }
+        DasDennis(n_objectives, best_h1, directions);
+        if (best_h2 > 0) {
+            DasDennis(n_objectives, best_h2, directions, 0.5);
+        }
+    }
+};
+
+} // namespace moo
+
+#endif // SOLVER_UTIL_REFERENCE_DIRECTIONS_H_
@@ -13,8 +13,10 @@
 #ifndef SOLVER_UTIL_SELECTOR_H_
 #define SOLVER_UTIL_SELECTOR_H_
 
+#include "solver/util/selector/crowding_distance_selector.h"
 #include "solver/util/selector/farthest_candidate.h"
 #include "solver/util/selector/non_dominated_sorting_selector.h"
+#include "solver/util/selector/reference_point_selector.h"
 
 #endif // SOLVER_UTIL_SELECTOR_H_
 
@@ -0,0 +1,70 @@
+//
+// Copyright 2013 Yangbin Lin and Bili Chen. All Rights Reserved.
+//
+// Author: yblin.xmu@qq.com (Yangbin Lin)
+//
+// To use this code, please cite the follow paper:
+//
+// Chen B, Zeng W, Lin Y, et al. A New Local Search-Based Multiobjective
+// Optimization Algorithm[J]. IEEE Transactions on Evolutionary Computation,
+// 2014, 19(1):1-1.
+//
+
+#ifndef SOLVER_UTIL_SELECTOR_CROWDING_DISTANCE_SELECTOR_H_
+#define SOLVER_UTIL_SELECTOR_CROWDING_DISTANCE_SELECTOR_H_
+
+#include <algorithm>
+#include <vector>
+
+#include "codelibrary/util/common/arg_sort.h"
+
+#include "core/population.h"
+#include "solver/util/crowding_distance.h"
+#include "test/basic_test.h"
+
+namespace moo {
+
+/// Crowding Distance Method for Selector.
+/**
+ * Select the n individuals with the largest crowding distance, like NSGA-II.
+ * It can be used in place of FarthestCandidate, e.g.,
+ *
+ *    SolverNSLS<CrowdingDistanceSelector> solver;
+ *
+ * The selector is created for each call, so the buffers are kept per thread.
+ */
+class CrowdingDistanceSelector {
+public:
+    void operator () (const BasicTest& /* test */,
+                      const Population& population,
+                      int n, Population* selected_population) const {
+        assert(selected_population);
+        assert(size_t(n) <= population.size());
+
+        if (static_cast<size_t>(n) == population.size()) {
+            *selected_population = population;
+            return;
+        }
+
+        static thread_local CrowdingDistance crowding_distance;
+        static thread_local cl::ArgSort arg_sort;
+        static thread_local std::vector<double> distance;
+        static thread_local std::vector<int> orders;
+
+        // Ties are broken by the index, so the selection is deterministic.
+        crowding_distance.Compute(population, &distance);
+        arg_sort.PartialSort(distance, n, &orders, true);
+        std::sort(orders.begin(), orders.end());
+
+        Population selected(n);
+        for (int i = 0; i < n; ++i) {
+            selected[i] = population[orders[i]];
+            selected[i].distance = distance[orders[i]];
+        }
+        selected_population->swap(selected);
+    }
+};
+
+} // namespace moo
+
+#endif // SOLVER_UTIL_SELECTOR_CROWDING_DISTANCE_SELECTOR_H_
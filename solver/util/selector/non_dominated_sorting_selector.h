@@ -20,6 +20,10 @@
 namespace moo {
 
 // Non-dominated Sorting based Selector.
+//
+// If the Selector also accepts (test, selected, front, n, result), it gets the
+// individuals selected from the previous fronts, e.g.,
+// ReferencePointSelector counts them in its niches.
 template <class Selector>
 class NonDominatedSortingSelector {
 public:
@@ -31,10 +35,23 @@ public:
                        int n, Population* selected_population) {
         assert(selected_population);
 
-        selected_population->resize(n);
-
+        // Only the fronts that cover n individuals are needed.
         std::vector<Population> fronts;
-        NonDominatedSort(population, &fronts);
+        NonDominatedSort(population, n, &fronts);
+        SelectFronts(test, fronts, n, selected_population);
+    }
+
+    /**
+     * The same as Select(), but the population is already sorted into the
+     * fronts, e.g., by IncrementalNonDominatedSort and SplitFronts(). The
+     * fronts must cover at least n individuals.
+     */
+    static void SelectFronts(const BasicTest& test,
+                             const std::vector<Population>& fronts, int n,
+                             Population* selected_population) {
+        assert(selected_population);
+
+        selected_population->resize(n);
 
         int k = 0;
         size_t cur_front = 0;
@@ -53,7 +70,8 @@ public:
 
         if (k < n) {
             Population tmp;
-            Selector()(test, fronts[cur_front], n - k, &tmp);
+            CallSelector(Selector(), test, *selected_population, k,
+                         fronts[cur_front], n - k, &tmp, 0);
             assert(tmp.size() == static_cast<std::size_t>(n - k));
 
             for (size_t j = 0; j < tmp.size(); ++j) {
@@ -65,6 +83,32 @@ public:
 
         assert(selected_population->size() == static_cast<std::size_t>(n));
     }
+
+private:
+    /**
+     * Call the Selector with the first k individuals of 'selected', if it
+     * supports them.
+     */
+    template <class S>
+    static auto CallSelector(S selector, const BasicTest& test,
+                             const Population& selected, int k,
+                             const Population& front, int n,
+                             Population* result, int)
+            -> decltype(selector(test, selected, front, n, result), void()) {
+        Population previous(selected.begin(), selected.begin() + k);
+        selector(test, previous, front, n, result);
+    }
+
+    /**
+     * Call the Selector with the last front only.
+     */
+    template <class S>
+    static void CallSelector(S selector, const BasicTest& test,
+                             const Population& /* selected */, int /* k */,
+                             const Population& front, int n,
+                             Population* result, long) {
+        selector(test, front, n, result);
+    }
 };
 
 } // namespace moo
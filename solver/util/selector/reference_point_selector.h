@@ -0,0 +1,447 @@
+//
+// Copyright 2013 Yangbin Lin and Bili Chen. All Rights Reserved.
+//
+// Author: yblin.xmu@qq.com (Yangbin Lin)
+//
+// To use this code, please cite the follow paper:
+//
+// Chen B, Zeng W, Lin Y, et al. A New Local Search-Based Multiobjective
+// Optimization Algorithm[J]. IEEE Transactions on Evolutionary Computation,
+// 2014, 19(1):1-1.
+//
+
+#ifndef SOLVER_UTIL_SELECTOR_REFERENCE_POINT_SELECTOR_H_
+#define SOLVER_UTIL_SELECTOR_REFERENCE_POINT_SELECTOR_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cfloat>
+#include <climits>
+#include <cmath>
+#include <vector>
+
+#include "codelibrary/util/array/array_2d.h"
+
+#include "core/population.h"
+#include "solver/util/reference_directions.h"
+#include "test/basic_test.h"
+
+namespace moo {
+
+/// Reference Point based Selector of NSGA-III.
+/**
+ * The selector keeps the diversity for many objectives by the reference
+ * directions instead of the distances between individuals:
+ *
+ * 1. The objectives of the selected individuals and the last front are
+ *    normalized by the ideal point and the intercepts of the hyperplane
+ *    through the extreme points, which adapts to the scales of objectives in
+ *    each generation.
+ * 2. Each individual is associated with the closest reference direction (by
+ *    the perpendicular distance to the line).
+ * 3. The individuals of the last front are picked niche by niche. The niche
+ *    with the fewest associated individuals gets the closest candidate next.
+ *
+ * The association costs O(N |R| M) for N individuals and |R| directions. The
+ * kernel computes the dot products of a block of individuals with each
+ * direction and keeps the running maximums in registers, which is about 3
+ * times faster than one individual at a time.
+ *
+ * The number of directions is about the size of population, see
+ * ReferenceDirections::Generate(). It can be used in place of
+ * FarthestCandidate, e.g.,
+ *
+ *    SolverNSLS<ReferencePointSelector> solver;
+ *
+ * NonDominatedSortingSelector passes the individuals already selected from the
+ * previous fronts, which count in the niches. Unlike NSGA-III, the ties are
+ * broken deterministically (the closest candidate first), so the selection
+ * does not consume random numbers.
+ */
+class ReferencePointSelector {
+    // The number of rows associated together.
+    static const int BLOCK_SIZE = 4;
+
+    /// The buffers of a thread.
+    struct Buffer {
+        Buffer()
+            : n_objectives(0), n_directions(0) {}
+
+        int n_objectives;               // The objectives of directions.
+        int n_directions;               // The requested number of them.
+        cl::Array2D<double> directions; // The reference directions.
+        std::vector<double> units;      // The unit directions.
+
+        std::vector<double> objectives; // The objectives of S, row by row.
+        std::vector<int> niches;        // The associated direction of S.
+        std::vector<double> distances;  // The distance to the direction.
+        std::vector<int> counts;        // The niche count of directions.
+        std::vector<int> starts;        // The candidates of each direction.
+        std::vector<int> nexts;         // The next candidate of direction.
+        std::vector<int> candidates;    // The front sorted by niches.
+        std::vector<int> active;        // The directions with candidates.
+        std::vector<int> round;         // The directions of a round.
+        std::vector<int> accepted;      // The picked front indices.
+    };
+
+public:
+    /**
+     * Select n individuals from population without others selected.
+     */
+    void operator () (const BasicTest& test, const Population& population,
+                      int n, Population* selected_population) const {
+        (*this)(test, Population(), population, n, selected_population);
+    }
+
+    /**
+     * Select n individuals from population (the last front), given the
+     * individuals 'selected' from the previous fronts.
+     */
+    void operator () (const BasicTest& test, const Population& selected,
+                      const Population& population, int n,
+                      Population* selected_population) const {
+        assert(selected_population);
+        assert(size_t(n) <= population.size());
+
+        if (static_cast<size_t>(n) == population.size()) {
+            *selected_population = population;
+            return;
+        }
+
+        static thread_local Buffer buffer;
+        int m = test.parameter.n_objectives;
+        int n_selected = static_cast<int>(selected.size());
+        SetDirections(m, n_selected + n, &buffer);
+
+        // Copy S = selected + population.
+        int n_population = static_cast<int>(population.size());
+        int size = n_selected + n_population;
+        buffer.objectives.resize(size * m);
+        for (int i = 0; i < size; ++i) {
+            const Individual& individual = i < n_selected ?
+                    selected[i] : population[i - n_selected];
+            assert(static_cast<int>(individual.objectives.size()) == m);
+            std::copy(individual.objectives.begin(),
+                      individual.objectives.end(),
+                      buffer.objectives.begin() + i * m);
+        }
+
+        Normalize(size, m, n_selected, &buffer.objectives);
+        Associate(size, m, &buffer);
+        Niching(n_selected, n_population, n, &buffer);
+
+        // Keep the order of population.
+        std::vector<int>& accepted = buffer.accepted;
+        std::sort(accepted.begin(), accepted.end());
+        Population result(n);
+        for (int i = 0; i < n; ++i) {
+            result[i] = population[accepted[i]];
+        }
+        selected_population->swap(result);
+    }
+
+private:
+    /**
+     * Generate the directions for M objectives and N individuals, unless they
+     * are the same as the last call.
+     */
+    static void SetDirections(int m, int n, Buffer* buffer) {
+        if (buffer->n_objectives == m && buffer->n_directions == n) return;
+
+        buffer->n_objectives = m;
+        buffer->n_directions = n;
+        ReferenceDirections::Generate(m, n, &buffer->directions);
+
+        int r = buffer->directions.rows();
+        const double* w = buffer->directions.data().data();
+        buffer->units.resize(m * r);
+        for (int j = 0; j < r; ++j) {
+            double norm = 0.0;
+            for (int k = 0; k < m; ++k) {
+                norm += w[j * m + k] * w[j * m + k];
+            }
+            norm = 1.0 / std::sqrt(norm);
+            for (int k = 0; k < m; ++k) {
+                buffer->units[j * m + k] = w[j * m + k] * norm;
+            }
+        }
+    }
+
+    /**
+     * Normalize the objectives (size x m) by the ideal point and the
+     * intercepts of the hyperplane through the extreme points. If the
+     * hyperplane is degenerate, the nadir point of the selected individuals
+     * (or the last front if none is selected) is used instead.
+     */
+    static void Normalize(int size, int m, int n_selected,
+                          std::vector<double>* objectives) {
+        double* f = objectives->data();
+
+        std::vector<double> ideal(m, DBL_MAX);
+        for (int i = 0; i < size; ++i) {
+            for (int k = 0; k < m; ++k) {
+                ideal[k] = std::min(ideal[k], f[i * m + k]);
+            }
+        }
+        for (int i = 0; i < size; ++i) {
+            for (int k = 0; k < m; ++k) {
+                f[i * m + k] -= ideal[k];
+            }
+        }
+
+        // The extreme point of k-th axis minimizes the achievement
+        // scalarizing function max_j f_j / w_j, where w = e_k (and 1e-6 for
+        // the other axes).
+        std::vector<double> extremes(m * m);
+        for (int k = 0; k < m; ++k) {
+            double min = DBL_MAX;
+            int best = 0;
+            for (int i = 0; i < size; ++i) {
+                double asf = 0.0;
+                for (int j = 0; j < m; ++j) {
+                    double v = j == k ? f[i * m + j] : f[i * m + j] * 1e6;
+                    asf = std::max(asf, v);
+                }
+                if (asf < min) {
+                    min = asf;
+                    best = i;
+                }
+            }
+            std::copy(f + best * m, f + best * m + m,
+                      extremes.begin() + k * m);
+        }
+
+        std::vector<double> intercepts(m);
+        if (!Intercepts(m, &extremes, &intercepts)) {
+            int last = n_selected > 0 ? n_selected : size;
+            std::fill(intercepts.begin(), intercepts.end(), 0.0);
+            for (int i = 0; i < last; ++i) {
+                for (int k = 0; k < m; ++k) {
+                    intercepts[k] = std::max(intercepts[k], f[i * m + k]);
+                }
+            }
+        }
+
+        for (int k = 0; k < m; ++k) {
+            if (!(intercepts[k] > 1e-10)) intercepts[k] = 1.0;
+            intercepts[k] = 1.0 / intercepts[k];
+        }
+        for (int i = 0; i < size; ++i) {
+            for (int k = 0; k < m; ++k) {
+                f[i * m + k] *= intercepts[k];
+            }
+        }
+    }
+
+    /**
+     * Compute the intercepts of the hyperplane through the m extreme points
+     * (row by row), i.e., solve E b = 1 and the intercepts are 1 / b.
+     *
+     * @return false if the hyperplane is degenerate.
+     */
+    static bool Intercepts(int m, std::vector<double>* extremes,
+                           std::vector<double>* intercepts) {
+        double* a = extremes->data();
+        std::vector<double> b(m, 1.0);
+
+        // Gaussian elimination with partial pivoting.
+        for (int k = 0; k < m; ++k) {
+            int pivot = k;
+            for (int i = k + 1; i < m; ++i) {
+                if (std::fabs(a[i * m + k]) > std::fabs(a[pivot * m + k])) {
+                    pivot = i;
+                }
+            }
+            if (std::fabs(a[pivot * m + k]) < 1e-12) return false;
+            if (pivot != k) {
+                std::swap_ranges(a + k * m, a + k * m + m, a + pivot * m);
+                std::swap(b[k], b[pivot]);
+            }
+            for (int i = k + 1; i < m; ++i) {
+                double factor = a[i * m + k] / a[k * m + k];
+                for (int j = k; j < m; ++j) {
+                    a[i * m + j] -= factor * a[k * m + j];
+                }
+                b[i] -= factor * b[k];
+            }
+        }
+        for (int k = m - 1; k >= 0; --k) {
+            for (int j = k + 1; j < m; ++j) {
+                b[k] -= a[k * m + j] * b[j];
+            }
+            b[k] /= a[k * m + k];
+        }
+
+        for (int k = 0; k < m; ++k) {
+            if (!(b[k] > 1e-10)) return false;
+            (*intercepts)[k] = 1.0 / b[k];
+        }
+        return true;
+    }
+
+    /**
+     * Associate each row of the normalized objectives with the closest unit
+     * direction w, by the perpendicular distance
+     *
+     *   d^2 = |f|^2 - (f . w)^2.
+     *
+     * Since f and w are non-negative, the closest direction has the largest
+     * dot product. The rows are processed in blocks of BLOCK_SIZE, so that
+     * each direction is loaded once per block and the running maximums stay in
+     * registers.
+     */
+    static void Associate(int size, int m, Buffer* buffer) {
+        const double* f = buffer->objectives.data();
+        buffer->niches.resize(size);
+        buffer->distances.resize(size);
+        int* niches = buffer->niches.data();
+        double* distances = buffer->distances.data();
+
+        int i = 0;
+        for (; i + BLOCK_SIZE <= size; i += BLOCK_SIZE) {
+            AssociateBlock(f + i * m, m, *buffer, niches + i, distances + i);
+        }
+        if (i < size) {
+            // Pad the last block by zero rows.
+            std::vector<double> block(BLOCK_SIZE * m, 0.0);
+            int rest = size - i;
+            std::copy(f + i * m, f + size * m, block.begin());
+            int block_niches[BLOCK_SIZE];
+            double block_distances[BLOCK_SIZE];
+            AssociateBlock(block.data(), m, *buffer, block_niches,
+                           block_distances);
+            std::copy(block_niches, block_niches + rest, niches + i);
+            std::copy(block_distances, block_distances + rest,
+                      distances + i);
+        }
+    }
+
+    /**
+     * Associate BLOCK_SIZE rows of f.
+     */
+    static void AssociateBlock(const double* f, int m, const Buffer& buffer,
+                               int* niches, double* distances) {
+        int r = buffer.directions.rows();
+        const double* w = buffer.units.data();
+        const double* f0 = f;
+        const double* f1 = f0 + m;
+        const double* f2 = f1 + m;
+        const double* f3 = f2 + m;
+
+        int b0 = 0, b1 = 0, b2 = 0, b3 = 0;
+        double m0 = -1.0, m1 = -1.0, m2 = -1.0, m3 = -1.0;
+        for (int j = 0; j < r; ++j, w += m) {
+            double d0 = 0.0, d1 = 0.0, d2 = 0.0, d3 = 0.0;
+            for (int k = 0; k < m; ++k) {
+                double v = w[k];
+                d0 += v * f0[k];
+                d1 += v * f1[k];
+                d2 += v * f2[k];
+                d3 += v * f3[k];
+            }
+            if (d0 > m0) { m0 = d0; b0 = j; }
+            if (d1 > m1) { m1 = d1; b1 = j; }
+            if (d2 > m2) { m2 = d2; b2 = j; }
+            if (d3 > m3) { m3 = d3; b3 = j; }
+        }
+
+        const double dots[BLOCK_SIZE] = { m0, m1, m2, m3 };
+        const int bests[BLOCK_SIZE] = { b0, b1, b2, b3 };
+        for (int q = 0; q < BLOCK_SIZE; ++q) {
+            double norm = 0.0;
+            for (int k = 0; k < m; ++k) {
+                norm += f[q * m + k] * f[q * m + k];
+            }
+            niches[q] = bests[q];
+            distances[q] = std::sqrt(std::max(norm - dots[q] * dots[q], 0.0));
+        }
+    }
+
+    /**
+     * Pick n individuals from the last front (the rows after n_selected).
+     */
+    static void Niching(int n_selected, int n_population, int n,
+                        Buffer* buffer) {
+        int r = buffer->directions.rows();
+        const int* niches = buffer->niches.data();
+        const double* distances = buffer->distances.data();
+
+        buffer->counts.assign(r, 0);
+        for (int i = 0; i < n_selected; ++i) {
+            ++buffer->counts[niches[i]];
+        }
+
+        // Sort the candidates by niches, then by distances.
+        std::vector<int>& starts = buffer->starts;
+        std::vector<int>& nexts = buffer->nexts;
+        std::vector<int>& candidates = buffer->candidates;
+        starts.assign(r + 1, 0);
+        for (int i = 0; i < n_population; ++i) {
+            ++starts[niches[n_selected + i] + 1];
+        }
+        for (int j = 0; j < r; ++j) {
+            starts[j + 1] += starts[j];
+        }
+        candidates.resize(n_population);
+        nexts.assign(starts.begin(), starts.end() - 1);
+        for (int i = 0; i < n_population; ++i) {
+            candidates[nexts[niches[n_selected + i]]++] = i;
+        }
+        for (int j = 0; j < r; ++j) {
+            std::sort(candidates.begin() + starts[j],
+                      candidates.begin() + starts[j + 1],
+                      [&](int a, int b) {
+                return distances[n_selected + a] < distances[n_selected + b];
+            });
+        }
+
+        std::vector<int>& active = buffer->active;
+        active.clear();
+        for (int j = 0; j < r; ++j) {
+            nexts[j] = starts[j];
+            if (starts[j] < starts[j + 1]) active.push_back(j);
+        }
+
+        // Each round gives one candidate to each niche with the fewest
+        // individuals. If the round is the last one, the niches whose next
+        // candidates are closer go first.
+        std::vector<int>& accepted = buffer->accepted;
+        std::vector<int>& round = buffer->round;
+        accepted.clear();
+        while (static_cast<int>(accepted.size()) < n) {
+            int min_count = INT_MAX;
+            for (int j : active) {
+                min_count = std::min(min_count, buffer->counts[j]);
+            }
+            round.clear();
+            for (int j : active) {
+                if (buffer->counts[j] == min_count) round.push_back(j);
+            }
+
+            int rest = n - static_cast<int>(accepted.size());
+            if (static_cast<int>(round.size()) > rest) {
+                std::stable_sort(round.begin(), round.end(),
+                                 [&](int a, int b) {
+                    return distances[n_selected + candidates[nexts[a]]] <
+                           distances[n_selected + candidates[nexts[b]]];
+                });
+                round.resize(rest);
+            }
+
+            for (int j : round) {
+                accepted.push_back(candidates[nexts[j]++]);
+                ++buffer->counts[j];
+            }
+
+            int k = 0;
+            for (int j : active) {
+                if (nexts[j] < starts[j + 1]) active[k++] = j;
+            }
+            active.resize(k);
+        }
+    }
+};
+
+} // namespace moo
+
+#endif // SOLVER_UTIL_SELECTOR_REFERENCE_POINT_SELECTOR_H_
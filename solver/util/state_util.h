@@ -0,0 +1,68 @@
+//
+// Copyright 2013 Yangbin Lin and Bili Chen. All Rights Reserved.
+//
+// Author: yblin.xmu@qq.com (Yangbin Lin)
+//
+// To use this code, please cite the follow paper:
+//
+// Chen B, Zeng W, Lin Y, et al. A New Local Search-Based Multiobjective
+// Optimization Algorithm[J]. IEEE Transactions on Evolutionary Computation,
+// 2014, 19(1):1-1.
+//
+
+#ifndef SOLVER_UTIL_STATE_UTIL_H_
+#define SOLVER_UTIL_STATE_UTIL_H_
+
+#include <cassert>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <vector>
+
+namespace moo {
+
+/// Util for the text states of the solver components kept in checkpoints.
+/**
+ * A state is a sequence of values separated by spaces, like the state of
+ * std::mt19937. The doubles are written with max_digits10 digits, so they are
+ * read back exactly.
+ */
+class StateUtil {
+public:
+    /**
+     * Write the size and the values of a vector, after a space.
+     */
+    template <typename T>
+    static void Write(const std::vector<T>& values, std::ostream* out) {
+        assert(out);
+
+        out->precision(std::numeric_limits<double>::max_digits10);
+        *out << ' ' << values.size();
+        for (const T& value : values) {
+            *out << ' ' << value;
+        }
+    }
+
+    /**
+     * Read a vector written by Write().
+     */
+    template <typename T>
+    static bool Read(std::istream* in, std::vector<T>* values) {
+        assert(in);
+        assert(values);
+
+        size_t size = 0;
+        if (!(*in >> size)) return false;
+        values->clear();
+        for (size_t i = 0; i < size; ++i) {
+            T value;
+            if (!(*in >> value)) return false;
+            values->push_back(value);
+        }
+        return true;
+    }
+};
+
+} // namespace moo
+
+#endif // SOLVER_UTIL_STATE_UTIL_H_
@@ -0,0 +1,291 @@
+//
+// Copyright 2013 Yangbin Lin and Bili Chen. All Rights Reserved.
+//
+// Author: yblin.xmu@qq.com (Yangbin Lin)
+//
+// To use this code, please cite the follow paper:
+//
+// Chen B, Zeng W, Lin Y, et al. A New Local Search-Based Multiobjective
+// Optimization Algorithm[J]. IEEE Transactions on Evolutionary Computation,
+// 2014, 19(1):1-1.
+//
+
+#ifndef SOLVER_UTIL_TERMINATION_H_
+#define SOLVER_UTIL_TERMINATION_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cfloat>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+#include "core/population.h"
+
+namespace moo {
+
+/// Stopping Criteria for BasicSolver::Run().
+/**
+ * Termination combines any number of stopping criteria, the run stops as soon
+ * as one of the enabled criteria is met:
+ *
+ *   1. the number of generations reaches the limit;
+ *   2. the next generation would exceed the budget of evaluations (estimated
+ *      by the cost of the last generation, or by the cost given to Start()
+ *      for the first generation);
+ *   3. the wall-clock time since Start() exceeds the limit;
+ *   4. the non-dominated front stagnates.
+ *
+ * The stagnation is measured without any reference front. The front is the
+ * individuals of rank 0, as sorted by the solver. The movement of the front is
+ * the average distance from the points of current front to their nearest
+ * points of a reference front, normalized by the range of reference front.
+ * The reference front is replaced by the current front whenever the movement
+ * exceeds the tolerance, so that a slow drift is still detected. If the
+ * movement stays below the tolerance for 'window' generations, the front is
+ * stagnant.
+ *
+ * The distances of the points are kept until the reference is replaced, so
+ * each check costs O(N log N) for N individuals, plus O(R M) for each point
+ * that entered the front, where R is the size of reference front and M the
+ * number of objectives.
+ *
+ * Usage:
+ *    Termination termination;
+ *    termination.set_max_evaluations(1000000);
+ *    termination.set_stagnation(20, 1e-3);
+ *    solver.Run(&termination, &population);
+ */
+class Termination {
+public:
+    // The reason of termination.
+    enum Reason {
+        NONE,            // Not terminated.
+        MAX_GENERATIONS, // The limit of generations is reached.
+        MAX_EVALUATIONS, // The budget of evaluations is used up.
+        TIME_LIMIT,      // The wall-clock time limit is exceeded.
+        STAGNATION       // The non-dominated front stagnates.
+    };
+
+    Termination()
+        : max_generations_(-1),
+          max_evaluations_(-1),
+          time_limit_(-1.0),
+          window_(0),
+          tolerance_(0.0),
+          n_objectives_(0) {
+        Start();
+    }
+
+    /**
+     * Restart the clock and the stagnation detection. It is called at the
+     * beginning of BasicSolver::Run(), with the maximum number of evaluations
+     * of the first generation, which has no last generation to measure.
+     */
+    void Start(int64_t first_cost = 0) {
+        assert(first_cost >= 0);
+
+        start_time_ = std::chrono::steady_clock::now();
+        reason_ = NONE;
+        last_n_evaluations_ = -1;
+        last_cost_ = first_cost;
+        n_stagnant_ = 0;
+        reference_.clear();
+        distances_.clear();
+    }
+
+    /**
+     * Check if the run should stop after the given generation.
+     */
+    bool Check(int n_generation, int64_t n_evaluations,
+               const Population& population) {
+        if (last_n_evaluations_ >= 0) {
+            last_cost_ = n_evaluations - last_n_evaluations_;
+        }
+        last_n_evaluations_ = n_evaluations;
+
+        if (max_generations_ >= 0 && n_generation >= max_generations_) {
+            reason_ = MAX_GENERATIONS;
+        } else if (max_evaluations_ >= 0 &&
+                   n_evaluations + last_cost_ > max_evaluations_) {
+            reason_ = MAX_EVALUATIONS;
+        } else if (time_limit_ >= 0.0 && elapsed_time() >= time_limit_) {
+            reason_ = TIME_LIMIT;
+        } else if (window_ > 0 && UpdateStagnation(population)) {
+            reason_ = STAGNATION;
+        } else {
+            reason_ = NONE;
+        }
+        return reason_ != NONE;
+    }
+
+    /**
+     * Stop when the number of generations reaches 'max_generations'.
+     */
+    void set_max_generations(int max_generations) {
+        assert(max_generations >= 0);
+
+        max_generations_ = max_generations;
+    }
+
+    /**
+     * Stop before the number of evaluations exceeds 'max_evaluations'.
+     */
+    void set_max_evaluations(int64_t max_evaluations) {
+        assert(max_evaluations >= 0);
+
+        max_evaluations_ = max_evaluations;
+    }
+
+    /**
+     * Stop when the wall-clock time of run exceeds 'seconds'.
+     */
+    void set_time_limit(double seconds) {
+        assert(seconds >= 0.0);
+
+        time_limit_ = seconds;
+    }
+
+    /**
+     * Stop when the movement of front is less than 'tolerance' for 'window'
+     * generations, see the class comment.
+     */
+    void set_stagnation(int window, double tolerance) {
+        assert(window > 0);
+        assert(tolerance >= 0.0);
+
+        window_ = window;
+        tolerance_ = tolerance;
+    }
+
+    /**
+     * Return the seconds since Start().
+     */
+    double elapsed_time() const {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                             start_time_).count();
+    }
+
+    Reason reason()                  const { return reason_;     }
+    int n_stagnant()                 const { return n_stagnant_; }
+
+private:
+    /**
+     * Update the stagnation detection by the population.
+     *
+     * @return true if the front is stagnant.
+     */
+    bool UpdateStagnation(const Population& population) {
+        GetFront(population);
+        if (front_.empty()) return false;
+
+        if (reference_.empty()) {
+            SetReference();
+            return false;
+        }
+
+        if (Movement() > tolerance_) {
+            SetReference();
+            n_stagnant_ = 0;
+        } else {
+            ++n_stagnant_;
+        }
+        return n_stagnant_ >= window_;
+    }
+
+    /**
+     * Get the objectives of the individuals of rank 0.
+     */
+    void GetFront(const Population& population) {
+        front_.clear();
+        for (const Individual& individual : population) {
+            if (individual.rank == 0) front_.push_back(individual.objectives);
+        }
+        if (!front_.empty()) {
+            n_objectives_ = static_cast<int>(front_[0].size());
+        }
+    }
+
+    /**
+     * Set the current front as the reference front.
+     */
+    void SetReference() {
+        reference_.clear();
+        for (const std::vector<double>& point : front_) {
+            reference_.insert(reference_.end(), point.begin(), point.end());
+        }
+        distances_.clear();
+
+        scales_.assign(n_objectives_, 0.0);
+        for (int k = 0; k < n_objectives_; ++k) {
+            double min = DBL_MAX, max = -DBL_MAX;
+            for (size_t i = k; i < reference_.size(); i += n_objectives_) {
+                min = std::min(min, reference_[i]);
+                max = std::max(max, reference_[i]);
+            }
+            scales_[k] = max - min > 0.0 ? 1.0 / (max - min) : 1.0;
+        }
+    }
+
+    /**
+     * The average normalized distance from the current front to the reference
+     * front. Only the points that entered the front since the last check are
+     * compared with the reference front.
+     */
+    double Movement() {
+        std::map<std::vector<double>, double> distances;
+        double sum = 0.0;
+        for (const std::vector<double>& point : front_) {
+            std::map<std::vector<double>, double>::const_iterator i =
+                    distances_.find(point);
+            double distance = i != distances_.end() ? i->second
+                                                    : Distance(point);
+            distances[point] = distance;
+            sum += distance;
+        }
+        distances_.swap(distances);
+        return sum / front_.size();
+    }
+
+    /**
+     * The normalized distance from the point to the reference front.
+     */
+    double Distance(const std::vector<double>& point) const {
+        double min_distance = DBL_MAX;
+        for (size_t j = 0; j < reference_.size(); j += n_objectives_) {
+            double d = 0.0;
+            for (int k = 0; k < n_objectives_; ++k) {
+                double t = (point[k] - reference_[j + k]) * scales_[k];
+                d += t * t;
+            }
+            min_distance = std::min(min_distance, d);
+        }
+        return std::sqrt(min_distance);
+    }
+
+    int max_generations_;     // The limit of generations, -1 if disabled.
+    int64_t max_evaluations_; // The budget of evaluations, -1 if disabled.
+    double time_limit_;       // The limit of seconds, negative if disabled.
+    int window_;              // The window of stagnation, 0 if disabled.
+    double tolerance_;        // The tolerance of front movement.
+
+    std::chrono::steady_clock::time_point start_time_; // The start time.
+    Reason reason_;                 // The reason of the last check.
+    int64_t last_n_evaluations_;    // The evaluations at the last check.
+    int64_t last_cost_;             // The evaluations of the last generation.
+
+    int n_objectives_;              // The number of objectives.
+    int n_stagnant_;                // The number of stagnant generations.
+    std::vector<std::vector<double> > front_; // The current front.
+    std::vector<double> reference_; // The reference front, row by row.
+    std::vector<double> scales_;    // The normalization of objectives.
+
+    // The distances of the last front to the reference front.
+    std::map<std::vector<double>, double> distances_;
+};
+
+} // namespace moo
+
+#endif // SOLVER_UTIL_TERMINATION_H_
@@ -0,0 +1,454 @@
+//
+// Copyright 2013 Yangbin Lin and Bili Chen. All Rights Reserved.
+//
+// Author: yblin.xmu@qq.com (Yangbin Lin)
+//
+// To use this code, please cite the follow paper:
+//
+// Chen B, Zeng W, Lin Y, et al. A New Local Search-Based Multiobjective
+// Optimization Algorithm[J]. IEEE Transactions on Evolutionary Computation,
+// 2014, 19(1):1-1.
+//
+
+#ifndef SOLVER_UTIL_TRAJECTORY_LOGGER_H_
+#define SOLVER_UTIL_TRAJECTORY_LOGGER_H_
+
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "codelibrary/base/macros.h"
+#include "codelibrary/util/io/mapped_file.h"
+#include "codelibrary/util/queue/spsc_queue.h"
+#include "core/population.h"
+
+namespace moo {
+
+/// A snapshot of population in one generation.
+struct TrajectoryFrame {
+    TrajectoryFrame()
+        : generation(0), n_rows(0), n_objectives(0), n_variables(0) {}
+
+    int generation;                // The generation of snapshot.
+    int n_rows;                    // The number of logged individuals.
+    int n_objectives;              // The number of objectives.
+    int n_variables;               // The number of variables, 0 if the
+                                   // variables are not logged.
+    std::vector<double> objectives; // The row-major objectives.
+    std::vector<double> variables;  // The row-major variables.
+};
+
+/// Asynchronous Trajectory Logger.
+/**
+ * TrajectoryLogger records the population of each generation without stalling
+ * the solver. Log() only copies the population into a frame and hands it to a
+ * background writer thread through a lock-free queue. If the queue is full, the
+ * frame is dropped and counted, the solver never waits for the disk.
+ *
+ * The file consists of a header ("NSLSTRAJ", version) and one chunk per frame:
+ *
+ *   generation (int64), n_rows, n_objectives, n_variables, 0 (uint32 * 4),
+ *   payload size (uint64), payload.
+ *
+ * The payload is columnar: the objectives and then the variables, one column
+ * after another. Each value is XORed with the previous value in its column, and
+ * only the non-zero low bytes of the result are stored, with a 4-bit length
+ * per value (two lengths share a control byte). Converged columns, bounded
+ * variables and similar values therefore take much less than 8 bytes. The
+ * encoding is lossless, use Read() to decode the frames.
+ *
+ * A failed write (e.g., the disk is full) does not stop the solver either. It
+ * is recorded, and reported by Flush() and Close().
+ */
+class TrajectoryLogger {
+public:
+    /**
+     * Create a logger, queue_capacity is the maximum number of frames waiting
+     * to be written.
+     */
+    explicit TrajectoryLogger(int queue_capacity = 64)
+        : stride_(1),
+          max_rows_(0),
+          log_variables_(false),
+          file_(NULL),
+          queue_(queue_capacity),
+          spare_frames_(queue_capacity),
+          stop_(false),
+          write_error_(false),
+          n_logged_(0),
+          n_dropped_(0),
+          n_written_(0),
+          n_bytes_(0) {}
+
+    ~TrajectoryLogger() {
+        Close();
+    }
+
+    /**
+     * Open the file and start the writer thread.
+     */
+    bool Open(const std::string& file) {
+        Close();
+
+        file_ = std::fopen(file.c_str(), "wb");
+        if (!file_) return false;
+
+        std::setvbuf(file_, NULL, _IOFBF, 1 << 20);
+
+        uint32_t version = VERSION, reserved = 0;
+        if (std::fwrite("NSLSTRAJ", 1, 8, file_) != 8 ||
+            std::fwrite(&version, sizeof(version), 1, file_) != 1 ||
+            std::fwrite(&reserved, sizeof(reserved), 1, file_) != 1) {
+            std::fclose(file_);
+            file_ = NULL;
+            return false;
+        }
+
+        stop_ = false;
+        write_error_ = false;
+        writer_ = std::thread(&TrajectoryLogger::WriterLoop, this);
+        return true;
+    }
+
+    /**
+     * Write all pending frames, stop the writer thread and close the file.
+     *
+     * @return false if any frame could not be written.
+     */
+    bool Close() {
+        if (!file_) return true;
+
+        stop_ = true;
+        writer_.join();
+        bool ok = std::fclose(file_) == 0 && !write_error_;
+        file_ = NULL;
+        return ok;
+    }
+
+    /**
+     * Wait until all logged frames are written, and flush the file. Only the
+     * solver thread can call it.
+     *
+     * @return false if any frame could not be written since Open().
+     */
+    bool Flush() {
+        if (!file_) return true;
+
+        while (n_written_ < n_logged_) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        // The writer thread is idle now, and the stream is locked by stdio.
+        if (std::fflush(file_) != 0) write_error_ = true;
+        return !write_error_;
+    }
+
+    /**
+     * Log the population of the given generation. Only the solver thread can
+     * call it.
+     *
+     * @return false if the frame is skipped by the stride, or dropped because
+     *         the writer can not keep up.
+     */
+    bool Log(int generation, const Population& population) {
+        if (!file_ || generation % stride_ != 0 || population.empty()) {
+            return false;
+        }
+
+        // Reuse the buffers of written frames if possible.
+        TrajectoryFrame frame;
+        spare_frames_.TryPop(&frame);
+
+        int n = static_cast<int>(population.size());
+        int n_rows = max_rows_ > 0 && max_rows_ < n ? max_rows_ : n;
+        int n_objectives = static_cast<int>(population[0].objectives.size());
+        int n_variables = log_variables_ ?
+                    static_cast<int>(population[0].variables.size()) : 0;
+
+        frame.generation = generation;
+        frame.n_rows = n_rows;
+        frame.n_objectives = n_objectives;
+        frame.n_variables = n_variables;
+        frame.objectives.resize(n_rows * n_objectives);
+        frame.variables.resize(n_rows * n_variables);
+        for (int r = 0; r < n_rows; ++r) {
+            // Uniformly sample the rows if max_rows is set.
+            const Individual& ind = population[
+                    static_cast<int64_t>(r) * n / n_rows];
+            std::copy(ind.objectives.begin(), ind.objectives.end(),
+                      frame.objectives.begin() + r * n_objectives);
+            if (n_variables > 0) {
+                std::copy(ind.variables.begin(), ind.variables.end(),
+                          frame.variables.begin() + r * n_variables);
+            }
+        }
+
+        if (!queue_.TryPush(&frame)) {
+            ++n_dropped_;
+            return false;
+        }
+        ++n_logged_;
+        return true;
+    }
+
+    /**
+     * Read all frames from a trajectory file.
+     */
+    static bool Read(const std::string& file,
+                     std::vector<TrajectoryFrame>* frames) {
+        assert(frames);
+
+        cl::MappedFile mapped_file;
+        if (!mapped_file.Open(file)) return false;
+
+        const unsigned char* data =
+                reinterpret_cast<const unsigned char*>(mapped_file.data());
+        size_t size = mapped_file.size();
+
+        uint32_t version;
+        if (size < 16 || std::memcmp(data, "NSLSTRAJ", 8) != 0) return false;
+        std::memcpy(&version, data + 8, sizeof(version));
+        if (version == 0 || version > VERSION) return false;
+
+        frames->clear();
+        size_t offset = 16;
+        while (offset < size) {
+            ChunkHeader header;
+            if (size - offset < sizeof(header)) return false;
+            std::memcpy(&header, data + offset, sizeof(header));
+            offset += sizeof(header);
+            if (header.payload_size > size - offset) return false;
+
+            // Check the counts before allocating the frame. A logged frame has
+            // at least one row, and each pair of rows takes at least a control
+            // byte per column.
+            if (header.n_rows == 0 || header.n_rows > INT_MAX ||
+                header.n_objectives > INT_MAX ||
+                header.n_variables > INT_MAX) {
+                return false;
+            }
+            uint64_t n_columns = static_cast<uint64_t>(header.n_objectives) +
+                                 header.n_variables;
+            if ((header.n_rows / 2 + header.n_rows % 2) * n_columns >
+                header.payload_size) {
+                return false;
+            }
+
+            TrajectoryFrame frame;
+            frame.generation = static_cast<int>(header.generation);
+            frame.n_rows = header.n_rows;
+            frame.n_objectives = header.n_objectives;
+            frame.n_variables = header.n_variables;
+            frame.objectives.resize(static_cast<size_t>(frame.n_rows) *
+                                    frame.n_objectives);
+            frame.variables.resize(static_cast<size_t>(frame.n_rows) *
+                                   frame.n_variables);
+
+            const unsigned char* p = data + offset;
+            const unsigned char* end = p + header.payload_size;
+            for (int c = 0; c < frame.n_objectives; ++c) {
+                if (!DecodeColumn(&p, end, frame.n_rows, frame.n_objectives,
+                                  &frame.objectives[c])) {
+                    return false;
+                }
+            }
+            for (int c = 0; c < frame.n_variables; ++c) {
+                if (!DecodeColumn(&p, end, frame.n_rows, frame.n_variables,
+                                  &frame.variables[c])) {
+                    return false;
+                }
+            }
+            if (p != end) return false;
+
+            offset += header.payload_size;
+            frames->push_back(frame);
+        }
+
+        return true;
+    }
+
+    /**
+     * Only log every 'stride' generations.
+     */
+    void set_stride(int stride) {
+        assert(stride > 0);
+
+        stride_ = stride;
+    }
+
+    /**
+     * Log at most 'max_rows' uniformly sampled individuals per generation, 0
+     * means all individuals.
+     */
+    void set_max_rows(int max_rows) {
+        assert(max_rows >= 0);
+
+        max_rows_ = max_rows;
+    }
+
+    /**
+     * Also log the variables of individuals.
+     */
+    void set_log_variables(bool log_variables) {
+        log_variables_ = log_variables;
+    }
+
+    bool is_open()           const { return file_ != NULL; }
+    bool write_error()       const { return write_error_;  }
+    int n_logged()           const { return n_logged_;     }
+    int n_dropped()          const { return n_dropped_;    }
+    int n_written()          const { return n_written_;    }
+    int64_t n_bytes()        const { return n_bytes_;      }
+
+private:
+    // The current version of file format.
+    static const uint32_t VERSION = 1;
+
+    // The header of each chunk.
+    struct ChunkHeader {
+        int64_t generation;
+        uint32_t n_rows;
+        uint32_t n_objectives;
+        uint32_t n_variables;
+        uint32_t reserved;
+        uint64_t payload_size;
+    };
+
+    /**
+     * The writer thread, it encodes and writes the frames until Close().
+     */
+    void WriterLoop() {
+        TrajectoryFrame frame;
+        std::vector<unsigned char> payload;
+
+        while (true) {
+            if (queue_.TryPop(&frame)) {
+                Write(frame, &payload);
+                spare_frames_.TryPush(&frame);
+            } else if (stop_) {
+                // The producer has stopped, so the queue is final.
+                if (queue_.empty()) break;
+            } else {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+        if (std::fflush(file_) != 0) write_error_ = true;
+    }
+
+    /**
+     * Encode and write a frame.
+     */
+    void Write(const TrajectoryFrame& frame,
+               std::vector<unsigned char>* payload) {
+        payload->clear();
+        for (int c = 0; c < frame.n_objectives; ++c) {
+            EncodeColumn(&frame.objectives[c], frame.n_rows, frame.n_objectives,
+                         payload);
+        }
+        for (int c = 0; c < frame.n_variables; ++c) {
+            EncodeColumn(&frame.variables[c], frame.n_rows, frame.n_variables,
+                         payload);
+        }
+
+        ChunkHeader header;
+        header.generation = frame.generation;
+        header.n_rows = frame.n_rows;
+        header.n_objectives = frame.n_objectives;
+        header.n_variables = frame.n_variables;
+        header.reserved = 0;
+        header.payload_size = payload->size();
+
+        if (std::fwrite(&header, sizeof(header), 1, file_) != 1 ||
+            (!payload->empty() &&
+             std::fwrite(payload->data(), 1, payload->size(), file_) !=
+             payload->size())) {
+            write_error_ = true;
+        }
+        n_bytes_ += sizeof(header) + payload->size();
+        ++n_written_;
+    }
+
+    /**
+     * Encode n values (values[0], values[stride], ...) of a column.
+     */
+    static void EncodeColumn(const double* values, int n, int stride,
+                             std::vector<unsigned char>* out) {
+        uint64_t prev = 0;
+        for (int i = 0; i < n; i += 2) {
+            uint64_t x[2] = { 0, 0 };
+            int length[2] = { 0, 0 };
+            for (int k = 0; k < 2 && i + k < n; ++k) {
+                uint64_t bits;
+                std::memcpy(&bits, &values[(i + k) * stride], sizeof(bits));
+                x[k] = bits ^ prev;
+                prev = bits;
+                while (length[k] < 8 && (x[k] >> (8 * length[k])) != 0) {
+                    ++length[k];
+                }
+            }
+
+            out->push_back(static_cast<unsigned char>(length[0] |
+                                                      (length[1] << 4)));
+            for (int k = 0; k < 2; ++k) {
+                for (int b = 0; b < length[k]; ++b) {
+                    out->push_back(static_cast<unsigned char>(x[k] >> (8 * b)));
+                }
+            }
+        }
+    }
+
+    /**
+     * Decode a column encoded by EncodeColumn.
+     */
+    static bool DecodeColumn(const unsigned char** p, const unsigned char* end,
+                             int n, int stride, double* values) {
+        uint64_t prev = 0;
+        for (int i = 0; i < n; i += 2) {
+            if (*p >= end) return false;
+            int control = *(*p)++;
+            for (int k = 0; k < 2 && i + k < n; ++k) {
+                int length = (control >> (4 * k)) & 15;
+                if (length > 8 || end - *p < length) return false;
+
+                uint64_t x = 0;
+                for (int b = 0; b < length; ++b) {
+                    x |= static_cast<uint64_t>(*(*p)++) << (8 * b);
+                }
+                prev ^= x;
+                std::memcpy(&values[(i + k) * stride], &prev, sizeof(prev));
+            }
+        }
+        return true;
+    }
+
+    int stride_;         // Log every 'stride' generations.
+    int max_rows_;       // The maximum number of rows per frame, 0 if no limit.
+    bool log_variables_; // True to log the variables.
+
+    FILE* file_;         // The output file.
+    std::thread writer_; // The writer thread.
+
+    // The frames waiting to be written, and the written frames whose buffers
+    // can be reused by Log().
+    cl::SPSCQueue<TrajectoryFrame> queue_;
+    cl::SPSCQueue<TrajectoryFrame> spare_frames_;
+
+    std::atomic<bool> stop_;        // True if the writer should stop.
+    std::atomic<bool> write_error_; // True if any writing failed.
+    int n_logged_;                  // The number of queued frames.
+    int n_dropped_;                 // The number of dropped frames.
+    std::atomic<int> n_written_;    // The number of written frames.
+    std::atomic<int64_t> n_bytes_;  // The number of written bytes.
+
+    DISALLOW_COPY_AND_ASSIGN(TrajectoryLogger);
+};
+
+} // namespace moo
+
+#endif // SOLVER_UTIL_TRAJECTORY_LOGGER_H_
@@ -13,10 +13,16 @@
 #ifndef SOLVER_UPDATER_NSLS_UPDATER_H_
 #define SOLVER_UPDATER_NSLS_UPDATER_H_
 
+#include <algorithm>
+#include <cstdint>
 #include <random>
+#include <vector>
+
+#include "codelibrary/util/array/array_2d.h"
 
 #include "core/population.h"
 #include "solver/util/individual_util.h"
+#include "solver/util/surrogate.h"
 #include "test/basic_test.h"
 
 #include "solver/util/population_util.h"
@@ -25,29 +31,107 @@ namespace moo {
 
 /// NSLS updater.
 class NSLSUpdater {
+    // Accept either trial at random, see Accept().
+    static const int EITHER = 3;
+
 public:
-    void operator() (const BasicTest& test, Population* population) const {
+    NSLSUpdater()
+        : n_avoided_objectives_(0) {}
+
+    /**
+     * Update the population by local search. All random numbers are drawn from
+     * the given random engine, so that the update is reproducible.
+     *
+     * If a surrogate is given, the trials predicted to be dominated are
+     * skipped without evaluation, see Surrogate.
+     *
+     * If the variables are given (e.g., by a VariableScheduler), only these
+     * variables are tried instead of all, for the large-scale problems.
+     *
+     * If the test gives the costs of its objectives, the objectives of the
+     * trials are evaluated one by one from the cheapest, until the accepted
+     * trial is known regardless of the others. Then only the accepted trial is
+     * evaluated completely. The population and the random numbers are the
+     * same as evaluating all objective functions of the trials. The lazy
+     * evaluation replaces the incremental one, whose results may differ by
+     * rounding, so the run may differ from the one without costs for a test
+     * with incremental objectives. It is not used with a surrogate, or with a
+     * batch evaluator, which must see every evaluation (e.g., a
+     * ProcessPoolEvaluator or a StoredEvaluator).
+     *
+     * @return the number of evaluated trial individuals, including the ones
+     *         evaluated lazily.
+     */
+    int operator() (const BasicTest& test, std::mt19937* random,
+                    Population* population,
+                    Surrogate* surrogate = NULL,
+                    const std::vector<int>* variables = NULL) {
+        assert(random);
         assert(population);
 
-        unsigned int seed = time(NULL);
         std::normal_distribution<double> normal_distribution(0.5, 0.1);
-        std::mt19937 mt_random(seed);
 
+        // If the test has a batch evaluator, the two trials are evaluated as
+        // a batch by it.
+        bool batch = test.has_batch_evaluator();
+        cl::Array2D<double> trials, trial_objectives;
+
+        // Otherwise use the incremental evaluation if the test supports it,
+        // since only one variable is changed for each trial. For a subset of
+        // variables of a large-scale test, it is used even if the test has a
+        // batch evaluator, since a trial updates a small part of the objectives
+        // instead of evaluating all variables again.
+        bool incremental = test.has_incremental_objectives() &&
+                           (!batch || variables);
+        if (incremental) {
+            batch = false;
+        }
+        std::vector<double> state, state1, state2;
+
+        // The lazy evaluation calls the objective functions one by one, so it
+        // replaces the incremental evaluation, but never the batch evaluator.
+        bool lazy = test.has_objective_costs() && !surrogate &&
+                    !test.has_batch_evaluator() && !test.objectives.empty();
+        std::vector<int> order;
+        if (lazy) {
+            assert(test.objective_costs.size() == test.objectives.size());
+
+            incremental = false;
+            order.resize(test.objectives.size());
+            for (size_t k = 0; k < order.size(); ++k) {
+                order[k] = static_cast<int>(k);
+            }
+            std::stable_sort(order.begin(), order.end(), [&test] (int a,
+                                                                  int b) {
+                return test.objective_costs[a] < test.objective_costs[b];
+            });
+        }
+
+        int n_evaluations = 0;
         for (size_t i = 0; i < population->size(); ++i) {
-            for (int j = 0; j < test.parameter.n_variables; ++j) {
+            Individual& b = (*population)[i];
+
+            // The trial individuals only differ from b in the j-th variable.
+            Individual a1 = b;
+            Individual a2 = b;
+            if (incremental) {
+                test.partial_state(b.variables, &state);
+            }
+
+            int n_variables = variables ?
+                    static_cast<int>(variables->size()) :
+                    test.parameter.n_variables;
+            for (int k = 0; k < n_variables; ++k) {
+                int j = variables ? (*variables)[k] : k;
                 double v_min = test.parameter.min_variables[j];
                 double v_max = test.parameter.max_variables[j];
 
-                Individual a1 = (*population)[i];
-                Individual a2 = (*population)[i];
-                const Individual& b = (*population)[i];
-
                 double v = b.variables[j];
 
-                int rnd1 = rand() % population->size();
-                int rnd2 = rand() % population->size();
+                int rnd1 = (*random)() % population->size();
+                int rnd2 = (*random)() % population->size();
 
-                double rnd3 = normal_distribution(mt_random);
+                double rnd3 = normal_distribution(*random);
 
                 double v1 = v + rnd3 * ((*population)[rnd1].variables[j] -
                                         (*population)[rnd2].variables[j]);
@@ -67,30 +151,259 @@ public:
                     v2 = v_max;
                 }
 
+                Surrogate::Outcome p1 = Surrogate::UNKNOWN;
+                Surrogate::Outcome p2 = Surrogate::UNKNOWN;
+                bool skip1 = false, skip2 = false;
+                if (surrogate) {
+                    p1 = surrogate->Predict(j, v, v1, b.objectives);
+                    p2 = surrogate->Predict(j, v, v2, b.objectives);
+                    skip1 = surrogate->Skip(p1, random);
+                    skip2 = surrogate->Skip(p2, random);
+                }
+
                 a1.variables[j] = v1;
                 a2.variables[j] = v2;
-                IndividualUtil::SetObjectives(test.objectives, &a1);
-                IndividualUtil::SetObjectives(test.objectives, &a2);
-
-                int t1 = IndividualUtil::Dominance(a1, b);
-                int t2 = IndividualUtil::Dominance(a2, b);
-
-                if (t1 == 1 && t2 == 1) {
-                    (*population)[i] = rand() % 2 ? a1 : a2;
-                } else if (t1 == 1) {
-                    (*population)[i] = a1;
-                } else if (t2 == 1) {
-                    (*population)[i] = a2;
-                } else if (t1 == 0 && t2 == -1) {
-                    (*population)[i] = a1;
-                } else if (t2 == 0 && t1 == -1) {
-                    (*population)[i] = a2;
-                } else if (t1 == 0 && t2 == 0) {
-                    (*population)[i] = rand() % 2 ? a1 : a2;
+
+                // The accepted trial, 0 if b is kept.
+                int accepted = 0;
+                if (lazy) {
+                    accepted = EvaluateLazily(test, order, b, random, &a1,
+                                              &a2);
+                    n_evaluations += 2;
+                } else {
+                    if (batch) {
+                        EvaluateBatch(test, skip1 ? NULL : &a1,
+                                      skip2 ? NULL : &a2, &trials,
+                                      &trial_objectives);
+                        n_evaluations += !skip1 + !skip2;
+                    } else {
+                        if (!skip1) {
+                            Evaluate(test, incremental, j, v, state, &state1,
+                                     &a1);
+                            ++n_evaluations;
+                        }
+                        if (!skip2) {
+                            Evaluate(test, incremental, j, v, state, &state2,
+                                     &a2);
+                            ++n_evaluations;
+                        }
+                    }
+
+                    // A skipped trial is treated as dominated.
+                    int t1 = skip1 ? -1 : IndividualUtil::Dominance(a1, b);
+                    int t2 = skip2 ? -1 : IndividualUtil::Dominance(a2, b);
+
+                    if (surrogate) {
+                        if (!skip1) {
+                            surrogate->Update(j, v, v1, b.objectives,
+                                              a1.objectives, p1);
+                        }
+                        if (!skip2) {
+                            surrogate->Update(j, v, v2, b.objectives,
+                                              a2.objectives, p2);
+                        }
+                    }
+
+                    accepted = Accept(t1, t2);
+                    if (accepted == EITHER) {
+                        accepted = (*random)() % 2 ? 1 : 2;
+                    }
                 }
+
+                if (accepted == 1) {
+                    b.variables[j] = v1;
+                    b.objectives = a1.objectives;
+                    state.swap(state1);
+                } else if (accepted == 2) {
+                    b.variables[j] = v2;
+                    b.objectives = a2.objectives;
+                    state.swap(state2);
+                }
+
+                a1.variables[j] = b.variables[j];
+                a2.variables[j] = b.variables[j];
             }
         }
+
+        return n_evaluations;
     }
+
+    /**
+     * The number of objective calls saved by the lazy evaluation.
+     */
+    int64_t n_avoided_objectives() const { return n_avoided_objectives_; }
+
+private:
+    /**
+     * The accepted trial by the dominances t1 and t2 of the trials over b:
+     * the dominating trial, or the non-dominated one if the other is
+     * dominated, or EITHER if both dominate or both are non-dominated, and 0
+     * (keep b) otherwise.
+     */
+    static int Accept(int t1, int t2) {
+        if (t1 == 1 && t2 == 1) {
+            return EITHER;
+        } else if (t1 == 1) {
+            return 1;
+        } else if (t2 == 1) {
+            return 2;
+        } else if (t1 == 0 && t2 == -1) {
+            return 1;
+        } else if (t2 == 0 && t1 == -1) {
+            return 2;
+        } else if (t1 == 0 && t2 == 0) {
+            return EITHER;
+        }
+        return 0;
+    }
+
+    /**
+     * Evaluate the objectives of the trials a1 and a2 in the given order until
+     * the accepted trial does not depend on the other objectives, and then
+     * complete the accepted trial.
+     *
+     * @return the accepted trial, see Accept(), where EITHER is drawn at
+     *         random as the eager evaluation.
+     */
+    int EvaluateLazily(const BasicTest& test, const std::vector<int>& order,
+                       const Individual& b, std::mt19937* random,
+                       Individual* a1, Individual* a2) {
+        Individual* trials[2] = { a1, a2 };
+        const int m = static_cast<int>(order.size());
+        int n_evaluated[2] = { 0, 0 };
+        bool better[2] = { false, false };
+        bool worse[2] = { false, false };
+
+        int accepted = 0;
+        for (;;) {
+            int outcomes[2];
+            for (int t = 0; t < 2; ++t) {
+                outcomes[t] = Outcomes(n_evaluated[t] == m, better[t],
+                                       worse[t]);
+            }
+            if (Decide(outcomes[0], outcomes[1], &accepted)) break;
+
+            // The next objective of the undecided trial with the fewer
+            // evaluated objectives, i.e., the cheaper one.
+            int t = 0;
+            if (IsSingle(outcomes[0]) ||
+                (!IsSingle(outcomes[1]) && n_evaluated[1] < n_evaluated[0])) {
+                t = 1;
+            }
+            int k = order[n_evaluated[t]++];
+            double f = (test.objectives[k])(trials[t]->variables);
+            trials[t]->objectives[k] = f;
+            better[t] |= f < b.objectives[k];
+            worse[t] |= f > b.objectives[k];
+        }
+
+        if (accepted == EITHER) {
+            accepted = (*random)() % 2 ? 1 : 2;
+        }
+        if (accepted != 0) {
+            int t = accepted - 1;
+            for (; n_evaluated[t] < m; ++n_evaluated[t]) {
+                int k = order[n_evaluated[t]];
+                trials[t]->objectives[k] =
+                        (test.objectives[k])(trials[t]->variables);
+            }
+        }
+
+        n_avoided_objectives_ += 2 * m - n_evaluated[0] - n_evaluated[1];
+        return accepted;
+    }
+
+    /**
+     * The possible dominances of a partially evaluated trial over b, as the
+     * bits of -1, 0 and 1, given that it is better or worse than b in some of
+     * the evaluated objectives.
+     */
+    static int Outcomes(bool complete, bool better, bool worse) {
+        const int dominated = 1, non_dominated = 2, dominating = 4;
+
+        if (better && worse) return non_dominated;
+        if (complete) {
+            return better ? dominating : (worse ? dominated : non_dominated);
+        }
+        if (better) return dominating | non_dominated;
+        if (worse) return dominated | non_dominated;
+        return dominated | non_dominated | dominating;
+    }
+
+    static bool IsSingle(int outcomes) {
+        return (outcomes & (outcomes - 1)) == 0;
+    }
+
+    /**
+     * Check if all possible dominances of the two trials accept the same
+     * trial, which is returned.
+     */
+    static bool Decide(int outcomes1, int outcomes2, int* accepted) {
+        int decision = -1;
+        for (int t1 = -1; t1 <= 1; ++t1) {
+            if (!(outcomes1 >> (t1 + 1) & 1)) continue;
+            for (int t2 = -1; t2 <= 1; ++t2) {
+                if (!(outcomes2 >> (t2 + 1) & 1)) continue;
+                int d = Accept(t1, t2);
+                if (decision != -1 && d != decision) return false;
+                decision = d;
+            }
+        }
+        *accepted = decision;
+        return true;
+    }
+
+    /**
+     * Evaluate the trial a, whose index-th variable is changed from
+     * 'old_value'. For the incremental evaluation, the partial state of a is
+     * derived from the given state of b.
+     */
+    static void Evaluate(const BasicTest& test, bool incremental, int index,
+                         double old_value, const std::vector<double>& state,
+                         std::vector<double>* trial_state, Individual* a) {
+        if (incremental) {
+            *trial_state = state;
+            test.incremental_objectives(a->variables, index, old_value,
+                                        trial_state, &a->objectives);
+        } else {
+            IndividualUtil::SetObjectives(test.objectives, a);
+        }
+    }
+
+    /**
+     * Evaluate the trials a1 and a2 (NULL if skipped) by one call of the
+     * batch evaluator of test.
+     */
+    static void EvaluateBatch(const BasicTest& test, Individual* a1,
+                              Individual* a2, cl::Array2D<double>* variables,
+                              cl::Array2D<double>* objectives) {
+        Individual* trials[2] = { a1, a2 };
+        int n = (a1 != NULL) + (a2 != NULL);
+        if (n == 0) return;
+
+        int d = test.parameter.n_variables;
+        variables->Resize(n, d);
+        int k = 0;
+        for (Individual* a : trials) {
+            if (!a) continue;
+            std::copy(a->variables.begin(), a->variables.end(),
+                      variables->data().begin() + k * d);
+            ++k;
+        }
+
+        test.batch_evaluator->Evaluate(*variables, objectives);
+
+        int m = objectives->columns();
+        k = 0;
+        for (Individual* a : trials) {
+            if (!a) continue;
+            const double* row = objectives->data().data() + k * m;
+            a->objectives.assign(row, row + m);
+            ++k;
+        }
+    }
+
+    int64_t n_avoided_objectives_; // The objective calls saved by laziness.
 };
 
 } // namespace moo
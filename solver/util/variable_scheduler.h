@@ -0,0 +1,519 @@
+//
+// Copyright 2013 Yangbin Lin and Bili Chen. All Rights Reserved.
+//
+// Author: yblin.xmu@qq.com (Yangbin Lin)
+//
+// To use this code, please cite the follow paper:
+//
+// Chen B, Zeng W, Lin Y, et al. A New Local Search-Based Multiobjective
+// Optimization Algorithm[J]. IEEE Transactions on Evolutionary Computation,
+// 2014, 19(1):1-1.
+//
+
+#ifndef SOLVER_UTIL_VARIABLE_SCHEDULER_H_
+#define SOLVER_UTIL_VARIABLE_SCHEDULER_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "codelibrary/util/array/array_2d.h"
+#include "core/population.h"
+#include "solver/util/individual_util.h"
+#include "solver/util/population_util.h"
+#include "solver/util/state_util.h"
+#include "test/basic_test.h"
+
+namespace moo {
+
+/// Variable Scheduler of NSLS.
+/**
+ * NSLS tries every variable of every individual in each generation, i.e.,
+ * 2 * N * D evaluations per generation, which is too many for thousands of
+ * variables, and mostly wasted on the variables that already converged. The
+ * scheduler chooses the variables tried in each generation:
+ *
+ *   RANDOM       'block_size' variables drawn at random in each generation.
+ *   ROUND_ROBIN  the consecutive blocks of 'block_size' variables in turn.
+ *   GROUPED      the groups of interacting variables, packed into blocks of
+ *                about 'block_size' variables and tried in turn, so that the
+ *                interacting variables are tried together.
+ *   ADAPTIVE     each variable with the probability matched to the recent
+ *                success of its moves.
+ *
+ * The groups are found at the beginning of run. A variable is a position
+ * variable if some of its samples are non-dominated to each other, i.e., it
+ * trades off the objectives, and the position variables are one group. The
+ * other variables are grouped by the recursive differential grouping, which
+ * costs O(D log D) evaluations. Two sets of variables interact if the change
+ * of objectives by moving the first set depends on the value of the second
+ * one.
+ *
+ * ADAPTIVE is the probability matching of a multi-armed bandit whose arms are
+ * the variables. The reward of a variable is the fraction of individuals that
+ * moved it and dominate their parents after the generation where it was tried,
+ * smoothed exponentially, and it is tried with the probability
+ *
+ *   p_j = p_min + (1 - p_min) * q_j / max(q),
+ *
+ * where q_j is its smoothed reward (p_min if all rewards are 0). So the
+ * variables that converged are still tried every 1 / p_min generations on
+ * average, and they come back when their moves pay off again. All rewards
+ * start at 1, i.e., all variables are tried in the first generation. It saves
+ * the trials of the variables that converge early (e.g., ZDT), but it may cost
+ * quality where the distance variables keep following the position variables
+ * (e.g., LZ and UF).
+ *
+ * Reference:
+ *   Sun Y, Kirley M, Halgamuge S K. A recursive decomposition method for
+ *   large scale continuous optimization. IEEE Transactions on Evolutionary
+ *   Computation, 2018, 22(5): 647-661.
+ *
+ *   Thierens D. An adaptive pursuit strategy for allocating operator
+ *   probabilities. GECCO, 2005: 1539-1546.
+ *
+ * Usage:
+ *    VariableScheduler scheduler(VariableScheduler::GROUPED, 100);
+ *    solver.set_variable_scheduler(&scheduler);
+ */
+class VariableScheduler {
+    // The number of samples to classify a variable.
+    static const int N_SAMPLES = 5;
+
+public:
+    enum Strategy {
+        RANDOM,
+        ROUND_ROBIN,
+        GROUPED,
+        ADAPTIVE
+    };
+
+    /**
+     * The block size is not used by ADAPTIVE.
+     */
+    explicit VariableScheduler(Strategy strategy = GROUPED,
+                               int block_size = 100)
+        : strategy_(strategy),
+          block_size_(block_size),
+          min_rate_(0.1),
+          n_variables_(0),
+          n_saved_evaluations_(0) {
+        assert(block_size_ > 0);
+    }
+
+    /**
+     * Build the blocks for the given test. It is called by the solver at the
+     * beginning of run.
+     *
+     * @return the number of evaluations used to group the variables.
+     */
+    int Initialize(const BasicTest& test) {
+        n_variables_ = test.parameter.n_variables;
+        position_variables_.clear();
+        blocks_.clear();
+        rewards_.assign(n_variables_, 1.0);
+        n_saved_evaluations_ = 0;
+
+        std::vector<std::vector<int> > groups;
+        int n_evaluations = 0;
+        if (strategy_ == GROUPED) {
+            n_evaluations = Group(test, &groups);
+        } else if (strategy_ == ROUND_ROBIN) {
+            for (int i = 0; i < n_variables_; ++i) {
+                groups.push_back(std::vector<int>(1, i));
+            }
+        }
+
+        // Pack the groups into blocks in order.
+        std::vector<int> block;
+        for (const std::vector<int>& group : groups) {
+            if (!block.empty() &&
+                block.size() + group.size() >
+                static_cast<size_t>(block_size_)) {
+                blocks_.push_back(block);
+                block.clear();
+            }
+            block.insert(block.end(), group.begin(), group.end());
+        }
+        if (!block.empty() || blocks_.empty()) {
+            blocks_.push_back(block);
+        }
+        return n_evaluations;
+    }
+
+    /**
+     * Select the variables to try in the given generation, in increasing
+     * order.
+     */
+    void Select(int generation, std::mt19937* random,
+                std::vector<int>* variables) const {
+        assert(random);
+        assert(variables);
+        assert(generation >= 0);
+
+        if (strategy_ == RANDOM) {
+            int n = std::min(block_size_, n_variables_);
+            variables->resize(n_variables_);
+            for (int i = 0; i < n_variables_; ++i) {
+                (*variables)[i] = i;
+            }
+            for (int i = 0; i < n; ++i) {
+                int j = i + (*random)() % (n_variables_ - i);
+                std::swap((*variables)[i], (*variables)[j]);
+            }
+            variables->resize(n);
+        } else if (strategy_ == ADAPTIVE) {
+            double max_reward = *std::max_element(rewards_.begin(),
+                                                  rewards_.end());
+            std::uniform_real_distribution<double> uniform(0.0, 1.0);
+            variables->clear();
+            for (int i = 0; i < n_variables_; ++i) {
+                double p = min_rate_;
+                if (max_reward > 0.0) {
+                    p += (1.0 - min_rate_) * rewards_[i] / max_reward;
+                }
+                if (uniform(*random) < p) {
+                    variables->push_back(i);
+                }
+            }
+        } else {
+            *variables = blocks_[generation % blocks_.size()];
+        }
+        std::sort(variables->begin(), variables->end());
+    }
+
+    /**
+     * Record the outcome of a generation, where the variables were tried for
+     * the parents, and the offspring are the parents after the moves (in the
+     * same order). It is called by the solver after each update.
+     */
+    void Update(const std::vector<int>& variables, const Population& parents,
+                const Population& offspring) {
+        assert(parents.size() == offspring.size());
+
+        int n = static_cast<int>(parents.size());
+        n_saved_evaluations_ += 2LL * n * (n_variables_ -
+                                           static_cast<int>(variables.size()));
+        if (strategy_ != ADAPTIVE || n == 0) return;
+
+        // The weight of the last generation in the smoothed rewards.
+        const double smoothing = 0.3;
+
+        // Only the moves of the individuals that dominate their parents are
+        // rewarded. The moves along the front are not, otherwise the position
+        // variables, which always have them, would take most of the trials.
+        std::vector<bool> improved(n);
+        for (int i = 0; i < n; ++i) {
+            improved[i] = IndividualUtil::Dominance(offspring[i],
+                                                    parents[i]) == 1;
+        }
+
+        for (int j : variables) {
+            int n_moved = 0;
+            for (int i = 0; i < n; ++i) {
+                n_moved += improved[i] &&
+                           offspring[i].variables[j] != parents[i].variables[j];
+            }
+            rewards_[j] += smoothing * (static_cast<double>(n_moved) / n -
+                                        rewards_[j]);
+        }
+    }
+
+    /**
+     * Save the state of run, i.e., the blocks, the rewards and the counters,
+     * into a string. The solver keeps it in the checkpoint, so that a restart
+     * continues the bandit of ADAPTIVE and does not group the variables again.
+     */
+    std::string SaveState() const {
+        std::ostringstream out;
+        out << strategy_ << ' ' << block_size_ << ' ' << n_variables_ << ' '
+            << n_saved_evaluations_;
+        StateUtil::Write(rewards_, &out);
+        StateUtil::Write(position_variables_, &out);
+        out << ' ' << blocks_.size();
+        for (const std::vector<int>& block : blocks_) {
+            StateUtil::Write(block, &out);
+        }
+        return out.str();
+    }
+
+    /**
+     * Load the state saved by SaveState(), instead of Initialize(). It fails,
+     * and the scheduler is not changed, if the state was saved by a scheduler
+     * of another strategy or block size, or for another test.
+     */
+    bool LoadState(const BasicTest& test, const std::string& state) {
+        std::istringstream in(state);
+        int strategy = 0, block_size = 0, n_variables = 0;
+        int64_t n_saved_evaluations = 0;
+        size_t n_blocks = 0;
+        std::vector<double> rewards;
+        std::vector<int> position_variables;
+        if (!(in >> strategy >> block_size >> n_variables >>
+              n_saved_evaluations) ||
+            strategy != strategy_ || block_size != block_size_ ||
+            n_variables != test.parameter.n_variables ||
+            !StateUtil::Read(&in, &rewards) ||
+            rewards.size() != static_cast<size_t>(n_variables) ||
+            !StateUtil::Read(&in, &position_variables) ||
+            !(in >> n_blocks) || n_blocks == 0) {
+            return false;
+        }
+
+        std::vector<std::vector<int> > blocks(n_blocks);
+        for (std::vector<int>& block : blocks) {
+            if (!StateUtil::Read(&in, &block)) return false;
+            for (int i : block) {
+                if (i < 0 || i >= n_variables) return false;
+            }
+        }
+
+        n_variables_ = n_variables;
+        n_saved_evaluations_ = n_saved_evaluations;
+        rewards_.swap(rewards);
+        position_variables_.swap(position_variables);
+        blocks_.swap(blocks);
+        return true;
+    }
+
+    /**
+     * Set the minimum probability to try a variable by ADAPTIVE.
+     */
+    void set_min_rate(double min_rate) {
+        assert(0.0 < min_rate && min_rate <= 1.0);
+
+        min_rate_ = min_rate;
+    }
+
+    double min_rate() const { return min_rate_; }
+
+    Strategy strategy() const { return strategy_; }
+    int block_size()    const { return block_size_; }
+
+    /**
+     * The number of blocks tried in turn, 1 for RANDOM and ADAPTIVE.
+     */
+    int n_blocks() const { return static_cast<int>(blocks_.size()); }
+
+    /**
+     * The maximum number of variables selected in a generation, i.e., the
+     * largest block of RANDOM, ROUND_ROBIN and GROUPED. ADAPTIVE may select
+     * all variables (it does in the first generation), so it is the number of
+     * variables, a bound that is loose once the rewards drop. It is valid
+     * after Initialize() or LoadState().
+     */
+    int max_variables_per_generation() const {
+        if (strategy_ == RANDOM) return std::min(block_size_, n_variables_);
+        if (strategy_ == ADAPTIVE) return n_variables_;
+
+        size_t n = 0;
+        for (const std::vector<int>& block : blocks_) {
+            n = std::max(n, block.size());
+        }
+        return static_cast<int>(n);
+    }
+
+    /**
+     * The position variables found by GROUPED.
+     */
+    const std::vector<int>& position_variables() const {
+        return position_variables_;
+    }
+
+    /**
+     * The number of trials saved against trying all variables since
+     * Initialize(), counted by Update().
+     */
+    int64_t n_saved_evaluations() const { return n_saved_evaluations_; }
+
+private:
+    /**
+     * Find the position variables and the groups of the other variables.
+     *
+     * @return the number of evaluations.
+     */
+    int Group(const BasicTest& test,
+              std::vector<std::vector<int> >* groups) {
+        const std::vector<double>& lower = test.parameter.min_variables;
+        const std::vector<double>& upper = test.parameter.max_variables;
+        int n_evaluations = 0;
+
+        middle_.resize(n_variables_);
+        for (int i = 0; i < n_variables_; ++i) {
+            middle_[i] = 0.5 * (lower[i] + upper[i]);
+        }
+
+        // Sample each variable over its range at the middle of the bounds.
+        std::vector<int> distance_variables;
+        cl::Array2D<double> samples(N_SAMPLES, n_variables_);
+        for (int i = 0; i < n_variables_; ++i) {
+            for (int k = 0; k < N_SAMPLES; ++k) {
+                std::copy(middle_.begin(), middle_.end(),
+                          samples.data().begin() + k * n_variables_);
+                samples(k, i) = lower[i] +
+                        (upper[i] - lower[i]) * k / (N_SAMPLES - 1);
+            }
+            PopulationUtil::SetObjectiveValues(test, samples, &objectives_);
+            n_evaluations += N_SAMPLES;
+
+            if (HasTradeOff(objectives_)) {
+                position_variables_.push_back(i);
+            } else {
+                distance_variables.push_back(i);
+            }
+        }
+        if (!position_variables_.empty()) {
+            groups->push_back(position_variables_);
+        }
+        if (distance_variables.empty()) return n_evaluations;
+
+        // The base point has the position variables at the middle and the
+        // distance variables at the lower bounds.
+        base_ = middle_;
+        for (int i : distance_variables) {
+            base_[i] = lower[i];
+        }
+        f_base_ = Evaluate(test, base_, &n_evaluations);
+
+        std::vector<int> x1(1, distance_variables[0]);
+        std::vector<int> x2(distance_variables.begin() + 1,
+                            distance_variables.end());
+        std::vector<double> f_upper = EvaluateUpper(test, x1, &n_evaluations);
+        while (!x2.empty()) {
+            std::vector<int> interacting;
+            Interact(test, x1, f_upper, x2, &interacting, &n_evaluations);
+            if (interacting.empty()) {
+                groups->push_back(x1);
+                x1.assign(1, x2.front());
+                x2.erase(x2.begin());
+            } else {
+                // Look for the variables interacting with the larger group.
+                x1.insert(x1.end(), interacting.begin(), interacting.end());
+                std::sort(x1.begin(), x1.end());
+                std::vector<int> rest;
+                std::set_difference(x2.begin(), x2.end(),
+                                    interacting.begin(), interacting.end(),
+                                    std::back_inserter(rest));
+                x2.swap(rest);
+            }
+            f_upper = EvaluateUpper(test, x1, &n_evaluations);
+        }
+        groups->push_back(x1);
+        return n_evaluations;
+    }
+
+    /**
+     * Find the variables of x2 (in increasing order) that interact with x1, by
+     * halving x2 recursively. f_upper is the objectives of the base point with
+     * x1 at the upper bounds.
+     */
+    void Interact(const BasicTest& test, const std::vector<int>& x1,
+                  const std::vector<double>& f_upper,
+                  const std::vector<int>& x2, std::vector<int>* interacting,
+                  int* n_evaluations) {
+        std::vector<double> x = base_;
+        for (int i : x2) {
+            x[i] = middle_[i];
+        }
+        std::vector<double> f_middle = Evaluate(test, x, n_evaluations);
+        for (int i : x1) {
+            x[i] = test.parameter.max_variables[i];
+        }
+        std::vector<double> f_both = Evaluate(test, x, n_evaluations);
+
+        bool interact = false;
+        for (size_t k = 0; k < f_base_.size() && !interact; ++k) {
+            double delta1 = f_base_[k] - f_upper[k];
+            double delta2 = f_middle[k] - f_both[k];
+            double epsilon = 1e-10 * (std::abs(f_base_[k]) +
+                                      std::abs(f_upper[k]) +
+                                      std::abs(f_middle[k]) +
+                                      std::abs(f_both[k]));
+            interact = std::abs(delta1 - delta2) > epsilon;
+        }
+        if (!interact) return;
+
+        if (x2.size() == 1) {
+            interacting->push_back(x2[0]);
+            return;
+        }
+        size_t half = x2.size() / 2;
+        Interact(test, x1, f_upper,
+                 std::vector<int>(x2.begin(), x2.begin() + half),
+                 interacting, n_evaluations);
+        Interact(test, x1, f_upper,
+                 std::vector<int>(x2.begin() + half, x2.end()),
+                 interacting, n_evaluations);
+    }
+
+    /**
+     * The objectives of the base point with the variables at the upper bounds.
+     */
+    std::vector<double> EvaluateUpper(const BasicTest& test,
+                                      const std::vector<int>& variables,
+                                      int* n_evaluations) {
+        std::vector<double> x = base_;
+        for (int i : variables) {
+            x[i] = test.parameter.max_variables[i];
+        }
+        return Evaluate(test, x, n_evaluations);
+    }
+
+    /**
+     * Evaluate the objectives of one point.
+     */
+    std::vector<double> Evaluate(const BasicTest& test,
+                                 const std::vector<double>& x,
+                                 int* n_evaluations) {
+        cl::Array2D<double> point(1, n_variables_);
+        std::copy(x.begin(), x.end(), point.data().begin());
+        PopulationUtil::SetObjectiveValues(test, point, &objectives_);
+        ++*n_evaluations;
+        return std::vector<double>(objectives_.data().begin(),
+                                   objectives_.data().end());
+    }
+
+    /**
+     * Check if two of the rows are non-dominated to each other.
+     */
+    static bool HasTradeOff(const cl::Array2D<double>& objectives) {
+        int n = objectives.rows();
+        int m = objectives.columns();
+        for (int a = 0; a < n; ++a) {
+            for (int b = a + 1; b < n; ++b) {
+                bool better = false, worse = false;
+                for (int k = 0; k < m; ++k) {
+                    better |= objectives(a, k) < objectives(b, k);
+                    worse |= objectives(a, k) > objectives(b, k);
+                }
+                if (better && worse) return true;
+            }
+        }
+        return false;
+    }
+
+    Strategy strategy_;            // The strategy of selection.
+    int block_size_;               // The number of variables per generation.
+    double min_rate_;              // The minimum probability of ADAPTIVE.
+    int n_variables_;              // The number of variables of test.
+    int64_t n_saved_evaluations_;  // The trials saved against all variables.
+
+    std::vector<double> rewards_;              // The rewards of ADAPTIVE.
+    std::vector<int> position_variables_;      // The variables of positions.
+    std::vector<std::vector<int> > blocks_;    // The blocks tried in turn.
+
+    std::vector<double> middle_;      // The middle of the bounds.
+    std::vector<double> base_;        // The base point of grouping.
+    std::vector<double> f_base_;      // The objectives of the base point.
+    cl::Array2D<double> objectives_;  // The buffer of objectives.
+};
+
+} // namespace moo
+
+#endif // SOLVER_UTIL_VARIABLE_SCHEDULER_H_
@@ -16,6 +16,7 @@
 
 #include <string>
 
+#include "core/batch_evaluator.h"
 #include "core/objective.h"
 #include "core/parameter.h"
 #include "core/constants.h"
@@ -24,10 +25,52 @@ namespace moo {
 
 /// Basic Test.
 struct BasicTest {
+    BasicTest()
+        : batch_evaluator(NULL) {}
+
+    // The tests created by TestFactory are deleted through BasicTest.
+    virtual ~BasicTest() {}
+
+    /**
+     * Return true if the test supports incremental evaluation for single
+     * variable changes.
+     */
+    bool has_incremental_objectives() const {
+        return partial_state && incremental_objectives;
+    }
+
+    /**
+     * Return true if the objectives are evaluated by the batch evaluator.
+     */
+    bool has_batch_evaluator() const {
+        return batch_evaluator != NULL;
+    }
+
+    /**
+     * Return true if the costs of objectives are given, so the objectives can
+     * be evaluated lazily from the cheapest one.
+     */
+    bool has_objective_costs() const {
+        return !objective_costs.empty();
+    }
+
     std::string name;                  // The name of Test.
     Parameter parameter;               // The parameter of Test.
     std::vector<Objective> objectives; // The objectives of Test.
     std::vector<Constraint> constraints; // The constraints of Test.
+
+    // Optional incremental evaluation, empty if the test does not support it.
+    PartialState partial_state;
+    IncrementalObjectives incremental_objectives;
+
+    // Optional batch evaluation (not owned), NULL if the objectives are
+    // evaluated one by one in process.
+    BatchEvaluator* batch_evaluator;
+
+    // Optional relative costs of evaluating each objective (e.g., the seconds
+    // per call), empty if unknown. They enable the lazy evaluation of
+    // NSLSUpdater, unless the batch evaluator is set.
+    std::vector<double> objective_costs;
 };
 
 } // namespace moo
@@ -0,0 +1,157 @@
+//
+// Copyright 2013 Yangbin Lin and Bili Chen. All Rights Reserved.
+//
+// Author: yblin.xmu@qq.com (Yangbin Lin)
+//
+// To use this code, please cite the follow paper:
+//
+// Chen B, Zeng W, Lin Y, et al. A New Local Search-Based Multiobjective
+// Optimization Algorithm[J]. IEEE Transactions on Evolutionary Computation,
+// 2014, 19(1):1-1.
+//
+
+#ifndef TEST_BATCH_KERNEL_EVALUATOR_H_
+#define TEST_BATCH_KERNEL_EVALUATOR_H_
+
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
+#include "codelibrary/base/macros.h"
+#include "codelibrary/base/simd.h"
+#include "codelibrary/math/batch_math.h"
+#include "codelibrary/util/array/array_2d.h"
+#include "core/batch_evaluator.h"
+
+#if CL_BATCH_MATH
+
+namespace moo {
+
+/// Kernel Evaluator.
+/**
+ * It evaluates the candidates by blocks, one candidate per lane of a SIMD
+ * vector, so the elementary functions of the objectives are computed for the
+ * whole block at once.
+ *
+ * The Kernel computes the objectives of one block:
+ *
+ *    template <typename Lanes>
+ *    CL_SIMD_INLINE void Evaluate(const double* x, double* f) const;
+ *
+ * where Lanes is one of the vectors of cl::batch_math, x[i * N_LANES + l] is
+ * the i-th variable of the l-th candidate, and f[k * N_LANES + l] receives its
+ * k-th objective.
+ *
+ * The blocks are evaluated by a function compiled for AVX-512, AVX2 or the
+ * generic instruction set, with the vector of its width, the best one
+ * supported by the processor by default.
+ */
+template <class Kernel>
+class KernelEvaluator : public BatchEvaluator {
+public:
+    KernelEvaluator(const Kernel& kernel, int n_variables, int n_objectives)
+        : kernel_(kernel),
+          n_variables_(n_variables),
+          n_objectives_(n_objectives),
+          level_(cl::simd::SupportedLevel()) {
+        assert(n_variables > 0);
+        assert(n_objectives > 0);
+    }
+
+    virtual void Evaluate(const cl::Array2D<double>& variables,
+                          cl::Array2D<double>* objectives) {
+        assert(objectives);
+        assert(variables.empty() || variables.columns() == n_variables_);
+
+        int n = variables.rows();
+        objectives->Resize(n, n_objectives_);
+        if (n == 0) return;
+
+        const double* x = variables.data().data();
+        double* f = objectives->data().data();
+        switch (level_) {
+        case cl::simd::AVX512:
+            EvaluateAVX512(x, n, f);
+            break;
+        case cl::simd::AVX2:
+            EvaluateAVX2(x, n, f);
+            break;
+        default:
+            EvaluateGeneric(x, n, f);
+        }
+    }
+
+    /**
+     * Force the instruction set, e.g., to compare the results of the levels.
+     * It must be supported by the processor.
+     */
+    void set_level(cl::simd::SimdLevel level) {
+        assert(level <= cl::simd::SupportedLevel());
+
+        level_ = level;
+    }
+
+    cl::simd::SimdLevel level() const { return level_; }
+
+private:
+    /**
+     * Evaluate n candidates given as rows of variables.
+     */
+    template <typename Lanes>
+    CL_SIMD_INLINE void EvaluateBlocks(const double* variables, int n,
+                                       double* objectives) const {
+        const int N_LANES = cl::batch_math::LaneTraits<Lanes>::N_LANES;
+
+        std::vector<double> x(n_variables_ * N_LANES);
+        std::vector<double> f(n_objectives_ * N_LANES);
+
+        for (int first = 0; first < n; first += N_LANES) {
+            // The lanes after the last candidate repeat it.
+            int size = std::min(N_LANES, n - first);
+            for (int l = 0; l < N_LANES; ++l) {
+                const double* row = variables +
+                        (first + std::min(l, size - 1)) * n_variables_;
+                for (int i = 0; i < n_variables_; ++i) {
+                    x[i * N_LANES + l] = row[i];
+                }
+            }
+
+            kernel_.template Evaluate<Lanes>(x.data(), f.data());
+
+            for (int l = 0; l < size; ++l) {
+                double* row = objectives + (first + l) * n_objectives_;
+                for (int k = 0; k < n_objectives_; ++k) {
+                    row[k] = f[k * N_LANES + l];
+                }
+            }
+        }
+    }
+
+    CL_TARGET_AVX512 void EvaluateAVX512(const double* variables, int n,
+                                         double* objectives) const {
+        EvaluateBlocks<cl::batch_math::Lanes8>(variables, n, objectives);
+    }
+
+    CL_TARGET_AVX2 void EvaluateAVX2(const double* variables, int n,
+                                     double* objectives) const {
+        EvaluateBlocks<cl::batch_math::Lanes4>(variables, n, objectives);
+    }
+
+    void EvaluateGeneric(const double* variables, int n,
+                         double* objectives) const {
+        EvaluateBlocks<cl::batch_math::Lanes2>(variables, n, objectives);
+    }
+
+    Kernel kernel_;             // The objectives of a block.
+    int n_variables_;           // The number of variables.
+    int n_objectives_;          // The number of objectives.
+    cl::simd::SimdLevel level_; // The instruction set used.
+
+    DISALLOW_COPY_AND_ASSIGN(KernelEvaluator);
+};
+
+} // namespace moo
+
+#endif // CL_BATCH_MATH
+
+#endif // TEST_BATCH_KERNEL_EVALUATOR_H_
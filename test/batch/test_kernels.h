@@ -0,0 +1,1068 @@
+//
+// Copyright 2013 Yangbin Lin and Bili Chen. All Rights Reserved.
+//
+// Author: yblin.xmu@qq.com (Yangbin Lin)
+//
+// To use this code, please cite the follow paper:
+//
+// Chen B, Zeng W, Lin Y, et al. A New Local Search-Based Multiobjective
+// Optimization Algorithm[J]. IEEE Transactions on Evolutionary Computation,
+// 2014, 19(1):1-1.
+//
+
+#ifndef TEST_BATCH_TEST_KERNELS_H_
+#define TEST_BATCH_TEST_KERNELS_H_
+
+#include <cassert>
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "codelibrary/base/constants.h"
+#include "codelibrary/base/simd.h"
+#include "codelibrary/math/batch_math.h"
+#include "test/basic_test.h"
+#include "test/batch/kernel_evaluator.h"
+
+#if CL_BATCH_MATH
+
+namespace moo {
+
+/// Basic Kernel.
+/**
+ * The helpers of the kernels of the built-in tests, see KernelEvaluator for
+ * the layout of x and f.
+ *
+ * The kernels compute the same formulas as the tests, including their quirks,
+ * but the terms that only depend on j, e.g., sin(j * PI / n), are tabulated in
+ * the constructors. The results differ from the tests by rounding only, i.e.,
+ * about 1e-15 relatively.
+ */
+struct BasicKernel {
+    /**
+     * The i-th variable of the candidates.
+     */
+    template <typename Lanes>
+    static CL_SIMD_INLINE Lanes Variable(const double* x, int i) {
+        return cl::batch_math::Load<Lanes>(
+                x + i * cl::batch_math::LaneTraits<Lanes>::N_LANES);
+    }
+
+    /**
+     * Set the k-th objective of the candidates.
+     */
+    template <typename Lanes>
+    static CL_SIMD_INLINE void SetObjective(const Lanes& value, int k,
+                                            double* f) {
+        cl::batch_math::Store(
+                value, f + k * cl::batch_math::LaneTraits<Lanes>::N_LANES);
+    }
+
+    /**
+     * Sum(xi, i = [first, last)).
+     */
+    template <typename Lanes>
+    static CL_SIMD_INLINE Lanes Sum(const double* x, int first, int last) {
+        Lanes sum = cl::batch_math::Broadcast<Lanes>(0.0);
+        for (int i = first; i < last; ++i) {
+            sum += Variable<Lanes>(x, i);
+        }
+        return sum;
+    }
+
+    template <typename Lanes>
+    static CL_SIMD_INLINE Lanes Square(const Lanes& value) {
+        return value * value;
+    }
+
+    /**
+     * max(value, 0).
+     */
+    template <typename Lanes>
+    static CL_SIMD_INLINE Lanes ClampToZero(const Lanes& value) {
+        return cl::batch_math::Select(
+                value < 0.0, cl::batch_math::Broadcast<Lanes>(0.0), value);
+    }
+
+    /**
+     * The number of j in {first, first + step, ...} that are not greater than
+     * last, i.e., the |J| of the tests.
+     */
+    static int Count(int first, int last, int step) {
+        return first <= last ? (last - first) / step + 1 : 0;
+    }
+
+    /**
+     * The exponents of x0 in LZ1, LZ7, LZ8 and CF1, i.e.,
+     * 0.5 * (1 + 3 * (j - 2) / (n - 2)) for j = [0, n].
+     */
+    static std::vector<double> Exponents(int n) {
+        std::vector<double> exponents(n + 1);
+        for (int j = 0; j <= n; ++j) {
+            exponents[j] = 0.5 * (1.0 + 3.0 * (j - 2) / (n - 2));
+        }
+        return exponents;
+    }
+
+    /// The phases of the sines, i.e., scale * j * PI / n for j = [0, n].
+    /**
+     * sin(a + phase_j) is computed from sin(a) and cos(a), so a is reduced
+     * once per candidate instead of once per variable.
+     */
+    class Phases {
+    public:
+        Phases(int n, double scale)
+            : sines_(n + 1), cosines_(n + 1) {
+            for (int j = 0; j <= n; ++j) {
+                double phase = scale * (cl::PI * j / n);
+                sines_[j] = std::sin(phase);
+                cosines_[j] = std::cos(phase);
+            }
+        }
+
+        /**
+         * sin(a + phase_j).
+         */
+        template <typename Lanes>
+        CL_SIMD_INLINE Lanes Sin(const Lanes& sin_a, const Lanes& cos_a,
+                                 int j) const {
+            return sin_a * cosines_[j] + cos_a * sines_[j];
+        }
+
+        /**
+         * cos(a + phase_j).
+         */
+        template <typename Lanes>
+        CL_SIMD_INLINE Lanes Cos(const Lanes& sin_a, const Lanes& cos_a,
+                                 int j) const {
+            return cos_a * cosines_[j] - sin_a * sines_[j];
+        }
+
+    private:
+        std::vector<double> sines_, cosines_;
+    };
+};
+
+/// ZDT1 kernel, see ZDT1Test.
+class ZDT1Kernel : public BasicKernel {
+public:
+    explicit ZDT1Kernel(int n)
+        : n_(n) {}
+
+    template <typename Lanes>
+    CL_SIMD_INLINE void Evaluate(const double* x, double* f) const {
+        Lanes x0 = Variable<Lanes>(x, 0);
+        Lanes g = 1.0 + 9.0 * Sum<Lanes>(x, 1, n_) / (n_ - 1);
+        SetObjective(x0, 0, f);
+        SetObjective(g * (1.0 - cl::batch_math::Sqrt(x0 / g)), 1, f);
+    }
+
+private:
+    int n_;
+};
+
+/// ZDT2 kernel, see ZDT2Test.
+class ZDT2Kernel : public BasicKernel {
+public:
+    explicit ZDT2Kernel(int n)
+        : n_(n) {}
+
+    template <typename Lanes>
+    CL_SIMD_INLINE void Evaluate(const double* x, double* f) const {
+        Lanes x0 = Variable<Lanes>(x, 0);
+        Lanes g = 1.0 + 9.0 * Sum<Lanes>(x, 1, n_) / (n_ - 1);
+        SetObjective(x0, 0, f);
+        SetObjective(g * (1.0 - Square(x0 / g)), 1, f);
+    }
+
+private:
+    int n_;
+};
+
+/// ZDT3 kernel, see ZDT3Test.
+class ZDT3Kernel : public BasicKernel {
+public:
+    explicit ZDT3Kernel(int n)
+        : n_(n) {}
+
+    template <typename Lanes>
+    CL_SIMD_INLINE void Evaluate(const double* x, double* f) const {
+        Lanes x0 = Variable<Lanes>(x, 0);
+        Lanes g = 1.0 + 9.0 * Sum<Lanes>(x, 1, n_) / (n_ - 1);
+        SetObjective(x0, 0, f);
+        SetObjective(g * (1.0 - cl::batch_math::Sqrt(x0 / g) -
+                          x0 / g * cl::batch_math::Sin(10.0 * cl::PI * x0)),
+                     1, f);
+    }
+
+private:
+    int n_;
+};
+
+/// ZDT4 kernel, see ZDT4Test.
+class ZDT4Kernel : public BasicKernel {
+public:
+    explicit ZDT4Kernel(int n)
+        : n_(n) {}
+
+    template <typename Lanes>
+    CL_SIMD_INLINE void Evaluate(const double* x, double* f) const {
+        Lanes x0 = Variable<Lanes>(x, 0);
+        Lanes g = cl::batch_math::Broadcast<Lanes>(1.0 + 10.0 * (n_ - 1));
+        for (int i = 1; i < n_; ++i) {
+            Lanes xi = Variable<Lanes>(x, i);
+            g += xi * xi - 10.0 * cl::batch_math::Cos(4.0 * cl::PI * xi);
+        }
+        SetObjective(x0, 0, f);
+        SetObjective(g * (1.0 - cl::batch_math::Sqrt(x0 / g)), 1, f);
+    }
+
+private:
+    int n_;
+};
+
+/// ZDT6 kernel, see ZDT6Test.
+class ZDT6Kernel : public BasicKernel {
+public:
+    explicit ZDT6Kernel(int n)
+        : n_(n) {}
+
+    template <typename Lanes>
+    CL_SIMD_INLINE void Evaluate(const double* x, double* f) const {
+        Lanes x0 = Variable<Lanes>(x, 0);
+        Lanes s2 = Square(cl::batch_math::Sin(6.0 * cl::PI * x0));
+        Lanes f1 = 1.0 - cl::batch_math::Exp(-4.0 * x0) * s2 * s2 * s2;
+        Lanes g = 1.0 + 9.0 * cl::batch_math::Sqrt(cl::batch_math::Sqrt(
+                                  Sum<Lanes>(x, 1, n_) / (n_ - 1)));
+        SetObjective(f1, 0, f);
+        SetObjective(g * (1.0 - Square(f1 / g)), 1, f);
+    }
+
+private:
+    int n_;
+};
+
+/// DTLZ1 kernel, see DTLZ1Test.
+class DTLZ1Kernel : public BasicKernel {
+    static const int K = 5;
+
+public:
+    explicit DTLZ1Kernel(int n)
+        : n_(n) {}
+
+    template <typename Lanes>
+    CL_SIMD_INLINE void Evaluate(const double* x, double* f) const {
+        Lanes x0 = Variable<Lanes>(x, 0);
+        Lanes x1 = Variable<Lanes>(x, 1);
+        Lanes h = 0.5 * (1.0 + GX<Lanes>(x, n_ - K, n_));
+        SetObjective(h * x0 * x1, 0, f);
+        SetObjective(h * x0 * (1.0 - x1), 1, f);
+        SetObjective(h * (1.0 - x0), 2, f);
+    }
+
+    /**
+     * The g(x) of DTLZ1 and DTLZ3, i.e.,
+     * 100 * (K + Sum[(xi - 0.5)^2 - cos(20PI * (xi - 0.5)) | i = [first, n)]),
+     * where K = n - first.
+     */
+    template <typename Lanes>
+    static CL_SIMD_INLINE Lanes GX(const double* x, int first, int n) {
+        Lanes sum = cl::batch_math::Broadcast<Lanes>(0.0);
+        for (int i = first; i < n; ++i) {
+            Lanes y = Variable<Lanes>(x, i) - 0.5;
+            sum += y * y - cl::batch_math::Cos(20.0 * cl::PI * y);
+        }
+        return 100.0 * ((n - first) + sum);
+    }
+
+private:
+    int n_;
+};
+
+/// DTLZ2 kernel, see DTLZ2Test.
+class DTLZ2Kernel : public BasicKernel {
+    static const int K = 10;
+
+public:
+    explicit DTLZ2Kernel(int n)
+        : n_(n) {}
+
+    template <typename Lanes>
+    CL_SIMD_INLINE void Evaluate(const double* x, double* f) const {
+        Lanes gx = cl::batch_math::Broadcast<Lanes>(0.0);
+        for (int i = n_ - K; i < n_; ++i) {
+            gx += Square(Variable<Lanes>(x, i) - 0.5);
+        }
+        Sphere(Variable<Lanes>(x, 0) * (cl::PI / 2.0),
+               Variable<Lanes>(x, 1) * (cl::PI / 2.0), gx, f);
+    }
+
+    /**
+     * The objectives of DTLZ2 to DTLZ5 from their angles and g(x):
+     * (1 + g) * (cos(a0)cos(a1), cos(a0)sin(a1), sin(a0)).
+     */
+    template <typename Lanes>
+    static CL_SIMD_INLINE void Sphere(const Lanes& a0, const Lanes& a1,
+                                      const Lanes& gx, double* f) {
+        Lanes s0, c0, s1, c1;
+        cl::batch_math::SinCos(a0, &s0, &c0);
+        cl::batch_math::SinCos(a1, &s1, &c1);
+        Lanes r = 1.0 + gx;
+        SetObjective(r * c0 * c1, 0, f);
+        SetObjective(r * c0 * s1, 1, f);
+        SetObjective(r * s0, 2, f);
+    }
+
+private:
+    int n_;
+};
+
+/// DTLZ3 kernel, see DTLZ3Test.
+class DTLZ3Kernel : public BasicKernel {
+    static const int K = 10;
+
+public:
+    explicit DTLZ3Kernel(int n)
+        : n_(n) {}
+
+    template <typename Lanes>
+    CL_SIMD_INLINE void Evaluate(const double* x, double* f) const {
+        DTLZ2Kernel::Sphere(Variable<Lanes>(x, 0) * (cl::PI * 0.5),
+                            Variable<Lanes>(x, 1) * (cl::PI * 0.5),
+                            DTLZ1Kernel::GX<Lanes>(x, n_ - K, n_), f);
+    }
+
+private:
+    int n_;
+};
+
+/// DTLZ4 kernel, see DTLZ4Test.
+class DTLZ4Kernel : public BasicKernel {
+public:
+    explicit DTLZ4Kernel(int n)
+        : n_(n) {}
+
+    template <typename Lanes>
+    CL_SIMD_INLINE void Evaluate(const double* x, double* f) const {
+        // DTLZ4Test sums from x3.
+        Lanes gx = cl::batch_math::Broadcast<Lanes>(0.0);
+        for (int i = 3; i < n_; ++i) {
+            gx += Square(Variable<Lanes>(x, i) - 0.5);
+        }
+        DTLZ2Kernel::Sphere(Power100(Variable<Lanes>(x, 0)) * (cl::PI / 2.0),
+                            Power100(Variable<Lanes>(x, 1)) * (cl::PI / 2.0),
+                            gx, f);
+    }
+
+private:
+    /**
+     * x^100 by squaring.
+     */
+    template <typename Lanes>
+    static CL_SIMD_INLINE Lanes Power100(const Lanes& x) {
+        Lanes x2 = x * x;
+        Lanes x4 = x2 * x2;
+        Lanes x8 = x4 * x4;
+        Lanes x25 = x8 * x8 * x8 * x;
+        Lanes x50 = x25 * x25;
+        return x50 * x50;
+    }
+
+    int n_;
+};
+
+/// DTLZ5 kernel, see DTLZ5Test.
+class DTLZ5Kernel : public BasicKernel {
+    static const int K = 10;
+
+public:
+    explicit DTLZ5Kernel(int n)
+        : n_(n) {}
+
+    template <typename Lanes>
+    CL_SIMD_INLINE void Evaluate(const double* x, double* f) const {
+        Lanes gx = cl::batch_math::Broadcast<Lanes>(0.0);
+        for (int i = n_ - K; i < n_; ++i) {
+            gx += Square(Variable<Lanes>(x, i) - 0.5);
+        }
+        Lanes t = cl::PI / (4.0 * (1.0 + gx));
+        Lanes seta0 = t * (1.0 + 2.0 * gx * Variable<Lanes>(x, 0));
+        Lanes seta1 = t * (1.0 + 2.0 * gx * Variable<Lanes>(x, 1));
+        DTLZ2Kernel::Sphere(seta0 * (cl::PI / 2.0), seta1 * (cl::PI / 2.0),
+                            gx, f);
+    }
+
+private:
+    int n_;
+};
+
+/// LZ1 kernel, see LZ1Test.
+class LZ1Kernel : public BasicKernel {
+public:
+    explicit LZ1Kernel(int n)
+        : n_(n), exponents_(Exponents(n)) {}
+
+    template <typename Lanes>
+    CL_SIMD_INLINE void Evaluate(const double* x, double* f) const {
+        Lanes x0 = Variable<Lanes>(x, 0);
+        Lanes log_x0 = cl::batch_math::Log(x0);
+        Lanes sum1 = cl::batch_math::Broadcast<Lanes>(0.0);
+        for (int j = 3; j <= n_; j += 2) {
+            sum1 += Square(Variable<Lanes>(x, j - 1) -
+                           cl::batch_math::Exp(log_x0 * exponents_[j]));
+        }
+        Lanes sum2 = cl::batch_math::Broadcast<Lanes>(0.0);
+        for (int j = 2; j <= n_; j += 2) {
+            sum2 += Square(Variable<Lanes>(x, j - 1) -
+                           cl::batch_math::Exp(log_x0 * exponents_[j]));
+        }
+        SetObjective(x0 + 2.0 / Count(3, n_, 2) * sum1, 0, f);
+        SetObjective(1.0 - cl::batch_math::Sqrt(x0) +
+                     2.0 / Count(2, n_, 2) * sum2, 1, f);
+    }
+
+private:
+    int n_;
+    std::vector<double> exponents_;
+};
+
+/// LZ2 kernel, see LZ2Test.
+class LZ2Kernel : public BasicKernel {
+public:
+    explicit LZ2Kernel(int n)
+        : n_(n), phases_(n, 1.0) {}
+
+    template <typename Lanes>
+    CL_SIMD_INLINE void Evaluate(const double* x, double* f) const {
+        Lanes x0 = Variable<Lanes>(x, 0);
+        Lanes sa, ca;
+        cl::batch_math::SinCos(6.0 * cl::PI * x0, &sa, &ca);
+        Lanes sum1 = cl::batch_math::Broadcast<Lanes>(0.0);
+        for (int j = 3; j <= n_; j += 2) {
+            sum1 += Square(Variable<Lanes>(x, j - 1) - phases_.Sin(sa, ca, j));
+        }
+        Lanes sum2 = cl::batch_math::Broadcast<Lanes>(0.0);
+        for (int j = 2; j <= n_; j += 2) {
+            sum2 += Square(Variable<Lanes>(x, j - 1) - phases_.Sin(sa, ca, j));
+        }
+        SetObjective(x0 + 2.0 / Count(3, n_, 2) * sum1, 0, f);
+        SetObjective(1.0 - cl::batch_math::Sqrt(x0) +
+                     2.0 / Count(2, n_, 2) * sum2, 1, f);
+    }
+
+private:
+    int n_;
+    Phases phases_;
+};
+
+/// LZ3 kernel, see LZ3Test.
+class LZ3Kernel : public BasicKernel {
+public:
+    explicit LZ3Kernel(int n)
+        : n_(n), phases_(n, 1.0) {}
+
+    template <typename Lanes>
+    CL_SIMD_INLINE void Evaluate(const double* x, double* f) const {
+        Lanes x0 = Variable<Lanes>(x, 0);
+        Lanes sa, ca;
+        cl::batch_math::SinCos(6.0 * cl::PI * x0, &sa, &ca);
+        Lanes r = 0.8 * x0;
+        Lanes sum1 = cl::batch_math::Broadcast<Lanes>(0.0);
+        for (int j = 3; j <= n_; j += 2) {
+            sum1 += Square(Variable<Lanes>(x, j - 1) -
+                           r * phases_.Cos(sa, ca, j));
+        }
+        Lanes sum2 = cl::batch_math::Broadcast<Lanes>(0.0);
+        for (int j = 2; j <= n_; j += 2) {
+            sum2 += Square(Variable<Lanes>(x, j - 1) -
+                           r * phases_.Sin(sa, ca, j));
+        }
+        SetObjective(x0 + 2.0 / Count(3, n_, 2) * sum1, 0, f);
+        SetObjective(1.0 - cl::batch_math::Sqrt(x0) +
+                     2.0 / Count(2, n_, 2) * sum2, 1, f);
+    }
+
+private:
+    int n_;
+    Phases phases_;
+};
+
+/// LZ4 kernel, see LZ4Test.
+class LZ4Kernel : public BasicKernel {
+public:
+    explicit LZ4Kernel(int n)
+        : n_(n), phases_(n, 1.0), third_phases_(n, 1.0 / 3.0) {}
+
+    template <typename Lanes>
+    CL_SIMD_INLINE void Evaluate(const double* x, double* f) const {
+        Lanes x0 = Variable<Lanes>(x, 0);
+        Lanes sa, ca, sb, cb;
+        cl::batch_math::SinCos(6.0 * cl::PI * x0, &sa, &ca);
+        cl::batch_math::SinCos(2.0 * cl::PI * x0, &sb, &cb);
+        Lanes r = 0.8 * x0;
+        Lanes sum1 = cl::batch_math::Broadcast<Lanes>(0.0);
+        for (int j = 3; j <= n_; j += 2) {
+            sum1 += Square(Variable<Lanes>(x, j - 1) -
+                           r * third_phases_.Cos(sb, cb, j));
+        }
+        Lanes sum2 = cl::batch_math::Broadcast<Lanes>(0.0);
+        for (int j = 2; j <= n_; j += 2) {
+            sum2 += Square(Variable<Lanes>(x, j - 1) -
+                           r * phases_.Sin(sa, ca, j));
+        }
+        SetObjective(x0 + 2.0 / Count(3, n_, 2) * sum1, 0, f);
+        SetObjective(1.0 - cl::batch_math::Sqrt(x0) +
+                     2.0 / Count(2, n_, 2) * sum2, 1, f);
+    }
+
+private:
+    int n_;
+    Phases phases_, third_phases_;
+};
+
+/// LZ5 kernel, see LZ5Test.
+class LZ5Kernel : public BasicKernel {
+public:
+    explicit LZ5Kernel(int n)
+        : n_(n), phases_(n, 1.0), quadruple_phases_(n, 4.0) {}
+
+    template <typename Lanes>
+    CL_SIMD_INLINE void Evaluate(const double* x, double* f) const {
+        Lanes x0 = Variable<Lanes>(x, 0);
+        Lanes sa, ca, sb, cb;
+        cl::batch_math::SinCos(6.0 * cl::PI * x0, &sa, &ca);
+        cl::batch_math::SinCos(24.0 * cl::PI * x0, &sb, &cb);
+        Lanes r2 = 0.3 * x0 * x0;
+        Lanes r1 = 0.6 * x0;
+        Lanes sum1 = cl::batch_math::Broadcast<Lanes>(0.0);
+        for (int j = 3; j <= n_; j += 2) {
+            Lanes r = r2 * quadruple_phases_.Cos(sb, cb, j) + r1;
+            sum1 += Square(Variable<Lanes>(x, j - 1) -
+                           r * phases_.Cos(sa, ca, j));
+        }
+        Lanes sum2 = cl::batch_math::Broadcast<Lanes>(0.0);
+        for (int j = 2; j <= n_; j += 2) {
+            Lanes r = r2 * quadruple_phases_.Cos(sb, cb, j) + r1;
+            sum2 += Square(Variable<Lanes>(x, j - 1) -
+                           r * phases_.Sin(sa, ca, j));
+        }
+        SetObjective(x0 + 2.0 / Count(3, n_, 2) * sum1, 0, f);
+        SetObjective(1.0 - cl::batch_math::Sqrt(x0) +
+                     2.0 / Count(2, n_, 2) * sum2, 1, f);
+    }
+
+private:
+    int n_;
+    Phases phases_, quadruple_phases_;
+};
+
+/// LZ6 kernel, see LZ6Test.
+class LZ6Kernel : public BasicKernel {
+public:
+    explicit LZ6Kernel(int n)
+        : n_(n), phases_(n, 1.0) {}
+
+    template <typename Lanes>
+    CL_SIMD_INLINE void Evaluate(const double* x, double* f) const {
+        Lanes x0 = Variable<Lanes>(x, 0);
+        Lanes x1 = Variable<Lanes>(x, 1);
+        Lanes sa, ca, s0, c0, s1, c1;
+        cl::batch_math::SinCos(2.0 * cl::PI * x0, &sa, &ca);
+        cl::batch_math::SinCos(0.5 * x0 * cl::PI, &s0, &c0);
+        cl::batch_math::SinCos(0.5 * x1 * cl::PI, &s1, &c1);
+        Lanes r = 2.0 * x1;
+        Lanes sums[3] = {};
+        for (int j = 3; j <= n_; ++j) {
+            sums[(j - 1) % 3] += Square(Variable<Lanes>(x, j - 1) -
+                                        r * phases_.Sin(sa, ca, j));
+        }
+        SetObjective(c0 * c1 + 2.0 / Count(4, n_, 3) * sums[0], 0, f);
+        SetObjective(c0 * s1 + 2.0 / Count(5, n_, 3) * sums[1], 1, f);
+        SetObjective(s0 + 2.0 / Count(3, n_, 3) * sums[2], 2, f);
+    }
+
+private:
+    int n_;
+    Phases phases_;
+};
+
+/// LZ7 kernel, see LZ7Test.
+class LZ7Kernel : public BasicKernel {
+public:
+    explicit LZ7Kernel(int n)
+        : n_(n), exponents_(Exponents(n)) {}
+
+    template <typename Lanes>
+    CL_SIMD_INLINE void Evaluate(const double* x, double* f) const {
+        Lanes x0 = Variable<Lanes>(x, 0);
+        Lanes log_x0 = cl::batch_math::Log(x0);
+        Lanes sum1 = cl::batch_math::Broadcast<Lanes>(0.0);
+        for (int j = 3; j <= n_; j += 2) {
+            sum1 += H(Variable<Lanes>(x, j - 1) -
+                      cl::batch_math::Exp(log_x0 * exponents_[j]));
+        }
+        Lanes sum2 = cl::batch_math::Broadcast<Lanes>(0.0);
+        for (int j = 2; j <= n_; j += 2) {
+            sum2 += H(Variable<Lanes>(x, j - 1) -
+                      cl::batch_math::Exp(log_x0 * exponents_[j]));
+        }
+        SetObjective(x0 + 2.0 / Count(3, n_, 2) * sum1, 0, f);
+        SetObjective(1.0 - cl::batch_math::Sqrt(x0) +
+                     2.0 / Count(2, n_, 2) * sum2, 1, f);
+    }
+
+private:
+    /**
+     * 4y^2 - cos(8PI * y) + 1.
+     */
+    template <typename Lanes>
+    static CL_SIMD_INLINE Lanes H(const Lanes& y) {
+        return 4.0 * y * y - cl::batch_math::Cos(8.0 * y * cl::PI) + 1.0;
+    }
+
+    int n_;
+    std::vector<double> exponents_;
+};
+
+/// LZ8 kernel, see LZ8Test.
+class LZ8Kernel : public BasicKernel {
+public:
+    explicit LZ8Kernel(int n)
+        : n_(n), exponents_(Exponents(n)), frequencies_(n + 1) {
+        // The frequencies of the product, 20PI / sqrt(j).
+        for (int j = 1; j <= n; ++j) {
+            frequencies_[j] = 20.0 * cl::PI / std::sqrt(j);
+        }
+    }
+
+    template <typename Lanes>
+    CL_SIMD_INLINE void Evaluate(const double* x, double* f) const {
+        Lanes x0 = Variable<Lanes>(x, 0);
+        Lanes log_x0 = cl::batch_math::Log(x0);
+        SetObjective(x0 + 2.0 / Count(3, n_, 2) * Sum(x, log_x0, 3), 0, f);
+        SetObjective(1.0 - cl::batch_math::Sqrt(x0) +
+                     2.0 / Count(2, n_, 2) * Sum(x, log_x0, 2), 1, f);
+    }
+
+private:
+    /**
+     * 4 * Sum[yj^2] - 2 * Product[cos(20PI * yj / sqrt(j))] + 2 for
+     * j = first, first + 2, ...
+     */
+    template <typename Lanes>
+    CL_SIMD_INLINE Lanes Sum(const double* x, const Lanes& log_x0,
+                             int first) const {
+        Lanes sum = cl::batch_math::Broadcast<Lanes>(0.0);
+        Lanes product = cl::batch_math::Broadcast<Lanes>(1.0);
+        for (int j = first; j <= n_; j += 2) {
+            Lanes y = Variable<Lanes>(x, j - 1) -
+                      cl::batch_math::Exp(log_x0 * exponents_[j]);
+            sum += y * y;
+            product *= cl::batch_math::Cos(y * frequencies_[j]);
+        }
+        return 4.0 * sum - 2.0 * product + 2.0;
+    }
+
+    int n_;
+    std::vector<double> exponents_, frequencies_;
+};
+
+/// LZ9 kernel, see LZ9Test.
+class LZ9Kernel : public BasicKernel {
+public:
+    explicit LZ9Kernel(int n)
+        : n_(n), phases_(n, 1.0) {}
+
+    template <typename Lanes>
+    CL_SIMD_INLINE void Evaluate(const double* x, double* f) const {
+        Lanes x0 = Variable<Lanes>(x, 0);
+        Lanes sa, ca;
+        cl::batch_math::SinCos(6.0 * cl::PI * x0, &sa, &ca);
+        Lanes sum1 = cl::batch_math::Broadcast<Lanes>(0.0);
+        for (int j = 3; j <= n_; j += 2) {
+            sum1 += Square(Variable<Lanes>(x, j - 1) - phases_.Sin(sa, ca, j));
+        }
+        Lanes sum2 = cl::batch_math::Broadcast<Lanes>(0.0);
+        for (int j = 2; j <= n_; j += 2) {
+            sum2 += Square(Variable<Lanes>(x, j - 1) - phases_.Sin(sa, ca, j));
+        }
+        SetObjective(x0 + 2.0 / Count(3, n_, 2) * sum1, 0, f);
+        SetObjective(1.0 - x0 * x0 + 2.0 / Count(2, n_, 2) * sum2, 1, f);
+    }
+
+private:
+    int n_;
+    Phases phases_;
+};
+
+/// UF4 kernel, see UF4Test.
+class UF4Kernel : public BasicKernel {
+public:
+    explicit UF4Kernel(int n)
+        : n_(n), phases_(n, 1.0) {}
+
+    template <typename Lanes>
+    CL_SIMD_INLINE void Evaluate(const double* x, double* f) const {
+        Lanes x0 = Variable<Lanes>(x, 0);
+        Lanes sa, ca;
+        cl::batch_math::SinCos(6.0 * cl::PI * x0, &sa, &ca);
+        Lanes sum1 = cl::batch_math::Broadcast<Lanes>(0.0);
+        for (int j = 3; j <= n_; j += 2) {
+            sum1 += H(Variable<Lanes>(x, j - 1) - phases_.Sin(sa, ca, j));
+        }
+        Lanes sum2 = cl::batch_math::Broadcast<Lanes>(0.0);
+        for (int j = 2; j <= n_; j += 2) {
+            sum2 += H(Variable<Lanes>(x, j - 1) - phases_.Sin(sa, ca, j));
+        }
+        SetObjective(x0 + 2.0 / Count(3, n_, 2) * sum1, 0, f);
+        SetObjective(1.0 - x0 * x0 + 2.0 / Count(2, n_, 2) * sum2, 1, f);
+    }
+
+private:
+    /**
+     * |y| / (1 + e^(2|y|)).
+     */
+    template <typename Lanes>
+    static CL_SIMD_INLINE Lanes H(const Lanes& y) {
+        Lanes a = cl::batch_math::Abs(y);
+        return a / (1.0 + cl::batch_math::Exp(2.0 * a));
+    }
+
+    int n_;
+    Phases phases_;
+};
+
+/// UF5 kernel, see UF5Test.
+class UF5Kernel : public BasicKernel {
+public:
+    explicit UF5Kernel(int n)
+        : n_(n), phases_(n, 1.0) {}
+
+    template <typename Lanes>
+    CL_SIMD_INLINE void Evaluate(const double* x, double* f) const {
+        const double nn = 10.0;
+
+        Lanes x0 = Variable<Lanes>(x, 0);
+        Lanes sa, ca;
+        cl::batch_math::SinCos(6.0 * cl::PI * x0, &sa, &ca);
+        Lanes h = (1.0 / (2.0 * nn) + 0.1) *
+                  cl::batch_math::Abs(cl::batch_math::Sin(2.0 * nn * x0));
+        Lanes sum1 = cl::batch_math::Broadcast<Lanes>(0.0);
+        for (int j = 3; j <= n_; j += 2) {
+            sum1 += H(Variable<Lanes>(x, j - 1) - phases_.Sin(sa, ca, j));
+        }
+        Lanes sum2 = cl::batch_math::Broadcast<Lanes>(0.0);
+        for (int j = 2; j <= n_; j += 2) {
+            sum2 += H(Variable<Lanes>(x, j - 1) - phases_.Sin(sa, ca, j));
+        }
+        SetObjective(x0 + h + 2.0 / Count(3, n_, 2) * sum1, 0, f);
+        SetObjective(1.0 - x0 + h + 2.0 / Count(2, n_, 2) * sum2, 1, f);
+    }
+
+private:
+    /**
+     * 2y^2 - cos(4PI * y) + 1.
+     */
+    template <typename Lanes>
+    static CL_SIMD_INLINE Lanes H(const Lanes& y) {
+        return 2.0 * y * y - cl::batch_math::Cos(4.0 * cl::PI * y) + 1.0;
+    }
+
+    int n_;
+    Phases phases_;
+};
+
+/// UF6 kernel, see UF6Test.
+class UF6Kernel : public BasicKernel {
+public:
+    explicit UF6Kernel(int n)
+        : n_(n), phases_(n, 1.0), frequencies_(n + 1) {
+        // The frequencies of the product, 20PI / sqrt(j).
+        for (int j = 1; j <= n; ++j) {
+            frequencies_[j] = 20.0 * cl::PI / std::sqrt(j);
+        }
+    }
+
+    template <typename Lanes>
+    CL_SIMD_INLINE void Evaluate(const double* x, double* f) const {
+        const double nn = 10.0;
+
+        Lanes x0 = Variable<Lanes>(x, 0);
+        Lanes sa, ca;
+        cl::batch_math::SinCos(6.0 * cl::PI * x0, &sa, &ca);
+        Lanes h = ClampToZero((1.0 / (2.0 * nn) + 0.1) *
+                              cl::batch_math::Sin(2.0 * nn * x0));
+        SetObjective(x0 + h + 2.0 / Count(3, n_, 2) * Sum(x, sa, ca, 3),
+                     0, f);
+        SetObjective(1.0 - x0 + h + 2.0 / Count(2, n_, 2) * Sum(x, sa, ca, 2),
+                     1, f);
+    }
+
+private:
+    /**
+     * 4 * Sum[yj^2] - 2 * Product[cos(20PI * yj / sqrt(j))] + 2 for
+     * j = first, first + 2, ...
+     */
+    template <typename Lanes>
+    CL_SIMD_INLINE Lanes Sum(const double* x, const Lanes& sa,
+                             const Lanes& ca, int first) const {
+        Lanes sum = cl::batch_math::Broadcast<Lanes>(0.0);
+        Lanes product = cl::batch_math::Broadcast<Lanes>(1.0);
+        for (int j = first; j <= n_; j += 2) {
+            Lanes y = Variable<Lanes>(x, j - 1) - phases_.Sin(sa, ca, j);
+            sum += y * y;
+            product *= cl::batch_math::Cos(y * frequencies_[j]);
+        }
+        return 4.0 * sum - 2.0 * product + 2.0;
+    }
+
+    int n_;
+    Phases phases_;
+    std::vector<double> frequencies_;
+};
+
+/// UF7 kernel, see UF7Test.
+class UF7Kernel : public BasicKernel {
+public:
+    explicit UF7Kernel(int n)
+        : n_(n), phases_(n, 1.0) {}
+
+    template <typename Lanes>
+    CL_SIMD_INLINE void Evaluate(const double* x, double* f) const {
+        Lanes x0 = Variable<Lanes>(x, 0);
+        Lanes sa, ca;
+        cl::batch_math::SinCos(6.0 * cl::PI * x0, &sa, &ca);
+        Lanes h = cl::batch_math::Pow(x0,
+                                      cl::batch_math::Broadcast<Lanes>(0.2));
+        Lanes sum1 = cl::batch_math::Broadcast<Lanes>(0.0);
+        for (int j = 3; j <= n_; j += 2) {
+            sum1 += Square(Variable<Lanes>(x, j - 1) - phases_.Sin(sa, ca, j));
+        }
+        Lanes sum2 = cl::batch_math::Broadcast<Lanes>(0.0);
+        for (int j = 2; j <= n_; j += 2) {
+            sum2 += Square(Variable<Lanes>(x, j - 1) - phases_.Sin(sa, ca, j));
+        }
+        SetObjective(h + 2.0 / Count(3, n_, 2) * sum1, 0, f);
+        SetObjective(1.0 - h + 2.0 / Count(2, n_, 2) * sum2, 1, f);
+    }
+
+private:
+    int n_;
+    Phases phases_;
+};
+
+/// UF9 kernel, see UF9Test.
+class UF9Kernel : public BasicKernel {
+public:
+    explicit UF9Kernel(int n)
+        : n_(n), phases_(n, 1.0) {}
+
+    template <typename Lanes>
+    CL_SIMD_INLINE void Evaluate(const double* x, double* f) const {
+        Lanes x0 = Variable<Lanes>(x, 0);
+        Lanes x1 = Variable<Lanes>(x, 1);
+        Lanes sa, ca;
+        cl::batch_math::SinCos(2.0 * cl::PI * x0, &sa, &ca);
+        Lanes r = 2.0 * x1;
+        Lanes sums[3] = {};
+        for (int j = 3; j <= n_; ++j) {
+            sums[(j - 1) % 3] += Square(Variable<Lanes>(x, j - 1) -
+                                        r * phases_.Sin(sa, ca, j));
+        }
+        Lanes t = ClampToZero((1.0 + 0.1) *
+                              (1.0 - 4.0 * Square(2.0 * x0 - 1.0)));
+        SetObjective(0.5 * (t + 2.0 * x0) * x1 +
+                     2.0 / Count(4, n_, 3) * sums[0], 0, f);
+        SetObjective(0.5 * (t - 2.0 * x0 + 2.0) * x1 +
+                     2.0 / Count(5, n_, 3) * sums[1], 1, f);
+        SetObjective(1.0 - x1 + 2.0 / Count(3, n_, 3) * sums[2], 2, f);
+    }
+
+private:
+    int n_;
+    Phases phases_;
+};
+
+/// UF10 kernel, see UF10Test.
+class UF10Kernel : public BasicKernel {
+public:
+    explicit UF10Kernel(int n)
+        : n_(n), phases_(n, 1.0) {}
+
+    template <typename Lanes>
+    CL_SIMD_INLINE void Evaluate(const double* x, double* f) const {
+        Lanes x0 = Variable<Lanes>(x, 0);
+        Lanes x1 = Variable<Lanes>(x, 1);
+        Lanes sa, ca, s0, c0, s1, c1;
+        cl::batch_math::SinCos(2.0 * cl::PI * x0, &sa, &ca);
+        cl::batch_math::SinCos(0.5 * x0 * cl::PI, &s0, &c0);
+        cl::batch_math::SinCos(0.5 * x1 * cl::PI, &s1, &c1);
+        Lanes r = 2.0 * x1;
+        Lanes sums[3] = {};
+        for (int j = 3; j <= n_; ++j) {
+            Lanes y = Variable<Lanes>(x, j - 1) - r * phases_.Sin(sa, ca, j);
+            sums[(j - 1) % 3] += 4.0 * y * y -
+                                 cl::batch_math::Cos(8.0 * cl::PI * y) + 1.0;
+        }
+        SetObjective(c0 * c1 + 2.0 / Count(4, n_, 3) * sums[0], 0, f);
+        SetObjective(c0 * s1 + 2.0 / Count(5, n_, 3) * sums[1], 1, f);
+        SetObjective(s0 + 2.0 / Count(3, n_, 3) * sums[2], 2, f);
+    }
+
+private:
+    int n_;
+    Phases phases_;
+};
+
+/// CF1 kernel, see CF1Test. The constraint is evaluated by the test.
+class CF1Kernel : public BasicKernel {
+public:
+    explicit CF1Kernel(int n)
+        : n_(n), exponents_(Exponents(n)) {}
+
+    template <typename Lanes>
+    CL_SIMD_INLINE void Evaluate(const double* x, double* f) const {
+        Lanes x0 = Variable<Lanes>(x, 0);
+        Lanes log_x0 = cl::batch_math::Log(x0);
+        Lanes sum1 = cl::batch_math::Broadcast<Lanes>(0.0);
+        for (int j = 3; j <= n_; j += 2) {
+            sum1 += Square(Variable<Lanes>(x, j - 1) -
+                           cl::batch_math::Exp(log_x0 * exponents_[j]));
+        }
+        Lanes sum2 = cl::batch_math::Broadcast<Lanes>(0.0);
+        for (int j = 2; j <= n_; j += 2) {
+            sum2 += Square(Variable<Lanes>(x, j - 1) -
+                           cl::batch_math::Exp(log_x0 * exponents_[j]));
+        }
+        SetObjective(x0 + 2.0 / Count(3, n_, 2) * sum1, 0, f);
+        SetObjective(1.0 - x0 + 2.0 / Count(2, n_, 2) * sum2, 1, f);
+    }
+
+private:
+    int n_;
+    std::vector<double> exponents_;
+};
+
+/// CF2 kernel, see CF2Test. The constraint is evaluated by the test.
+class CF2Kernel : public BasicKernel {
+public:
+    explicit CF2Kernel(int n)
+        : n_(n), phases_(n, 1.0) {}
+
+    template <typename Lanes>
+    CL_SIMD_INLINE void Evaluate(const double* x, double* f) const {
+        Lanes x0 = Variable<Lanes>(x, 0);
+        Lanes sa, ca;
+        cl::batch_math::SinCos(6.0 * cl::PI * x0, &sa, &ca);
+        Lanes sum1 = cl::batch_math::Broadcast<Lanes>(0.0);
+        for (int j = 3; j <= n_; j += 2) {
+            sum1 += Square(Variable<Lanes>(x, j - 1) - phases_.Sin(sa, ca, j));
+        }
+        Lanes sum2 = cl::batch_math::Broadcast<Lanes>(0.0);
+        for (int j = 2; j <= n_; j += 2) {
+            sum2 += Square(Variable<Lanes>(x, j - 1) - phases_.Cos(sa, ca, j));
+        }
+        SetObjective(x0 + 2.0 / Count(3, n_, 2) * sum1, 0, f);
+        SetObjective(1.0 - cl::batch_math::Sqrt(x0) +
+                     2.0 / Count(2, n_, 2) * sum2, 1, f);
+    }
+
+private:
+    int n_;
+    Phases phases_;
+};
+
+/// CTP1 kernel, see CTP1Test. The constraints are evaluated by the test.
+class CTP1Kernel : public BasicKernel {
+public:
+    explicit CTP1Kernel(int n)
+        : n_(n) {}
+
+    template <typename Lanes>
+    CL_SIMD_INLINE void Evaluate(const double* x, double* f) const {
+        Lanes x0 = Variable<Lanes>(x, 0);
+        Lanes g = 1.0 + 9.0 * (Sum<Lanes>(x, 1, n_) / (n_ - 1));
+        SetObjective(x0, 0, f);
+        SetObjective(g * cl::batch_math::Exp(-x0 / g), 1, f);
+    }
+
+private:
+    int n_;
+};
+
+/// Kernel Factory.
+/**
+ * It creates the SIMD evaluators of the built-in tests. The evaluators are
+ * optional, the tests are unchanged and still evaluated one by one unless the
+ * evaluator is set:
+ *
+ *    BasicTest* test = TestFactory::CreateTest("LZ8");
+ *    BatchEvaluator* evaluator = KernelFactory::CreateEvaluator(*test);
+ *    if (evaluator) test->batch_evaluator = evaluator;
+ *
+ * CF3, CF4 and CF5 have no kernel, since they read x[n]. SCH, FON and KUR have
+ * no kernel, since they have few variables.
+ */
+class KernelFactory {
+public:
+    /**
+     * Create the evaluator of the test, owned by the caller. It uses the given
+     * instruction set, which must be supported by the processor, the best one
+     * by default.
+     *
+     * @return NULL if there is no kernel for the test.
+     */
+    static BatchEvaluator* CreateEvaluator(
+            const BasicTest& test,
+            cl::simd::SimdLevel level = cl::simd::SupportedLevel()) {
+        const std::string& name = test.name;
+        int n = test.parameter.n_variables;
+
+        if (name == "ZDT1") return Create(ZDT1Kernel(n), test, level);
+        if (name == "ZDT2") return Create(ZDT2Kernel(n), test, level);
+        if (name == "ZDT3") return Create(ZDT3Kernel(n), test, level);
+        if (name == "ZDT4") return Create(ZDT4Kernel(n), test, level);
+        if (name == "ZDT6") return Create(ZDT6Kernel(n), test, level);
+        if (name == "DTLZ1") return Create(DTLZ1Kernel(n), test, level);
+        if (name == "DTLZ2") return Create(DTLZ2Kernel(n), test, level);
+        if (name == "DTLZ3") return Create(DTLZ3Kernel(n), test, level);
+        if (name == "DTLZ4") return Create(DTLZ4Kernel(n), test, level);
+        if (name == "DTLZ5") return Create(DTLZ5Kernel(n), test, level);
+        if (name == "LZ1") return Create(LZ1Kernel(n), test, level);
+        if (name == "LZ2") return Create(LZ2Kernel(n), test, level);
+        if (name == "LZ3") return Create(LZ3Kernel(n), test, level);
+        if (name == "LZ4") return Create(LZ4Kernel(n), test, level);
+        if (name == "LZ5") return Create(LZ5Kernel(n), test, level);
+        if (name == "LZ6") return Create(LZ6Kernel(n), test, level);
+        if (name == "LZ7") return Create(LZ7Kernel(n), test, level);
+        if (name == "LZ8") return Create(LZ8Kernel(n), test, level);
+        if (name == "LZ9") return Create(LZ9Kernel(n), test, level);
+        if (name == "UF4") return Create(UF4Kernel(n), test, level);
+        if (name == "UF5") return Create(UF5Kernel(n), test, level);
+        if (name == "UF6") return Create(UF6Kernel(n), test, level);
+        if (name == "UF7") return Create(UF7Kernel(n), test, level);
+        if (name == "UF9") return Create(UF9Kernel(n), test, level);
+        if (name == "UF10") return Create(UF10Kernel(n), test, level);
+        if (name == "CF1") return Create(CF1Kernel(n), test, level);
+        if (name == "CF2") return Create(CF2Kernel(n), test, level);
+        if (name == "CTP1") return Create(CTP1Kernel(n), test, level);
+        return NULL;
+    }
+
+private:
+    template <class Kernel>
+    static BatchEvaluator* Create(const Kernel& kernel, const BasicTest& test,
+                                  cl::simd::SimdLevel level) {
+        KernelEvaluator<Kernel>* evaluator = new KernelEvaluator<Kernel>(
+                kernel, test.parameter.n_variables,
+                test.parameter.n_objectives);
+        evaluator->set_level(level);
+        return evaluator;
+    }
+};
+
+} // namespace moo
+
+#endif // CL_BATCH_MATH
+
+#endif // TEST_BATCH_TEST_KERNELS_H_
@@ -17,12 +17,18 @@
 
 #include "codelibrary/util/array/array_2d.h"
 
+#include "core/math.h"
 #include "core/population.h"
 #include "solver/util/non_dominated_sort.h"
 
 namespace moo {
 
 /// Metrics for population.
+/**
+ * The reference fronts may be stored in float (cl::Array2D<float>) to halve
+ * the memory of the large ones, e.g., of 10^6 points. The distances are still
+ * computed in double, on the rounded points of front.
+ */
 class Metrics {
 public:
 
@@ -57,20 +63,26 @@ public:
     /**
      * Get IGD metrics.
      */
+    template <typename T>
     static double IGD(const Population& population,
-                      const cl::Array2D<double>& pareto_fronts) {
+                      const cl::Array2D<T>& pareto_fronts) {
         Population nondominated_solutions = GetNondominated(population);
 
         double igd = 0.0;
 
+        // The point of front, widened to double once for all solutions.
+        std::vector<double> point(pareto_fronts.columns());
         for (int i = 0; i < pareto_fronts.rows(); ++i){
+            for (int k = 0; k < pareto_fronts.columns(); ++k){
+                point[k] = pareto_fronts(i,k);
+            }
             double min_igd = DBL_MAX;
             for (size_t j = 0; j < nondominated_solutions.size(); ++j){
                 const Individual& ind = nondominated_solutions[j];
                 double temp = 0.0;
                 for (int k = 0; k < pareto_fronts.columns(); ++k){
-                    temp += (pareto_fronts(i,k) - ind.objectives[k]) *
-                            (pareto_fronts(i,k) - ind.objectives[k]);
+                    temp += (point[k] - ind.objectives[k]) *
+                            (point[k] - ind.objectives[k]);
                 }
                 min_igd = std::min(min_igd, temp);
             }
@@ -83,8 +95,9 @@ public:
     /**
      * Get GD metrics.
      */
+    template <typename T>
     static double GD(const Population& population,
-                     const cl::Array2D<double>& pareto_fronts) {
+                     const cl::Array2D<T>& pareto_fronts) {
         Population nondominated_solutions = GetNondominated(population);
         double convergences = 0.0;
         for (size_t i = 0; i < nondominated_solutions.size(); ++i){
@@ -107,8 +120,9 @@ public:
     /**
      * Get convergences metrics.
      */
+    template <typename T>
     static double Convergences(const Population& population,
-                               const cl::Array2D<double>& pareto_fronts) {
+                               const cl::Array2D<T>& pareto_fronts) {
         Population nondominated_solutions = GetNondominated(population);
 
         double convergences = 0.0;
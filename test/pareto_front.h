@@ -0,0 +1,482 @@
+//
+// Copyright 2013 Yangbin Lin and Bili Chen. All Rights Reserved.
+//
+// Author: yblin.xmu@qq.com (Yangbin Lin)
+//
+// To use this code, please cite the follow paper:
+//
+// Chen B, Zeng W, Lin Y, et al. A New Local Search-Based Multiobjective
+// Optimization Algorithm[J]. IEEE Transactions on Evolutionary Computation,
+// 2014, 19(1):1-1.
+//
+
+#ifndef TEST_PARETO_FRONT_H_
+#define TEST_PARETO_FRONT_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cfloat>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "codelibrary/base/constants.h"
+#include "codelibrary/util/array/array_2d.h"
+#include "core/math.h"
+#include "test/pareto_front_io.h"
+#include "test/test_dtlz.h"
+
+namespace moo {
+
+/// Reference Pareto Fronts of the Tests.
+/**
+ * ParetoFront samples the true Pareto front of every test in TestFactory at a
+ * requested density, and loads the reference fronts from files. The results
+ * are cached for the whole process, so repeated experiments share the same
+ * front instead of regenerating or reparsing it. The cache is thread-safe and
+ * the returned fronts are never released.
+ *
+ * The fronts follow the tests as they are implemented in this library, which
+ * differ from the original papers in a few places (UF5, UF6, DTLZ5, CF4 and
+ * CF5, see Sample()).
+ *
+ * Usage:
+ *    const cl::Array2D<double>* front = ParetoFront::Get("ZDT1", 1000);
+ *    double igd = Metrics::IGD(population, *front);
+ */
+class ParetoFront {
+    typedef std::pair<double, double> Point2D;
+
+public:
+    /**
+     * Return the cached front of the given test with about n_points points, or
+     * NULL if the test is unknown. The name is the name in TestFactory.
+     */
+    static const cl::Array2D<double>* Get(const std::string& name,
+                                          int n_points) {
+        assert(n_points > 0);
+
+        Cache* cache = GetCache();
+        std::lock_guard<std::mutex> lock(cache->mutex);
+
+        std::unique_ptr<cl::Array2D<double> >& front =
+                cache->samples[std::make_pair(name, n_points)];
+        if (!front) {
+            std::unique_ptr<cl::Array2D<double> > sample(
+                        new cl::Array2D<double>());
+            if (!Sample(name, n_points, sample.get())) return NULL;
+            front.swap(sample);
+        }
+        return front.get();
+    }
+
+    /**
+     * Return the cached front loaded from the given file (text or binary, see
+     * ParetoFrontIO), or NULL if the file can not be loaded.
+     */
+    static const cl::Array2D<double>* Load(const std::string& file) {
+        Cache* cache = GetCache();
+        std::lock_guard<std::mutex> lock(cache->mutex);
+
+        std::unique_ptr<cl::Array2D<double> >& front = cache->files[file];
+        if (!front) {
+            std::unique_ptr<cl::Array2D<double> > loaded(
+                        new cl::Array2D<double>());
+            if (!ParetoFrontIO::Load(file, loaded.get())) return NULL;
+            front.swap(loaded);
+        }
+        return front.get();
+    }
+
+    /**
+     * Sample the front of the given test without caching.
+     *
+     * The two-objective fronts have n_points points evenly spaced by the arc
+     * length of the front, except the discrete fronts (CF1 and UF5). The
+     * three-objective fronts are sampled from a lattice, and have at least
+     * n_points points.
+     *
+     * @return false if the test is unknown.
+     */
+    static bool Sample(const std::string& name, int n_points,
+                       cl::Array2D<double>* front) {
+        assert(n_points > 0);
+        assert(front);
+
+        std::vector<Point2D> curve;
+        if (name == "SCH") {
+            // x in [0, 2].
+            for (int i = 0; i < N_CURVE; ++i) {
+                double x = 2.0 * i / (N_CURVE - 1);
+                curve.push_back(Point2D(x * x, (x - 2.0) * (x - 2.0)));
+            }
+        } else if (name == "FON") {
+            // x0 = x1 = x2 = t in [-1/sqrt(3), 1/sqrt(3)].
+            double s = 1.0 / std::sqrt(3.0);
+            for (int i = 0; i < N_CURVE; ++i) {
+                double t = -s + 2.0 * s * i / (N_CURVE - 1);
+                curve.push_back(Point2D(1.0 - std::exp(-3.0 * Sqr(t - s)),
+                                        1.0 - std::exp(-3.0 * Sqr(t + s))));
+            }
+        } else if (name == "KUR") {
+            SampleKUR(n_points, &curve);
+        } else if (name == "ZDT1" || name == "ZDT4" || name == "LZ1" ||
+                   name == "LZ2" || name == "LZ3" || name == "LZ4" ||
+                   name == "LZ5" || name == "LZ7" || name == "LZ8" ||
+                   name == "CF2") {
+            // f2 = 1 - sqrt(f1).
+            for (int i = 0; i < N_CURVE; ++i) {
+                double f1 = static_cast<double>(i) / (N_CURVE - 1);
+                double f2 = 1.0 - std::sqrt(f1);
+                // The constraint of CF2 (N = 2) on the front.
+                if (name == "CF2" &&
+                    std::sin(2.0 * cl::PI * (std::sqrt(f1) - f2 + 1.0)) >
+                    1e-12) {
+                    curve.push_back(Infeasible());
+                } else {
+                    curve.push_back(Point2D(f1, f2));
+                }
+            }
+        } else if (name == "ZDT2" || name == "LZ9" || name == "UF4" ||
+                   name == "CF3") {
+            // f2 = 1 - f1^2.
+            for (int i = 0; i < N_CURVE; ++i) {
+                double f1 = static_cast<double>(i) / (N_CURVE - 1);
+                double f2 = 1.0 - f1 * f1;
+                // The constraint of CF3 (N = 2) on the front.
+                if (name == "CF3" &&
+                    std::sin(2.0 * cl::PI * (f1 * f1 - f2 + 1.0)) > 1e-12) {
+                    curve.push_back(Infeasible());
+                } else {
+                    curve.push_back(Point2D(f1, f2));
+                }
+            }
+        } else if (name == "ZDT3") {
+            for (int i = 0; i < N_CURVE; ++i) {
+                double f1 = static_cast<double>(i) / (N_CURVE - 1);
+                curve.push_back(Point2D(f1, 1.0 - std::sqrt(f1) -
+                                        f1 * std::sin(10.0 * cl::PI * f1)));
+            }
+        } else if (name == "ZDT6") {
+            // f2 = 1 - f1^2, where f1 = 1 - exp(-4x) * sin^6(6 PI x) is not
+            // monotone in x, so the curve is parameterized by f1 from its
+            // minimum.
+            double min_f1 = 1.0;
+            for (int i = 0; i < N_CURVE; ++i) {
+                double x = 0.2 * i / (N_CURVE - 1);
+                min_f1 = std::min(min_f1, 1.0 - std::exp(-4.0 * x) *
+                                  std::pow(std::sin(6.0 * cl::PI * x), 6.0));
+            }
+            for (int i = 0; i < N_CURVE; ++i) {
+                double f1 = min_f1 + (1.0 - min_f1) * i / (N_CURVE - 1);
+                curve.push_back(Point2D(f1, 1.0 - f1 * f1));
+            }
+        } else if (name == "UF5" || name == "UF6") {
+            // The UF5 and UF6 here use sin(2N x0) instead of sin(2N PI x0):
+            // f1 = x0 + h(x0), f2 = 1 - x0 + h(x0).
+            for (int i = 0; i < N_CURVE; ++i) {
+                double x = static_cast<double>(i) / (N_CURVE - 1);
+                double h = 0.15 * std::sin(20.0 * x);
+                h = name == "UF5" ? std::fabs(h) : std::max(h, 0.0);
+                curve.push_back(Point2D(x + h, 1.0 - x + h));
+            }
+        } else if (name == "UF7" || name == "CF4" || name == "CF5") {
+            // The constraints of CF4 and CF5 here only involve x1, which is
+            // not used by the objectives, so their fronts are unconstrained.
+            for (int i = 0; i < N_CURVE; ++i) {
+                double f1 = static_cast<double>(i) / (N_CURVE - 1);
+                curve.push_back(Point2D(f1, 1.0 - f1));
+            }
+        } else if (name == "CF1") {
+            // The discrete front: f1 = i / 2N, f2 = 1 - f1, N = 10.
+            front->Resize(21, 2);
+            for (int i = 0; i <= 20; ++i) {
+                (*front)(i, 0) = i / 20.0;
+                (*front)(i, 1) = 1.0 - i / 20.0;
+            }
+            return true;
+        } else if (name == "CTP1") {
+            // The lowest feasible f2 = g * exp(-f1) with g >= 1.
+            for (int i = 0; i < N_CURVE; ++i) {
+                double f1 = static_cast<double>(i) / (N_CURVE - 1);
+                double f2 = std::max(std::exp(-f1),
+                                     std::max(0.858 * std::exp(-0.541 * f1),
+                                              0.728 * std::exp(-0.295 * f1)));
+                curve.push_back(Point2D(f1, f2));
+            }
+        } else if (name == "DTLZ1_3D") {
+            SampleSimplex(n_points, front);
+            for (double& v : front->data()) {
+                v *= 0.5;
+            }
+            return true;
+        } else if (name == "DTLZ2_3D" || name == "DTLZ3_3D" ||
+                   name == "DTLZ4_3D" || name == "LZ6" || name == "UF10") {
+            SampleSphere(n_points, front);
+            return true;
+        } else if (name == "UF9") {
+            SampleUF9(n_points, front);
+            return true;
+        } else if (name == "DTLZ5_3D") {
+            SampleDTLZ5(n_points, front);
+            return true;
+        } else {
+            return false;
+        }
+
+        ArcLengthSample(curve, n_points, front);
+        return true;
+    }
+
+private:
+    // The number of samples of the parameter of a two-objective front.
+    static const int N_CURVE = 100000;
+
+    // The cache of fronts.
+    struct Cache {
+        std::mutex mutex;
+        std::map<std::pair<std::string, int>,
+                 std::unique_ptr<cl::Array2D<double> > > samples;
+        std::map<std::string, std::unique_ptr<cl::Array2D<double> > > files;
+    };
+
+    static Cache* GetCache() {
+        static Cache cache;
+        return &cache;
+    }
+
+    /**
+     * The infeasible samples of a curve are replaced by a dominated point, so
+     * that they split the curve like the dominated samples.
+     */
+    static Point2D Infeasible() {
+        return Point2D(DBL_MAX, DBL_MAX);
+    }
+
+    /**
+     * Sample n points evenly by arc length from a densely sampled curve.
+     *
+     * The dominated samples are removed first, which may split the curve into
+     * several pieces. The gaps between pieces are not counted into the arc
+     * length, and each point is the curve sample nearest to its arc length, so
+     * that all points lie exactly on the front.
+     */
+    static void ArcLengthSample(const std::vector<Point2D>& curve, int n,
+                                cl::Array2D<double>* front) {
+        // Indices of the non-dominated samples, sorted by f1.
+        std::vector<int> order(curve.size());
+        for (size_t i = 0; i < curve.size(); ++i) {
+            order[i] = static_cast<int>(i);
+        }
+        std::sort(order.begin(), order.end(), [&curve](int a, int b) {
+            return curve[a] < curve[b];
+        });
+        std::vector<int> kept;
+        double min_f2 = DBL_MAX;
+        for (int i : order) {
+            if (curve[i].second < min_f2) {
+                kept.push_back(i);
+                min_f2 = curve[i].second;
+            }
+        }
+
+        // Two consecutive non-dominated samples are on the same piece if no
+        // sample between them is removed.
+        std::vector<double> length(kept.size(), 0.0);
+        for (size_t i = 1; i < kept.size(); ++i) {
+            double d = 0.0;
+            if (std::abs(kept[i] - kept[i - 1]) == 1) {
+                d = std::sqrt(Sqr(curve[kept[i]].first -
+                                  curve[kept[i - 1]].first) +
+                              Sqr(curve[kept[i]].second -
+                                  curve[kept[i - 1]].second));
+            }
+            length[i] = length[i - 1] + d;
+        }
+
+        std::vector<int> selected;
+        double total = length.empty() ? 0.0 : length.back();
+        if (static_cast<int>(kept.size()) <= n || total == 0.0) {
+            selected = kept;
+        } else {
+            size_t j = 0;
+            for (int k = 0; k < n; ++k) {
+                double s = n == 1 ? 0.0 : total * k / (n - 1);
+                while (j + 1 < kept.size() && length[j + 1] < s) ++j;
+                size_t nearest = j;
+                if (j + 1 < kept.size() &&
+                    length[j + 1] - s < s - length[j]) {
+                    nearest = j + 1;
+                }
+                if (selected.empty() || selected.back() != kept[nearest]) {
+                    selected.push_back(kept[nearest]);
+                }
+            }
+        }
+
+        front->Resize(static_cast<int>(selected.size()), 2);
+        for (size_t i = 0; i < selected.size(); ++i) {
+            (*front)(i, 0) = curve[selected[i]].first;
+            (*front)(i, 1) = curve[selected[i]].second;
+        }
+    }
+
+    /**
+     * Sample the unit simplex in 3D by the lattice of Das and Dennis, with the
+     * smallest number of divisions that gives at least n points.
+     */
+    static void SampleSimplex(int n, cl::Array2D<double>* front) {
+        int h = 1;
+        while ((h + 1) * (h + 2) / 2 < n) ++h;
+
+        front->Resize((h + 1) * (h + 2) / 2, 3);
+        int k = 0;
+        for (int i = 0; i <= h; ++i) {
+            for (int j = 0; i + j <= h; ++j, ++k) {
+                (*front)(k, 0) = static_cast<double>(i) / h;
+                (*front)(k, 1) = static_cast<double>(j) / h;
+                (*front)(k, 2) = static_cast<double>(h - i - j) / h;
+            }
+        }
+    }
+
+    /**
+     * Sample the positive octant of the unit sphere by projecting the simplex
+     * lattice.
+     */
+    static void SampleSphere(int n, cl::Array2D<double>* front) {
+        SampleSimplex(n, front);
+        for (int i = 0; i < front->rows(); ++i) {
+            double norm = std::sqrt(Sqr((*front)(i, 0)) + Sqr((*front)(i, 1)) +
+                                    Sqr((*front)(i, 2)));
+            for (int j = 0; j < 3; ++j) {
+                (*front)(i, j) /= norm;
+            }
+        }
+    }
+
+    /**
+     * The front of UF9 is the part of plane f1 + f2 + f3 = 1 with
+     * f1 <= (1 - f3) / 4 or f1 >= 3 (1 - f3) / 4.
+     */
+    static void SampleUF9(int n, cl::Array2D<double>* front) {
+        // About half of the simplex is dominated.
+        cl::Array2D<double> simplex;
+        SampleSimplex(2 * n, &simplex);
+
+        std::vector<double> points;
+        for (int i = 0; i < simplex.rows(); ++i) {
+            double r = 1.0 - simplex(i, 2);
+            if (simplex(i, 0) <= 0.25 * r + 1e-12 ||
+                simplex(i, 0) >= 0.75 * r - 1e-12) {
+                points.insert(points.end(), &simplex(i, 0),
+                              &simplex(i, 0) + 3);
+            }
+        }
+        *front = cl::Array2D<double>(static_cast<int>(points.size() / 3), 3,
+                                     points.begin(), points.end());
+    }
+
+    /**
+     * The DTLZ5 here maps both position variables by theta and then multiplies
+     * them by PI / 2 again, so its front is not the curve of the original
+     * DTLZ5. Instead, the objectives are evaluated on a lattice of (x0, x1, g)
+     * and the non-dominated points are kept.
+     */
+    static void SampleDTLZ5(int n, cl::Array2D<double>* front) {
+        const int k = 10;
+        int m = std::max(8, static_cast<int>(std::ceil(std::sqrt(1.0 * n))));
+
+        std::vector<double> x(k + 2);
+        std::vector<double> points;
+        for (int a = 0; a < m; ++a) {
+            // g = sum (xi - 0.5)^2 in [0, k / 4].
+            double g = 0.25 * k * Sqr(static_cast<double>(a) / (m - 1));
+            std::fill(x.begin() + 2, x.end(), 0.5 + std::sqrt(g / k));
+            for (int b = 0; b < m; ++b) {
+                for (int c = 0; c < m; ++c) {
+                    x[0] = static_cast<double>(b) / (m - 1);
+                    x[1] = static_cast<double>(c) / (m - 1);
+                    points.push_back(DTLZ5_3DTest::Objective1(x));
+                    points.push_back(DTLZ5_3DTest::Objective2(x));
+                    points.push_back(DTLZ5_3DTest::Objective3(x));
+                }
+            }
+        }
+
+        NonDominated3D(points, front);
+    }
+
+    /**
+     * Keep the non-dominated points of the row-major 3D points.
+     */
+    static void NonDominated3D(const std::vector<double>& points,
+                               cl::Array2D<double>* front) {
+        int n = static_cast<int>(points.size() / 3);
+        std::vector<int> order(n);
+        for (int i = 0; i < n; ++i) {
+            order[i] = i;
+        }
+        std::sort(order.begin(), order.end(), [&points](int a, int b) {
+            return std::lexicographical_compare(&points[3 * a],
+                                                &points[3 * a] + 3,
+                                                &points[3 * b],
+                                                &points[3 * b] + 3);
+        });
+
+        // A point can only be dominated by the points before it.
+        std::vector<double> kept;
+        for (int i : order) {
+            const double* p = &points[3 * i];
+            bool dominated = false;
+            for (size_t j = 0; j < kept.size() && !dominated; j += 3) {
+                dominated = kept[j] <= p[0] && kept[j + 1] <= p[1] &&
+                            kept[j + 2] <= p[2];
+            }
+            if (!dominated) kept.insert(kept.end(), p, p + 3);
+        }
+
+        *front = cl::Array2D<double>(static_cast<int>(kept.size() / 3), 3,
+                                     kept.begin(), kept.end());
+    }
+
+    /**
+     * The f1 of KUR here only depends on r = |(x0, x1)|, and x2 only affects
+     * f2 by h(x2) = |x2|^0.8 + 5 sin(x2^3). So the front is the lower envelope
+     * of (f1(r), min h(x0) + h(x1) on the circle of radius r) + min h(x2).
+     */
+    static void SampleKUR(int n, std::vector<Point2D>* curve) {
+        const int n_angle = 720;
+        int n_radius = std::max(5000, 10 * n);
+
+        double min_h = DBL_MAX;
+        for (int i = 0; i <= 1000000; ++i) {
+            min_h = std::min(min_h, KURH(-5.0 + 10.0 * i / 1000000));
+        }
+
+        double max_radius = 5.0 * std::sqrt(2.0);
+        for (int i = 0; i < n_radius; ++i) {
+            double r = max_radius * i / (n_radius - 1);
+            double f2 = DBL_MAX;
+            for (int j = 0; j < n_angle; ++j) {
+                double angle = 2.0 * cl::PI * j / n_angle;
+                double x0 = r * std::cos(angle), x1 = r * std::sin(angle);
+                if (std::fabs(x0) > 5.0 || std::fabs(x1) > 5.0) continue;
+                f2 = std::min(f2, KURH(x0) + KURH(x1));
+            }
+            curve->push_back(Point2D(-20.0 * std::exp(-0.2 * r), f2 + min_h));
+        }
+    }
+
+    static double KURH(double x) {
+        return std::pow(std::fabs(x), 0.8) + 5.0 * std::sin(x * x * x);
+    }
+};
+
+} // namespace moo
+
+#endif // TEST_PARETO_FRONT_H_
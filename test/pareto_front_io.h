@@ -0,0 +1,303 @@
+//
+// Copyright 2013 Yangbin Lin and Bili Chen. All Rights Reserved.
+//
+// Author: yblin.xmu@qq.com (Yangbin Lin)
+//
+// To use this code, please cite the follow paper:
+//
+// Chen B, Zeng W, Lin Y, et al. A New Local Search-Based Multiobjective
+// Optimization Algorithm[J]. IEEE Transactions on Evolutionary Computation,
+// 2014, 19(1):1-1.
+//
+
+#ifndef TEST_PARETO_FRONT_IO_H_
+#define TEST_PARETO_FRONT_IO_H_
+
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "codelibrary/util/array/array_2d.h"
+#include "codelibrary/util/io/mapped_file.h"
+
+namespace moo {
+
+/// Reader and Writer of Reference Pareto Fronts.
+/**
+ * A reference front is a matrix whose rows are the points of front. Two formats
+ * are supported, and Load() detects the format automatically:
+ *
+ * 1. Text: one point per line, the values are separated by spaces, tabs,
+ *    commas or semicolons. Empty lines and the lines starting with '#' or '%'
+ *    (after any spaces or tabs) are ignored.
+ *
+ * 2. Binary: "NSLSPFRT", version (uint32), columns (uint32), rows (uint64),
+ *    then the row-major doubles in the native byte order. It is written by
+ *    SaveBinary() and loaded without parsing.
+ *
+ * Both formats are read through a memory mapped file. The text parser converts
+ * most decimal numbers directly from the digits, and only falls back to strtod
+ * for the numbers that can not be converted exactly this way.
+ */
+class ParetoFrontIO {
+public:
+    /**
+     * Load a reference front from a text or binary file.
+     */
+    static bool Load(const std::string& file, cl::Array2D<double>* front) {
+        assert(front);
+
+        cl::MappedFile mapped_file;
+        if (!mapped_file.Open(file)) return false;
+
+        const char* data = mapped_file.data();
+        size_t size = mapped_file.size();
+        if (size >= 8 && std::memcmp(data, "NSLSPFRT", 8) == 0) {
+            return ParseBinary(data, size, front);
+        }
+        return ParseText(data, size, front);
+    }
+
+    /**
+     * Save a reference front in the binary format.
+     */
+    static bool SaveBinary(const std::string& file,
+                           const cl::Array2D<double>& front) {
+        FILE* f = std::fopen(file.c_str(), "wb");
+        if (!f) return false;
+
+        uint32_t version = VERSION;
+        uint32_t columns = front.columns();
+        uint64_t rows = front.rows();
+        bool ok = std::fwrite("NSLSPFRT", 1, 8, f) == 8 &&
+                  std::fwrite(&version, sizeof(version), 1, f) == 1 &&
+                  std::fwrite(&columns, sizeof(columns), 1, f) == 1 &&
+                  std::fwrite(&rows, sizeof(rows), 1, f) == 1;
+        if (ok && !front.empty()) {
+            ok = std::fwrite(front.data().data(), sizeof(double),
+                             front.size(), f) == size_t(front.size());
+        }
+        return std::fclose(f) == 0 && ok;
+    }
+
+    /**
+     * Save a reference front in the text format.
+     */
+    static bool SaveText(const std::string& file,
+                         const cl::Array2D<double>& front) {
+        FILE* f = std::fopen(file.c_str(), "w");
+        if (!f) return false;
+
+        bool ok = true;
+        for (int i = 0; i < front.rows() && ok; ++i) {
+            for (int j = 0; j < front.columns(); ++j) {
+                ok = ok && std::fprintf(f, j == 0 ? "%.17g" : " %.17g",
+                                        front(i, j)) > 0;
+            }
+            ok = ok && std::fputc('\n', f) != EOF;
+        }
+        return std::fclose(f) == 0 && ok;
+    }
+
+private:
+    // The current version of binary format.
+    static const uint32_t VERSION = 1;
+
+    /**
+     * Parse the binary format.
+     */
+    static bool ParseBinary(const char* data, size_t size,
+                            cl::Array2D<double>* front) {
+        const size_t header_size = 24;
+        if (size < header_size) return false;
+
+        uint32_t version, columns;
+        uint64_t rows;
+        std::memcpy(&version, data + 8, sizeof(version));
+        std::memcpy(&columns, data + 12, sizeof(columns));
+        std::memcpy(&rows, data + 16, sizeof(rows));
+        if (version == 0 || version > VERSION) return false;
+        if (columns == 0 ? rows != 0 : rows > INT32_MAX / columns) {
+            return false;
+        }
+        if ((size - header_size) / sizeof(double) != rows * columns) {
+            return false;
+        }
+
+        front->Resize(static_cast<int>(rows), static_cast<int>(columns));
+        if (rows > 0) {
+            std::memcpy(front->data().data(), data + header_size,
+                        rows * columns * sizeof(double));
+        }
+        return true;
+    }
+
+    /**
+     * Parse the text format.
+     */
+    static bool ParseText(const char* data, size_t size,
+                          cl::Array2D<double>* front) {
+        const char* p = data;
+        const char* end = data + size;
+
+        std::vector<double> values;
+        int columns = 0, rows = 0;
+        while (p < end) {
+            // Skip the comments.
+            while (p < end && (*p == ' ' || *p == '\t')) ++p;
+            if (p < end && (*p == '#' || *p == '%')) {
+                while (p < end && *p != '\n') ++p;
+                continue;
+            }
+
+            int n = 0;
+            while (true) {
+                while (p < end && IsSeparator(*p)) ++p;
+                if (p == end || *p == '\n' || *p == '\r') break;
+
+                double value;
+                if (!ParseDouble(&p, end, &value)) return false;
+                values.push_back(value);
+                ++n;
+            }
+            while (p < end && (*p == '\n' || *p == '\r')) ++p;
+
+            if (n == 0) continue;
+            if (rows == 0) {
+                columns = n;
+            } else if (n != columns) {
+                return false;
+            }
+            ++rows;
+        }
+
+        *front = cl::Array2D<double>(rows, columns, values.begin(),
+                                     values.end());
+        return true;
+    }
+
+    static bool IsSeparator(char c) {
+        return c == ' ' || c == '\t' || c == ',' || c == ';';
+    }
+
+    /**
+     * Check if a number may end at p, i.e., p is the end of data, a separator
+     * or a line break.
+     */
+    static bool IsEndOfNumber(const char* p, const char* end) {
+        return p == end || IsSeparator(*p) || *p == '\n' || *p == '\r';
+    }
+
+    /**
+     * Parse a decimal number starting at *p, and move *p to the end of number.
+     *
+     * If the significand has at most 19 digits and fits in 53 bits, and the
+     * decimal exponent is within [-22, 22], the value is exactly
+     * significand * 10^exponent or significand / 10^-exponent, both rounded
+     * correctly by a single floating-point operation. Other numbers (including
+     * inf and nan) are passed to strtod. The number must be followed by a
+     * separator or a line break, e.g., "1.5-2" is rejected.
+     */
+    static bool ParseDouble(const char** p, const char* end, double* value) {
+        static const double powers[] = {
+            1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10,
+            1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21,
+            1e22
+        };
+
+        const char* s = *p;
+        bool negative = false;
+        if (s < end && (*s == '-' || *s == '+')) {
+            negative = *s == '-';
+            ++s;
+        }
+
+        uint64_t significand = 0;
+        int n_digits = 0, exponent = 0;
+        bool has_digits = false;
+        for (; s < end && IsDigit(*s); ++s) {
+            has_digits = true;
+            if (n_digits < 19) {
+                if (significand != 0 || *s != '0') {
+                    significand = significand * 10 + (*s - '0');
+                    ++n_digits;
+                }
+            } else {
+                ++exponent;
+                n_digits = 20;
+            }
+        }
+        if (s < end && *s == '.') {
+            for (++s; s < end && IsDigit(*s); ++s) {
+                has_digits = true;
+                if (n_digits < 19) {
+                    if (significand != 0 || *s != '0') {
+                        significand = significand * 10 + (*s - '0');
+                        ++n_digits;
+                    }
+                    --exponent;
+                } else {
+                    n_digits = 20;
+                }
+            }
+        }
+        if (has_digits && s < end && (*s == 'e' || *s == 'E')) {
+            const char* t = s + 1;
+            bool negative_exponent = false;
+            if (t < end && (*t == '-' || *t == '+')) {
+                negative_exponent = *t == '-';
+                ++t;
+            }
+            if (t < end && IsDigit(*t)) {
+                int e = 0;
+                for (; t < end && IsDigit(*t); ++t) {
+                    if (e < 100000) e = e * 10 + (*t - '0');
+                }
+                exponent += negative_exponent ? -e : e;
+                s = t;
+            }
+        }
+
+        if (has_digits && n_digits <= 19 &&
+            significand <= (UINT64_C(1) << 53) &&
+            exponent >= -22 && exponent <= 22 && IsEndOfNumber(s, end)) {
+            double v = static_cast<double>(significand);
+            v = exponent < 0 ? v / powers[-exponent] : v * powers[exponent];
+            *value = negative ? -v : v;
+            *p = s;
+            return true;
+        }
+
+        return ParseDoubleSlow(p, end, value);
+    }
+
+    /**
+     * Parse a number by strtod. The mapped data is not null-terminated, so the
+     * token is copied first.
+     */
+    static bool ParseDoubleSlow(const char** p, const char* end,
+                                double* value) {
+        const char* s = *p;
+        while (!IsEndOfNumber(s, end)) ++s;
+
+        std::string token(*p, s);
+        char* token_end = NULL;
+        *value = std::strtod(token.c_str(), &token_end);
+        if (token_end == token.c_str() || *token_end != '\0') return false;
+
+        *p = s;
+        return true;
+    }
+
+    static bool IsDigit(char c) {
+        return c >= '0' && c <= '9';
+    }
+};
+
+} // namespace moo
+
+#endif // TEST_PARETO_FRONT_IO_H_
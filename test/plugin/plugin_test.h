@@ -0,0 +1,245 @@
+//
+// Copyright 2013 Yangbin Lin and Bili Chen. All Rights Reserved.
+//
+// Author: yblin.xmu@qq.com (Yangbin Lin)
+//
+// To use this code, please cite the follow paper:
+//
+// Chen B, Zeng W, Lin Y, et al. A New Local Search-Based Multiobjective
+// Optimization Algorithm[J]. IEEE Transactions on Evolutionary Computation,
+// 2014, 19(1):1-1.
+//
+
+#ifndef TEST_PLUGIN_PLUGIN_TEST_H_
+#define TEST_PLUGIN_PLUGIN_TEST_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#include <dlfcn.h>
+#endif
+
+#include "codelibrary/base/macros.h"
+#include "codelibrary/util/array/array_2d.h"
+#include "core/batch_evaluator.h"
+#include "test/basic_test.h"
+#include "test/plugin/problem_plugin.h"
+
+namespace moo {
+
+/// Plugin Library.
+/**
+ * A loaded problem plugin. The shared object is unloaded when the library is
+ * destroyed, so the tests created from it share the library by a shared_ptr.
+ */
+class PluginLibrary {
+public:
+    PluginLibrary()
+        : handle_(NULL), plugin_(NULL) {}
+
+    ~PluginLibrary() {
+#ifndef _WIN32
+        if (handle_) dlclose(handle_);
+#endif
+    }
+
+    /**
+     * Load the shared object and check its problems.
+     *
+     * @return false if the plugin can not be loaded, or it is invalid. The
+     *         reason is given by error().
+     */
+    bool Load(const std::string& path) {
+        assert(!handle_);
+
+#ifdef _WIN32
+        error_ = "Plugins are not supported on this platform";
+        return false;
+#else
+        handle_ = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+        if (!handle_) {
+            error_ = dlerror();
+            return false;
+        }
+
+        // The object pointer to function pointer conversion is allowed by
+        // POSIX, but not by ISO C++, hence the copy.
+        void* symbol = dlsym(handle_, MOO_PLUGIN_ENTRY);
+        MooPluginEntry entry = NULL;
+        static_assert(sizeof(entry) == sizeof(symbol), "");
+        std::memcpy(&entry, &symbol, sizeof(entry));
+        if (!entry) {
+            error_ = path + ": no entry point " MOO_PLUGIN_ENTRY;
+            return false;
+        }
+
+        plugin_ = entry();
+        if (!plugin_) {
+            error_ = path + ": no plugin";
+            return false;
+        }
+        if (plugin_->abi_version != MOO_PLUGIN_ABI_VERSION) {
+            error_ = path + ": ABI version " +
+                     std::to_string(plugin_->abi_version) + ", expected " +
+                     std::to_string(MOO_PLUGIN_ABI_VERSION);
+            return false;
+        }
+        if (plugin_->n_problems < 0 ||
+            (plugin_->n_problems > 0 && !plugin_->problems)) {
+            error_ = path + ": no problems";
+            return false;
+        }
+        for (int i = 0; i < plugin_->n_problems; ++i) {
+            if (!IsValid(plugin_->problems[i])) {
+                error_ = path + ": invalid problem " + std::to_string(i);
+                return false;
+            }
+        }
+        return true;
+#endif // _WIN32
+    }
+
+    /**
+     * The number of problems, 0 if the plugin is not loaded.
+     */
+    int n_problems() const {
+        return plugin_ ? plugin_->n_problems : 0;
+    }
+
+    const MooProblem& problem(int i) const {
+        assert(0 <= i && i < n_problems());
+
+        return plugin_->problems[i];
+    }
+
+    const std::string& error() const { return error_; }
+
+private:
+    /**
+     * Return true if the metadata of the problem is complete.
+     */
+    static bool IsValid(const MooProblem& p) {
+        if (!p.name || !*p.name || p.n_variables <= 0 ||
+            p.n_objectives <= 0 || !p.min_variables || !p.max_variables ||
+            !p.evaluate) {
+            return false;
+        }
+        for (int i = 0; i < p.n_variables; ++i) {
+            if (!(p.min_variables[i] <= p.max_variables[i])) return false;
+        }
+        return true;
+    }
+
+    void* handle_;            // The handle of the shared object.
+    const MooPlugin* plugin_; // The problems exported by the plugin.
+    std::string error_;       // The reason of the last failure.
+
+    DISALLOW_COPY_AND_ASSIGN(PluginLibrary);
+};
+
+/// Plugin Test.
+/**
+ * A test whose objectives are computed by a plugin. The plugin evaluates a
+ * batch of candidates at once, so the test is evaluated only through its
+ * batch_evaluator, and 'objectives' is empty.
+ *
+ * To run a plugin problem in a ProcessPoolEvaluator, give the pool the
+ * function of the test:
+ *
+ *    ProcessPoolEvaluator pool(test->parameter.n_variables,
+ *                              test->parameter.n_objectives,
+ *                              [test](const std::vector<double>& x,
+ *                                     std::vector<double>* f) {
+ *                                  test->Evaluate(x.data(), 1, f->data());
+ *                              });
+ *    test->batch_evaluator = &pool;
+ */
+class PluginTest : public BasicTest {
+    /// Forward the batches to the plugin.
+    class Evaluator : public BatchEvaluator {
+    public:
+        explicit Evaluator(const PluginTest* test)
+            : test_(test) {}
+
+        virtual void Evaluate(const cl::Array2D<double>& variables,
+                              cl::Array2D<double>* objectives) {
+            assert(objectives);
+            assert(variables.empty() ||
+                   variables.columns() == test_->parameter.n_variables);
+
+            int n = variables.rows();
+            objectives->Resize(n, test_->parameter.n_objectives);
+            if (n == 0) return;
+
+            test_->Evaluate(variables.data().data(), n,
+                            objectives->data().data());
+        }
+
+    private:
+        const PluginTest* test_;
+    };
+
+public:
+    /**
+     * The i-th problem of the loaded library.
+     */
+    PluginTest(const std::shared_ptr<const PluginLibrary>& library, int i)
+        : library_(library), problem_(library->problem(i)), evaluator_(this) {
+        name = problem_.name;
+        parameter.n_variables = problem_.n_variables;
+        parameter.n_objectives = problem_.n_objectives;
+        parameter.n_constraints = 0;
+        parameter.min_variables.assign(problem_.min_variables,
+                                       problem_.min_variables +
+                                       problem_.n_variables);
+        parameter.max_variables.assign(problem_.max_variables,
+                                       problem_.max_variables +
+                                       problem_.n_variables);
+
+        if (problem_.variable_names) {
+            variable_names.assign(problem_.variable_names,
+                                  problem_.variable_names +
+                                  problem_.n_variables);
+        }
+        if (problem_.objective_names) {
+            objective_names.assign(problem_.objective_names,
+                                   problem_.objective_names +
+                                   problem_.n_objectives);
+        }
+
+        batch_evaluator = &evaluator_;
+    }
+
+    /**
+     * Evaluate n candidates, given as contiguous rows of variables. The
+     * objectives are written as contiguous rows, HUGE_VAL if the plugin fails.
+     */
+    void Evaluate(const double* variables, int n, double* objectives) const {
+        assert(n >= 0);
+
+        if (problem_.evaluate(problem_.data, variables, n, objectives) != 0) {
+            std::fill(objectives, objectives + n * parameter.n_objectives,
+                      HUGE_VAL);
+        }
+    }
+
+    std::vector<std::string> variable_names;  // Empty if not given.
+    std::vector<std::string> objective_names; // Empty if not given.
+
+private:
+    std::shared_ptr<const PluginLibrary> library_; // Keep the library loaded.
+    const MooProblem& problem_;                    // The problem in library.
+    Evaluator evaluator_;                          // The default evaluator.
+
+    DISALLOW_COPY_AND_ASSIGN(PluginTest);
+};
+
+} // namespace moo
+
+#endif // TEST_PLUGIN_PLUGIN_TEST_H_
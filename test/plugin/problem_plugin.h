@@ -0,0 +1,117 @@
+//
+// Copyright 2013 Yangbin Lin and Bili Chen. All Rights Reserved.
+//
+// Author: yblin.xmu@qq.com (Yangbin Lin)
+//
+// To use this code, please cite the follow paper:
+//
+// Chen B, Zeng W, Lin Y, et al. A New Local Search-Based Multiobjective
+// Optimization Algorithm[J]. IEEE Transactions on Evolutionary Computation,
+// 2014, 19(1):1-1.
+//
+
+#ifndef TEST_PLUGIN_PROBLEM_PLUGIN_H_
+#define TEST_PLUGIN_PROBLEM_PLUGIN_H_
+
+/*
+ * The C interface of the problem plugins.
+ *
+ * A plugin is a shared object that exports the function MOO_PLUGIN_ENTRY,
+ * which returns the description of its problems. This file is plain C, so the
+ * plugins can be written in C, C++ or any language that exports C functions,
+ * and built without the solver:
+ *
+ *    #include "test/plugin/problem_plugin.h"
+ *
+ *    static int Evaluate(void* data, const double* x, int n, double* f) {
+ *        for (int i = 0; i < n; ++i, x += 30, f += 2) {
+ *            ... f[0] = ..., f[1] = ...
+ *        }
+ *        return 0;
+ *    }
+ *
+ *    static const double lower[30] = { 0.0, ... };
+ *    static const double upper[30] = { 1.0, ... };
+ *    static const MooProblem problems[] = {
+ *        { "MY_ZDT1", 30, 2, lower, upper, NULL, NULL, Evaluate, NULL }
+ *    };
+ *    static const MooPlugin plugin = { MOO_PLUGIN_ABI_VERSION, 1, problems };
+ *
+ *    MOO_PLUGIN_EXPORT const MooPlugin* moo_plugin(void) { return &plugin; }
+ *
+ *    $ gcc -O3 -march=native -shared -fPIC my_problems.c -o my_problems.so
+ *
+ * The plugins in C++ may compute their elementary functions over arrays by
+ * codelibrary/math/batch_math_array.h, or over SIMD vectors by
+ * codelibrary/math/batch_math.h.
+ *
+ * All memory returned by the plugin is owned by the plugin, and must stay
+ * valid until the shared object is unloaded.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* The version of this interface, checked when a plugin is loaded. */
+#define MOO_PLUGIN_ABI_VERSION 1
+
+/* The name of the exported entry point. */
+#define MOO_PLUGIN_ENTRY "moo_plugin"
+
+#ifdef __cplusplus
+#define MOO_PLUGIN_EXTERN extern "C"
+#else
+#define MOO_PLUGIN_EXTERN extern
+#endif
+
+#if defined(_WIN32)
+#define MOO_PLUGIN_EXPORT MOO_PLUGIN_EXTERN __declspec(dllexport)
+#else
+#define MOO_PLUGIN_EXPORT MOO_PLUGIN_EXTERN \
+                          __attribute__((visibility("default")))
+#endif
+
+/*
+ * Evaluate 'n' candidates at once. 'variables' holds n rows of n_variables
+ * values and 'objectives' receives n rows of n_objectives values, both
+ * contiguous and row-major, so the function can vectorize over the rows.
+ * 'data' is the data pointer of the problem.
+ *
+ * Return 0 on success. On failure the objectives of the whole batch are set to
+ * HUGE_VAL by the solver.
+ *
+ * The function may be called from several threads or processes at once, so it
+ * must not modify shared state without synchronization.
+ */
+typedef int (*MooEvaluate)(void* data, const double* variables, int n,
+                           double* objectives);
+
+/* The metadata and the entry point of a problem. */
+typedef struct MooProblem {
+    const char* name;                   /* Unique name, used for lookup. */
+    int n_variables;                    /* The number of variables. */
+    int n_objectives;                   /* The number of objectives. */
+    const double* min_variables;        /* n_variables lower bounds. */
+    const double* max_variables;        /* n_variables upper bounds. */
+    const char* const* variable_names;  /* n_variables names, or NULL. */
+    const char* const* objective_names; /* n_objectives names, or NULL. */
+    MooEvaluate evaluate;               /* The batch evaluation. */
+    void* data;                         /* Passed to evaluate. */
+} MooProblem;
+
+/* The problems of a plugin. */
+typedef struct MooPlugin {
+    int abi_version;            /* Must be MOO_PLUGIN_ABI_VERSION. */
+    int n_problems;             /* The number of problems. */
+    const MooProblem* problems; /* The problems. */
+} MooPlugin;
+
+/* The type of the exported entry point. */
+typedef const MooPlugin* (*MooPluginEntry)(void);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* TEST_PLUGIN_PROBLEM_PLUGIN_H_ */
@@ -0,0 +1,326 @@
+//
+// Copyright 2013 Yangbin Lin and Bili Chen. All Rights Reserved.
+//
+// Author: yblin.xmu@qq.com (Yangbin Lin)
+//
+// To use this code, please cite the follow paper:
+//
+// Chen B, Zeng W, Lin Y, et al. A New Local Search-Based Multiobjective
+// Optimization Algorithm[J]. IEEE Transactions on Evolutionary Computation,
+// 2014, 19(1):1-1.
+//
+
+#ifndef TEST_SCALABLE_TEST_H_
+#define TEST_SCALABLE_TEST_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <string>
+
+#include "codelibrary/base/macros.h"
+#include "codelibrary/base/simd.h"
+#include "codelibrary/math/batch_math.h"
+#include "core/batch_evaluator.h"
+#include "test/basic_test.h"
+#include "test/batch/kernel_evaluator.h"
+
+namespace moo {
+
+/**
+ * The arithmetic of the scalable problems on one candidate (double) or on a
+ * block of candidates, one per lane of a vector of cl::batch_math. The
+ * formulas of a problem are written once for both:
+ *
+ *    template <typename Real>
+ *    CL_SIMD_INLINE void Evaluate(const double* x, double* f) const {
+ *        Real x0 = lanes::Get<Real>(x, 0);
+ *        lanes::Set(lanes::Cos(x0), 0, f);
+ *    }
+ *
+ * where x[i * N_LANES + l] is the i-th variable of the l-th candidate, as in
+ * KernelEvaluator, and N_LANES is 1 for double.
+ */
+namespace lanes {
+
+template <typename Real>
+struct RealTraits;
+
+template <>
+struct RealTraits<double> {
+    static const int N_LANES = 1;
+};
+
+template <typename Real>
+CL_SIMD_INLINE Real Broadcast(double value);
+
+template <>
+CL_SIMD_INLINE double Broadcast<double>(double value) {
+    return value;
+}
+
+/**
+ * The i-th value of the candidates.
+ */
+template <typename Real>
+CL_SIMD_INLINE Real Get(const double* x, int i);
+
+template <>
+CL_SIMD_INLINE double Get<double>(const double* x, int i) {
+    return x[i];
+}
+
+/**
+ * Set the i-th value of the candidates.
+ */
+CL_SIMD_INLINE void Set(double value, int i, double* x) {
+    x[i] = value;
+}
+
+CL_SIMD_INLINE double Abs(double x) {
+    return std::abs(x);
+}
+
+CL_SIMD_INLINE double Floor(double x) {
+    return std::floor(x);
+}
+
+CL_SIMD_INLINE double Min(double a, double b) {
+    return std::min(a, b);
+}
+
+CL_SIMD_INLINE double Max(double a, double b) {
+    return std::max(a, b);
+}
+
+CL_SIMD_INLINE double Sin(double x) {
+    return std::sin(x);
+}
+
+CL_SIMD_INLINE double Cos(double x) {
+    return std::cos(x);
+}
+
+CL_SIMD_INLINE double Exp(double x) {
+    return std::exp(x);
+}
+
+CL_SIMD_INLINE double Sqrt(double x) {
+    return std::sqrt(x);
+}
+
+CL_SIMD_INLINE double Pow(double x, double y) {
+    return std::pow(x, y);
+}
+
+CL_SIMD_INLINE void SinCos(double x, double* sin_x, double* cos_x) {
+    *sin_x = std::sin(x);
+    *cos_x = std::cos(x);
+}
+
+#if CL_BATCH_MATH
+
+template <>
+struct RealTraits<cl::batch_math::Lanes2>
+    : public cl::batch_math::LaneTraits<cl::batch_math::Lanes2> {};
+
+template <>
+struct RealTraits<cl::batch_math::Lanes4>
+    : public cl::batch_math::LaneTraits<cl::batch_math::Lanes4> {};
+
+template <>
+struct RealTraits<cl::batch_math::Lanes8>
+    : public cl::batch_math::LaneTraits<cl::batch_math::Lanes8> {};
+
+template <typename Real>
+CL_SIMD_INLINE Real Broadcast(double value) {
+    return cl::batch_math::Broadcast<Real>(value);
+}
+
+template <typename Real>
+CL_SIMD_INLINE Real Get(const double* x, int i) {
+    return cl::batch_math::Load<Real>(x + i * RealTraits<Real>::N_LANES);
+}
+
+template <typename V>
+CL_SIMD_INLINE void Set(const V& value, int i, double* x) {
+    cl::batch_math::Store(value, x + i * RealTraits<V>::N_LANES);
+}
+
+template <typename V>
+CL_SIMD_INLINE V Abs(const V& x) {
+    return cl::batch_math::Abs(x);
+}
+
+template <typename V>
+CL_SIMD_INLINE V Floor(const V& x) {
+    return cl::batch_math::Floor(x);
+}
+
+template <typename V>
+CL_SIMD_INLINE V Min(const V& a, const V& b) {
+    return cl::batch_math::Min(a, b);
+}
+
+template <typename V>
+CL_SIMD_INLINE V Max(const V& a, const V& b) {
+    return cl::batch_math::Max(a, b);
+}
+
+template <typename V>
+CL_SIMD_INLINE V Sin(const V& x) {
+    return cl::batch_math::Sin(x);
+}
+
+template <typename V>
+CL_SIMD_INLINE V Cos(const V& x) {
+    return cl::batch_math::Cos(x);
+}
+
+template <typename V>
+CL_SIMD_INLINE V Exp(const V& x) {
+    return cl::batch_math::Exp(x);
+}
+
+template <typename V>
+CL_SIMD_INLINE V Sqrt(const V& x) {
+    return cl::batch_math::Sqrt(x);
+}
+
+template <typename V>
+CL_SIMD_INLINE V Pow(const V& x, const V& y) {
+    return cl::batch_math::Pow(x, y);
+}
+
+template <typename V>
+CL_SIMD_INLINE V Pow(const V& x, double y) {
+    return cl::batch_math::Pow(x, cl::batch_math::Broadcast<V>(y));
+}
+
+template <typename V>
+CL_SIMD_INLINE void SinCos(const V& x, V* sin_x, V* cos_x) {
+    cl::batch_math::SinCos(x, sin_x, cos_x);
+}
+
+#endif // CL_BATCH_MATH
+
+/**
+ * Clamp x into [0, 1], i.e., correct the rounding errors of the values that
+ * are in [0, 1] by definition.
+ */
+template <typename Real>
+CL_SIMD_INLINE Real Clamp01(const Real& x) {
+    return Min(Max(x, Broadcast<Real>(0.0)), Broadcast<Real>(1.0));
+}
+
+} // namespace lanes
+
+/// Scalable Test.
+/**
+ * A test whose numbers of objectives and variables are chosen at the
+ * construction, e.g., to measure how the solver scales with them.
+ *
+ * The objectives are computed by the Problem for a batch of candidates, so the
+ * test is evaluated only through its batch_evaluator, and 'objectives' is
+ * empty. The Problem computes the objectives of one candidate or of a block of
+ * candidates by the same code (see lanes):
+ *
+ *    template <typename Real>
+ *    CL_SIMD_INLINE void Evaluate(const double* x, double* f) const;
+ *
+ * The blocks are evaluated by a KernelEvaluator, i.e., vectorized, unless
+ * set_vectorized(false) is called or the compiler has no vector extensions.
+ */
+template <class Problem>
+class ScalableTest : public BasicTest {
+    /// Evaluate the candidates one by one.
+    class Evaluator : public BatchEvaluator {
+    public:
+        explicit Evaluator(const ScalableTest* test)
+            : test_(test) {}
+
+        virtual void Evaluate(const cl::Array2D<double>& variables,
+                              cl::Array2D<double>* objectives) {
+            assert(objectives);
+            assert(variables.empty() ||
+                   variables.columns() == test_->parameter.n_variables);
+
+            int n = variables.rows();
+            int n_variables = test_->parameter.n_variables;
+            int n_objectives = test_->parameter.n_objectives;
+            objectives->Resize(n, n_objectives);
+            for (int i = 0; i < n; ++i) {
+                test_->Evaluate(variables.data().data() + i * n_variables,
+                                objectives->data().data() + i * n_objectives);
+            }
+        }
+
+    private:
+        const ScalableTest* test_;
+    };
+
+public:
+    /**
+     * The test of the problem with the variables in [0, 1].
+     */
+    ScalableTest(const std::string& test_name, const Problem& problem,
+                 int n_objectives, int n_variables)
+        : problem_(problem),
+          evaluator_(this)
+#if CL_BATCH_MATH
+        , kernel_evaluator_(problem, n_variables, n_objectives)
+#endif
+    {
+        assert(n_objectives > 0);
+        assert(n_variables > 0);
+
+        name = test_name;
+        parameter.n_objectives = n_objectives;
+        parameter.n_variables = n_variables;
+        parameter.n_constraints = 0;
+        parameter.min_variables.assign(n_variables, 0.0);
+        parameter.max_variables.assign(n_variables, 1.0);
+
+        set_vectorized(true);
+    }
+
+    /**
+     * Evaluate the objectives of one candidate.
+     */
+    void Evaluate(const double* variables, double* objectives) const {
+        problem_.template Evaluate<double>(variables, objectives);
+    }
+
+    /**
+     * Evaluate the blocks of candidates by the SIMD vectors, or the candidates
+     * one by one. The results differ by rounding only.
+     */
+    void set_vectorized(bool vectorized) {
+#if CL_BATCH_MATH
+        if (vectorized) {
+            batch_evaluator = &kernel_evaluator_;
+            return;
+        }
+#endif
+        batch_evaluator = &evaluator_;
+    }
+
+    bool vectorized() const {
+        return batch_evaluator != &evaluator_;
+    }
+
+    const Problem& problem() const { return problem_; }
+
+private:
+    Problem problem_;                            // The objectives.
+    Evaluator evaluator_;                        // The scalar evaluator.
+#if CL_BATCH_MATH
+    KernelEvaluator<Problem> kernel_evaluator_;  // The vectorized evaluator.
+#endif
+
+    DISALLOW_COPY_AND_ASSIGN(ScalableTest);
+};
+
+} // namespace moo
+
+#endif // TEST_SCALABLE_TEST_H_
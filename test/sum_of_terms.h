@@ -0,0 +1,92 @@
+//
+// Copyright 2013 Yangbin Lin and Bili Chen. All Rights Reserved.
+//
+// Author: yblin.xmu@qq.com (Yangbin Lin)
+//
+// To use this code, please cite the follow paper:
+//
+// Chen B, Zeng W, Lin Y, et al. A New Local Search-Based Multiobjective
+// Optimization Algorithm[J]. IEEE Transactions on Evolutionary Computation,
+// 2014, 19(1):1-1.
+//
+
+#ifndef TEST_SUM_OF_TERMS_H_
+#define TEST_SUM_OF_TERMS_H_
+
+#include <cassert>
+#include <vector>
+
+namespace moo {
+
+/// Incremental evaluation for the tests whose objectives are sums of terms.
+/**
+ * Many tests (e.g., LZ, UF and CF) have objectives of the form:
+ *
+ *   f_k(x) = h_k(x_0, ..., x_{P-1}) + c_k * Sum[t(x, i) | i % M == k, i >= P],
+ *
+ * where the first P variables are the position variables, M is the number of
+ * objectives, and the term t(x, i) only depends on the position variables and
+ * x_i. The partial state is the M sums, so that a change of a distance
+ * variable costs two term evaluations instead of the whole sum.
+ *
+ * The Test class must provide:
+ *   static double Term(const std::vector<double>& x, int i, double xi);
+ *   static void Objectives(const std::vector<double>& x, const double* sums,
+ *                          const int* counts,
+ *                          std::vector<double>* objectives);
+ */
+template <class Test, int M, int P>
+class SumOfTerms {
+public:
+    /**
+     * Initialize the M sums of terms.
+     */
+    static void InitializeState(const std::vector<double>& x,
+                                std::vector<double>* state) {
+        assert(state);
+
+        state->assign(M, 0.0);
+        for (int i = P; i < static_cast<int>(x.size()); ++i) {
+            (*state)[i % M] += Test::Term(x, i, x[i]);
+        }
+    }
+
+    /**
+     * Update the sums and the objectives after x[index] is changed.
+     */
+    static void UpdateObjectives(const std::vector<double>& x, int index,
+                                 double old_value, std::vector<double>* state,
+                                 std::vector<double>* objectives) {
+        assert(state && state->size() == M);
+        assert(objectives);
+
+        if (index < P) {
+            // Every term depends on the position variables.
+            InitializeState(x, state);
+        } else {
+            (*state)[index % M] += Test::Term(x, index, x[index]) -
+                                   Test::Term(x, index, old_value);
+        }
+
+        int n = static_cast<int>(x.size());
+        int counts[M];
+        for (int k = 0; k < M; ++k) {
+            counts[k] = Count(n, k);
+        }
+
+        Test::Objectives(x, state->data(), counts, objectives);
+    }
+
+    /**
+     * Return the number of terms in the k-th sum, i.e., the number of i in
+     * [P, n) with i % M == k.
+     */
+    static int Count(int n, int k) {
+        int first = P + ((k - P) % M + M) % M;
+        return first < n ? (n - 1 - first) / M + 1 : 0;
+    }
+};
+
+} // namespace moo
+
+#endif // TEST_SUM_OF_TERMS_H_
@@ -15,6 +15,7 @@
 
 #include <vector>
 #include "test/basic_test.h"
+#include "test/sum_of_terms.h"
 
 namespace moo {
 /**
@@ -44,6 +45,9 @@ public:
         objectives.push_back(Objective2);
 
         constraints.push_back(Constraint1);
+
+        partial_state = SumOfTerms<CF1Test, 2, 1>::InitializeState;
+        incremental_objectives = SumOfTerms<CF1Test, 2, 1>::UpdateObjectives;
     }
 
     /**
@@ -87,6 +91,24 @@ public:
         double result = f1 + f2 - a * std::abs(temp) - 1.0;
         return result;// result >=0  is satisfied.
     }
+
+    /**
+     * The j-th term of the sums, where j = i + 1 and x[i] = xi.
+     */
+    static double Term(const std::vector<double>& x, int i, double xi) {
+        int n = static_cast<int>(x.size());
+        int j = i + 1;
+        return Sqr(xi - pow(x[0], 0.5 * (1.0 + 3.0 * (j - 2) / (n - 2))));
+    }
+
+    /**
+     * Get the objectives from the sums of terms.
+     */
+    static void Objectives(const std::vector<double>& x, const double* sums,
+                           const int* counts, std::vector<double>* objectives) {
+        (*objectives)[0] = x[0] + 2.0 / counts[0] * sums[0];
+        (*objectives)[1] = 1.0 - x[0] + 2.0 / counts[1] * sums[1];
+    }
 };
 
 /**
@@ -120,6 +142,9 @@ public:
         objectives.push_back(Objective2);
 
         constraints.push_back(Constraint1);
+
+        partial_state = SumOfTerms<CF2Test, 2, 1>::InitializeState;
+        incremental_objectives = SumOfTerms<CF2Test, 2, 1>::UpdateObjectives;
     }
 
     /**
@@ -162,6 +187,27 @@ public:
         double result = t / (1.0 + exp(4.0 * std::abs(t)));
         return result; // result >=0  is satisfied.
     }
+
+    /**
+     * The j-th term of the sums, where j = i + 1 and x[i] = xi.
+     */
+    static double Term(const std::vector<double>& x, int i, double xi) {
+        int n = static_cast<int>(x.size());
+        int j = i + 1;
+        if (i % 2 == 0) {
+            return Sqr(xi - sin(6.0 * M_PI * x[0] +  M_PI * j / n));
+        }
+        return Sqr(xi - cos(6.0 * M_PI * x[0] + M_PI * j / n));
+    }
+
+    /**
+     * Get the objectives from the sums of terms.
+     */
+    static void Objectives(const std::vector<double>& x, const double* sums,
+                           const int* counts, std::vector<double>* objectives) {
+        (*objectives)[0] = x[0] + 2.0 / counts[0] * sums[0];
+        (*objectives)[1] = 1.0 - sqrt(x[0]) + 2.0 / counts[1] * sums[1];
+    }
 };
 
 /**
@@ -42,6 +42,9 @@ public:
         objectives.push_back(Objective1);
         objectives.push_back(Objective2);
         objectives.push_back(Objective3);
+
+        partial_state = InitializeState;
+        incremental_objectives = UpdateObjectives;
     }
 
     static double Objective1(const std::vector<double>& x) {
@@ -71,6 +74,37 @@ public:
         result = 0.5 * (1.0 - x[0]) * (1.0 + gx);
         return result;
     }
+
+    /**
+     * The partial state is the sum of GTerm over the last K variables.
+     */
+    static void InitializeState(const std::vector<double>& x,
+                                std::vector<double>* state) {
+        double gx_2 = 0.0;
+        int n = static_cast<int>(x.size());
+        for (int i = n - K; i < n; ++i) {
+            gx_2 += GTerm(x[i]);
+        }
+        state->assign(1, gx_2);
+    }
+
+    /**
+     * Update the objectives after x[index] is changed from old_value.
+     */
+    static void UpdateObjectives(const std::vector<double>& x, int index,
+                                 double old_value, std::vector<double>* state,
+                                 std::vector<double>* objectives) {
+        int n = static_cast<int>(x.size());
+        if (index >= n - K) {
+            (*state)[0] += GTerm(x[index]) - GTerm(old_value);
+        }
+        double gx = 100.0 * (K + (*state)[0]);
+
+        (*objectives)[0] = 0.5 * x[0] * x[1] * (1.0 + gx);
+        (*objectives)[1] = 0.5 * x[0] * (1.0 - x[1]) * (1.0 + gx);
+        (*objectives)[2] = 0.5 * (1.0 - x[0]) * (1.0 + gx);
+    }
+
     private:
     static double GX(const std::vector<double>& x) {
         double gx_2 = 0.0;
@@ -82,6 +116,13 @@ public:
         double gx = 100.0 * (K + gx_2);
         return gx;
     }
+
+    /**
+     * The term of g(x) for xi.
+     */
+    static double GTerm(double xi) {
+        return (xi - 0.5) * (xi - 0.5) - cos(20.0 * M_PI * (xi - 0.5));
+    }
 };
 
 /**
@@ -108,6 +149,9 @@ public:
         objectives.push_back(Objective1);
         objectives.push_back(Objective2);
         objectives.push_back(Objective3);
+
+        partial_state = InitializeState;
+        incremental_objectives = UpdateObjectives;
     }
 
     static double Objective1(const std::vector<double>& x) {
@@ -145,6 +189,39 @@ public:
         result = (1.0 + gx) * sin(x[0] * M_PI / 2.0);
         return result;
     }
+
+    /**
+     * The partial state is g(x) = Sum[(xi - 0.5)^2] over the last K variables.
+     */
+    static void InitializeState(const std::vector<double>& x,
+                                std::vector<double>* state) {
+        int n = static_cast<int>(x.size());
+        double gx = 0.0;
+        for (int i = n - K; i < n; ++i) {
+            gx += (x[i] - 0.5) * (x[i] - 0.5);
+        }
+        state->assign(1, gx);
+    }
+
+    /**
+     * Update the objectives after x[index] is changed from old_value.
+     */
+    static void UpdateObjectives(const std::vector<double>& x, int index,
+                                 double old_value, std::vector<double>* state,
+                                 std::vector<double>* objectives) {
+        int n = static_cast<int>(x.size());
+        if (index >= n - K) {
+            (*state)[0] += (x[index] - 0.5) * (x[index] - 0.5) -
+                           (old_value - 0.5) * (old_value - 0.5);
+        }
+        double gx = (*state)[0];
+
+        (*objectives)[0] = (1.0 + gx) * cos(x[0] * M_PI / 2.0) *
+                           cos(x[1] * M_PI / 2.0);
+        (*objectives)[1] = (1.0 + gx) * cos(x[0] * M_PI / 2.0) *
+                           sin(x[1] * M_PI / 2.0);
+        (*objectives)[2] = (1.0 + gx) * sin(x[0] * M_PI / 2.0);
+    }
 };
 
 /**
@@ -170,6 +247,9 @@ public:
         objectives.push_back(Objective1);
         objectives.push_back(Objective2);
         objectives.push_back(Objective3);
+
+        partial_state = InitializeState;
+        incremental_objectives = UpdateObjectives;
     }
 
     static double Objective1(const std::vector<double>& x) {
@@ -196,6 +276,38 @@ public:
         return result;
     }
 
+    /**
+     * The partial state is the sum of GTerm over the last K variables.
+     */
+    static void InitializeState(const std::vector<double>& x,
+                                std::vector<double>* state) {
+        double gx_2 = 0.0;
+        int n = static_cast<int>(x.size());
+        for (int i = n - K; i < n; ++i) {
+            gx_2 += GTerm(x[i]);
+        }
+        state->assign(1, gx_2);
+    }
+
+    /**
+     * Update the objectives after x[index] is changed from old_value.
+     */
+    static void UpdateObjectives(const std::vector<double>& x, int index,
+                                 double old_value, std::vector<double>* state,
+                                 std::vector<double>* objectives) {
+        int n = static_cast<int>(x.size());
+        if (index >= n - K) {
+            (*state)[0] += GTerm(x[index]) - GTerm(old_value);
+        }
+        double gx = 100.0 * (K + (*state)[0]);
+
+        (*objectives)[0] = (1.0 + gx) * cos(x[0] * M_PI * 0.5) *
+                           cos(x[1] * M_PI * 0.5);
+        (*objectives)[1] = (1.0 + gx) * cos(x[0] * M_PI * 0.5) *
+                           sin(x[1] * M_PI * 0.5);
+        (*objectives)[2] = (1.0 + gx) * sin(x[0] * M_PI * 0.5);
+    }
+
 private:
     static double GX(const std::vector<double>& x) {
         double gx_2 = 0.0;
@@ -207,6 +319,13 @@ private:
         double gx = 100.0 * (K + gx_2);
         return gx;
     }
+
+    /**
+     * The term of g(x) for xi.
+     */
+    static double GTerm(double xi) {
+        return (xi - 0.5) * (xi - 0.5) - cos(20.0 * M_PI * (xi - 0.5));
+    }
 };
 
 /**
@@ -231,6 +350,9 @@ public:
         objectives.push_back(Objective1);
         objectives.push_back(Objective2);
         objectives.push_back(Objective3);
+
+        partial_state = InitializeState;
+        incremental_objectives = UpdateObjectives;
     }
 
     static double Objective1(const std::vector<double>& x) {
@@ -270,6 +392,38 @@ public:
         result = (1.0 + gx) * sin(pow(x[0],100) * M_PI / 2.0);
         return result;
     }
+
+    /**
+     * The partial state is g(x) = Sum[(xi - 0.5)^2 | i = [3, n)].
+     */
+    static void InitializeState(const std::vector<double>& x,
+                                std::vector<double>* state) {
+        int n = static_cast<int>(x.size());
+        double gx = 0.0;
+        for (int i = 3; i < n; ++i) {
+            gx += (x[i] - 0.5) * (x[i] - 0.5);
+        }
+        state->assign(1, gx);
+    }
+
+    /**
+     * Update the objectives after x[index] is changed from old_value.
+     */
+    static void UpdateObjectives(const std::vector<double>& x, int index,
+                                 double old_value, std::vector<double>* state,
+                                 std::vector<double>* objectives) {
+        if (index >= 3) {
+            (*state)[0] += (x[index] - 0.5) * (x[index] - 0.5) -
+                           (old_value - 0.5) * (old_value - 0.5);
+        }
+        double gx = (*state)[0];
+
+        (*objectives)[0] = (1.0 + gx) * cos(pow(x[0],100) * M_PI / 2.0) *
+                           cos(pow(x[1],100) * M_PI / 2.0);
+        (*objectives)[1] = (1.0 + gx) * cos(pow(x[0],100) * M_PI / 2.0) *
+                           sin(pow(x[1],100) * M_PI / 2.0);
+        (*objectives)[2] = (1.0 + gx) * sin(pow(x[0],100) * M_PI / 2.0);
+    }
 };
 
 /**
@@ -295,6 +449,9 @@ public:
         objectives.push_back(Objective1);
         objectives.push_back(Objective2);
         objectives.push_back(Objective3);
+
+        partial_state = InitializeState;
+        incremental_objectives = UpdateObjectives;
     }
 
     static double Objective1(const std::vector<double>& x) {
@@ -339,6 +496,41 @@ public:
         result = (1.0 + gx) * sin(seta0 * M_PI / 2.0);
         return result;
     }
+
+    /**
+     * The partial state is g(x) = Sum[(xi - 0.5)^2] over the last K variables.
+     */
+    static void InitializeState(const std::vector<double>& x,
+                                std::vector<double>* state) {
+        int n = static_cast<int>(x.size());
+        double gx = 0.0;
+        for (int i = n - K; i < n; ++i) {
+            gx += (x[i] - 0.5) * (x[i] - 0.5);
+        }
+        state->assign(1, gx);
+    }
+
+    /**
+     * Update the objectives after x[index] is changed from old_value.
+     */
+    static void UpdateObjectives(const std::vector<double>& x, int index,
+                                 double old_value, std::vector<double>* state,
+                                 std::vector<double>* objectives) {
+        int n = static_cast<int>(x.size());
+        if (index >= n - K) {
+            (*state)[0] += (x[index] - 0.5) * (x[index] - 0.5) -
+                           (old_value - 0.5) * (old_value - 0.5);
+        }
+        double gx = (*state)[0];
+        double seta0 = M_PI / (4.0 * (1.0 + gx)) * (1.0 + 2.0 * gx * x[0]);
+        double seta1 = M_PI / (4.0 * (1.0 + gx)) * (1.0 + 2.0 * gx * x[1]);
+
+        (*objectives)[0] = (1.0 + gx) * cos(seta0 * M_PI / 2.0) *
+                           cos(seta1 * M_PI / 2.0);
+        (*objectives)[1] = (1.0 + gx) * cos(seta0 * M_PI / 2.0) *
+                           sin(seta1 * M_PI / 2.0);
+        (*objectives)[2] = (1.0 + gx) * sin(seta0 * M_PI / 2.0);
+    }
 };
 
 } // namespace moo
@@ -17,91 +17,115 @@
 #include "test/test_fon.h"
 #include "test/test_sch.h"
 #include "test/test_kur.h"
+#include "test/test_lsmop.h"
 #include "test/test_lz.h"
 #include "test/test_uf.h"
 #include "test/test_zdt.h"
 #include "test/test_ctp.h"
 #include "test/test_cf.h"
-
+#include "test/test_registry.h"
+#include "test/test_scalable_dtlz.h"
+#include "test/test_wfg.h"
 
 namespace moo {
 
 /// Test Factory
+/**
+ * It creates the tests by their names. The built-in tests are registered in a
+ * TestRegistry on the first use, and the problems of the plugins loaded by
+ * LoadPlugin() are added to it, so a new problem does not need to be compiled
+ * into the solver.
+ *
+ * DTLZ1 to DTLZ7, WFG1 to WFG9 and LSMOP1 to LSMOP9 are also created for any
+ * numbers of objectives and variables by the names such as DTLZ2_M10_D20, see
+ * ScalableDTLZTest, WFGTest and LSMOPTest.
+ */
 class TestFactory {
 public:
+    /**
+     * Create the test with the given name, NULL if the name is unknown.
+     */
     static BasicTest* CreateTest(const std::string& name) {
-        if (name == "SCH") {
-            return new SCHTest();
-        } else if (name == "FON") {
-            return new FONTest();
-        } else if (name == "KUR") {
-            return new KURTest();
-        } else if (name == "ZDT1") {
-            return new ZDT1Test();
-        } else if (name == "ZDT2") {
-            return new ZDT2Test();
-        } else if (name == "ZDT3") {
-            return new ZDT3Test();
-        } else if (name == "ZDT4") {
-            return new ZDT4Test();
-        } else if (name == "ZDT6") {
-            return new ZDT6Test();
-        } else if (name == "LZ1") {
-            return new LZ1Test();
-        } else if (name == "LZ2") {
-            return new LZ2Test();
-        } else if (name == "LZ3") {
-            return new LZ3Test();
-        } else if (name == "LZ4") {
-            return new LZ4Test();
-        } else if (name == "LZ5") {
-            return new LZ5Test();
-        } else if (name == "LZ6") {
-            return new LZ6Test();
-        } else if (name == "LZ7") {
-            return new LZ7Test();
-        } else if (name == "LZ8") {
-            return new LZ8Test();
-        } else if (name == "LZ9") {
-            return new LZ9Test();
-        } else if (name == "UF4") {
-            return new UF4Test();
-        } else if (name == "UF5") {
-            return new UF5Test();
-        } else if (name == "UF6") {
-            return new UF6Test();
-        } else if (name == "UF7") {
-            return new UF7Test();
-        } else if (name == "UF9") {
-            return new UF9Test();
-        } else if (name == "UF10") {
-            return new UF10Test();
-        }else if (name == "DTLZ1_3D") {
-            return new DTLZ1_3DTest();
-        } else if (name == "DTLZ2_3D") {
-            return new DTLZ2_3DTest();
-        } else if (name == "DTLZ3_3D") {
-            return new DTLZ3_3DTest();
-        } else if (name == "DTLZ4_3D") {
-            return new DTLZ4_3DTest();
-        } else if (name == "DTLZ5_3D") {
-            return new DTLZ5_3DTest();
-        } else if (name == "CTP1"){
-            return new CTP1Test();
-        } else if (name == "CF1") {
-            return new CF1Test();
-        } else if (name == "CF2") {
-            return new CF2Test();
-        } else if (name == "CF3") {
-            return new CF3Test();
-        } else if (name == "CF4") {
-            return new CF4Test();
-        } else if (name == "CF5") {
-            return new CF5Test();
-        } else {
-            assert(false);
+        BasicTest* test = registry()->Create(name);
+        assert(test && "Unknown test");
+        return test;
+    }
+
+    /**
+     * Load a problem plugin, see TestRegistry::LoadPlugin().
+     */
+    static bool LoadPlugin(const std::string& path) {
+        return registry()->LoadPlugin(path);
+    }
+
+    /**
+     * The registry of all tests.
+     */
+    static TestRegistry* registry() {
+        // Never destroyed, so the plugins stay loaded until the exit.
+        static TestRegistry* registry = CreateRegistry();
+        return registry;
+    }
+
+private:
+    static TestRegistry* CreateRegistry() {
+        TestRegistry* registry = new TestRegistry;
+        registry->Register<SCHTest>("SCH");
+        registry->Register<FONTest>("FON");
+        registry->Register<KURTest>("KUR");
+        registry->Register<ZDT1Test>("ZDT1");
+        registry->Register<ZDT2Test>("ZDT2");
+        registry->Register<ZDT3Test>("ZDT3");
+        registry->Register<ZDT4Test>("ZDT4");
+        registry->Register<ZDT6Test>("ZDT6");
+        registry->Register<LZ1Test>("LZ1");
+        registry->Register<LZ2Test>("LZ2");
+        registry->Register<LZ3Test>("LZ3");
+        registry->Register<LZ4Test>("LZ4");
+        registry->Register<LZ5Test>("LZ5");
+        registry->Register<LZ6Test>("LZ6");
+        registry->Register<LZ7Test>("LZ7");
+        registry->Register<LZ8Test>("LZ8");
+        registry->Register<LZ9Test>("LZ9");
+        registry->Register<UF4Test>("UF4");
+        registry->Register<UF5Test>("UF5");
+        registry->Register<UF6Test>("UF6");
+        registry->Register<UF7Test>("UF7");
+        registry->Register<UF9Test>("UF9");
+        registry->Register<UF10Test>("UF10");
+        registry->Register<DTLZ1_3DTest>("DTLZ1_3D");
+        registry->Register<DTLZ2_3DTest>("DTLZ2_3D");
+        registry->Register<DTLZ3_3DTest>("DTLZ3_3D");
+        registry->Register<DTLZ4_3DTest>("DTLZ4_3D");
+        registry->Register<DTLZ5_3DTest>("DTLZ5_3D");
+        registry->Register<CTP1Test>("CTP1");
+        registry->Register<CF1Test>("CF1");
+        registry->Register<CF2Test>("CF2");
+        registry->Register<CF3Test>("CF3");
+        registry->Register<CF4Test>("CF4");
+        registry->Register<CF5Test>("CF5");
+
+        // The scalable families, e.g., DTLZ2_M10_D20, WFG4_M10_D38 and
+        // LSMOP1_M3_D1000.
+        for (int i = 1; i <= 7; ++i) {
+            registry->RegisterScalable("DTLZ" + std::to_string(i),
+                                       [i] (int m, int n) {
+                return ScalableDTLZTest::Create(i, m, n);
+            });
+        }
+        for (int i = 1; i <= 9; ++i) {
+            registry->RegisterScalable("WFG" + std::to_string(i),
+                                       [i] (int m, int n) {
+                return WFGTest::Create(i, m, n);
+            });
+        }
+        for (int i = 1; i <= 9; ++i) {
+            registry->RegisterScalable("LSMOP" + std::to_string(i),
+                                       [i] (int m, int n) {
+                return LSMOPTest::Create(i, m, n);
+            });
         }
-        return NULL;
+        return registry;
     }
 };
 
@@ -0,0 +1,393 @@
+//
+// Copyright 2013 Yangbin Lin and Bili Chen. All Rights Reserved.
+//
+// Author: yblin.xmu@qq.com (Yangbin Lin)
+//
+// To use this code, please cite the follow paper:
+//
+// Chen B, Zeng W, Lin Y, et al. A New Local Search-Based Multiobjective
+// Optimization Algorithm[J]. IEEE Transactions on Evolutionary Computation,
+// 2014, 19(1):1-1.
+//
+
+#ifndef TEST_TEST_LSMOP_H_
+#define TEST_TEST_LSMOP_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "codelibrary/base/constants.h"
+#include "test/scalable_test.h"
+
+namespace moo {
+
+/**
+ * Problem:                LSMOP1 to LSMOP9
+ * Objectives:             M >= 2
+ * Dimension:              n >= M, usually hundreds to thousands
+ *
+ * The first M - 1 variables are the positions in [0, 1], and the others are
+ * the distance variables in [0, 10], linked to the first variable by
+ *
+ *   t_i = (1 + (i + 1) / n) * x_i - 10 * x_0           (LSMOP1 to LSMOP4),
+ *   t_i = (1 + cos(PI / 2 * (i + 1) / n)) * x_i - 10 * x_0   (the others).
+ *
+ * The distance variables are divided into M groups of the sizes given by the
+ * logistic map, and each group into 5 subcomponents of equal size. g_m is the
+ * sum of the basic functions (Sphere, Schwefel, Rosenbrock, Rastrigin,
+ * Griewank or Ackley) of the subcomponents of the m-th group, divided by the
+ * number of its variables. The variables left by the rounding of sizes are
+ * added to the last subcomponent, where the reference drops them. As in the
+ * reference, Rosenbrock is minimal at t = 1 instead of 0.
+ *
+ * The subcomponents are cached as the partial state of the incremental
+ * evaluation, so a change of a distance variable only computes its
+ * subcomponent again.
+ *
+ * Reference:
+ *   Cheng R, Jin Y, Olhofer M, Sendhoff B. Test problems for large-scale
+ *   multiobjective and many-objective optimization. IEEE Transactions on
+ *   Cybernetics, 2017, 47(12): 4108-4121.
+ */
+class LSMOPProblem {
+    // The number of subcomponents of each group.
+    static const int N_SUBCOMPONENTS = 5;
+
+    enum Function {
+        SPHERE, SCHWEFEL, ROSENBROCK, RASTRIGIN, GRIEWANK, ACKLEY
+    };
+
+public:
+    /**
+     * The type-th problem, i.e., LSMOP<type>.
+     */
+    LSMOPProblem(int type, int n_objectives, int n_variables)
+        : type_(type), m_(n_objectives), n_(n_variables) {
+        assert(IsValid(type, n_objectives, n_variables));
+
+        // The basic functions of the odd and even objectives (from 1).
+        static const Function functions[9][2] = {
+            { SPHERE,     SPHERE     },
+            { GRIEWANK,   SCHWEFEL   },
+            { RASTRIGIN,  ROSENBROCK },
+            { ACKLEY,     GRIEWANK   },
+            { SPHERE,     SPHERE     },
+            { ROSENBROCK, SCHWEFEL   },
+            { ACKLEY,     ROSENBROCK },
+            { GRIEWANK,   SPHERE     },
+            { SPHERE,     ACKLEY     }
+        };
+        functions_[0] = functions[type - 1][0];
+        functions_[1] = functions[type - 1][1];
+
+        std::vector<int> sizes;
+        GroupSizes(n_objectives, n_variables, &sizes);
+        first_.resize(m_ * N_SUBCOMPONENTS + 1);
+        first_[0] = m_ - 1;
+        for (int i = 0; i < m_ * N_SUBCOMPONENTS; ++i) {
+            first_[i + 1] = first_[i] + sizes[i / N_SUBCOMPONENTS];
+        }
+        first_.back() = n_;
+
+        counts_.resize(m_);
+        for (int i = 0; i < m_; ++i) {
+            counts_[i] = first_[(i + 1) * N_SUBCOMPONENTS] -
+                         first_[i * N_SUBCOMPONENTS];
+        }
+
+        links_.assign(n_, 1.0);
+        for (int i = m_ - 1; i < n_; ++i) {
+            double r = (i + 1.0) / n_;
+            links_[i] = type <= 4 ? 1.0 + r : 1.0 + std::cos(cl::PI / 2.0 * r);
+        }
+    }
+
+    /**
+     * Each subcomponent must have at least one variable.
+     */
+    static bool IsValid(int type, int n_objectives, int n_variables) {
+        if (type < 1 || type > 9 || n_objectives < 2 ||
+            n_variables < n_objectives) {
+            return false;
+        }
+
+        std::vector<int> sizes;
+        GroupSizes(n_objectives, n_variables, &sizes);
+        return *std::min_element(sizes.begin(), sizes.end()) >= 1;
+    }
+
+    template <typename Real>
+    CL_SIMD_INLINE void Evaluate(const double* x, double* f) const {
+        for (int i = 0; i < m_; ++i) {
+            Real g = lanes::Broadcast<Real>(0.0);
+            for (int j = 0; j < N_SUBCOMPONENTS; ++j) {
+                g += Subcomponent<Real>(x, i * N_SUBCOMPONENTS + j);
+            }
+            lanes::Set(g / counts_[i], i, f);
+        }
+        Shape<Real>(x, f);
+    }
+
+    /**
+     * The partial state is the basic functions of the subcomponents.
+     */
+    void InitializeState(const std::vector<double>& x,
+                         std::vector<double>* state) const {
+        assert(state);
+        assert(static_cast<int>(x.size()) == n_);
+
+        state->resize(m_ * N_SUBCOMPONENTS);
+        for (int i = 0; i < m_ * N_SUBCOMPONENTS; ++i) {
+            (*state)[i] = Subcomponent<double>(x.data(), i);
+        }
+    }
+
+    /**
+     * Update the subcomponent of x[index] and the objectives after x[index]
+     * is changed. The first variable is linked to all subcomponents, and the
+     * other position variables to none.
+     */
+    void UpdateObjectives(const std::vector<double>& x, int index,
+                          std::vector<double>* state,
+                          std::vector<double>* objectives) const {
+        assert(state && static_cast<int>(state->size()) ==
+                        m_ * N_SUBCOMPONENTS);
+        assert(objectives);
+        assert(0 <= index && index < n_);
+
+        if (index == 0) {
+            InitializeState(x, state);
+        } else if (index >= m_ - 1) {
+            int i = static_cast<int>(std::upper_bound(first_.begin(),
+                                                      first_.end(), index) -
+                                     first_.begin()) - 1;
+            (*state)[i] = Subcomponent<double>(x.data(), i);
+        }
+
+        objectives->resize(m_);
+        for (int i = 0; i < m_; ++i) {
+            double g = 0.0;
+            for (int j = 0; j < N_SUBCOMPONENTS; ++j) {
+                g += (*state)[i * N_SUBCOMPONENTS + j];
+            }
+            (*objectives)[i] = g / counts_[i];
+        }
+        Shape<double>(x.data(), objectives->data());
+    }
+
+    int type() const { return type_; }
+
+private:
+    /**
+     * The numbers of variables of each subcomponent of the M groups.
+     */
+    static void GroupSizes(int n_objectives, int n_variables,
+                           std::vector<int>* sizes) {
+        std::vector<double> c(n_objectives);
+        c[0] = 3.8 * 0.1 * (1.0 - 0.1);
+        for (int i = 1; i < n_objectives; ++i) {
+            c[i] = 3.8 * c[i - 1] * (1.0 - c[i - 1]);
+        }
+
+        double sum = 0.0;
+        for (double ci : c) {
+            sum += ci;
+        }
+        sizes->resize(n_objectives);
+        for (int i = 0; i < n_objectives; ++i) {
+            (*sizes)[i] = static_cast<int>(std::floor(
+                    c[i] / sum * (n_variables - n_objectives + 1) /
+                    N_SUBCOMPONENTS));
+        }
+    }
+
+    /**
+     * The linked value t_i of the i-th distance variable.
+     */
+    template <typename Real>
+    CL_SIMD_INLINE Real Linked(const double* x, int i, const Real& x0) const {
+        return links_[i] * lanes::Get<Real>(x, i) - 10.0 * x0;
+    }
+
+    /**
+     * The basic function of the s-th subcomponent.
+     */
+    template <typename Real>
+    CL_SIMD_INLINE Real Subcomponent(const double* x, int s) const {
+        const int first = first_[s], last = first_[s + 1];
+        const Real x0 = lanes::Get<Real>(x, 0);
+
+        Real sum = lanes::Broadcast<Real>(0.0);
+        switch (functions_[s / N_SUBCOMPONENTS % 2]) {
+        case SPHERE:
+            for (int i = first; i < last; ++i) {
+                Real t = Linked(x, i, x0);
+                sum += t * t;
+            }
+            return sum;
+        case SCHWEFEL:
+            for (int i = first; i < last; ++i) {
+                sum = lanes::Max(sum, lanes::Abs(Linked(x, i, x0)));
+            }
+            return sum;
+        case ROSENBROCK:
+            for (int i = first; i + 1 < last; ++i) {
+                Real t = Linked(x, i, x0);
+                Real u = t * t - Linked(x, i + 1, x0);
+                sum += 100.0 * u * u + (t - 1.0) * (t - 1.0);
+            }
+            return sum;
+        case RASTRIGIN:
+            for (int i = first; i < last; ++i) {
+                Real t = Linked(x, i, x0);
+                sum += t * t - 10.0 * lanes::Cos(2.0 * cl::PI * t) + 10.0;
+            }
+            return sum;
+        case GRIEWANK: {
+            Real product = lanes::Broadcast<Real>(1.0);
+            for (int i = first; i < last; ++i) {
+                Real t = Linked(x, i, x0);
+                sum += t * t;
+                product *= lanes::Cos(t / std::sqrt(i - first + 1.0));
+            }
+            return sum / 4000.0 - product + 1.0;
+        }
+        default: {
+            Real sum_cos = lanes::Broadcast<Real>(0.0);
+            for (int i = first; i < last; ++i) {
+                Real t = Linked(x, i, x0);
+                sum += t * t;
+                sum_cos += lanes::Cos(2.0 * cl::PI * t);
+            }
+            const double n = last - first;
+            return 20.0 - 20.0 * lanes::Exp(-0.2 * lanes::Sqrt(sum / n)) -
+                   lanes::Exp(sum_cos / n) + cl::E;
+        }
+        }
+    }
+
+    /**
+     * Compute the objectives from g_m, given in f.
+     */
+    template <typename Real>
+    CL_SIMD_INLINE void Shape(const double* x, double* f) const {
+        if (type_ == 9) {
+            Disconnected<Real>(x, f);
+            return;
+        }
+
+        // The scales of the objectives, 1 + g_m, or 1 + g_m + g_(m+1) for the
+        // concave fronts.
+        for (int i = 0; i < m_; ++i) {
+            Real scale = 1.0 + lanes::Get<Real>(f, i);
+            if (type_ >= 5 && i + 1 < m_) {
+                scale += lanes::Get<Real>(f, i + 1);
+            }
+            lanes::Set(scale, i, f);
+        }
+
+        // The linear front of LSMOP1 to LSMOP4,
+        // f(M - 1 - i) = scale * x0...x(i-1)(1 - xi), or the spherical front
+        // of LSMOP5 to LSMOP8 by the angles xi * PI / 2.
+        Real product = lanes::Broadcast<Real>(1.0);
+        for (int i = 0; i < m_ - 1; ++i) {
+            Real xi = lanes::Get<Real>(x, i);
+            Real last, rest;
+            if (type_ <= 4) {
+                last = 1.0 - xi;
+                rest = xi;
+            } else {
+                lanes::SinCos(xi * (cl::PI / 2.0), &last, &rest);
+            }
+            int k = m_ - 1 - i;
+            lanes::Set(lanes::Get<Real>(f, k) * product * last, k, f);
+            product *= rest;
+        }
+        lanes::Set(lanes::Get<Real>(f, 0) * product, 0, f);
+    }
+
+    /**
+     * The disconnected front of LSMOP9, where g = 1 + Sum[g_m].
+     */
+    template <typename Real>
+    CL_SIMD_INLINE void Disconnected(const double* x, double* f) const {
+        Real g = lanes::Broadcast<Real>(1.0);
+        for (int i = 0; i < m_; ++i) {
+            g += lanes::Get<Real>(f, i);
+        }
+
+        Real h = lanes::Broadcast<Real>(m_);
+        for (int i = 0; i < m_ - 1; ++i) {
+            Real xi = lanes::Get<Real>(x, i);
+            lanes::Set(xi, i, f);
+            h -= xi / (1.0 + g) * (1.0 + lanes::Sin(3.0 * cl::PI * xi));
+        }
+        lanes::Set((1.0 + g) * h, m_ - 1, f);
+    }
+
+    int type_;                  // The number of LSMOP.
+    int m_;                     // The number of objectives.
+    int n_;                     // The number of variables.
+    Function functions_[2];     // The basic functions of odd and even groups.
+    std::vector<int> first_;    // The first variable of each subcomponent.
+    std::vector<double> counts_;   // The number of variables of each group.
+    std::vector<double> links_;    // The linkage factors of the variables.
+};
+
+/**
+ * LSMOP1 to LSMOP9 of any numbers of objectives and variables, named as
+ * LSMOP1_M3_D300.
+ *
+ * Usage:
+ *    LSMOPTest test(1, 3, 300);
+ */
+class LSMOPTest : public ScalableTest<LSMOPProblem> {
+public:
+    LSMOPTest(int type, int n_objectives, int n_variables)
+        : ScalableTest<LSMOPProblem>(Name(type, n_objectives, n_variables),
+                                     LSMOPProblem(type, n_objectives,
+                                                  n_variables),
+                                     n_objectives, n_variables) {
+        for (int i = n_objectives - 1; i < n_variables; ++i) {
+            parameter.max_variables[i] = 10.0;
+        }
+
+        const LSMOPProblem* p = &problem();
+        partial_state = [p] (const std::vector<double>& x,
+                             std::vector<double>* state) {
+            p->InitializeState(x, state);
+        };
+        incremental_objectives = [p] (const std::vector<double>& x,
+                                      int index, double,
+                                      std::vector<double>* state,
+                                      std::vector<double>* objectives) {
+            p->UpdateObjectives(x, index, state, objectives);
+        };
+    }
+
+    /**
+     * Create the test, owned by the caller.
+     *
+     * @return NULL if the numbers are invalid.
+     */
+    static BasicTest* Create(int type, int n_objectives, int n_variables) {
+        if (!LSMOPProblem::IsValid(type, n_objectives, n_variables)) {
+            return NULL;
+        }
+        return new LSMOPTest(type, n_objectives, n_variables);
+    }
+
+private:
+    static std::string Name(int type, int n_objectives, int n_variables) {
+        return "LSMOP" + std::to_string(type) +
+               "_M" + std::to_string(n_objectives) +
+               "_D" + std::to_string(n_variables);
+    }
+};
+
+} // namespace moo
+
+#endif // TEST_TEST_LSMOP_H_
@@ -17,6 +17,7 @@
 
 #include "codelibrary/util/array/array_2d.h"
 #include "test/basic_test.h"
+#include "test/sum_of_terms.h"
 
 namespace moo {
 
@@ -50,6 +51,9 @@ public:
 
         objectives.push_back(Objective1);
         objectives.push_back(Objective2);
+
+        partial_state = SumOfTerms<LZ1Test, 2, 1>::InitializeState;
+        incremental_objectives = SumOfTerms<LZ1Test, 2, 1>::UpdateObjectives;
     }
 
     /**
@@ -83,6 +87,24 @@ public:
         }
         return 1.0 - sqrt(x[0]) + 2.0 / count * sum;
     }
+
+    /**
+     * The j-th term of the sums, where j = i + 1 and x[i] = xi.
+     */
+    static double Term(const std::vector<double>& x, int i, double xi) {
+        int n = static_cast<int>(x.size());
+        int j = i + 1;
+        return Sqr(xi - pow(x[0], 0.5 * (1.0 + 3.0 * (j - 2) / (n - 2))));
+    }
+
+    /**
+     * Get the objectives from the sums of terms.
+     */
+    static void Objectives(const std::vector<double>& x, const double* sums,
+                           const int* counts, std::vector<double>* objectives) {
+        (*objectives)[0] = x[0] + 2.0 / counts[0] * sums[0];
+        (*objectives)[1] = 1.0 - sqrt(x[0]) + 2.0 / counts[1] * sums[1];
+    }
 };
 
 /**
@@ -112,6 +134,9 @@ public:
 
         objectives.push_back(Objective1);
         objectives.push_back(Objective2);
+
+        partial_state = SumOfTerms<LZ2Test, 2, 1>::InitializeState;
+        incremental_objectives = SumOfTerms<LZ2Test, 2, 1>::UpdateObjectives;
     }
 
     /**
@@ -143,6 +168,24 @@ public:
         }
         return 1.0 - sqrt(x[0]) + 2.0 / count * sum;
     }
+
+    /**
+     * The j-th term of the sums, where j = i + 1 and x[i] = xi.
+     */
+    static double Term(const std::vector<double>& x, int i, double xi) {
+        int n = static_cast<int>(x.size());
+        int j = i + 1;
+        return Sqr(xi - sin(6.0 * cl::PI * x[0] + cl::PI * j / n));
+    }
+
+    /**
+     * Get the objectives from the sums of terms.
+     */
+    static void Objectives(const std::vector<double>& x, const double* sums,
+                           const int* counts, std::vector<double>* objectives) {
+        (*objectives)[0] = x[0] + 2.0 / counts[0] * sums[0];
+        (*objectives)[1] = 1.0 - sqrt(x[0]) + 2.0 / counts[1] * sums[1];
+    }
 };
 
 /**
@@ -173,6 +216,9 @@ public:
 
         objectives.push_back(Objective1);
         objectives.push_back(Objective2);
+
+        partial_state = SumOfTerms<LZ3Test, 2, 1>::InitializeState;
+        incremental_objectives = SumOfTerms<LZ3Test, 2, 1>::UpdateObjectives;
     }
 
     /**
@@ -206,6 +252,28 @@ public:
         }
         return 1.0 - sqrt(x[0]) + 2.0 / count * sum;
     }
+
+    /**
+     * The j-th term of the sums, where j = i + 1 and x[i] = xi.
+     */
+    static double Term(const std::vector<double>& x, int i, double xi) {
+        int n = static_cast<int>(x.size());
+        int j = i + 1;
+        if (i % 2 == 0) {
+            return Sqr(xi - 0.8 * x[0] * cos(6.0 * cl::PI * x[0] +
+                                              cl::PI * j / n));
+        }
+        return Sqr(xi - 0.8 * x[0] * sin(6.0 * cl::PI * x[0] + cl::PI * j / n));
+    }
+
+    /**
+     * Get the objectives from the sums of terms.
+     */
+    static void Objectives(const std::vector<double>& x, const double* sums,
+                           const int* counts, std::vector<double>* objectives) {
+        (*objectives)[0] = x[0] + 2.0 / counts[0] * sums[0];
+        (*objectives)[1] = 1.0 - sqrt(x[0]) + 2.0 / counts[1] * sums[1];
+    }
 };
 
 /**
@@ -236,6 +304,9 @@ public:
 
         objectives.push_back(Objective1);
         objectives.push_back(Objective2);
+
+        partial_state = SumOfTerms<LZ4Test, 2, 1>::InitializeState;
+        incremental_objectives = SumOfTerms<LZ4Test, 2, 1>::UpdateObjectives;
     }
 
     /**
@@ -270,6 +341,29 @@ public:
         }
         return 1.0 - std::sqrt(x[0]) + 2.0 / count * sum;
     }
+
+    /**
+     * The j-th term of the sums, where j = i + 1 and x[i] = xi.
+     */
+    static double Term(const std::vector<double>& x, int i, double xi) {
+        int n = static_cast<int>(x.size());
+        int j = i + 1;
+        if (i % 2 == 0) {
+            return Sqr(xi - 0.8 * x[0] *
+                       std::cos((6.0 * cl::PI * x[0] + cl::PI * j / n) / 3.0));
+        }
+        return Sqr(xi - 0.8 * x[0] * std::sin(6.0 * cl::PI * x[0] +
+                                              cl::PI * j / n));
+    }
+
+    /**
+     * Get the objectives from the sums of terms.
+     */
+    static void Objectives(const std::vector<double>& x, const double* sums,
+                           const int* counts, std::vector<double>* objectives) {
+        (*objectives)[0] = x[0] + 2.0 / counts[0] * sums[0];
+        (*objectives)[1] = 1.0 - std::sqrt(x[0]) + 2.0 / counts[1] * sums[1];
+    }
 };
 
 /**
@@ -304,6 +398,9 @@ public:
 
         objectives.push_back(Objective1);
         objectives.push_back(Objective2);
+
+        partial_state = SumOfTerms<LZ5Test, 2, 1>::InitializeState;
+        incremental_objectives = SumOfTerms<LZ5Test, 2, 1>::UpdateObjectives;
     }
 
     /**
@@ -346,6 +443,30 @@ public:
         }
         return 1.0 - sqrt(x[0]) + 2.0 / count * sum;
     }
+
+    /**
+     * The j-th term of the sums, where j = i + 1 and x[i] = xi.
+     */
+    static double Term(const std::vector<double>& x, int i, double xi) {
+        int n = static_cast<int>(x.size());
+        int j = i + 1;
+        double a = 0.3 * x[0] * x[0] * std::cos(24.0 * cl::PI * x[0] +
+                                                4.0 * j * cl::PI / n) +
+                   0.6 * x[0];
+        if (i % 2 == 0) {
+            return Sqr(xi - a * std::cos(6.0 * cl::PI * x[0] + cl::PI * j / n));
+        }
+        return Sqr(xi - a * std::sin(6.0 * cl::PI * x[0] + cl::PI * j / n));
+    }
+
+    /**
+     * Get the objectives from the sums of terms.
+     */
+    static void Objectives(const std::vector<double>& x, const double* sums,
+                           const int* counts, std::vector<double>* objectives) {
+        (*objectives)[0] = x[0] + 2.0 / counts[0] * sums[0];
+        (*objectives)[1] = 1.0 - sqrt(x[0]) + 2.0 / counts[1] * sums[1];
+    }
 };
 
 /**
@@ -375,6 +496,9 @@ public:
         objectives.push_back(Objective1);
         objectives.push_back(Objective2);
         objectives.push_back(Objective3);
+
+        partial_state = SumOfTerms<LZ6Test, 3, 2>::InitializeState;
+        incremental_objectives = SumOfTerms<LZ6Test, 3, 2>::UpdateObjectives;
     }
 
     static double Objective1(const std::vector<double>& x) {
@@ -418,6 +542,31 @@ public:
         }
         return sum1 + 2.0 / count * sum2;
     }
+
+    /**
+     * The j-th term of the sums, where j = i + 1 and x[i] = xi.
+     */
+    static double Term(const std::vector<double>& x, int i, double xi) {
+        int n = static_cast<int>(x.size());
+        int j = i + 1;
+        return Sqr(xi - 2.0 * x[1] *
+                   std::sin(2.0 * cl::PI * x[0] + j * cl::PI / n));
+    }
+
+    /**
+     * Get the objectives from the sums of terms.
+     */
+    static void Objectives(const std::vector<double>& x, const double* sums,
+                           const int* counts, std::vector<double>* objectives) {
+        (*objectives)[0] = std::cos(0.5 * x[0] * cl::PI) *
+                           std::cos(0.5 * x[1] * cl::PI) +
+                           2.0 / counts[0] * sums[0];
+        (*objectives)[1] = std::cos(0.5 * x[0] * cl::PI) *
+                           std::sin(0.5 * x[1] * cl::PI) +
+                           2.0 / counts[1] * sums[1];
+        (*objectives)[2] = std::sin(0.5 * x[0] * cl::PI) +
+                           2.0 / counts[2] * sums[2];
+    }
 };
 
 /**
@@ -447,6 +596,9 @@ public:
 
         objectives.push_back(Objective1);
         objectives.push_back(Objective2);
+
+        partial_state = SumOfTerms<LZ7Test, 2, 1>::InitializeState;
+        incremental_objectives = SumOfTerms<LZ7Test, 2, 1>::UpdateObjectives;
     }
 
     /**
@@ -485,6 +637,25 @@ public:
         }
         return 1.0 - std::sqrt(x[0]) + 2.0 / count * sum;
     }
+
+    /**
+     * The j-th term of the sums, where j = i + 1 and x[i] = xi.
+     */
+    static double Term(const std::vector<double>& x, int i, double xi) {
+        int n = static_cast<int>(x.size());
+        int j = i + 1;
+        double yj = xi - std::pow(x[0], 0.5 * (1.0 + 3.0 * (j - 2) / (n - 2)));
+        return 4.0 * yj * yj - std::cos(8.0 * yj * cl::PI) + 1.0;
+    }
+
+    /**
+     * Get the objectives from the sums of terms.
+     */
+    static void Objectives(const std::vector<double>& x, const double* sums,
+                           const int* counts, std::vector<double>* objectives) {
+        (*objectives)[0] = x[0] + 2.0 / counts[0] * sums[0];
+        (*objectives)[1] = 1.0 - std::sqrt(x[0]) + 2.0 / counts[1] * sums[1];
+    }
 };
 
 /**
@@ -516,6 +687,9 @@ public:
 
         objectives.push_back(Objective1);
         objectives.push_back(Objective2);
+
+        partial_state = InitializeState;
+        incremental_objectives = UpdateObjectives;
     }
 
     /**
@@ -561,6 +735,63 @@ public:
         return 1.0 - std::sqrt(x[0]) + 2.0 / count *
                (4.0 * sum1 - 2.0 * sum2 + 2.0);
     }
+
+    /**
+     * The partial state is [sum1 of J1, sum1 of J2, cos(20 * yj * PI / sqrt(j))
+     * for each variable]. The factors are kept, since the products can not be
+     * updated by division safely.
+     */
+    static void InitializeState(const std::vector<double>& x,
+                                std::vector<double>* state) {
+        int n = static_cast<int>(x.size());
+        state->assign(2 + n, 1.0);
+        (*state)[0] = (*state)[1] = 0.0;
+        for (int i = 1; i < n; ++i) {
+            double yj = Y(x, i, x[i]);
+            (*state)[i % 2] += yj * yj;
+            (*state)[2 + i] = std::cos(20.0 * yj * cl::PI / std::sqrt(i + 1));
+        }
+    }
+
+    /**
+     * Update the objectives after x[index] is changed from old_value.
+     */
+    static void UpdateObjectives(const std::vector<double>& x, int index,
+                                 double old_value, std::vector<double>* state,
+                                 std::vector<double>* objectives) {
+        int n = static_cast<int>(x.size());
+        if (index == 0) {
+            InitializeState(x, state);
+        } else {
+            double y1 = Y(x, index, x[index]);
+            double y2 = Y(x, index, old_value);
+            (*state)[index % 2] += y1 * y1 - y2 * y2;
+            (*state)[2 + index] = std::cos(20.0 * y1 * cl::PI /
+                                           std::sqrt(index + 1));
+        }
+
+        double sum2[2] = { 1.0, 1.0 };
+        int count[2] = { 0, 0 };
+        for (int i = 1; i < n; ++i) {
+            sum2[i % 2] *= (*state)[2 + i];
+            ++count[i % 2];
+        }
+
+        (*objectives)[0] = x[0] + 2.0 / count[0] *
+                           (4.0 * (*state)[0] - 2.0 * sum2[0] + 2.0);
+        (*objectives)[1] = 1.0 - std::sqrt(x[0]) + 2.0 / count[1] *
+                           (4.0 * (*state)[1] - 2.0 * sum2[1] + 2.0);
+    }
+
+private:
+    /**
+     * yj = xi - pow(x[0], 0.5 * (1.0 + 3.0 * (j - 2))/(n - 2)), j = i + 1.
+     */
+    static double Y(const std::vector<double>& x, int i, double xi) {
+        int n = static_cast<int>(x.size());
+        int j = i + 1;
+        return xi - std::pow(x[0], 0.5 * (1.0 + 3.0 * (j - 2) / (n - 2)));
+    }
 };
 
 /**
@@ -595,6 +826,9 @@ public:
 
         objectives.push_back(Objective1);
         objectives.push_back(Objective2);
+
+        partial_state = SumOfTerms<LZ9Test, 2, 1>::InitializeState;
+        incremental_objectives = SumOfTerms<LZ9Test, 2, 1>::UpdateObjectives;
     }
 
     /**
@@ -630,6 +864,24 @@ public:
 
         return 1.0 - x[0] * x[0] + 2.0 / count * sum;
     }
+
+    /**
+     * The j-th term of the sums, where j = i + 1 and x[i] = xi.
+     */
+    static double Term(const std::vector<double>& x, int i, double xi) {
+        int n = static_cast<int>(x.size());
+        int j = i + 1;
+        return Sqr(xi - std::sin(6.0 * cl::PI * x[0] + cl::PI * j / n));
+    }
+
+    /**
+     * Get the objectives from the sums of terms.
+     */
+    static void Objectives(const std::vector<double>& x, const double* sums,
+                           const int* counts, std::vector<double>* objectives) {
+        (*objectives)[0] = x[0] + 2.0 / counts[0] * sums[0];
+        (*objectives)[1] = 1.0 - x[0] * x[0] + 2.0 / counts[1] * sums[1];
+    }
 };
 
 } // namespace moo
@@ -0,0 +1,213 @@
+//
+// Copyright 2013 Yangbin Lin and Bili Chen. All Rights Reserved.
+//
+// Author: yblin.xmu@qq.com (Yangbin Lin)
+//
+// To use this code, please cite the follow paper:
+//
+// Chen B, Zeng W, Lin Y, et al. A New Local Search-Based Multiobjective
+// Optimization Algorithm[J]. IEEE Transactions on Evolutionary Computation,
+// 2014, 19(1):1-1.
+//
+
+#ifndef TEST_TEST_REGISTRY_H_
+#define TEST_TEST_REGISTRY_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "test/basic_test.h"
+#include "test/plugin/plugin_test.h"
+
+namespace moo {
+
+/// Test Registry.
+/**
+ * It maps the names of the tests to their creators in a hash table, so a test
+ * is found in O(1) time, whether it is compiled in or loaded from a plugin.
+ *
+ * Usage:
+ *    TestRegistry registry;
+ *    registry.Register<ZDT1Test>("ZDT1");
+ *    registry.LoadPlugin("./my_problems.so");
+ *    BasicTest* test = registry.Create("MY_ZDT1");
+ *    ...
+ *    delete test;
+ */
+class TestRegistry {
+public:
+    /**
+     * The creator of a test, the test is owned by the caller.
+     */
+    typedef std::function<BasicTest*()> Creator;
+
+    /**
+     * Register the creator under the name.
+     *
+     * @return false if the name is already registered.
+     */
+    bool Register(const std::string& name, const Creator& creator) {
+        assert(creator);
+
+        return creators_.emplace(name, creator).second;
+    }
+
+    /**
+     * Register a test class that is default constructible.
+     */
+    template <typename Test>
+    bool Register(const std::string& name) {
+        return Register(name, [] () -> BasicTest* { return new Test(); });
+    }
+
+    /**
+     * The creator of the tests of a scalable family, given the numbers of
+     * objectives and variables. It returns NULL if they are invalid.
+     */
+    typedef std::function<BasicTest*(int, int)> ScalableCreator;
+
+    /**
+     * Register a family of scalable tests, e.g., DTLZ2. Its tests are created
+     * by the names of the form <family>_M<n_objectives>_D<n_variables>, e.g.,
+     * DTLZ2_M10_D20.
+     *
+     * @return false if the family is already registered.
+     */
+    bool RegisterScalable(const std::string& family,
+                          const ScalableCreator& creator) {
+        assert(creator);
+
+        return scalable_creators_.emplace(family, creator).second;
+    }
+
+    /**
+     * Load a problem plugin (see test/plugin/problem_plugin.h) and register
+     * its problems under their names. The shared object stays loaded until
+     * the registry and all tests created from it are destroyed.
+     *
+     * @return false if the plugin is invalid or one of its names is already
+     *         registered, then none of its problems is registered. The reason
+     *         is given by error().
+     */
+    bool LoadPlugin(const std::string& path) {
+        std::shared_ptr<PluginLibrary> library(new PluginLibrary);
+        if (!library->Load(path)) {
+            error_ = library->error();
+            return false;
+        }
+
+        std::vector<std::string> names;
+        for (int i = 0; i < library->n_problems(); ++i) {
+            std::string name = library->problem(i).name;
+            if (Contains(name) ||
+                std::find(names.begin(), names.end(), name) != names.end()) {
+                error_ = path + ": duplicated name " + name;
+                return false;
+            }
+            names.push_back(name);
+        }
+
+        std::shared_ptr<const PluginLibrary> shared = library;
+        for (int i = 0; i < library->n_problems(); ++i) {
+            Register(names[i], [shared, i] () -> BasicTest* {
+                return new PluginTest(shared, i);
+            });
+        }
+        return true;
+    }
+
+    /**
+     * Return true if the name is registered.
+     */
+    bool Contains(const std::string& name) const {
+        return creators_.find(name) != creators_.end();
+    }
+
+    /**
+     * Create the test with the given name, or the test of a scalable family
+     * if the name is of the form <family>_M<n_objectives>_D<n_variables>.
+     *
+     * @return the new test, or NULL if the name is not registered.
+     */
+    BasicTest* Create(const std::string& name) const {
+        std::unordered_map<std::string, Creator>::const_iterator i =
+                creators_.find(name);
+        if (i != creators_.end()) return (i->second)();
+
+        std::string family;
+        int n_objectives = 0, n_variables = 0;
+        if (!ParseScalableName(name, &family, &n_objectives, &n_variables)) {
+            return NULL;
+        }
+        std::unordered_map<std::string, ScalableCreator>::const_iterator j =
+                scalable_creators_.find(family);
+        return j == scalable_creators_.end()
+               ? NULL : (j->second)(n_objectives, n_variables);
+    }
+
+    /**
+     * The registered names, in no particular order.
+     */
+    std::vector<std::string> names() const {
+        std::vector<std::string> names;
+        names.reserve(creators_.size());
+        for (const auto& creator : creators_) {
+            names.push_back(creator.first);
+        }
+        return names;
+    }
+
+    /**
+     * The registered scalable families, in no particular order.
+     */
+    std::vector<std::string> scalable_families() const {
+        std::vector<std::string> families;
+        families.reserve(scalable_creators_.size());
+        for (const auto& creator : scalable_creators_) {
+            families.push_back(creator.first);
+        }
+        return families;
+    }
+
+    int size() const { return static_cast<int>(creators_.size()); }
+
+    /**
+     * The reason of the last failure of LoadPlugin().
+     */
+    const std::string& error() const { return error_; }
+
+private:
+    /**
+     * Split <family>_M<n_objectives>_D<n_variables>.
+     */
+    static bool ParseScalableName(const std::string& name,
+                                  std::string* family, int* n_objectives,
+                                  int* n_variables) {
+        size_t pos = name.rfind("_M");
+        if (pos == std::string::npos || pos == 0) return false;
+
+        int length = 0;
+        if (std::sscanf(name.c_str() + pos, "_M%d_D%d%n", n_objectives,
+                        n_variables, &length) != 2 ||
+            pos + length != name.size()) {
+            return false;
+        }
+        *family = name.substr(0, pos);
+        return true;
+    }
+
+    std::unordered_map<std::string, Creator> creators_; // Name to creator.
+    std::unordered_map<std::string, ScalableCreator>
+            scalable_creators_;                         // Family to creator.
+    std::string error_;                                 // The last failure.
+};
+
+} // namespace moo
+
+#endif // TEST_TEST_REGISTRY_H_
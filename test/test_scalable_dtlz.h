@@ -0,0 +1,242 @@
+//
+// Copyright 2013 Yangbin Lin and Bili Chen. All Rights Reserved.
+//
+// Author: yblin.xmu@qq.com (Yangbin Lin)
+//
+// To use this code, please cite the follow paper:
+//
+// Chen B, Zeng W, Lin Y, et al. A New Local Search-Based Multiobjective
+// Optimization Algorithm[J]. IEEE Transactions on Evolutionary Computation,
+// 2014, 19(1):1-1.
+//
+
+#ifndef TEST_TEST_SCALABLE_DTLZ_H_
+#define TEST_TEST_SCALABLE_DTLZ_H_
+
+#include <cassert>
+#include <string>
+
+#include "codelibrary/base/constants.h"
+#include "test/scalable_test.h"
+
+namespace moo {
+
+/**
+ * Problem:                DTLZ1 to DTLZ7
+ * Objectives:             M >= 2
+ * Dimension:              n >= M
+ *
+ * The first M - 1 variables are the positions, and the last K = n - M + 1
+ * variables are the distances to the Pareto front.
+ *
+ * The objectives are the ones of the reference, so with M = 3, DTLZ1, DTLZ2
+ * and DTLZ3 equal DTLZ1_3DTest (n = 7), DTLZ2_3DTest and DTLZ3_3DTest
+ * (n = 12) up to rounding, but DTLZ4 and DTLZ5 differ from DTLZ4_3DTest and
+ * DTLZ5_3DTest, which sum g(x) from x3 and scale the angles of DTLZ5 twice.
+ *
+ * Reference:
+ *   Deb K, Thiele L, Laumanns M, Zitzler E. Scalable test problems for
+ *   evolutionary multiobjective optimization. Evolutionary Multiobjective
+ *   Optimization, 2005: 105-145.
+ */
+class DTLZProblem {
+public:
+    /**
+     * The type-th problem, i.e., DTLZ<type>.
+     */
+    DTLZProblem(int type, int n_objectives, int n_variables)
+        : type_(type), m_(n_objectives), n_(n_variables) {
+        assert(IsValid(type, n_objectives, n_variables));
+    }
+
+    static bool IsValid(int type, int n_objectives, int n_variables) {
+        return type >= 1 && type <= 7 && n_objectives >= 2 &&
+               n_variables >= n_objectives;
+    }
+
+    template <typename Real>
+    CL_SIMD_INLINE void Evaluate(const double* x, double* f) const {
+        const double k = n_ - m_ + 1;
+
+        switch (type_) {
+        case 1:
+            Linear(x, 0.5 * (1.0 + 100.0 * (k + Rastrigin<Real>(x))), f);
+            break;
+        case 3:
+            Sphere(x, 100.0 * (k + Rastrigin<Real>(x)), f);
+            break;
+        case 6:
+            Sphere(x, SumOfPowers<Real>(x), f);
+            break;
+        case 7:
+            Disconnected<Real>(x, f);
+            break;
+        default:
+            Sphere(x, SumOfSquares<Real>(x), f);
+        }
+    }
+
+    int type() const { return type_; }
+
+private:
+    /**
+     * Sum[(xi - 0.5)^2 - cos(20PI * (xi - 0.5))] of the distance variables.
+     */
+    template <typename Real>
+    CL_SIMD_INLINE Real Rastrigin(const double* x) const {
+        Real sum = lanes::Broadcast<Real>(0.0);
+        for (int i = m_ - 1; i < n_; ++i) {
+            Real t = lanes::Get<Real>(x, i) - 0.5;
+            sum += t * t - lanes::Cos(20.0 * cl::PI * t);
+        }
+        return sum;
+    }
+
+    /**
+     * Sum[(xi - 0.5)^2] of the distance variables.
+     */
+    template <typename Real>
+    CL_SIMD_INLINE Real SumOfSquares(const double* x) const {
+        Real sum = lanes::Broadcast<Real>(0.0);
+        for (int i = m_ - 1; i < n_; ++i) {
+            Real t = lanes::Get<Real>(x, i) - 0.5;
+            sum += t * t;
+        }
+        return sum;
+    }
+
+    /**
+     * Sum[xi^0.1] of the distance variables.
+     */
+    template <typename Real>
+    CL_SIMD_INLINE Real SumOfPowers(const double* x) const {
+        Real sum = lanes::Broadcast<Real>(0.0);
+        for (int i = m_ - 1; i < n_; ++i) {
+            sum += lanes::Pow(lanes::Get<Real>(x, i), 0.1);
+        }
+        return sum;
+    }
+
+    /**
+     * The linear front of DTLZ1, f(M - 1 - i) = scale * x0...x(i-1)(1 - xi).
+     */
+    template <typename Real>
+    CL_SIMD_INLINE void Linear(const double* x, const Real& scale,
+                               double* f) const {
+        Real product = scale;
+        for (int i = 0; i < m_ - 1; ++i) {
+            Real xi = lanes::Get<Real>(x, i);
+            lanes::Set(product * (1.0 - xi), m_ - 1 - i, f);
+            product *= xi;
+        }
+        lanes::Set(product, 0, f);
+    }
+
+    /**
+     * The spherical front of DTLZ2 to DTLZ6,
+     * f(M - 1 - i) = (1 + g) * cos(a0)...cos(a(i-1))sin(ai).
+     */
+    template <typename Real>
+    CL_SIMD_INLINE void Sphere(const double* x, const Real& g,
+                               double* f) const {
+        Real product = 1.0 + g;
+        for (int i = 0; i < m_ - 1; ++i) {
+            Real sin_a, cos_a;
+            lanes::SinCos(Angle(x, i, g), &sin_a, &cos_a);
+            lanes::Set(product * sin_a, m_ - 1 - i, f);
+            product *= cos_a;
+        }
+        lanes::Set(product, 0, f);
+    }
+
+    /**
+     * The angle of the i-th position variable.
+     */
+    template <typename Real>
+    CL_SIMD_INLINE Real Angle(const double* x, int i, const Real& g) const {
+        Real xi = lanes::Get<Real>(x, i);
+        if (type_ == 4) {
+            return Power100(xi) * (cl::PI / 2.0);
+        }
+        if ((type_ == 5 || type_ == 6) && i > 0) {
+            return (cl::PI / 4.0) / (1.0 + g) * (1.0 + 2.0 * g * xi);
+        }
+        return xi * (cl::PI / 2.0);
+    }
+
+    /**
+     * x^100 by squaring.
+     */
+    template <typename Real>
+    static CL_SIMD_INLINE Real Power100(const Real& x) {
+        Real x2 = x * x;
+        Real x4 = x2 * x2;
+        Real x8 = x4 * x4;
+        Real x25 = x8 * x8 * x8 * x;
+        Real x50 = x25 * x25;
+        return x50 * x50;
+    }
+
+    /**
+     * The disconnected front of DTLZ7.
+     */
+    template <typename Real>
+    CL_SIMD_INLINE void Disconnected(const double* x, double* f) const {
+        Real sum = lanes::Broadcast<Real>(0.0);
+        for (int i = m_ - 1; i < n_; ++i) {
+            sum += lanes::Get<Real>(x, i);
+        }
+        Real g = 1.0 + 9.0 / (n_ - m_ + 1) * sum;
+
+        Real h = lanes::Broadcast<Real>(m_);
+        for (int i = 0; i < m_ - 1; ++i) {
+            Real xi = lanes::Get<Real>(x, i);
+            lanes::Set(xi, i, f);
+            h -= xi / (1.0 + g) * (1.0 + lanes::Sin(3.0 * cl::PI * xi));
+        }
+        lanes::Set((1.0 + g) * h, m_ - 1, f);
+    }
+
+    int type_; // The number of DTLZ.
+    int m_;    // The number of objectives.
+    int n_;    // The number of variables.
+};
+
+/**
+ * DTLZ1 to DTLZ7 of any numbers of objectives and variables, named as
+ * DTLZ2_M10_D20.
+ *
+ * Usage:
+ *    ScalableDTLZTest test(2, 10, 20);
+ */
+class ScalableDTLZTest : public ScalableTest<DTLZProblem> {
+public:
+    ScalableDTLZTest(int type, int n_objectives, int n_variables)
+        : ScalableTest<DTLZProblem>(Name(type, n_objectives, n_variables),
+                                    DTLZProblem(type, n_objectives,
+                                                n_variables),
+                                    n_objectives, n_variables) {}
+
+    /**
+     * Create the test, owned by the caller.
+     *
+     * @return NULL if the numbers are invalid.
+     */
+    static BasicTest* Create(int type, int n_objectives, int n_variables) {
+        if (!DTLZProblem::IsValid(type, n_objectives, n_variables)) {
+            return NULL;
+        }
+        return new ScalableDTLZTest(type, n_objectives, n_variables);
+    }
+
+private:
+    static std::string Name(int type, int n_objectives, int n_variables) {
+        return "DTLZ" + std::to_string(type) +
+               "_M" + std::to_string(n_objectives) +
+               "_D" + std::to_string(n_variables);
+    }
+};
+
+} // namespace moo
+
+#endif // TEST_TEST_SCALABLE_DTLZ_H_
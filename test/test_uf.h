@@ -16,6 +16,7 @@
 #include <vector>
 
 #include "test/basic_test.h"
+#include "test/sum_of_terms.h"
 
 namespace moo {
 
@@ -42,6 +43,9 @@ public:
 
         objectives.push_back(Objective1);
         objectives.push_back(Objective2);
+
+        partial_state = SumOfTerms<UF4Test, 2, 1>::InitializeState;
+        incremental_objectives = SumOfTerms<UF4Test, 2, 1>::UpdateObjectives;
     }
 
     static double Objective1(const std::vector<double>& x) {
@@ -69,6 +73,25 @@ public:
         }
         return 1.0 - x[0] * x[0] + 2.0 / count * sum;
     }
+
+    /**
+     * The j-th term of the sums, where j = i + 1 and x[i] = xi.
+     */
+    static double Term(const std::vector<double>& x, int i, double xi) {
+        int n = static_cast<int>(x.size());
+        int j = i + 1;
+        double yj = xi - sin(6.0 * M_PI * x[0] + M_PI * j / n);
+        return fabs(yj)/(1.0 + exp(2.0 * fabs(yj)));
+    }
+
+    /**
+     * Get the objectives from the sums of terms.
+     */
+    static void Objectives(const std::vector<double>& x, const double* sums,
+                           const int* counts, std::vector<double>* objectives) {
+        (*objectives)[0] = x[0] + 2.0 / counts[0] * sums[0];
+        (*objectives)[1] = 1.0 - x[0] * x[0] + 2.0 / counts[1] * sums[1];
+    }
 };
 
 /**
@@ -94,6 +117,9 @@ public:
 
         objectives.push_back(Objective1);
         objectives.push_back(Objective2);
+
+        partial_state = SumOfTerms<UF5Test, 2, 1>::InitializeState;
+        incremental_objectives = SumOfTerms<UF5Test, 2, 1>::UpdateObjectives;
     }
 
     static double Objective1(const std::vector<double>& x) {
@@ -129,6 +155,27 @@ public:
 
         return 1.0 - x[0] + sum1 + 2.0 / count * sum2;
     }
+
+    /**
+     * The j-th term of the sums, where j = i + 1 and x[i] = xi.
+     */
+    static double Term(const std::vector<double>& x, int i, double xi) {
+        int n = static_cast<int>(x.size());
+        int j = i + 1;
+        double yj = xi - sin(6.0 * M_PI * x[0] + M_PI * j / n);
+        return 2 * yj * yj - cos(4.0 * M_PI * yj) + 1.0;
+    }
+
+    /**
+     * Get the objectives from the sums of terms.
+     */
+    static void Objectives(const std::vector<double>& x, const double* sums,
+                           const int* counts, std::vector<double>* objectives) {
+        double nn = 10.0;
+        double sum1= (1.0 / (2.0 * nn) + 0.1) *fabs(sin(2.0 * nn * x[0]));
+        (*objectives)[0] = x[0] + sum1 + 2.0 / counts[0] * sums[0];
+        (*objectives)[1] = 1.0 - x[0] + sum1 + 2.0 / counts[1] * sums[1];
+    }
 };
 
 
@@ -155,6 +202,9 @@ public:
 
         objectives.push_back(Objective1);
         objectives.push_back(Objective2);
+
+        partial_state = InitializeState;
+        incremental_objectives = UpdateObjectives;
     }
 
     static double Objective1(const std::vector<double>& x) {
@@ -197,6 +247,67 @@ public:
         return 1.0 - x[0] + sum1 + 2.0 / count *
                                   (4.0 * sum2 - 2.0 * sum3 + 2.0);
     }
+
+    /**
+     * The partial state is [sum2 of J1, sum2 of J2, cos(20 * yj * PI / sqrt(j))
+     * for each variable]. The factors are kept, since the products can not be
+     * updated by division safely.
+     */
+    static void InitializeState(const std::vector<double>& x,
+                                std::vector<double>* state) {
+        int n = static_cast<int>(x.size());
+        state->assign(2 + n, 1.0);
+        (*state)[0] = (*state)[1] = 0.0;
+        for (int i = 1; i < n; ++i) {
+            double yj = Y(x, i, x[i]);
+            (*state)[i % 2] += yj * yj;
+            (*state)[2 + i] = cos(20.0 * yj * M_PI / sqrt(i + 1));
+        }
+    }
+
+    /**
+     * Update the objectives after x[index] is changed from old_value.
+     */
+    static void UpdateObjectives(const std::vector<double>& x, int index,
+                                 double old_value, std::vector<double>* state,
+                                 std::vector<double>* objectives) {
+        int n = static_cast<int>(x.size());
+        if (index == 0) {
+            InitializeState(x, state);
+        } else {
+            double y1 = Y(x, index, x[index]);
+            double y2 = Y(x, index, old_value);
+            (*state)[index % 2] += y1 * y1 - y2 * y2;
+            (*state)[2 + index] = cos(20.0 * y1 * M_PI / sqrt(index + 1));
+        }
+
+        double sum3[2] = { 1.0, 1.0 };
+        int count[2] = { 0, 0 };
+        for (int i = 1; i < n; ++i) {
+            sum3[i % 2] *= (*state)[2 + i];
+            ++count[i % 2];
+        }
+
+        double nn = 10.0;
+        double sum1= (1.0 / (2.0 * nn) + 0.1) * sin(2.0 * nn * x[0]);
+        if(sum1 < 0.0)
+            sum1 = 0.0;
+
+        (*objectives)[0] = x[0] + sum1 + 2.0 / count[0] *
+                           (4.0 * (*state)[0] - 2.0 * sum3[0] + 2.0);
+        (*objectives)[1] = 1.0 - x[0] + sum1 + 2.0 / count[1] *
+                           (4.0 * (*state)[1] - 2.0 * sum3[1] + 2.0);
+    }
+
+private:
+    /**
+     * yj = xi - sin(6.0 * PI * x[0] + PI * j / n), j = i + 1.
+     */
+    static double Y(const std::vector<double>& x, int i, double xi) {
+        int n = static_cast<int>(x.size());
+        int j = i + 1;
+        return xi - sin(6.0 * M_PI * x[0] + M_PI * j / n);
+    }
 };
 
 /**
@@ -222,6 +333,9 @@ public:
 
         objectives.push_back(Objective1);
         objectives.push_back(Objective2);
+
+        partial_state = SumOfTerms<UF7Test, 2, 1>::InitializeState;
+        incremental_objectives = SumOfTerms<UF7Test, 2, 1>::UpdateObjectives;
     }
 
     static double Objective1(const std::vector<double>& x) {
@@ -251,6 +365,26 @@ public:
 
         return 1.0 - sum1 + 2.0 / count * sum2;
     }
+
+    /**
+     * The j-th term of the sums, where j = i + 1 and x[i] = xi.
+     */
+    static double Term(const std::vector<double>& x, int i, double xi) {
+        int n = static_cast<int>(x.size());
+        int j = i + 1;
+        double yj = xi - sin(6.0 * M_PI * x[0] + M_PI * j / n);
+        return yj * yj;
+    }
+
+    /**
+     * Get the objectives from the sums of terms.
+     */
+    static void Objectives(const std::vector<double>& x, const double* sums,
+                           const int* counts, std::vector<double>* objectives) {
+        double sum1 = pow(x[0],0.2);
+        (*objectives)[0] = sum1 + 2.0 / counts[0] * sums[0];
+        (*objectives)[1] = 1.0 - sum1 + 2.0 / counts[1] * sums[1];
+    }
 };
 
 /**
@@ -279,6 +413,9 @@ public:
         objectives.push_back(Objective1);
         objectives.push_back(Objective2);
         objectives.push_back(Objective3);
+
+        partial_state = SumOfTerms<UF9Test, 3, 2>::InitializeState;
+        incremental_objectives = SumOfTerms<UF9Test, 3, 2>::UpdateObjectives;
     }
 
     static double Objective1(const std::vector<double>& x) {
@@ -335,6 +472,32 @@ public:
         }
         return 1.0 - x[1] + 2.0 / count * sum;
     }
+
+    /**
+     * The j-th term of the sums, where j = i + 1 and x[i] = xi.
+     */
+    static double Term(const std::vector<double>& x, int i, double xi) {
+        int n = static_cast<int>(x.size());
+        int j = i + 1;
+        return pow(xi - 2.0 * x[1] * sin(2.0 * M_PI * x[0] + j * M_PI / n),
+                   2.0);
+    }
+
+    /**
+     * Get the objectives from the sums of terms.
+     */
+    static void Objectives(const std::vector<double>& x, const double* sums,
+                           const int* counts, std::vector<double>* objectives) {
+        double temp1 = (1.0 + 0.1) * (1.0 - 4.0 * pow((2.0 * x[0] - 1.0),2.0));
+        if(temp1 < 0.0)
+            temp1 = 0.0;
+
+        (*objectives)[0] = 0.5 * (temp1 + 2.0 * x[0]) * x[1] +
+                           2.0 / counts[0] * sums[0];
+        (*objectives)[1] = 0.5 * (temp1 - 2.0 * x[0] + 2.0) * x[1] +
+                           2.0 / counts[1] * sums[1];
+        (*objectives)[2] = 1.0 - x[1] + 2.0 / counts[2] * sums[2];
+    }
 };
 
 /**
@@ -363,6 +526,9 @@ public:
         objectives.push_back(Objective1);
         objectives.push_back(Objective2);
         objectives.push_back(Objective3);
+
+        partial_state = SumOfTerms<UF10Test, 3, 2>::InitializeState;
+        incremental_objectives = SumOfTerms<UF10Test, 3, 2>::UpdateObjectives;
     }
 
     static double Objective1(const std::vector<double>& x) {
@@ -414,6 +580,28 @@ public:
         }
         return sum1 + 2.0 / count * sum2;
     }
+
+    /**
+     * The j-th term of the sums, where j = i + 1 and x[i] = xi.
+     */
+    static double Term(const std::vector<double>& x, int i, double xi) {
+        int n = static_cast<int>(x.size());
+        int j = i + 1;
+        double yj = xi - 2.0 * x[1] * sin(2.0 * M_PI * x[0] + M_PI * j / n);
+        return 4.0 * yj * yj - cos(8.0 * M_PI * yj) + 1.0;
+    }
+
+    /**
+     * Get the objectives from the sums of terms.
+     */
+    static void Objectives(const std::vector<double>& x, const double* sums,
+                           const int* counts, std::vector<double>* objectives) {
+        (*objectives)[0] = cos(0.5 * x[0] * M_PI) * cos(0.5 * x[1] * M_PI) +
+                           2.0 / counts[0] * sums[0];
+        (*objectives)[1] = cos(0.5 * x[0] * M_PI) * sin(0.5 * x[1] * M_PI) +
+                           2.0 / counts[1] * sums[1];
+        (*objectives)[2] = sin(0.5 * x[0] * M_PI) + 2.0 / counts[2] * sums[2];
+    }
 };
 
 } // namespace moo
@@ -0,0 +1,448 @@
+//
+// Copyright 2013 Yangbin Lin and Bili Chen. All Rights Reserved.
+//
+// Author: yblin.xmu@qq.com (Yangbin Lin)
+//
+// To use this code, please cite the follow paper:
+//
+// Chen B, Zeng W, Lin Y, et al. A New Local Search-Based Multiobjective
+// Optimization Algorithm[J]. IEEE Transactions on Evolutionary Computation,
+// 2014, 19(1):1-1.
+//
+
+#ifndef TEST_TEST_WFG_H_
+#define TEST_TEST_WFG_H_
+
+#include <cassert>
+#include <string>
+#include <vector>
+
+#include "codelibrary/base/constants.h"
+#include "test/scalable_test.h"
+
+namespace moo {
+
+/**
+ * Problem:                WFG1 to WFG9
+ * Objectives:             M >= 2
+ * Dimension:              n = k + l, k position and l distance variables
+ *
+ * k must be a multiple of M - 1, and l must be even for WFG2 and WFG3. The
+ * i-th variable (from 0) is in [0, 2(i + 1)].
+ *
+ * The problems are the compositions of the transformations of the reference,
+ * computed in place on the normalized variables. The transformed values are
+ * clamped into [0, 1] after each transformation, as the correct_to_01() of the
+ * reference implementation.
+ *
+ * Reference:
+ *   Huband S, Hingston P, Barone L, While L. A review of multiobjective test
+ *   problems and a scalable test problem toolkit. IEEE Transactions on
+ *   Evolutionary Computation, 2006, 10(5): 477-506.
+ */
+class WFGProblem {
+    /**
+     * The reductions of the position groups and of the distance variables.
+     */
+    enum Reduction {
+        WEIGHTED_SUM,   // r_sum with the weights 2(i + 1), WFG1.
+        SUM,            // r_sum with the equal weights.
+        NON_SEPARABLE   // r_nonsep, WFG6 and WFG9.
+    };
+
+public:
+    /**
+     * The type-th problem, i.e., WFG<type>.
+     */
+    WFGProblem(int type, int n_objectives, int k, int l)
+        : type_(type), m_(n_objectives), k_(k), l_(l) {
+        assert(IsValid(type, n_objectives, k, l));
+    }
+
+    static bool IsValid(int type, int n_objectives, int k, int l) {
+        return type >= 1 && type <= 9 && n_objectives >= 2 && k > 0 &&
+               k % (n_objectives - 1) == 0 && l > 0 &&
+               (l % 2 == 0 || (type != 2 && type != 3));
+    }
+
+    template <typename Real>
+    CL_SIMD_INLINE void Evaluate(const double* x, double* f) const {
+        const int n = k_ + l_;
+
+        // The normalized variables, transformed in place to t of M values.
+        std::vector<double> y(n * lanes::RealTraits<Real>::N_LANES);
+        for (int i = 0; i < n; ++i) {
+            lanes::Set(lanes::Get<Real>(x, i) / (2.0 * (i + 1)), i,
+                       y.data());
+        }
+
+        switch (type_) {
+        case 1:
+            TransformWFG1<Real>(y.data());
+            break;
+        case 2:
+        case 3:
+            TransformWFG2<Real>(y.data());
+            break;
+        case 4:
+            TransformWFG4<Real>(y.data());
+            break;
+        case 5:
+            TransformWFG5<Real>(y.data());
+            break;
+        case 6:
+            TransformWFG6<Real>(y.data());
+            break;
+        case 7:
+            TransformWFG7<Real>(y.data());
+            break;
+        case 8:
+            TransformWFG8<Real>(y.data());
+            break;
+        default:
+            TransformWFG9<Real>(y.data());
+        }
+
+        Shape<Real>(y.data(), f);
+    }
+
+    int type() const { return type_; }
+
+private:
+    template <typename Real>
+    CL_SIMD_INLINE void TransformWFG1(double* y) const {
+        const int n = k_ + l_;
+        for (int i = k_; i < n; ++i) {
+            Real t = SLinear(lanes::Get<Real>(y, i), 0.35);
+            lanes::Set(BFlat(t, 0.8, 0.75, 0.85), i, y);
+        }
+        for (int i = 0; i < n; ++i) {
+            Real t = lanes::Pow(lanes::Get<Real>(y, i), 0.02);
+            lanes::Set(lanes::Clamp01(t), i, y);
+        }
+        Reduce<Real>(WEIGHTED_SUM, n, y);
+    }
+
+    /**
+     * The transformations of WFG2 and WFG3.
+     */
+    template <typename Real>
+    CL_SIMD_INLINE void TransformWFG2(double* y) const {
+        const int n = k_ + l_;
+        for (int i = k_; i < n; ++i) {
+            lanes::Set(SLinear(lanes::Get<Real>(y, i), 0.35), i, y);
+        }
+        for (int i = 0; i < l_ / 2; ++i) {
+            int first = k_ + 2 * i;
+            lanes::Set(NonSeparable<Real>(y, first, first + 2), k_ + i, y);
+        }
+        Reduce<Real>(SUM, k_ + l_ / 2, y);
+    }
+
+    template <typename Real>
+    CL_SIMD_INLINE void TransformWFG4(double* y) const {
+        const int n = k_ + l_;
+        for (int i = 0; i < n; ++i) {
+            lanes::Set(SMulti(lanes::Get<Real>(y, i), 30.0, 10.0, 0.35), i, y);
+        }
+        Reduce<Real>(SUM, n, y);
+    }
+
+    template <typename Real>
+    CL_SIMD_INLINE void TransformWFG5(double* y) const {
+        const int n = k_ + l_;
+        for (int i = 0; i < n; ++i) {
+            lanes::Set(SDecept(lanes::Get<Real>(y, i), 0.35, 0.001, 0.05), i,
+                       y);
+        }
+        Reduce<Real>(SUM, n, y);
+    }
+
+    template <typename Real>
+    CL_SIMD_INLINE void TransformWFG6(double* y) const {
+        const int n = k_ + l_;
+        for (int i = k_; i < n; ++i) {
+            lanes::Set(SLinear(lanes::Get<Real>(y, i), 0.35), i, y);
+        }
+        Reduce<Real>(NON_SEPARABLE, n, y);
+    }
+
+    template <typename Real>
+    CL_SIMD_INLINE void TransformWFG7(double* y) const {
+        const int n = k_ + l_;
+
+        // The position variables depend on the mean of the following ones.
+        Real sum = lanes::Broadcast<Real>(0.0);
+        for (int i = n - 1; i >= 0; --i) {
+            Real yi = lanes::Get<Real>(y, i);
+            if (i < k_) {
+                lanes::Set(BParam(yi, sum / (n - 1 - i)), i, y);
+            }
+            sum += yi;
+        }
+        for (int i = k_; i < n; ++i) {
+            lanes::Set(SLinear(lanes::Get<Real>(y, i), 0.35), i, y);
+        }
+        Reduce<Real>(SUM, n, y);
+    }
+
+    template <typename Real>
+    CL_SIMD_INLINE void TransformWFG8(double* y) const {
+        const int n = k_ + l_;
+
+        // The distance variables depend on the mean of the preceding ones.
+        Real sum = lanes::Broadcast<Real>(0.0);
+        for (int i = 0; i < n; ++i) {
+            Real yi = lanes::Get<Real>(y, i);
+            if (i >= k_) {
+                lanes::Set(SLinear(BParam(yi, sum / i), 0.35), i, y);
+            }
+            sum += yi;
+        }
+        Reduce<Real>(SUM, n, y);
+    }
+
+    template <typename Real>
+    CL_SIMD_INLINE void TransformWFG9(double* y) const {
+        const int n = k_ + l_;
+
+        // All but the last variable depend on the mean of the following ones.
+        Real sum = lanes::Get<Real>(y, n - 1);
+        for (int i = n - 2; i >= 0; --i) {
+            Real yi = lanes::Get<Real>(y, i);
+            lanes::Set(BParam(yi, sum / (n - 1 - i)), i, y);
+            sum += yi;
+        }
+        for (int i = 0; i < k_; ++i) {
+            lanes::Set(SDecept(lanes::Get<Real>(y, i), 0.35, 0.001, 0.05), i,
+                       y);
+        }
+        for (int i = k_; i < n; ++i) {
+            lanes::Set(SMulti(lanes::Get<Real>(y, i), 30.0, 95.0, 0.35), i, y);
+        }
+        Reduce<Real>(NON_SEPARABLE, n, y);
+    }
+
+    /**
+     * Reduce y[0, n) to the M values of t: the M - 1 groups of the position
+     * variables, and the distance variables y[k, n).
+     */
+    template <typename Real>
+    CL_SIMD_INLINE void Reduce(Reduction reduction, int n, double* y) const {
+        // The group i is after y[i], so it is read before y[i] is written.
+        const int size = k_ / (m_ - 1);
+        for (int i = 0; i < m_; ++i) {
+            int first = i < m_ - 1 ? i * size : k_;
+            int last = i < m_ - 1 ? first + size : n;
+            Real t;
+            switch (reduction) {
+            case WEIGHTED_SUM:
+                t = WeightedSum<Real>(y, first, last);
+                break;
+            case SUM:
+                t = Sum<Real>(y, first, last) / (last - first);
+                break;
+            default:
+                t = NonSeparable<Real>(y, first, last);
+            }
+            lanes::Set(lanes::Clamp01(t), i, y);
+        }
+    }
+
+    /**
+     * The objectives from t, i.e., x(M - 1) + 2(m + 1) * hm(x0, ..., x(M - 2)).
+     */
+    template <typename Real>
+    CL_SIMD_INLINE void Shape(const double* t, double* f) const {
+        Real distance = lanes::Get<Real>(t, m_ - 1);
+
+        // The degenerate WFG3 has A = (1, 0, ..., 0), the others all ones.
+        Real product = lanes::Broadcast<Real>(1.0);
+        Real x0 = lanes::Get<Real>(t, 0);
+        for (int i = 0; i < m_ - 1; ++i) {
+            Real x = lanes::Get<Real>(t, i);
+            if (type_ == 3 && i > 0) {
+                x = distance * (x - 0.5) + 0.5;
+            }
+
+            Real h;
+            if (type_ == 3) {
+                h = product * (1.0 - x);
+                product *= x;
+            } else {
+                Real sin_x, cos_x;
+                lanes::SinCos(x * (cl::PI / 2.0), &sin_x, &cos_x);
+                if (type_ <= 2) {
+                    h = product * (1.0 - sin_x);
+                    product *= 1.0 - cos_x;
+                } else {
+                    h = product * cos_x;
+                    product *= sin_x;
+                }
+            }
+            lanes::Set(distance + 2.0 * (m_ - i) * h, m_ - 1 - i, f);
+        }
+        lanes::Set(distance + 2.0 * product, 0, f);
+
+        // The last objective of WFG1 is mixed and the one of WFG2 is disc.
+        if (type_ == 1) {
+            const double a = 10.0 * cl::PI;
+            Real h = 1.0 - x0 - lanes::Cos(a * x0 + cl::PI / 2.0) / a;
+            lanes::Set(distance + 2.0 * m_ * h, m_ - 1, f);
+        } else if (type_ == 2) {
+            Real c = lanes::Cos(5.0 * cl::PI * x0);
+            lanes::Set(distance + 2.0 * m_ * (1.0 - x0 * c * c), m_ - 1, f);
+        }
+    }
+
+    template <typename Real>
+    static CL_SIMD_INLINE Real Sum(const double* y, int first, int last) {
+        Real sum = lanes::Broadcast<Real>(0.0);
+        for (int i = first; i < last; ++i) {
+            sum += lanes::Get<Real>(y, i);
+        }
+        return sum;
+    }
+
+    /**
+     * r_sum(y[first, last)) with the weights 2(i + 1).
+     */
+    template <typename Real>
+    static CL_SIMD_INLINE Real WeightedSum(const double* y, int first,
+                                           int last) {
+        Real sum = lanes::Broadcast<Real>(0.0);
+        double weights = 0.0;
+        for (int i = first; i < last; ++i) {
+            sum += 2.0 * (i + 1) * lanes::Get<Real>(y, i);
+            weights += 2.0 * (i + 1);
+        }
+        return sum / weights;
+    }
+
+    /**
+     * r_nonsep(y[first, last), A) with A = last - first.
+     */
+    template <typename Real>
+    static CL_SIMD_INLINE Real NonSeparable(const double* y, int first,
+                                            int last) {
+        const int a = last - first;
+        Real sum = lanes::Broadcast<Real>(0.0);
+        for (int j = 0; j < a; ++j) {
+            Real yj = lanes::Get<Real>(y, first + j);
+            sum += yj;
+            for (int k = 0; k <= a - 2; ++k) {
+                sum += lanes::Abs(yj - lanes::Get<Real>(y, first +
+                                                        (j + k + 1) % a));
+            }
+        }
+        int half = (a + 1) / 2;
+        return sum / (half * (1.0 + 2.0 * a - 2.0 * half));
+    }
+
+    /**
+     * s_linear(y, A).
+     */
+    template <typename Real>
+    static CL_SIMD_INLINE Real SLinear(const Real& y, double a) {
+        Real t = lanes::Abs(y - a) / lanes::Abs(lanes::Floor(a - y) + a);
+        return lanes::Clamp01(t);
+    }
+
+    /**
+     * b_flat(y, A, B, C).
+     */
+    template <typename Real>
+    static CL_SIMD_INLINE Real BFlat(const Real& y, double a, double b,
+                                     double c) {
+        Real zero = lanes::Broadcast<Real>(0.0);
+        Real t = a + lanes::Min(zero, lanes::Floor(y - b)) * a * (b - y) / b -
+                 lanes::Min(zero, lanes::Floor(c - y)) * (1.0 - a) *
+                 (y - c) / (1.0 - c);
+        return lanes::Clamp01(t);
+    }
+
+    /**
+     * b_param(y, u, 0.98 / 49.98, 0.02, 50), the parameters of WFG7 to WFG9.
+     */
+    template <typename Real>
+    static CL_SIMD_INLINE Real BParam(const Real& y, const Real& u) {
+        const double a = 0.98 / 49.98, b = 0.02, c = 50.0;
+        Real v = a - (1.0 - 2.0 * u) * lanes::Abs(lanes::Floor(0.5 - u) + a);
+        return lanes::Clamp01(lanes::Pow(y, b + (c - b) * v));
+    }
+
+    /**
+     * s_decept(y, A, B, C).
+     */
+    template <typename Real>
+    static CL_SIMD_INLINE Real SDecept(const Real& y, double a, double b,
+                                       double c) {
+        Real t = 1.0 + (lanes::Abs(y - a) - b) *
+                 (lanes::Floor(y - a + b) * (1.0 - c + (a - b) / b) / (a - b) +
+                  lanes::Floor(a + b - y) * (1.0 - c + (1.0 - a - b) / b) /
+                  (1.0 - a - b) + 1.0 / b);
+        return lanes::Clamp01(t);
+    }
+
+    /**
+     * s_multi(y, A, B, C).
+     */
+    template <typename Real>
+    static CL_SIMD_INLINE Real SMulti(const Real& y, double a, double b,
+                                      double c) {
+        Real r = lanes::Abs(y - c) / (2.0 * (lanes::Floor(c - y) + c));
+        Real t = (1.0 + lanes::Cos((4.0 * a + 2.0) * cl::PI * (0.5 - r)) +
+                  4.0 * b * r * r) / (b + 2.0);
+        return lanes::Clamp01(t);
+    }
+
+    int type_; // The number of WFG.
+    int m_;    // The number of objectives.
+    int k_;    // The number of position variables.
+    int l_;    // The number of distance variables.
+};
+
+/**
+ * WFG1 to WFG9 of any numbers of objectives and variables, named as
+ * WFG4_M10_D38.
+ *
+ * Usage:
+ *    WFGTest test(4, 10, 18, 20); // k = 18, l = 20.
+ */
+class WFGTest : public ScalableTest<WFGProblem> {
+public:
+    WFGTest(int type, int n_objectives, int k, int l)
+        : ScalableTest<WFGProblem>(Name(type, n_objectives, k + l),
+                                   WFGProblem(type, n_objectives, k, l),
+                                   n_objectives, k + l) {
+        for (int i = 0; i < k + l; ++i) {
+            parameter.max_variables[i] = 2.0 * (i + 1);
+        }
+    }
+
+    /**
+     * Create the test of n variables, owned by the caller. There are
+     * k = 2(M - 1) position variables as suggested by the reference, and
+     * n - k distance variables.
+     *
+     * @return NULL if the numbers are invalid.
+     */
+    static BasicTest* Create(int type, int n_objectives, int n_variables) {
+        int k = 2 * (n_objectives - 1);
+        if (!WFGProblem::IsValid(type, n_objectives, k, n_variables - k)) {
+            return NULL;
+        }
+        return new WFGTest(type, n_objectives, k, n_variables - k);
+    }
+
+private:
+    static std::string Name(int type, int n_objectives, int n_variables) {
+        return "WFG" + std::to_string(type) +
+               "_M" + std::to_string(n_objectives) +
+               "_D" + std::to_string(n_variables);
+    }
+};
+
+} // namespace moo
+
+#endif // TEST_TEST_WFG_H_
@@ -48,6 +48,9 @@ public:
 
         objectives.push_back(Objective1);
         objectives.push_back(Objective2);
+
+        partial_state = InitializeState;
+        incremental_objectives = UpdateObjectives;
     }
 
     /**
@@ -69,6 +72,32 @@ public:
         double g = 1.0 + 9.0 * sum / (x.size() - 1);
         return g * (1.0 - sqrt(x[0] / g));
     }
+
+    /**
+     * The partial state is Sum(xi, i = [1, n)).
+     */
+    static void InitializeState(const std::vector<double>& x,
+                                std::vector<double>* state) {
+        double sum = 0.0;
+        for (size_t i = 1; i < x.size(); ++i) {
+            sum += x[i];
+        }
+        state->assign(1, sum);
+    }
+
+    /**
+     * Update the objectives after x[index] is changed from old_value.
+     */
+    static void UpdateObjectives(const std::vector<double>& x, int index,
+                                 double old_value, std::vector<double>* state,
+                                 std::vector<double>* objectives) {
+        if (index > 0) {
+            (*state)[0] += x[index] - old_value;
+        }
+        double g = 1.0 + 9.0 * (*state)[0] / (x.size() - 1);
+        (*objectives)[0] = x[0];
+        (*objectives)[1] = g * (1.0 - sqrt(x[0] / g));
+    }
 };
 
 /**
@@ -98,6 +127,9 @@ public:
 
         objectives.push_back(Objective1);
         objectives.push_back(Objective2);
+
+        partial_state = ZDT1Test::InitializeState;
+        incremental_objectives = UpdateObjectives;
     }
 
     /**
@@ -119,6 +151,20 @@ public:
         double g = 1.0 + 9.0 * sum / (x.size() - 1);
         return g * (1.0 - (x[0] / g) * (x[0] / g));
     }
+
+    /**
+     * Update the objectives after x[index] is changed from old_value.
+     */
+    static void UpdateObjectives(const std::vector<double>& x, int index,
+                                 double old_value, std::vector<double>* state,
+                                 std::vector<double>* objectives) {
+        if (index > 0) {
+            (*state)[0] += x[index] - old_value;
+        }
+        double g = 1.0 + 9.0 * (*state)[0] / (x.size() - 1);
+        (*objectives)[0] = x[0];
+        (*objectives)[1] = g * (1.0 - (x[0] / g) * (x[0] / g));
+    }
 };
 
 /**
@@ -149,6 +195,9 @@ public:
 
         objectives.push_back(Objective1);
         objectives.push_back(Objective2);
+
+        partial_state = ZDT1Test::InitializeState;
+        incremental_objectives = UpdateObjectives;
     }
 
     /**
@@ -171,6 +220,21 @@ public:
         return g * (1.0 - std::sqrt(x[0] / g) -
                x[0] / g * std::sin(10.0 * cl::PI * x[0]));
     }
+
+    /**
+     * Update the objectives after x[index] is changed from old_value.
+     */
+    static void UpdateObjectives(const std::vector<double>& x, int index,
+                                 double old_value, std::vector<double>* state,
+                                 std::vector<double>* objectives) {
+        if (index > 0) {
+            (*state)[0] += x[index] - old_value;
+        }
+        double g = 1.0 + 9.0 * (*state)[0] / (x.size() - 1);
+        (*objectives)[0] = x[0];
+        (*objectives)[1] = g * (1.0 - std::sqrt(x[0] / g) -
+                           x[0] / g * std::sin(10.0 * cl::PI * x[0]));
+    }
 };
 
 /**
@@ -203,6 +267,9 @@ public:
 
         objectives.push_back(Objective1);
         objectives.push_back(Objective2);
+
+        partial_state = InitializeState;
+        incremental_objectives = UpdateObjectives;
     }
 
     /**
@@ -223,6 +290,40 @@ public:
         }
         return g * (1.0 - std::sqrt(x[0] / g));
     }
+
+    /**
+     * The partial state is g(x).
+     */
+    static void InitializeState(const std::vector<double>& x,
+                                std::vector<double>* state) {
+        double g = 1.0 + 10.0 * (x.size() - 1);
+        for (size_t i = 1; i < x.size(); ++i) {
+            g += GTerm(x[i]);
+        }
+        state->assign(1, g);
+    }
+
+    /**
+     * Update the objectives after x[index] is changed from old_value.
+     */
+    static void UpdateObjectives(const std::vector<double>& x, int index,
+                                 double old_value, std::vector<double>* state,
+                                 std::vector<double>* objectives) {
+        if (index > 0) {
+            (*state)[0] += GTerm(x[index]) - GTerm(old_value);
+        }
+        double g = (*state)[0];
+        (*objectives)[0] = x[0];
+        (*objectives)[1] = g * (1.0 - std::sqrt(x[0] / g));
+    }
+
+private:
+    /**
+     * The term of g(x) for xi, i.e., xi * xi - 10cos(4PI * xi).
+     */
+    static double GTerm(double xi) {
+        return xi * xi - 10.0 * std::cos(4.0 * cl::PI * xi);
+    }
 };
 
 
@@ -253,6 +354,9 @@ public:
 
         objectives.push_back(Objective1);
         objectives.push_back(Objective2);
+
+        partial_state = ZDT1Test::InitializeState;
+        incremental_objectives = UpdateObjectives;
     }
 
     /**
@@ -276,6 +380,21 @@ public:
         double f1 = Objective1(x);
         return g * (1.0 - (f1 / g) * (f1 / g));
     }
+
+    /**
+     * Update the objectives after x[index] is changed from old_value.
+     */
+    static void UpdateObjectives(const std::vector<double>& x, int index,
+                                 double old_value, std::vector<double>* state,
+                                 std::vector<double>* objectives) {
+        if (index > 0) {
+            (*state)[0] += x[index] - old_value;
+        }
+        double g = 1.0 + 9.0 * pow((*state)[0] / (x.size() - 1), 0.25);
+        double f1 = Objective1(x);
+        (*objectives)[0] = f1;
+        (*objectives)[1] = g * (1.0 - (f1 / g) * (f1 / g));
+    }
 };
 
 } // namespace moo
@@ -0,0 +1,143 @@
+//
+// Copyright 2013 Yangbin Lin and Bili Chen. All Rights Reserved.
+//
+// Author: yblin.xmu@qq.com (Yangbin Lin)
+//
+// To use this code, please cite the follow paper:
+//
+// Chen B, Zeng W, Lin Y, et al. A New Local Search-Based Multiobjective
+// Optimization Algorithm[J]. IEEE Transactions on Evolutionary Computation,
+// 2014, 19(1):1-1.
+//
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "codelibrary/math/batch_math_array.h"
+#include "test/unit/unit_test.h"
+
+#if CL_BATCH_MATH
+
+using namespace cl::batch_math;
+
+namespace {
+
+// The number of samples, not a multiple of the lanes to cover the tails.
+const int N_SAMPLES = 100003;
+
+// The accuracies and their bounds of relative errors, see Accuracy.
+const Accuracy ACCURACIES[] = { FULL_ACCURACY, HIGH_ACCURACY, LOW_ACCURACY };
+const double BOUNDS[] = { 2.0 * DBL_EPSILON, 1e-12, 1e-7 };
+
+/**
+ * n uniform samples in [low, high).
+ */
+std::vector<double> Uniform(double low, double high, int n) {
+    std::mt19937 random(1);
+    std::uniform_real_distribution<double> uniform(low, high);
+    std::vector<double> x(n);
+    for (double& v : x) {
+        v = uniform(random);
+    }
+    return x;
+}
+
+/**
+ * The relative error of y to the reference computed in long double.
+ */
+double RelativeError(double y, long double reference) {
+    return static_cast<double>(std::fabs((y - reference) / reference));
+}
+
+// A function of batch_math over arrays, and its reference.
+typedef void (*ArrayFunction)(const double*, int, double*, Accuracy);
+typedef long double (*Reference)(double);
+
+/**
+ * The maximum relative error of the array function f against g.
+ */
+double MaxError(ArrayFunction f, Reference g, const std::vector<double>& x,
+                Accuracy accuracy) {
+    std::vector<double> y(x.size());
+    f(x.data(), static_cast<int>(x.size()), y.data(), accuracy);
+    double max_error = 0.0;
+    for (size_t i = 0; i < x.size(); ++i) {
+        max_error = std::max(max_error, RelativeError(y[i], g(x[i])));
+    }
+    return max_error;
+}
+
+long double SinL(double x) { return std::sin(static_cast<long double>(x)); }
+long double CosL(double x) { return std::cos(static_cast<long double>(x)); }
+long double ExpL(double x) { return std::exp(static_cast<long double>(x)); }
+long double LogL(double x) { return std::log(static_cast<long double>(x)); }
+
+} // namespace
+
+// Sin() and Cos() are within the bounds for |x| < 1e6.
+TEST(BatchMath_SinCosAccuracy) {
+    std::vector<double> x = Uniform(-100.0, 100.0, N_SAMPLES);
+    std::vector<double> large = Uniform(-1e6, 1e6, N_SAMPLES);
+    x.insert(x.end(), large.begin(), large.end());
+    for (int k = 0; k < 3; ++k) {
+        EXPECT(MaxError(Sin, SinL, x, ACCURACIES[k]) <= BOUNDS[k]);
+        EXPECT(MaxError(Cos, CosL, x, ACCURACIES[k]) <= BOUNDS[k]);
+    }
+}
+
+// Exp() is within the bounds over the range of normal results.
+TEST(BatchMath_ExpAccuracy) {
+    std::vector<double> x = Uniform(-700.0, 700.0, N_SAMPLES);
+    for (int k = 0; k < 3; ++k) {
+        EXPECT(MaxError(Exp, ExpL, x, ACCURACIES[k]) <= BOUNDS[k]);
+    }
+}
+
+// Log() is within the bounds from 1e-300 to 1e300.
+TEST(BatchMath_LogAccuracy) {
+    std::vector<double> x = Uniform(-690.0, 690.0, N_SAMPLES);
+    for (double& v : x) {
+        v = std::exp(v);
+    }
+    for (int k = 0; k < 3; ++k) {
+        EXPECT(MaxError(Log, LogL, x, ACCURACIES[k]) <= BOUNDS[k]);
+    }
+}
+
+// Pow() is within the bounds, times (1 + |y log(x)|) except FULL_ACCURACY.
+TEST(BatchMath_PowAccuracy) {
+    std::vector<double> x = Uniform(0.0, 10.0, N_SAMPLES);
+    std::vector<double> y = Uniform(-10.0, 10.0, N_SAMPLES);
+    std::vector<double> z(N_SAMPLES);
+    for (int k = 0; k < 3; ++k) {
+        Pow(x.data(), y.data(), N_SAMPLES, z.data(), ACCURACIES[k]);
+        double max_error = 0.0;
+        for (int i = 0; i < N_SAMPLES; ++i) {
+            double error = RelativeError(z[i], std::pow(
+                    static_cast<long double>(x[i]),
+                    static_cast<long double>(y[i])));
+            if (ACCURACIES[k] != FULL_ACCURACY) {
+                error /= 1.0 + std::fabs(y[i] * std::log(x[i]));
+            }
+            max_error = std::max(max_error, error);
+        }
+        EXPECT(max_error <= BOUNDS[k]);
+    }
+}
+
+// Sqrt() is correctly rounded.
+TEST(BatchMath_SqrtIsExact) {
+    std::vector<double> x = Uniform(0.0, 1e6, N_SAMPLES);
+    std::vector<double> y(N_SAMPLES);
+    Sqrt(x.data(), N_SAMPLES, y.data());
+    bool exact = true;
+    for (int i = 0; i < N_SAMPLES; ++i) {
+        exact = exact && y[i] == std::sqrt(x[i]);
+    }
+    EXPECT(exact);
+}
+
+#endif // CL_BATCH_MATH
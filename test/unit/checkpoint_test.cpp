@@ -0,0 +1,195 @@
+//
+// Copyright 2013 Yangbin Lin and Bili Chen. All Rights Reserved.
+//
+// Author: yblin.xmu@qq.com (Yangbin Lin)
+//
+// To use this code, please cite the follow paper:
+//
+// Chen B, Zeng W, Lin Y, et al. A New Local Search-Based Multiobjective
+// Optimization Algorithm[J]. IEEE Transactions on Evolutionary Computation,
+// 2014, 19(1):1-1.
+//
+
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+
+#include "solver/solver_nsls.h"
+#include "solver/util/non_dominated_archive.h"
+#include "test/test_factory.h"
+#include "test/unit/unit_test.h"
+
+using namespace moo;
+
+namespace {
+
+const char CHECKPOINT_FILE[] = "unit_test_checkpoint.bin";
+
+bool IsSame(const Population& a, const Population& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].variables != b[i].variables ||
+            a[i].objectives != b[i].objectives) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Run 2 * n generations, and run n generations, save a checkpoint, restart a
+ * new solver from it and run n generations again. Each run uses a copy of the
+ * given scheduler and surrogate, NULL if not used.
+ *
+ * @return true if both runs end with the same population and evaluations.
+ */
+bool RestartIsExact(const BasicTest& test, const VariableScheduler* scheduler,
+                    const Surrogate* surrogate, int n) {
+    VariableScheduler s = scheduler ? *scheduler : VariableScheduler();
+    Surrogate m = surrogate ? *surrogate : Surrogate();
+    VariableScheduler schedulers[3] = { s, s, s };
+    Surrogate surrogates[3] = { m, m, m };
+    SolverNSLS<> solvers[3];
+    Population populations[3];
+    for (int k = 0; k < 3; ++k) {
+        solvers[k].set_seed(3);
+        if (scheduler) solvers[k].set_variable_scheduler(&schedulers[k]);
+        if (surrogate) solvers[k].set_surrogate(&surrogates[k]);
+    }
+
+    for (int k = 0; k < 2; ++k) {
+        solvers[k].Initialize(test, 50, &populations[k]);
+        for (int i = 0; i < (2 - k) * n; ++i) {
+            solvers[k].SingleStep(&populations[k]);
+        }
+    }
+    if (!solvers[1].SaveCheckpoint(CHECKPOINT_FILE, populations[1])) {
+        return false;
+    }
+    bool restarted = solvers[2].Restart(test, CHECKPOINT_FILE,
+                                        &populations[2]);
+    std::remove(CHECKPOINT_FILE);
+    if (!restarted) return false;
+    for (int i = 0; i < n; ++i) {
+        solvers[2].SingleStep(&populations[2]);
+    }
+
+    return IsSame(populations[0], populations[2]) &&
+           solvers[0].n_evaluations() == solvers[2].n_evaluations() &&
+           schedulers[0].n_saved_evaluations() ==
+           schedulers[2].n_saved_evaluations() &&
+           surrogates[0].n_trials() == surrogates[2].n_trials() &&
+           surrogates[0].n_skipped() == surrogates[2].n_skipped();
+}
+
+} // namespace
+
+// The scheduler continues from the checkpoint, e.g., the rewards of ADAPTIVE
+// and the groups of GROUPED are not computed again.
+TEST(Checkpoint_RestartKeepsScheduler) {
+    std::unique_ptr<BasicTest> test(TestFactory::CreateTest("ZDT1"));
+    const VariableScheduler::Strategy strategies[] = {
+        VariableScheduler::ADAPTIVE,
+        VariableScheduler::GROUPED,
+        VariableScheduler::RANDOM
+    };
+    for (VariableScheduler::Strategy strategy : strategies) {
+        VariableScheduler scheduler(strategy, 10);
+        EXPECT(RestartIsExact(*test, &scheduler, NULL, 15));
+    }
+}
+
+// The surrogate continues from the checkpoint with the same histories and
+// running precision.
+TEST(Checkpoint_RestartKeepsSurrogate) {
+    const char* names[] = { "ZDT1", "DTLZ2_3D" };
+    for (const char* name : names) {
+        std::unique_ptr<BasicTest> test(TestFactory::CreateTest(name));
+        Surrogate surrogate;
+        surrogate.set_min_precision(0.9);
+        EXPECT(RestartIsExact(*test, NULL, &surrogate, 15));
+
+        VariableScheduler scheduler(VariableScheduler::ADAPTIVE, 10);
+        EXPECT(RestartIsExact(*test, &scheduler, &surrogate, 15));
+    }
+}
+
+// A float archive is saved as it is stored, and it continues from the
+// checkpoint with the same individuals.
+TEST(Checkpoint_RestartKeepsFloatArchive) {
+    std::unique_ptr<BasicTest> test(TestFactory::CreateTest("ZDT1"));
+    FloatNonDominatedArchive archives[3];
+    SolverNSLS<> solvers[3];
+    Population populations[3];
+    for (int k = 0; k < 3; ++k) {
+        solvers[k].set_seed(3);
+        solvers[k].set_archive(&archives[k]);
+    }
+    for (int k = 0; k < 2; ++k) {
+        solvers[k].Initialize(*test, 20, &populations[k]);
+        for (int i = 0; i < 10 * (2 - k); ++i) {
+            solvers[k].SingleStep(&populations[k]);
+        }
+    }
+    EXPECT(solvers[1].SaveCheckpoint(CHECKPOINT_FILE, populations[1]));
+    EXPECT(solvers[2].Restart(*test, CHECKPOINT_FILE, &populations[2]));
+    std::remove(CHECKPOINT_FILE);
+    EXPECT(archives[2].size() == archives[1].size());
+    for (int i = 0; i < 10; ++i) {
+        solvers[2].SingleStep(&populations[2]);
+    }
+
+    Population exported[2];
+    archives[0].Export(&exported[0]);
+    archives[2].Export(&exported[1]);
+    for (Population& population : exported) {
+        std::sort(population.begin(), population.end(),
+                  [](const Individual& a, const Individual& b) {
+            return a.objectives < b.objectives;
+        });
+    }
+    EXPECT(archives[0].size() > 20);
+    EXPECT(IsSame(exported[0], exported[1]));
+    EXPECT(IsSame(populations[0], populations[2]));
+}
+
+// A checkpoint with a scheduler state is only restarted with a scheduler of
+// the same strategy.
+TEST(Checkpoint_RestartRejectsOtherScheduler) {
+    std::unique_ptr<BasicTest> test(TestFactory::CreateTest("ZDT1"));
+    VariableScheduler scheduler(VariableScheduler::ADAPTIVE, 10);
+    SolverNSLS<> solver;
+    solver.set_seed(3);
+    solver.set_variable_scheduler(&scheduler);
+    Population population;
+    solver.Initialize(*test, 20, &population);
+    solver.SingleStep(&population);
+    EXPECT(solver.SaveCheckpoint(CHECKPOINT_FILE, population));
+
+    SolverNSLS<> solver1;
+    EXPECT(!solver1.Restart(*test, CHECKPOINT_FILE, &population));
+    VariableScheduler grouped(VariableScheduler::GROUPED, 10);
+    solver1.set_variable_scheduler(&grouped);
+    EXPECT(!solver1.Restart(*test, CHECKPOINT_FILE, &population));
+    VariableScheduler adaptive(VariableScheduler::ADAPTIVE, 10);
+    solver1.set_variable_scheduler(&adaptive);
+    EXPECT(solver1.Restart(*test, CHECKPOINT_FILE, &population));
+    std::remove(CHECKPOINT_FILE);
+}
+
+// A periodic checkpoint that can not be written is counted, and the run goes
+// on.
+TEST(Checkpoint_FailureIsCounted) {
+    std::unique_ptr<BasicTest> test(TestFactory::CreateTest("ZDT1"));
+    SolverNSLS<> solver;
+    solver.set_seed(1);
+    solver.set_checkpoint("/nonexistent_directory/checkpoint", 2);
+    Population population;
+    solver.Initialize(*test, 20, &population);
+    for (int i = 0; i < 5; ++i) {
+        solver.SingleStep(&population);
+    }
+    EXPECT(solver.n_generation() == 5);
+    EXPECT(solver.n_failed_checkpoints() == 2);
+    EXPECT(solver.last_failed_checkpoint() == 4);
+}
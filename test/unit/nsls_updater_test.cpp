@@ -0,0 +1,134 @@
+//
+// Copyright 2013 Yangbin Lin and Bili Chen. All Rights Reserved.
+//
+// Author: yblin.xmu@qq.com (Yangbin Lin)
+//
+// To use this code, please cite the follow paper:
+//
+// Chen B, Zeng W, Lin Y, et al. A New Local Search-Based Multiobjective
+// Optimization Algorithm[J]. IEEE Transactions on Evolutionary Computation,
+// 2014, 19(1):1-1.
+//
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/batch_evaluator.h"
+#include "solver/solver_nsls.h"
+#include "test/test_factory.h"
+#include "test/unit/unit_test.h"
+
+using namespace moo;
+
+namespace {
+
+/**
+ * Run SolverNSLS on test for the given number of generations.
+ */
+void Solve(const BasicTest& test, int n_generations,
+           SolverNSLS<>* solver, Population* population) {
+    solver->set_seed(5);
+    solver->Initialize(test, 100, population);
+    for (int i = 0; i < n_generations; ++i) {
+        solver->SingleStep(population);
+    }
+}
+
+bool IsSame(const Population& a, const Population& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].variables != b[i].variables ||
+            a[i].objectives != b[i].objectives) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/// Evaluate the objective functions of test, and count the candidates.
+class CountingEvaluator : public BatchEvaluator {
+public:
+    explicit CountingEvaluator(const BasicTest& test)
+        : objectives_(test.objectives), n_evaluations_(0) {}
+
+    virtual void Evaluate(const cl::Array2D<double>& variables,
+                          cl::Array2D<double>* objectives) {
+        int n = variables.rows(), d = variables.columns();
+        int m = static_cast<int>(objectives_.size());
+        objectives->Resize(n, m);
+        std::vector<double> x(d);
+        for (int i = 0; i < n; ++i) {
+            std::copy_n(variables.data().begin() + i * d, d, x.begin());
+            for (int j = 0; j < m; ++j) {
+                (*objectives)(i, j) = (objectives_[j])(x);
+            }
+        }
+        n_evaluations_ += n;
+    }
+
+    int64_t n_evaluations() const { return n_evaluations_; }
+
+private:
+    std::vector<Objective> objectives_;
+    int64_t n_evaluations_;
+};
+
+} // namespace
+
+// The lazy evaluation gives the same run as evaluating all objective
+// functions of the trials, also for the tests with incremental objectives.
+TEST(NSLSUpdater_LazyIsSameAsFullEvaluation) {
+    const char* names[] = { "ZDT1", "ZDT3", "DTLZ2_3D", "LZ8", "UF4", "CF1" };
+    int64_t n_avoided = 0;
+    for (const char* name : names) {
+        std::unique_ptr<BasicTest> test(TestFactory::CreateTest(name));
+        EXPECT(test.get() != NULL);
+        if (!test) continue;
+
+        BasicTest full = *test;
+        full.partial_state = nullptr;
+        full.incremental_objectives = nullptr;
+
+        BasicTest lazy = *test;
+        int m = lazy.parameter.n_objectives;
+        lazy.objective_costs.assign(m, 1.0);
+        lazy.objective_costs[m - 1] = 100.0;
+
+        SolverNSLS<> solver1, solver2;
+        Population population1, population2;
+        Solve(full, 20, &solver1, &population1);
+        Solve(lazy, 20, &solver2, &population2);
+        EXPECT(IsSame(population1, population2));
+        EXPECT(solver1.n_evaluations() == solver2.n_evaluations());
+        EXPECT(solver1.updater().n_avoided_objectives() == 0);
+        n_avoided += solver2.updater().n_avoided_objectives();
+    }
+    EXPECT(n_avoided > 0);
+}
+
+// With a batch evaluator, the costs are ignored and every trial goes through
+// the evaluator.
+TEST(NSLSUpdater_LazyKeepsBatchEvaluator) {
+    std::unique_ptr<BasicTest> test(TestFactory::CreateTest("ZDT1"));
+
+    BasicTest eager = *test;
+    CountingEvaluator evaluator1(eager);
+    eager.batch_evaluator = &evaluator1;
+
+    BasicTest lazy = *test;
+    CountingEvaluator evaluator2(lazy);
+    lazy.batch_evaluator = &evaluator2;
+    lazy.objective_costs.assign(lazy.parameter.n_objectives, 1.0);
+
+    SolverNSLS<> solver1, solver2;
+    Population population1, population2;
+    Solve(eager, 10, &solver1, &population1);
+    Solve(lazy, 10, &solver2, &population2);
+    EXPECT(IsSame(population1, population2));
+    EXPECT(solver2.updater().n_avoided_objectives() == 0);
+    EXPECT(evaluator2.n_evaluations() == solver2.n_evaluations());
+    EXPECT(evaluator1.n_evaluations() == evaluator2.n_evaluations());
+}
@@ -0,0 +1,59 @@
+//
+// Copyright 2013 Yangbin Lin and Bili Chen. All Rights Reserved.
+//
+// Author: yblin.xmu@qq.com (Yangbin Lin)
+//
+// To use this code, please cite the follow paper:
+//
+// Chen B, Zeng W, Lin Y, et al. A New Local Search-Based Multiobjective
+// Optimization Algorithm[J]. IEEE Transactions on Evolutionary Computation,
+// 2014, 19(1):1-1.
+//
+
+#include <cstdio>
+#include <string>
+
+#include "test/pareto_front_io.h"
+#include "test/unit/unit_test.h"
+
+using namespace moo;
+
+namespace {
+
+const char FRONT_FILE[] = "unit_test_front.txt";
+
+/**
+ * Load the text as a front file.
+ */
+bool LoadText(const std::string& text, cl::Array2D<double>* front) {
+    FILE* f = std::fopen(FRONT_FILE, "wb");
+    if (!f) return false;
+    std::fwrite(text.data(), 1, text.size(), f);
+    std::fclose(f);
+    bool ok = ParetoFrontIO::Load(FRONT_FILE, front);
+    std::remove(FRONT_FILE);
+    return ok;
+}
+
+} // namespace
+
+// The comments may be indented.
+TEST(ParetoFrontIO_IndentedComments) {
+    cl::Array2D<double> front;
+    EXPECT(LoadText("# f1 f2\n  # indented\n\t% tab\n0 1\n 1, 0\n\n",
+                    &front));
+    EXPECT(front.rows() == 2 && front.columns() == 2);
+    EXPECT(front(0, 0) == 0.0 && front(0, 1) == 1.0);
+    EXPECT(front(1, 0) == 1.0 && front(1, 1) == 0.0);
+}
+
+// The numbers must be separated.
+TEST(ParetoFrontIO_RejectsUnseparatedNumbers) {
+    cl::Array2D<double> front;
+    EXPECT(!LoadText("1.5-2\n", &front));
+    EXPECT(!LoadText("1.5 2+3\n", &front));
+    EXPECT(!LoadText("1.5 2e3e4\n", &front));
+    EXPECT(!LoadText("1.5x 2\n", &front));
+    EXPECT(LoadText("1.5 -2\n1e-3;inf\n", &front));
+    EXPECT(front.rows() == 2 && front(0, 1) == -2.0 && front(1, 0) == 1e-3);
+}
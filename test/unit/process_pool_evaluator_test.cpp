@@ -0,0 +1,79 @@
+//
+// Copyright 2013 Yangbin Lin and Bili Chen. All Rights Reserved.
+//
+// Author: yblin.xmu@qq.com (Yangbin Lin)
+//
+// To use this code, please cite the follow paper:
+//
+// Chen B, Zeng W, Lin Y, et al. A New Local Search-Based Multiobjective
+// Optimization Algorithm[J]. IEEE Transactions on Evolutionary Computation,
+// 2014, 19(1):1-1.
+//
+
+#ifndef _WIN32
+
+#include <vector>
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "codelibrary/util/array/array_2d.h"
+#include "solver/util/process_pool_evaluator.h"
+#include "test/unit/unit_test.h"
+
+using namespace moo;
+
+namespace {
+
+/**
+ * Evaluate a batch by a pool whose workers die on their first candidate and
+ * can not be forked again. It runs in the calling process, which should be a
+ * child of the test.
+ *
+ * @return true if the batch is evaluated in process, and counted as failures.
+ */
+bool EvaluateWithoutWorkers() {
+    // The limit of processes does not apply to root.
+    if (getuid() == 0 && (setgid(65534) != 0 || setuid(65534) != 0)) {
+        return true;
+    }
+
+    pid_t parent = getpid();
+    ProcessPoolEvaluator evaluator(1, 1, [parent](const std::vector<double>& x,
+                                                  std::vector<double>* f) {
+        if (getpid() != parent) _exit(1);
+        (*f)[0] = 2.0 * x[0];
+    }, 2);
+    if (evaluator.n_workers() != 2) return false;
+
+    // The parent and the two workers reach the limit.
+    rlimit limit = { 1, 1 };
+    if (setrlimit(RLIMIT_NPROC, &limit) != 0) return false;
+
+    const int n = 10;
+    cl::Array2D<double> variables(n, 1), objectives;
+    for (int i = 0; i < n; ++i) {
+        variables(i, 0) = i;
+    }
+    evaluator.Evaluate(variables, &objectives);
+    for (int i = 0; i < n; ++i) {
+        if (objectives(i, 0) != 2.0 * i) return false;
+    }
+    return evaluator.n_failures() == n;
+}
+
+} // namespace
+
+// The candidates do not wait forever for the workers that can not be forked.
+TEST(ProcessPoolEvaluator_NoWorkerCanBeForked) {
+    pid_t pid = fork();
+    if (pid == 0) _exit(EvaluateWithoutWorkers() ? 0 : 1);
+    EXPECT(pid > 0);
+
+    int status = 0;
+    EXPECT(waitpid(pid, &status, 0) == pid);
+    EXPECT(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+}
+
+#endif // _WIN32
@@ -0,0 +1,113 @@
+//
+// Copyright 2013 Yangbin Lin and Bili Chen. All Rights Reserved.
+//
+// Author: yblin.xmu@qq.com (Yangbin Lin)
+//
+// To use this code, please cite the follow paper:
+//
+// Chen B, Zeng W, Lin Y, et al. A New Local Search-Based Multiobjective
+// Optimization Algorithm[J]. IEEE Transactions on Evolutionary Computation,
+// 2014, 19(1):1-1.
+//
+
+#include <memory>
+
+#include "solver/solver_nsls.h"
+#include "solver/util/termination.h"
+#include "solver/util/variable_scheduler.h"
+#include "test/test_factory.h"
+#include "test/unit/unit_test.h"
+
+using namespace moo;
+
+namespace {
+
+/**
+ * A front of n points on the line f0 + f1 = 1 shifted by 'offset', all of
+ * rank 0, and one dominated individual.
+ */
+Population Front(int n, double offset) {
+    Population population(n + 1);
+    for (int i = 0; i <= n; ++i) {
+        double t = i < n ? double(i) / (n - 1) : 0.5;
+        double shift = i < n ? offset : offset + 1.0;
+        population[i].objectives = { t + shift, 1.0 - t + shift };
+        population[i].rank = i < n ? 0 : 1;
+    }
+    return population;
+}
+
+} // namespace
+
+// The budget holds from the first generation, whose cost is not measured yet.
+TEST(Termination_FirstGenerationRespectsBudget) {
+    std::unique_ptr<BasicTest> test(TestFactory::CreateTest("ZDT1"));
+    const int64_t budgets[] = { 1000, 6100, 20000 };
+    for (int64_t budget : budgets) {
+        SolverNSLS<> solver;
+        solver.set_seed(1);
+        Population population;
+        solver.Initialize(*test, 100, &population);
+
+        Termination termination;
+        termination.set_max_evaluations(budget);
+        EXPECT(solver.Run(&termination, &population) ==
+               Termination::MAX_EVALUATIONS);
+        EXPECT(solver.n_evaluations() <= budget);
+    }
+}
+
+// With a scheduler, a generation costs only the trials of the scheduled
+// variables, so a budget below 2 * N * D still runs some generations.
+TEST(Termination_BudgetWithScheduler) {
+    std::unique_ptr<BasicTest> test(
+            TestFactory::CreateTest("LSMOP1_M3_D1000"));
+    const VariableScheduler::Strategy strategies[] = {
+        VariableScheduler::RANDOM, VariableScheduler::ROUND_ROBIN
+    };
+    for (VariableScheduler::Strategy strategy : strategies) {
+        VariableScheduler scheduler(strategy, 100);
+        SolverNSLS<> solver;
+        solver.set_seed(1);
+        solver.set_variable_scheduler(&scheduler);
+        Population population;
+        solver.Initialize(*test, 100, &population);
+        EXPECT(solver.max_generation_cost() == 20000);
+
+        Termination termination;
+        termination.set_max_evaluations(150000);
+        EXPECT(solver.Run(&termination, &population) ==
+               Termination::MAX_EVALUATIONS);
+        EXPECT(solver.n_generation() == 7);
+        EXPECT(solver.n_evaluations() <= 150000);
+    }
+}
+
+// A front that does not move is stagnant after 'window' checks, a front that
+// keeps moving never is.
+TEST(Termination_Stagnation) {
+    Termination termination;
+    termination.set_stagnation(5, 1e-3);
+    termination.Start();
+    Population front = Front(50, 0.0);
+    int n_checks = 0;
+    while (!termination.Check(n_checks, 0, front) && n_checks < 100) {
+        ++n_checks;
+    }
+    EXPECT(termination.reason() == Termination::STAGNATION);
+    EXPECT(n_checks == 5);
+
+    termination.Start();
+    for (int i = 0; i < 100; ++i) {
+        EXPECT(!termination.Check(i, 0, Front(50, 0.01 * i)));
+    }
+
+    // The slow drift is caught by the accumulated movement.
+    termination.Start();
+    n_checks = 0;
+    for (int i = 0; i < 100; ++i) {
+        if (termination.Check(i, 0, Front(50, 2e-4 * i))) break;
+        ++n_checks;
+    }
+    EXPECT(n_checks == 100);
+}
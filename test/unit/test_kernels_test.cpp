@@ -0,0 +1,113 @@
+//
+// Copyright 2013 Yangbin Lin and Bili Chen. All Rights Reserved.
+//
+// Author: yblin.xmu@qq.com (Yangbin Lin)
+//
+// To use this code, please cite the follow paper:
+//
+// Chen B, Zeng W, Lin Y, et al. A New Local Search-Based Multiobjective
+// Optimization Algorithm[J]. IEEE Transactions on Evolutionary Computation,
+// 2014, 19(1):1-1.
+//
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "codelibrary/util/array/array_2d.h"
+#include "solver/util/population_util.h"
+#include "test/batch/test_kernels.h"
+#include "test/test_factory.h"
+#include "test/unit/unit_test.h"
+
+#if CL_BATCH_MATH
+
+using namespace moo;
+
+namespace {
+
+// The number of candidates, not a multiple of the lanes to cover the tails.
+const int N_CANDIDATES = 1003;
+
+// The bound of the errors of the kernels, relative to max(|f|, 1).
+const double BOUND = 1e-12;
+
+/**
+ * n candidates drawn uniformly in the bounds of test.
+ */
+void RandomVariables(const BasicTest& test, int n,
+                     cl::Array2D<double>* variables) {
+    std::mt19937 random(1);
+    int d = test.parameter.n_variables;
+    variables->Resize(n, d);
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < d; ++j) {
+            std::uniform_real_distribution<double> uniform(
+                    test.parameter.min_variables[j],
+                    test.parameter.max_variables[j]);
+            (*variables)(i, j) = uniform(random);
+        }
+    }
+}
+
+/**
+ * The maximum error of the kernel of test at the given level against the
+ * scalar objectives of test, for the first n candidates.
+ */
+double MaxError(BasicTest* test, cl::simd::SimdLevel level, int n) {
+    cl::Array2D<double> variables, objectives, expected;
+    RandomVariables(*test, n, &variables);
+    PopulationUtil::SetObjectiveValues(*test, variables, &expected);
+
+    std::unique_ptr<BatchEvaluator> evaluator(
+            KernelFactory::CreateEvaluator(*test, level));
+    test->batch_evaluator = evaluator.get();
+    PopulationUtil::SetObjectiveValues(*test, variables, &objectives);
+    test->batch_evaluator = NULL;
+
+    if (objectives.rows() != expected.rows() ||
+        objectives.columns() != expected.columns()) {
+        return INFINITY;
+    }
+    double max_error = 0.0;
+    for (size_t i = 0; i < expected.data().size(); ++i) {
+        double f = expected.data()[i];
+        double error = std::fabs(objectives.data()[i] - f) /
+                       std::max(std::fabs(f), 1.0);
+        // A NaN is never within the bound.
+        max_error = error <= max_error ? max_error : error;
+    }
+    return max_error;
+}
+
+} // namespace
+
+// Every kernel computes the objectives of its test within the bound, at each
+// instruction set supported by the processor, including the partial blocks.
+TEST(TestKernels_MatchScalarTests) {
+    std::vector<std::string> names = TestFactory::registry()->names();
+    std::sort(names.begin(), names.end());
+    int n_kernels = 0;
+    for (const std::string& name : names) {
+        std::unique_ptr<BasicTest> test(TestFactory::CreateTest(name));
+        std::unique_ptr<BatchEvaluator> evaluator(
+                KernelFactory::CreateEvaluator(*test));
+        if (!evaluator) continue;
+        ++n_kernels;
+
+        for (int level = cl::simd::GENERIC;
+             level <= cl::simd::SupportedLevel(); ++level) {
+            cl::simd::SimdLevel simd = cl::simd::SimdLevel(level);
+            EXPECT(MaxError(test.get(), simd, N_CANDIDATES) <= BOUND);
+            for (int n = 1; n <= 9; ++n) {
+                EXPECT(MaxError(test.get(), simd, n) <= BOUND);
+            }
+        }
+    }
+    EXPECT(n_kernels == 28);
+}
+
+#endif // CL_BATCH_MATH
@@ -0,0 +1,126 @@
+//
+// Copyright 2013 Yangbin Lin and Bili Chen. All Rights Reserved.
+//
+// Author: yblin.xmu@qq.com (Yangbin Lin)
+//
+// To use this code, please cite the follow paper:
+//
+// Chen B, Zeng W, Lin Y, et al. A New Local Search-Based Multiobjective
+// Optimization Algorithm[J]. IEEE Transactions on Evolutionary Computation,
+// 2014, 19(1):1-1.
+//
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "solver/util/trajectory_logger.h"
+#include "test/unit/unit_test.h"
+
+using namespace moo;
+
+namespace {
+
+const char TRAJECTORY_FILE[] = "unit_test_trajectory.bin";
+
+/**
+ * A population of n individuals with two objectives.
+ */
+Population Points(int n) {
+    Population population(n);
+    for (int i = 0; i < n; ++i) {
+        population[i].objectives = { 0.1 * i, 1.0 - 0.1 * i };
+    }
+    return population;
+}
+
+/**
+ * Write the bytes into the file.
+ */
+void WriteBytes(const std::vector<char>& bytes, const char* file) {
+    FILE* out = std::fopen(file, "wb");
+    if (!out) return;
+    std::fwrite(bytes.data(), 1, bytes.size(), out);
+    std::fclose(out);
+}
+
+} // namespace
+
+// The frames written without error are reported as such and read back.
+TEST(TrajectoryLogger_WriteAndRead) {
+    TrajectoryLogger logger;
+    EXPECT(logger.Open(TRAJECTORY_FILE));
+    for (int generation = 0; generation < 3; ++generation) {
+        EXPECT(logger.Log(generation, Points(10)));
+    }
+    EXPECT(logger.Flush());
+    EXPECT(logger.n_written() == 3);
+    EXPECT(logger.Close());
+
+    std::vector<TrajectoryFrame> frames;
+    EXPECT(TrajectoryLogger::Read(TRAJECTORY_FILE, &frames));
+    EXPECT(frames.size() == 3);
+    EXPECT(frames.back().generation == 2 && frames.back().n_rows == 10);
+    EXPECT(frames.back().objectives[3] == 1.0 - 0.1 * 1);
+    std::remove(TRAJECTORY_FILE);
+}
+
+// A corrupt or truncated chunk is rejected before its frame is allocated.
+TEST(TrajectoryLogger_RejectsCorruptHeader) {
+    TrajectoryLogger logger;
+    EXPECT(logger.Open(TRAJECTORY_FILE));
+    EXPECT(logger.Log(0, Points(10)));
+    EXPECT(logger.Close());
+
+    std::vector<char> bytes;
+    FILE* in = std::fopen(TRAJECTORY_FILE, "rb");
+    EXPECT(in);
+    if (!in) return;
+    for (int c = std::fgetc(in); c != EOF; c = std::fgetc(in)) {
+        bytes.push_back(static_cast<char>(c));
+    }
+    std::fclose(in);
+
+    // The offsets of n_rows, n_objectives and n_variables in the chunk.
+    const size_t offsets[] = { 24, 28, 32 };
+    const uint32_t counts[] = { 0xFFFFFFFFu, 0x7FFFFFFFu, 100000u };
+    std::vector<TrajectoryFrame> frames;
+    for (size_t offset : offsets) {
+        for (uint32_t count : counts) {
+            std::vector<char> corrupt = bytes;
+            std::memcpy(&corrupt[offset], &count, sizeof(count));
+            WriteBytes(corrupt, TRAJECTORY_FILE);
+            EXPECT(!TrajectoryLogger::Read(TRAJECTORY_FILE, &frames));
+        }
+    }
+    std::vector<char> no_rows = bytes;
+    std::memset(&no_rows[24], 0, 4);
+    WriteBytes(no_rows, TRAJECTORY_FILE);
+    EXPECT(!TrajectoryLogger::Read(TRAJECTORY_FILE, &frames));
+
+    WriteBytes(std::vector<char>(bytes.begin(), bytes.end() - 1),
+               TRAJECTORY_FILE);
+    EXPECT(!TrajectoryLogger::Read(TRAJECTORY_FILE, &frames));
+
+    WriteBytes(bytes, TRAJECTORY_FILE);
+    EXPECT(TrajectoryLogger::Read(TRAJECTORY_FILE, &frames));
+    EXPECT(frames.size() == 1);
+    std::remove(TRAJECTORY_FILE);
+}
+
+#ifndef _WIN32
+// A full disk is reported by Flush() and Close().
+TEST(TrajectoryLogger_ReportsWriteError) {
+    FILE* full = std::fopen("/dev/full", "wb");
+    if (!full) return;
+    std::fclose(full);
+
+    TrajectoryLogger logger;
+    EXPECT(logger.Open("/dev/full"));
+    EXPECT(logger.Log(0, Points(10)));
+    EXPECT(!logger.Flush());
+    EXPECT(logger.write_error());
+    EXPECT(!logger.Close());
+}
+#endif
@@ -0,0 +1,29 @@
+TEMPLATE = app
+CONFIG += console
+CONFIG -= app_bundle
+CONFIG -= qt
+CONFIG += c++11
+
+TARGET = unit_test
+INCLUDEPATH += ../..
+
+SOURCES += \
+    main.cpp \
+    batch_math_test.cpp \
+    checkpoint_test.cpp \
+    nsls_updater_test.cpp \
+    pareto_front_io_test.cpp \
+    process_pool_evaluator_test.cpp \
+    termination_test.cpp \
+    test_kernels_test.cpp \
+    trajectory_logger_test.cpp
+
+HEADERS += \
+    unit_test.h
+
+unix:QMAKE_CXXFLAGS += -pthread
+unix:LIBS += -pthread -ldl
+
+# The wide vectors of cl::batch_math are passed by value only to the inlined
+# functions, so the ABI warnings of GCC do not apply.
+*-g++*:QMAKE_CXXFLAGS += -Wno-psabi
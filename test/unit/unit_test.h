@@ -0,0 +1,96 @@
+//
+// Copyright 2013 Yangbin Lin and Bili Chen. All Rights Reserved.
+//
+// Author: yblin.xmu@qq.com (Yangbin Lin)
+//
+// To use this code, please cite the follow paper:
+//
+// Chen B, Zeng W, Lin Y, et al. A New Local Search-Based Multiobjective
+// Optimization Algorithm[J]. IEEE Transactions on Evolutionary Computation,
+// 2014, 19(1):1-1.
+//
+
+#ifndef TEST_UNIT_UNIT_TEST_H_
+#define TEST_UNIT_UNIT_TEST_H_
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace unit_test {
+
+/// A test case registered by TEST().
+struct TestCase {
+    const char* name;
+    void (*function)();
+};
+
+/**
+ * All registered test cases.
+ */
+inline std::vector<TestCase>* Registry() {
+    static std::vector<TestCase> registry;
+    return &registry;
+}
+
+/**
+ * The number of failed checks.
+ */
+inline int* Failures() {
+    static int n_failures = 0;
+    return &n_failures;
+}
+
+/// Register a test case at the static initialization.
+struct Registrar {
+    Registrar(const char* name, void (*function)()) {
+        TestCase test_case = { name, function };
+        Registry()->push_back(test_case);
+    }
+};
+
+/**
+ * Run the test cases whose names contain 'filter'.
+ *
+ * @return the number of failed checks.
+ */
+inline int RunAll(const std::string& filter) {
+    for (const TestCase& test_case : *Registry()) {
+        if (std::string(test_case.name).find(filter) == std::string::npos) {
+            continue;
+        }
+        int n_failures = *Failures();
+        test_case.function();
+        std::printf("%-6s %s\n", *Failures() == n_failures ? "OK" : "FAILED",
+                    test_case.name);
+    }
+    return *Failures();
+}
+
+} // namespace unit_test
+
+/**
+ * Define a test case, e.g.,
+ *
+ *    TEST(Checkpoint_RestartIsExact) {
+ *        EXPECT(...);
+ *    }
+ */
+#define TEST(name)                                                   \
+    static void name();                                              \
+    static unit_test::Registrar name##_registrar(#name, name);       \
+    static void name()
+
+/**
+ * Check the condition, and report it if it fails.
+ */
+#define EXPECT(condition)                                            \
+    do {                                                             \
+        if (!(condition)) {                                          \
+            ++*unit_test::Failures();                                \
+            std::printf("%s:%d: EXPECT(%s) failed\n", __FILE__,      \
+                        __LINE__, #condition);                       \
+        }                                                            \
+    } while (0)
+
+#endif // TEST_UNIT_UNIT_TEST_H_